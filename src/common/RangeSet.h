@@ -0,0 +1,166 @@
+/**
+ * Copyright (c) 2006-2024 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#pragma once
+
+#include "Range.h"
+
+#include <stddef.h>
+#include <vector>
+#include <algorithm>
+
+namespace love
+{
+
+/**
+ * A sorted set of non-overlapping Ranges. Ranges which overlap or touch are
+ * merged as they're added. When the number of stored ranges exceeds the
+ * configured maximum, the two ranges with the smallest gap between them are
+ * merged, so the set always stays small.
+ **/
+class RangeSet
+{
+public:
+
+	static constexpr size_t DEFAULT_MAX_RANGES = 32;
+
+	RangeSet(size_t maxRanges = DEFAULT_MAX_RANGES)
+		: maxRanges(std::max<size_t>(maxRanges, 1))
+	{}
+
+	void add(size_t offset, size_t size)
+	{
+		if (size > 0)
+			add(Range(offset, size));
+	}
+
+	void add(size_t index)
+	{
+		add(Range(index, 1));
+	}
+
+	void add(const Range &r)
+	{
+		if (!r.isValid())
+			return;
+
+		// Fast path: sequential additions usually extend the last range.
+		if (!ranges.empty() && ranges.back().last + 1 >= r.first && ranges.back().first <= r.first)
+		{
+			ranges.back().last = std::max(ranges.back().last, r.last);
+			return;
+		}
+
+		// First range that ends at or after the position right before r.
+		auto it = std::lower_bound(ranges.begin(), ranges.end(), r, [](const Range &a, const Range &b)
+		{
+			return a.last + 1 < b.first;
+		});
+
+		if (it == ranges.end() || it->first > r.last + 1)
+		{
+			ranges.insert(it, r);
+		}
+		else
+		{
+			// Merge r and every following range it overlaps or touches.
+			it->encapsulate(r);
+			auto next = it + 1;
+			while (next != ranges.end() && next->first <= it->last + 1)
+			{
+				it->last = std::max(it->last, next->last);
+				++next;
+			}
+			ranges.erase(it + 1, next);
+		}
+
+		while (ranges.size() > maxRanges)
+			mergeClosest();
+	}
+
+	/**
+	 * Merges neighbouring ranges which are separated by at most maxGap units.
+	 **/
+	void coalesce(size_t maxGap)
+	{
+		if (ranges.size() < 2)
+			return;
+
+		size_t out = 0;
+		for (size_t i = 1; i < ranges.size(); i++)
+		{
+			if (ranges[i].first - ranges[out].last - 1 <= maxGap)
+				ranges[out].last = ranges[i].last;
+			else
+				ranges[++out] = ranges[i];
+		}
+
+		ranges.resize(out + 1);
+	}
+
+	void clear() { ranges.clear(); }
+	bool isEmpty() const { return ranges.empty(); }
+
+	const std::vector<Range> &getRanges() const { return ranges; }
+
+	Range getBounds() const
+	{
+		if (ranges.empty())
+			return Range();
+		return Range(ranges.front().first, ranges.back().last - ranges.front().first + 1);
+	}
+
+	size_t getTotalSize() const
+	{
+		size_t total = 0;
+		for (const Range &r : ranges)
+			total += r.getSize();
+		return total;
+	}
+
+	size_t getMaxRanges() const { return maxRanges; }
+
+private:
+
+	void mergeClosest()
+	{
+		size_t best = 0;
+		size_t bestgap = ranges[1].first - ranges[0].last;
+
+		for (size_t i = 1; i + 1 < ranges.size(); i++)
+		{
+			size_t gap = ranges[i + 1].first - ranges[i].last;
+			if (gap < bestgap)
+			{
+				best = i;
+				bestgap = gap;
+			}
+		}
+
+		ranges[best].last = ranges[best + 1].last;
+		ranges.erase(ranges.begin() + best + 1);
+	}
+
+	std::vector<Range> ranges;
+	size_t maxRanges;
+
+}; // RangeSet
+
+} // love
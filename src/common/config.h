@@ -69,6 +69,11 @@
 #	endif
 #endif
 
+// SSE2 instructions (integer SIMD). Always available on x86-64.
+#if defined(__SSE2__) || defined(_M_AMD64) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#	define LOVE_SIMD_SSE2
+#endif
+
 // NEON instructions.
 #if defined(__ARM_NEON) || defined(_M_ARM64)
 #	define LOVE_SIMD_NEON
@@ -0,0 +1,337 @@
+/**
+ * Copyright (c) 2006-2024 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#include "common/config.h"
+#include "profiler.h"
+#include "thread/threads.h"
+
+#include <algorithm>
+#include <chrono>
+#include <sstream>
+
+namespace love
+{
+namespace profiler
+{
+
+// Zones per thread. Older zones are overwritten once a thread records more.
+static const uint64 ZONE_CAPACITY = 1 << 15;
+
+// Completed frames kept for getFrames.
+static const uint64 FRAME_CAPACITY = 256;
+
+/**
+ * A single-producer ring of zones. Only the owning thread writes zones, and
+ * readers copy them without locking, dropping any that may have been
+ * overwritten while they were copied. When a thread exits its buffer is
+ * handed to the next new thread, keeping the zones already recorded.
+ **/
+struct ThreadBuffer
+{
+	uint32 id;
+	bool inUse;
+	uint32 depth;
+	std::atomic<uint64> count;
+	Zone zones[ZONE_CAPACITY];
+};
+
+std::atomic<bool> enabled(false);
+
+// These are never freed: threads may exit, and release their buffers, while
+// static variables are being destroyed.
+static thread::Mutex *getMutex()
+{
+	static thread::Mutex *mutex = thread::newMutex();
+	return mutex;
+}
+
+static std::vector<ThreadBuffer *> &getBuffers()
+{
+	static std::vector<ThreadBuffer *> *buffers = new std::vector<ThreadBuffer *>();
+	return *buffers;
+}
+
+// Every thread which has recorded zones, including exited ones.
+static std::vector<ThreadInfo> &getThreadInfos()
+{
+	static std::vector<ThreadInfo> *infos = new std::vector<ThreadInfo>();
+	return *infos;
+}
+
+static Frame frames[FRAME_CAPACITY];
+static uint64 frameCount = 0;
+static uint64 frameStart = 0;
+
+// Gives the calling thread's buffer back when the thread exits.
+struct ThreadBufferOwner
+{
+	ThreadBuffer *buffer = nullptr;
+	std::string name;
+
+	~ThreadBufferOwner()
+	{
+		if (buffer != nullptr)
+		{
+			thread::Lock lock(getMutex());
+			buffer->inUse = false;
+		}
+	}
+};
+
+static thread_local ThreadBufferOwner threadBuffer;
+
+static ThreadBuffer *getThreadBuffer()
+{
+	if (threadBuffer.buffer != nullptr)
+		return threadBuffer.buffer;
+
+	thread::Lock lock(getMutex());
+
+	ThreadBuffer *buffer = nullptr;
+	for (ThreadBuffer *b : getBuffers())
+	{
+		if (!b->inUse)
+		{
+			buffer = b;
+			break;
+		}
+	}
+
+	if (buffer == nullptr)
+	{
+		buffer = new ThreadBuffer();
+		buffer->count.store(0, std::memory_order_relaxed);
+		getBuffers().push_back(buffer);
+	}
+
+	std::vector<ThreadInfo> &infos = getThreadInfos();
+	buffer->id = (uint32) infos.size() + 1;
+	buffer->inUse = true;
+	buffer->depth = 0;
+
+	std::string name = threadBuffer.name;
+	if (name.empty())
+		name = "Thread " + std::to_string(buffer->id);
+	infos.push_back({buffer->id, name});
+
+	threadBuffer.buffer = buffer;
+	return buffer;
+}
+
+uint64 getTime()
+{
+	using namespace std::chrono;
+	static const steady_clock::time_point epoch = steady_clock::now();
+	return (uint64) duration_cast<nanoseconds>(steady_clock::now() - epoch).count();
+}
+
+void setEnabled(bool enable)
+{
+	enabled.store(enable, std::memory_order_relaxed);
+}
+
+bool isEnabled()
+{
+	return enabled.load(std::memory_order_relaxed);
+}
+
+void setThreadName(const char *name)
+{
+	threadBuffer.name = name;
+
+	if (threadBuffer.buffer != nullptr)
+	{
+		thread::Lock lock(getMutex());
+		getThreadInfos()[threadBuffer.buffer->id - 1].name = name;
+	}
+}
+
+void markFrame()
+{
+	uint64 now = getTime();
+
+	if (threadBuffer.name.empty())
+		setThreadName("Main");
+
+	thread::Lock lock(getMutex());
+
+	if (isEnabled() && frameStart > 0)
+	{
+		Frame &frame = frames[frameCount % FRAME_CAPACITY];
+		frame.index = frameCount;
+		frame.start = frameStart;
+		frame.end = now;
+		frameCount++;
+	}
+
+	frameStart = now;
+}
+
+void Scope::begin(const char *name)
+{
+	buffer = getThreadBuffer();
+	this->name = name;
+	buffer->depth++;
+	start = getTime();
+}
+
+void Scope::end()
+{
+	uint64 now = getTime();
+	uint64 count = buffer->count.load(std::memory_order_relaxed);
+
+	Zone &zone = buffer->zones[count % ZONE_CAPACITY];
+	zone.name = name;
+	zone.start = start;
+	zone.end = now;
+	zone.depth = --buffer->depth;
+	zone.thread = buffer->id;
+
+	buffer->count.store(count + 1, std::memory_order_release);
+}
+
+static void copyZones(const ThreadBuffer *buffer, uint64 from, uint64 to, std::vector<Zone> &zones)
+{
+	uint64 end = buffer->count.load(std::memory_order_acquire);
+	uint64 begin = end > ZONE_CAPACITY ? end - ZONE_CAPACITY : 0;
+
+	size_t first = zones.size();
+	for (uint64 i = begin; i < end; i++)
+		zones.push_back(buffer->zones[i % ZONE_CAPACITY]);
+
+	std::atomic_thread_fence(std::memory_order_acquire);
+
+	// The owner may have been writing over the oldest entries meanwhile.
+	uint64 after = buffer->count.load(std::memory_order_relaxed);
+	uint64 valid = after >= ZONE_CAPACITY ? after - ZONE_CAPACITY + 1 : 0;
+	if (valid > begin)
+		zones.erase(zones.begin() + first, zones.begin() + first + (size_t) std::min(valid - begin, end - begin));
+
+	auto outside = [&](const Zone &zone) { return zone.start < from || zone.start >= to; };
+	zones.erase(std::remove_if(zones.begin() + first, zones.end(), outside), zones.end());
+}
+
+std::vector<Frame> getFrames(int count)
+{
+	std::vector<Frame> result;
+
+	thread::Lock lock(getMutex());
+
+	uint64 available = std::min(frameCount, FRAME_CAPACITY);
+	uint64 n = std::min(available, (uint64) std::max(count, 0));
+	if (n == 0)
+		return result;
+
+	for (uint64 i = frameCount - n; i < frameCount; i++)
+		result.push_back(frames[i % FRAME_CAPACITY]);
+
+	std::vector<Zone> zones;
+	for (const ThreadBuffer *buffer : getBuffers())
+		copyZones(buffer, result.front().start, result.back().end, zones);
+
+	std::sort(zones.begin(), zones.end(), [](const Zone &a, const Zone &b)
+	{
+		if (a.start != b.start)
+			return a.start < b.start;
+		return a.depth < b.depth;
+	});
+
+	size_t z = 0;
+	for (Frame &frame : result)
+	{
+		while (z < zones.size() && zones[z].start < frame.end)
+			frame.zones.push_back(zones[z++]);
+	}
+
+	return result;
+}
+
+std::vector<ThreadInfo> getThreads()
+{
+	thread::Lock lock(getMutex());
+	return getThreadInfos();
+}
+
+static void writeJSONString(std::stringstream &ss, const std::string &str)
+{
+	ss << '"';
+	for (char c : str)
+	{
+		if (c == '"' || c == '\\')
+			ss << '\\' << c;
+		else if ((unsigned char) c < 0x20)
+			ss << ' ';
+		else
+			ss << c;
+	}
+	ss << '"';
+}
+
+std::string getChromeTrace(const std::vector<Frame> &frames)
+{
+	std::stringstream ss;
+	ss.precision(3);
+	ss << std::fixed;
+
+	ss << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+	ss << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"Frames\"}}";
+
+	std::vector<bool> used;
+	for (const Frame &frame : frames)
+	{
+		for (const Zone &zone : frame.zones)
+		{
+			if (zone.thread >= used.size())
+				used.resize(zone.thread + 1, false);
+			used[zone.thread] = true;
+		}
+	}
+
+	for (const ThreadInfo &info : getThreads())
+	{
+		if (info.id >= used.size() || !used[info.id])
+			continue;
+
+		ss << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << info.id << ",\"args\":{\"name\":";
+		writeJSONString(ss, info.name);
+		ss << "}}";
+	}
+
+	// Times are in microseconds.
+	for (const Frame &frame : frames)
+	{
+		ss << ",\n{\"name\":\"Frame " << frame.index << "\",\"ph\":\"X\",\"pid\":1,\"tid\":0,\"ts\":"
+		   << frame.start / 1000.0 << ",\"dur\":" << (frame.end - frame.start) / 1000.0 << "}";
+
+		for (const Zone &zone : frame.zones)
+		{
+			ss << ",\n{\"name\":";
+			writeJSONString(ss, zone.name);
+			ss << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << zone.thread << ",\"ts\":" << zone.start / 1000.0
+			   << ",\"dur\":" << (zone.end - zone.start) / 1000.0 << "}";
+		}
+	}
+
+	ss << "\n]}\n";
+	return ss.str();
+}
+
+} // profiler
+} // love
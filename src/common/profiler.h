@@ -0,0 +1,141 @@
+/**
+ * Copyright (c) 2006-2024 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#pragma once
+
+#include "int.h"
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+namespace love
+{
+namespace profiler
+{
+
+/**
+ * A timed CPU zone. Times are in nanoseconds since the profiler's epoch.
+ **/
+struct Zone
+{
+	const char *name;
+	uint64 start;
+	uint64 end;
+	uint32 depth;
+	uint32 thread;
+};
+
+/**
+ * The time between two markFrame calls and the zones which started in it,
+ * ordered by start time.
+ **/
+struct Frame
+{
+	uint64 index;
+	uint64 start;
+	uint64 end;
+	std::vector<Zone> zones;
+};
+
+struct ThreadInfo
+{
+	uint32 id;
+	std::string name;
+};
+
+/**
+ * Zones are only recorded while the profiler is enabled. It's disabled by
+ * default, in which case a zone costs a single relaxed atomic load.
+ **/
+void setEnabled(bool enable);
+bool isEnabled();
+
+/**
+ * Ends the current frame. Called by love.timer.step on the main thread.
+ **/
+void markFrame();
+
+/**
+ * Names the calling thread in results and traces.
+ **/
+void setThreadName(const char *name);
+
+/**
+ * Gets up to count of the most recently completed frames, oldest first.
+ **/
+std::vector<Frame> getFrames(int count);
+
+std::vector<ThreadInfo> getThreads();
+
+/**
+ * Gets the frames as Chrome trace-event JSON, which can be opened in
+ * chrome://tracing or Perfetto.
+ **/
+std::string getChromeTrace(const std::vector<Frame> &frames);
+
+/**
+ * Nanoseconds since the profiler's epoch.
+ **/
+uint64 getTime();
+
+struct ThreadBuffer;
+
+extern std::atomic<bool> enabled;
+
+/**
+ * Records the lifetime of the scope as a zone. The name must be a string
+ * literal (or otherwise outlive the profiler).
+ **/
+class Scope
+{
+public:
+
+	Scope(const char *name)
+		: buffer(nullptr)
+	{
+		if (enabled.load(std::memory_order_relaxed))
+			begin(name);
+	}
+
+	~Scope()
+	{
+		if (buffer != nullptr)
+			end();
+	}
+
+private:
+
+	void begin(const char *name);
+	void end();
+
+	ThreadBuffer *buffer;
+	const char *name;
+	uint64 start;
+
+}; // Scope
+
+} // profiler
+} // love
+
+#define LOVE_PROFILE_CONCAT_(a, b) a##b
+#define LOVE_PROFILE_CONCAT(a, b) LOVE_PROFILE_CONCAT_(a, b)
+
+#define LOVE_PROFILE_ZONE(name) love::profiler::Scope LOVE_PROFILE_CONCAT(love_profile_zone_, __LINE__)(name)
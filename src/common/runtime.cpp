@@ -89,6 +89,11 @@ static int w__eq(lua_State *L)
 
 typedef uint64 ObjectKey;
 
+// The addresses of these are used as lightuserdata keys into the registry.
+// Raw lookups with lightuserdata keys don't need to hash a string each time.
+static char objectsRegistryKey = 0;
+static char typeMetatablesRegistryKey = 0;
+
 static bool luax_isfulllightuserdatasupported(lua_State *L)
 {
 	// LuaJIT prior to commit e9af1abec542e6f9851ff2368e7f196b6382a44c doesn't
@@ -186,7 +191,7 @@ static int w__release(lua_State *L)
 			ObjectKey objectkey = luax_computeloveobjectkey(L, object);
 			luax_pushloveobjectkey(L, objectkey);
 			lua_pushnil(L);
-			lua_settable(L, -3);
+			lua_rawset(L, -3);
 		}
 
 		lua_pop(L, 1);
@@ -196,6 +201,88 @@ static int w__release(lua_State *L)
 	return 1;
 }
 
+/**
+ * Pushes the metatable for the given type. Metatables are cached per Lua state
+ * in a registry table indexed by type id, so this doesn't need to look up the
+ * type's name in the registry. The metatable is created if it doesn't exist
+ * yet, and is guaranteed to have a __gc metamethod.
+ **/
+static void luax_pushcachedtypemetatable(lua_State *L, love::Type &type)
+{
+	lua_pushlightuserdata(L, &typeMetatablesRegistryKey);
+	lua_rawget(L, LUA_REGISTRYINDEX);
+
+	if (!lua_istable(L, -1))
+	{
+		lua_pop(L, 1);
+		lua_createtable(L, (int) Type::MAX_TYPES, 0);
+
+		lua_pushlightuserdata(L, &typeMetatablesRegistryKey);
+		lua_pushvalue(L, -2);
+		lua_rawset(L, LUA_REGISTRYINDEX);
+	}
+
+	int id = (int) type.getId();
+	lua_rawgeti(L, -1, id);
+
+	if (!lua_istable(L, -1))
+	{
+		lua_pop(L, 1);
+
+		luaL_newmetatable(L, type.getName());
+
+		lua_getfield(L, -1, "__gc");
+		bool has_gc = !lua_isnoneornil(L, -1);
+		lua_pop(L, 1);
+
+		// Make sure mt.__gc exists, so Lua states which don't have the object's
+		// module loaded will still clean the object up when it's collected.
+		if (!has_gc)
+		{
+			lua_pushcfunction(L, w__gc);
+			lua_setfield(L, -2, "__gc");
+		}
+
+		// cache[id] = metatable
+		lua_pushvalue(L, -1);
+		lua_rawseti(L, -3, id);
+	}
+
+	// Remove the cache table from the stack.
+	lua_remove(L, -2);
+}
+
+/**
+ * Pushes the weak-valued table of instantiated objects, creating it first if
+ * it doesn't exist yet.
+ **/
+static void luax_insistobjectsregistry(lua_State *L)
+{
+	lua_pushlightuserdata(L, &objectsRegistryKey);
+	lua_rawget(L, LUA_REGISTRYINDEX);
+
+	if (lua_istable(L, -1))
+		return;
+
+	lua_pop(L, 1);
+	lua_newtable(L);
+
+	// Create a metatable.
+	lua_newtable(L);
+
+	// metatable.__mode = "v". Weak userdata values.
+	lua_pushliteral(L, "v");
+	lua_setfield(L, -2, "__mode");
+
+	// setmetatable(newtable, metatable)
+	lua_setmetatable(L, -2);
+
+	// registry[objectsRegistryKey] = newtable
+	lua_pushlightuserdata(L, &objectsRegistryKey);
+	lua_pushvalue(L, -2);
+	lua_rawset(L, LUA_REGISTRYINDEX);
+}
+
 Reference *luax_refif(lua_State *L, int type)
 {
 	Reference *r = nullptr;
@@ -490,32 +577,13 @@ int luax_register_type(lua_State *L, love::Type *type, ...)
 {
 	type->init();
 
-	// Get the place for storing and re-using instantiated love types.
-	luax_getregistry(L, REGISTRY_OBJECTS);
-
-	// Create registry._loveobjects if it doesn't exist yet.
-	if (!lua_istable(L, -1))
-	{
-		lua_newtable(L);
-		lua_replace(L, -2);
-
-		// Create a metatable.
-		lua_newtable(L);
-
-		// metatable.__mode = "v". Weak userdata values.
-		lua_pushliteral(L, "v");
-		lua_setfield(L, -2, "__mode");
-
-		// setmetatable(newtable, metatable)
-		lua_setmetatable(L, -2);
-
-		// registry._loveobjects = newtable
-		lua_setfield(L, LUA_REGISTRYINDEX, "_loveobjects");
-	}
-	else
-		lua_pop(L, 1);
+	// Create the place for storing and re-using instantiated love types, if
+	// it doesn't exist yet.
+	luax_insistobjectsregistry(L);
+	lua_pop(L, 1);
 
-	luaL_newmetatable(L, type->getName());
+	// Also stores the metatable in the per-state type id cache.
+	luax_pushcachedtypemetatable(L, *type);
 
 	// m.__index = m
 	lua_pushvalue(L, -1);
@@ -629,21 +697,7 @@ void luax_rawnewtype(lua_State *L, love::Type &type, love::Object *object)
 	u->object = object;
 	u->type = &type;
 
-	const char *name = type.getName();
-	luaL_newmetatable(L, name);
-
-	lua_getfield(L, -1, "__gc");
-	bool has_gc = !lua_isnoneornil(L, -1);
-	lua_pop(L, 1);
-
-	// Make sure mt.__gc exists, so Lua states which don't have the object's
-	// module loaded will still clean the object up when it's collected.
-	if (!has_gc)
-	{
-		lua_pushcfunction(L, w__gc);
-		lua_setfield(L, -2, "__gc");
-	}
-
+	luax_pushcachedtypemetatable(L, type);
 	lua_setmetatable(L, -2);
 }
 
@@ -667,9 +721,11 @@ void luax_pushtype(lua_State *L, love::Type &type, love::Object *object)
 
 	ObjectKey objectkey = luax_computeloveobjectkey(L, object);
 
-	// Get the value of loveobjects[object] on the stack.
+	// Get the value of loveobjects[object] on the stack. The table only has a
+	// __mode metafield, so a raw lookup is equivalent and avoids the
+	// metamethod check.
 	luax_pushloveobjectkey(L, objectkey);
-	lua_gettable(L, -2);
+	lua_rawget(L, -2);
 
 	// If the Proxy userdata isn't in the instantiated types table yet, add it.
 	if (lua_type(L, -1) != LUA_TUSERDATA)
@@ -682,7 +738,7 @@ void luax_pushtype(lua_State *L, love::Type &type, love::Object *object)
 		lua_pushvalue(L, -2);
 
 		// loveobjects[object] = Proxy.
-		lua_settable(L, -4);
+		lua_rawset(L, -4);
 	}
 
 	// Remove the loveobjects table from the stack.
@@ -1011,7 +1067,8 @@ int luax_insistregistry(lua_State *L, Registry r)
 	case REGISTRY_MODULES:
 		return luax_insistlove(L, "_modules");
 	case REGISTRY_OBJECTS:
-		return luax_insist(L, LUA_REGISTRYINDEX, "_loveobjects");
+		luax_insistobjectsregistry(L);
+		return 1;
 	default:
 		return luaL_error(L, "Attempted to use invalid registry.");
 	}
@@ -1024,7 +1081,8 @@ int luax_getregistry(lua_State *L, Registry r)
 	case REGISTRY_MODULES:
 		return luax_getlove(L, "_modules");
 	case REGISTRY_OBJECTS:
-		lua_getfield(L, LUA_REGISTRYINDEX, "_loveobjects");
+		lua_pushlightuserdata(L, &objectsRegistryKey);
+		lua_rawget(L, LUA_REGISTRYINDEX);
 		return 1;
 	default:
 		return luaL_error(L, "Attempted to use invalid registry.");
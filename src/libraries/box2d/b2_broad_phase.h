@@ -28,6 +28,8 @@
 #include "b2_collision.h"
 #include "b2_dynamic_tree.h"
 
+class b2TaskExecutor;
+
 struct B2_API b2Pair
 {
 	int32 proxyIdA;
@@ -76,8 +78,10 @@ class B2_API b2BroadPhase
 	int32 GetProxyCount() const;
 
 	/// Update the pairs. This results in pair callbacks. This can only add pairs.
+	/// The tree queries may be split across the executor's workers, the pair
+	/// callbacks are always made on the calling thread and in the same order.
 	template <typename T>
-	void UpdatePairs(T* callback);
+	void UpdatePairs(T* callback, b2TaskExecutor* executor = nullptr);
 
 	/// Query an AABB for overlapping proxies. The callback class
 	/// is called for each proxy that overlaps the supplied AABB.
@@ -111,12 +115,16 @@ class B2_API b2BroadPhase
 private:
 
 	friend class b2DynamicTree;
+	friend class b2World;
 
 	void BufferMove(int32 proxyId);
 	void UnBufferMove(int32 proxyId);
 
 	bool QueryCallback(int32 proxyId);
 
+	void QueryMoves();
+	bool QueryMovesParallel(b2TaskExecutor* executor);
+
 	b2DynamicTree m_tree;
 
 	int32 m_proxyCount;
@@ -170,26 +178,15 @@ inline float b2BroadPhase::GetTreeQuality() const
 }
 
 template <typename T>
-void b2BroadPhase::UpdatePairs(T* callback)
+void b2BroadPhase::UpdatePairs(T* callback, b2TaskExecutor* executor)
 {
 	// Reset pair buffer
 	m_pairCount = 0;
 
 	// Perform tree queries for all moving proxies.
-	for (int32 i = 0; i < m_moveCount; ++i)
+	if (executor == nullptr || QueryMovesParallel(executor) == false)
 	{
-		m_queryProxyId = m_moveBuffer[i];
-		if (m_queryProxyId == e_nullProxy)
-		{
-			continue;
-		}
-
-		// We have to query the tree with the fat AABB so that
-		// we don't fail to create a pair that may touch later.
-		const b2AABB& fatAABB = m_tree.GetFatAABB(m_queryProxyId);
-
-		// Query tree, create pairs and add them pair buffer.
-		m_tree.Query(this, fatAABB);
+		QueryMoves();
 	}
 
 	// Send pairs to caller
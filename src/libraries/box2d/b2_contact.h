@@ -210,6 +210,13 @@ class B2_API b2Contact
 
 	void Update(b2ContactListener* listener);
 
+	/// Compute the new manifold and touching status without modifying the contact.
+	/// Safe to call concurrently for different contacts.
+	bool UpdateManifold(b2Manifold* manifold);
+
+	/// Store the result of UpdateManifold and send the listener callbacks.
+	void ApplyUpdate(const b2Manifold& manifold, bool touching, b2ContactListener* listener);
+
 	static b2ContactRegister s_registers[b2Shape::e_typeCount][b2Shape::e_typeCount];
 	static bool s_initialized;
 
@@ -30,12 +30,15 @@ class b2Contact;
 class b2ContactFilter;
 class b2ContactListener;
 class b2BlockAllocator;
+class b2TaskExecutor;
+struct b2ContactUpdate;
 
 // Delegate of b2World.
 class B2_API b2ContactManager
 {
 public:
 	b2ContactManager();
+	~b2ContactManager();
 
 	// Broad-phase callback.
 	void AddPair(void* proxyUserDataA, void* proxyUserDataB);
@@ -44,14 +47,28 @@ class B2_API b2ContactManager
 
 	void Destroy(b2Contact* c);
 
+	// Link a new contact into the world and body contact lists, or unlink and
+	// free one without notifying the contact listener.
+	void Insert(b2Contact* c);
+	void Remove(b2Contact* c);
+
 	void Collide();
 
+	// Evaluate the manifolds of the contacts Collide will update on the task
+	// executor's workers. Returns the number of entries in m_updates.
+	int32 UpdateManifolds();
+	static void UpdateManifoldsTask(int32 taskIndex, void* context);
+
 	b2BroadPhase m_broadPhase;
 	b2Contact* m_contactList;
 	int32 m_contactCount;
 	b2ContactFilter* m_contactFilter;
 	b2ContactListener* m_contactListener;
 	b2BlockAllocator* m_allocator;
+	b2TaskExecutor* m_taskExecutor;
+
+	b2ContactUpdate* m_updates;
+	int32 m_updateCapacity;
 };
 
 #endif
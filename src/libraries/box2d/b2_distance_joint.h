@@ -140,6 +140,7 @@ class B2_API b2DistanceJoint : public b2Joint
 	void InitVelocityConstraints(const b2SolverData& data) override;
 	void SolveVelocityConstraints(const b2SolverData& data) override;
 	bool SolvePositionConstraints(const b2SolverData& data) override;
+	void SerializeState(b2StateStream& stream) override;
 
 	float m_stiffness;
 	float m_damping;
@@ -135,6 +135,8 @@ class B2_API b2DynamicTree
 
 private:
 
+	friend class b2World;
+
 	int32 AllocateNode();
 	void FreeNode(int32 node);
 
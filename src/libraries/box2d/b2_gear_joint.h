@@ -88,6 +88,7 @@ class B2_API b2GearJoint : public b2Joint
 	void InitVelocityConstraints(const b2SolverData& data) override;
 	void SolveVelocityConstraints(const b2SolverData& data) override;
 	bool SolvePositionConstraints(const b2SolverData& data) override;
+	void SerializeState(b2StateStream& stream) override;
 
 	b2Joint* m_joint1;
 	b2Joint* m_joint2;
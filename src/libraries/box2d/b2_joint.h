@@ -31,6 +31,7 @@ class b2Draw;
 class b2Joint;
 struct b2SolverData;
 class b2BlockAllocator;
+class b2StateStream;
 
 enum b2JointType
 {
@@ -174,6 +175,9 @@ class B2_API b2Joint
 	// This returns true if the position errors are within tolerance.
 	virtual bool SolvePositionConstraints(const b2SolverData& data) = 0;
 
+	// Read or write the state that persists between time steps (see b2World::SaveState).
+	virtual void SerializeState(b2StateStream& stream) = 0;
+
 	b2JointType m_type;
 	b2Joint* m_prev;
 	b2Joint* m_next;
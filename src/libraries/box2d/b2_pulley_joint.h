@@ -125,6 +125,7 @@ class B2_API b2PulleyJoint : public b2Joint
 	void InitVelocityConstraints(const b2SolverData& data) override;
 	void SolveVelocityConstraints(const b2SolverData& data) override;
 	bool SolvePositionConstraints(const b2SolverData& data) override;
+	void SerializeState(b2StateStream& stream) override;
 
 	b2Vec2 m_groundAnchorA;
 	b2Vec2 m_groundAnchorB;
@@ -0,0 +1,100 @@
+// MIT License
+
+// Copyright (c) 2019 Erin Catto
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifndef B2_STATE_STREAM_H
+#define B2_STATE_STREAM_H
+
+#include <string.h>
+
+#include "b2_api.h"
+#include "b2_settings.h"
+
+/// Reads or writes the raw simulation state of world objects. The same
+/// serialization code is used in both directions: Value either copies a member
+/// out to the stream or overwrites it from the stream.
+/// Writing past the capacity keeps counting bytes without storing them, so
+/// GetOffset reports the size required to hold the whole state.
+class B2_API b2StateStream
+{
+public:
+	enum Mode
+	{
+		e_write,
+		e_read
+	};
+
+	b2StateStream(Mode mode, void* data, int32 capacity)
+	{
+		m_mode = mode;
+		m_data = (uint8*)data;
+		m_capacity = data != nullptr ? capacity : 0;
+		m_offset = 0;
+	}
+
+	/// Is this stream overwriting objects from its data?
+	bool IsReading() const { return m_mode == e_read; }
+
+	/// Did every byte read or written so far fit within the capacity?
+	bool IsValid() const { return m_offset <= m_capacity; }
+
+	/// Get the number of bytes read or written so far.
+	int32 GetOffset() const { return m_offset; }
+
+	/// Read or write size bytes at data.
+	void Bytes(void* data, int32 size)
+	{
+		if (m_offset + size <= m_capacity)
+		{
+			if (m_mode == e_write)
+			{
+				memcpy(m_data + m_offset, data, size);
+			}
+			else
+			{
+				memcpy(data, m_data + m_offset, size);
+			}
+		}
+		m_offset += size;
+	}
+
+	/// Step over size bytes without reading or writing them.
+	void Skip(int32 size)
+	{
+		m_offset += size;
+	}
+
+	/// Read or write a plain value.
+	template <typename T>
+	void Value(T& value)
+	{
+		Bytes(&value, sizeof(T));
+	}
+
+private:
+	Mode m_mode;
+	uint8* m_data;
+	int32 m_capacity;
+	int32 m_offset;
+};
+
+#endif
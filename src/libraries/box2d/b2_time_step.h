@@ -63,12 +63,28 @@ struct B2_API b2Velocity
 	float w;
 };
 
+class b2Body;
+
+/// Island index of a static body. Static bodies may be shared by islands that are
+/// solved concurrently, so their index is looked up instead of stored on the body.
+/// This is an internal structure.
+struct B2_API b2StaticIndex
+{
+	const b2Body* body;
+	int32 index;
+};
+
 /// Solver Data
 struct B2_API b2SolverData
 {
 	b2TimeStep step;
 	b2Position* positions;
 	b2Velocity* velocities;
+	const b2StaticIndex* staticIndices;	// sorted by body, nullptr if not shared
+	int32 staticCount;
+
+	/// Get the index of a body in the position and velocity arrays.
+	int32 GetIndex(const b2Body* body) const;
 };
 
 #endif
@@ -38,7 +38,9 @@ struct b2JointDef;
 class b2Body;
 class b2Draw;
 class b2Fixture;
+class b2Island;
 class b2Joint;
+class b2StateStream;
 
 /// The world class manages all physics entities, dynamic simulation,
 /// and asynchronous queries. The world also contains efficient memory
@@ -66,6 +68,14 @@ class B2_API b2World
 	/// remain in scope.
 	void SetContactListener(b2ContactListener* listener);
 
+	/// Register a task executor used to run parts of the time step on worker
+	/// threads. Pass nullptr to step on the calling thread only. Results do not
+	/// depend on the executor. The executor is owned by you and must remain in scope.
+	void SetTaskExecutor(b2TaskExecutor* executor);
+
+	/// Get the registered task executor, if any.
+	b2TaskExecutor* GetTaskExecutor() const;
+
 	/// Register a routine for debug drawing. The debug draw functions are called
 	/// inside with b2World::DebugDraw method. The debug draw object is owned
 	/// by you and must remain in scope.
@@ -214,6 +224,26 @@ class B2_API b2World
 	/// @warning this should be called outside of a time step.
 	void Dump();
 
+	/// Save the simulation state of the world: bodies, fixtures, joints, the broad-phase
+	/// and all contacts including their warm starting impulses. Restoring it gives a world
+	/// that steps bit for bit the same as this one.
+	/// @return the number of bytes required. The state is only complete if this is no
+	/// larger than capacity.
+	/// @warning this should be called outside of a time step.
+	int32 SaveState(void* data, int32 capacity);
+
+	/// Check that a state written by SaveState matches this world and is complete,
+	/// without modifying anything.
+	bool ValidateState(const void* data, int32 size);
+
+	/// Restore a state written by SaveState. The world must have the same bodies,
+	/// fixtures and joints, in the same order, as when the state was saved. The current
+	/// contacts are replaced without calling the contact listener.
+	/// @return false if the state does not pass ValidateState, in which case the world
+	/// is left unchanged.
+	/// @warning this should be called outside of a time step.
+	bool RestoreState(const void* data, int32 size);
+
 private:
 
 	friend class b2Body;
@@ -222,10 +252,16 @@ class B2_API b2World
 	friend class b2Controller;
 
 	void Solve(const b2TimeStep& step);
+	void SolveIslands(const b2TimeStep& step);
+	void SolveIslandsParallel(const b2TimeStep& step);
+	void BuildIsland(b2Body* seed, b2Body** stack, int32 stackSize, b2Island* island);
 	void SolveTOI(const b2TimeStep& step);
 
 	void DrawShape(b2Fixture* shape, const b2Transform& xf, const b2Color& color);
 
+	bool SerializeTopology(b2StateStream& stream);
+	void SerializeObjects(b2StateStream& stream);
+
 	b2BlockAllocator m_blockAllocator;
 	b2StackAllocator m_stackAllocator;
 
@@ -243,6 +279,12 @@ class B2_API b2World
 	b2DestructionListener* m_destructionListener;
 	b2Draw* m_debugDraw;
 
+	b2TaskExecutor* m_taskExecutor;
+
+	// One per task when islands are solved in parallel.
+	b2StackAllocator* m_taskAllocators;
+	int32 m_taskAllocatorCount;
+
 	// This is used to compute the time step ratio to
 	// support a variable time step.
 	float m_inv_dt0;
@@ -337,6 +379,11 @@ inline const b2ContactManager& b2World::GetContactManager() const
 	return m_contactManager;
 }
 
+inline b2TaskExecutor* b2World::GetTaskExecutor() const
+{
+	return m_taskExecutor;
+}
+
 inline const b2Profile& b2World::GetProfile() const
 {
 	return m_profile;
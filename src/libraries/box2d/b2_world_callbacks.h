@@ -158,4 +158,23 @@ class B2_API b2RayCastCallback
 									const b2Vec2& normal, float fraction) = 0;
 };
 
+/// Implement this interface to let b2World run parts of a time step
+/// (narrow-phase contact updates, broad-phase pair finding and island solving)
+/// on worker threads. See b2World::SetTaskExecutor.
+class B2_API b2TaskExecutor
+{
+public:
+	typedef void (*TaskFunction)(int32 taskIndex, void* context);
+
+	virtual ~b2TaskExecutor() {}
+
+	/// The maximum number of tasks which can usefully run at the same time.
+	virtual int32 GetWorkerCount() const = 0;
+
+	/// Call task(i, context) for every i in [0, taskCount), possibly in
+	/// parallel, and return once all of the calls have finished. Each task
+	/// index must be used exactly once.
+	virtual void Run(int32 taskCount, TaskFunction task, void* context) = 0;
+};
+
 #endif
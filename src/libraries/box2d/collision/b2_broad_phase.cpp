@@ -21,8 +21,12 @@
 // SOFTWARE.
 
 #include "box2d/b2_broad_phase.h"
+#include "box2d/b2_world_callbacks.h"
 #include <string.h>
 
+// Fewer moved proxies than this per task are queried on the calling thread.
+static const int32 b2_minMovesPerTask = 64;
+
 b2BroadPhase::b2BroadPhase()
 {
 	m_proxyCount = 0;
@@ -129,3 +133,142 @@ bool b2BroadPhase::QueryCallback(int32 proxyId)
 
 	return true;
 }
+
+void b2BroadPhase::QueryMoves()
+{
+	for (int32 i = 0; i < m_moveCount; ++i)
+	{
+		m_queryProxyId = m_moveBuffer[i];
+		if (m_queryProxyId == e_nullProxy)
+		{
+			continue;
+		}
+
+		// We have to query the tree with the fat AABB so that
+		// we don't fail to create a pair that may touch later.
+		const b2AABB& fatAABB = m_tree.GetFatAABB(m_queryProxyId);
+
+		// Query tree, create pairs and add them pair buffer.
+		m_tree.Query(this, fatAABB);
+	}
+}
+
+// Gathers the pairs of a contiguous range of the move buffer into its own pair buffer.
+struct b2PairQuery
+{
+	bool QueryCallback(int32 proxyId)
+	{
+		// Same as b2BroadPhase::QueryCallback.
+		if (proxyId == queryProxyId)
+		{
+			return true;
+		}
+
+		const bool moved = tree->WasMoved(proxyId);
+		if (moved && proxyId > queryProxyId)
+		{
+			return true;
+		}
+
+		if (pairCount == pairCapacity)
+		{
+			b2Pair* oldBuffer = pairs;
+			pairCapacity = b2Max(16, pairCapacity + (pairCapacity >> 1));
+			pairs = (b2Pair*)b2Alloc(pairCapacity * sizeof(b2Pair));
+			if (oldBuffer)
+			{
+				memcpy(pairs, oldBuffer, pairCount * sizeof(b2Pair));
+				b2Free(oldBuffer);
+			}
+		}
+
+		pairs[pairCount].proxyIdA = b2Min(proxyId, queryProxyId);
+		pairs[pairCount].proxyIdB = b2Max(proxyId, queryProxyId);
+		++pairCount;
+
+		return true;
+	}
+
+	const b2DynamicTree* tree;
+	const int32* moves;
+	int32 moveCount;
+	int32 queryProxyId;
+
+	b2Pair* pairs;
+	int32 pairCount;
+	int32 pairCapacity;
+};
+
+static void b2QueryMovesTask(int32 taskIndex, void* context)
+{
+	b2PairQuery* query = (b2PairQuery*)context + taskIndex;
+
+	for (int32 i = 0; i < query->moveCount; ++i)
+	{
+		query->queryProxyId = query->moves[i];
+		if (query->queryProxyId == b2BroadPhase::e_nullProxy)
+		{
+			continue;
+		}
+
+		const b2AABB& fatAABB = query->tree->GetFatAABB(query->queryProxyId);
+		query->tree->Query(query, fatAABB);
+	}
+}
+
+bool b2BroadPhase::QueryMovesParallel(b2TaskExecutor* executor)
+{
+	int32 taskCount = b2Min(executor->GetWorkerCount(), m_moveCount / b2_minMovesPerTask);
+	if (taskCount < 2)
+	{
+		return false;
+	}
+
+	// Each task handles a contiguous slice of the move buffer. Concatenating the
+	// results in task order gives the same pair buffer as QueryMoves.
+	b2PairQuery* queries = (b2PairQuery*)b2Alloc(taskCount * sizeof(b2PairQuery));
+	for (int32 i = 0; i < taskCount; ++i)
+	{
+		int32 begin = m_moveCount * i / taskCount;
+		int32 end = m_moveCount * (i + 1) / taskCount;
+
+		b2PairQuery* query = queries + i;
+		query->tree = &m_tree;
+		query->moves = m_moveBuffer + begin;
+		query->moveCount = end - begin;
+		query->queryProxyId = e_nullProxy;
+		query->pairs = nullptr;
+		query->pairCount = 0;
+		query->pairCapacity = 0;
+	}
+
+	executor->Run(taskCount, b2QueryMovesTask, queries);
+
+	int32 pairCount = 0;
+	for (int32 i = 0; i < taskCount; ++i)
+	{
+		pairCount += queries[i].pairCount;
+	}
+
+	if (pairCount > m_pairCapacity)
+	{
+		b2Free(m_pairBuffer);
+		m_pairCapacity = pairCount;
+		m_pairBuffer = (b2Pair*)b2Alloc(m_pairCapacity * sizeof(b2Pair));
+	}
+
+	m_pairCount = 0;
+	for (int32 i = 0; i < taskCount; ++i)
+	{
+		b2PairQuery* query = queries + i;
+		if (query->pairs)
+		{
+			memcpy(m_pairBuffer + m_pairCount, query->pairs, query->pairCount * sizeof(b2Pair));
+			m_pairCount += query->pairCount;
+			b2Free(query->pairs);
+		}
+	}
+
+	b2Free(queries);
+	return true;
+}
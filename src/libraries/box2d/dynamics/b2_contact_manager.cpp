@@ -29,6 +29,17 @@
 b2ContactFilter b2_defaultFilter;
 b2ContactListener b2_defaultListener;
 
+// Fewer contacts than this per task are updated on the calling thread.
+static const int32 b2_minContactsPerTask = 64;
+
+// A contact manifold evaluated ahead of Collide.
+struct b2ContactUpdate
+{
+	b2Contact* contact;
+	b2Manifold manifold;
+	bool touching;
+};
+
 b2ContactManager::b2ContactManager()
 {
 	m_contactList = nullptr;
@@ -36,20 +47,34 @@ b2ContactManager::b2ContactManager()
 	m_contactFilter = &b2_defaultFilter;
 	m_contactListener = &b2_defaultListener;
 	m_allocator = nullptr;
+	m_taskExecutor = nullptr;
+	m_updates = nullptr;
+	m_updateCapacity = 0;
 }
 
-void b2ContactManager::Destroy(b2Contact* c)
+b2ContactManager::~b2ContactManager()
 {
-	b2Fixture* fixtureA = c->GetFixtureA();
-	b2Fixture* fixtureB = c->GetFixtureB();
-	b2Body* bodyA = fixtureA->GetBody();
-	b2Body* bodyB = fixtureB->GetBody();
+	if (m_updates)
+	{
+		b2Free(m_updates);
+	}
+}
 
+void b2ContactManager::Destroy(b2Contact* c)
+{
 	if (m_contactListener && c->IsTouching())
 	{
 		m_contactListener->EndContact(c);
 	}
 
+	Remove(c);
+}
+
+void b2ContactManager::Remove(b2Contact* c)
+{
+	b2Body* bodyA = c->GetFixtureA()->GetBody();
+	b2Body* bodyB = c->GetFixtureB()->GetBody();
+
 	// Remove from the world.
 	if (c->m_prev)
 	{
@@ -106,12 +131,113 @@ void b2ContactManager::Destroy(b2Contact* c)
 // This is the top level collision call for the time step. Here
 // all the narrow phase collision is processed for the world
 // contact list.
+struct b2UpdateManifoldsContext
+{
+	b2ContactUpdate* updates;
+	int32 count;
+	int32 taskCount;
+};
+
+void b2ContactManager::UpdateManifoldsTask(int32 taskIndex, void* context)
+{
+	b2UpdateManifoldsContext* ctx = (b2UpdateManifoldsContext*)context;
+	int32 begin = ctx->count * taskIndex / ctx->taskCount;
+	int32 end = ctx->count * (taskIndex + 1) / ctx->taskCount;
+
+	for (int32 i = begin; i < end; ++i)
+	{
+		b2ContactUpdate* update = ctx->updates + i;
+		update->touching = update->contact->UpdateManifold(&update->manifold);
+	}
+}
+
+int32 b2ContactManager::UpdateManifolds()
+{
+	if (m_taskExecutor == nullptr)
+	{
+		return 0;
+	}
+
+	int32 workerCount = m_taskExecutor->GetWorkerCount();
+	if (workerCount < 2 || m_contactCount < 2 * b2_minContactsPerTask)
+	{
+		return 0;
+	}
+
+	if (m_updateCapacity < m_contactCount)
+	{
+		if (m_updates)
+		{
+			b2Free(m_updates);
+		}
+		m_updateCapacity = m_contactCount + (m_contactCount >> 1);
+		m_updates = (b2ContactUpdate*)b2Alloc(m_updateCapacity * sizeof(b2ContactUpdate));
+	}
+
+	// Gather the contacts that are known to reach c->Update in Collide. This has
+	// no side effects, so callbacks made during Collide still see the usual order.
+	int32 count = 0;
+	for (b2Contact* c = m_contactList; c; c = c->GetNext())
+	{
+		if (c->m_flags & b2Contact::e_filterFlag)
+		{
+			continue;
+		}
+
+		b2Fixture* fixtureA = c->GetFixtureA();
+		b2Fixture* fixtureB = c->GetFixtureB();
+		b2Body* bodyA = fixtureA->GetBody();
+		b2Body* bodyB = fixtureB->GetBody();
+
+		bool activeA = bodyA->IsAwake() && bodyA->m_type != b2_staticBody;
+		bool activeB = bodyB->IsAwake() && bodyB->m_type != b2_staticBody;
+		if (activeA == false && activeB == false)
+		{
+			continue;
+		}
+
+		int32 proxyIdA = fixtureA->m_proxies[c->GetChildIndexA()].proxyId;
+		int32 proxyIdB = fixtureB->m_proxies[c->GetChildIndexB()].proxyId;
+		if (m_broadPhase.TestOverlap(proxyIdA, proxyIdB) == false)
+		{
+			continue;
+		}
+
+		m_updates[count++].contact = c;
+	}
+
+	int32 taskCount = b2Min(workerCount, count / b2_minContactsPerTask);
+	if (taskCount < 2)
+	{
+		return 0;
+	}
+
+	b2UpdateManifoldsContext context;
+	context.updates = m_updates;
+	context.count = count;
+	context.taskCount = taskCount;
+	m_taskExecutor->Run(taskCount, UpdateManifoldsTask, &context);
+
+	return count;
+}
+
 void b2ContactManager::Collide()
 {
+	// Manifolds evaluated ahead of time, in contact list order.
+	int32 updateCount = UpdateManifolds();
+	int32 updateIndex = 0;
+
 	// Update awake contacts.
 	b2Contact* c = m_contactList;
 	while (c)
 	{
+		const b2ContactUpdate* update = nullptr;
+		if (updateIndex < updateCount && m_updates[updateIndex].contact == c)
+		{
+			update = m_updates + updateIndex;
+			++updateIndex;
+		}
+
 		b2Fixture* fixtureA = c->GetFixtureA();
 		b2Fixture* fixtureB = c->GetFixtureB();
 		int32 indexA = c->GetChildIndexA();
@@ -168,14 +294,22 @@ void b2ContactManager::Collide()
 		}
 
 		// The contact persists.
-		c->Update(m_contactListener);
+		if (update)
+		{
+			c->ApplyUpdate(update->manifold, update->touching, m_contactListener);
+		}
+		else
+		{
+			// Woken or re-filtered by an earlier callback.
+			c->Update(m_contactListener);
+		}
 		c = c->GetNext();
 	}
 }
 
 void b2ContactManager::FindNewContacts()
 {
-	m_broadPhase.UpdatePairs(this);
+	m_broadPhase.UpdatePairs(this, m_taskExecutor);
 }
 
 void b2ContactManager::AddPair(void* proxyUserDataA, void* proxyUserDataB)
@@ -246,13 +380,14 @@ void b2ContactManager::AddPair(void* proxyUserDataA, void* proxyUserDataB)
 		return;
 	}
 
-	// Contact creation may swap fixtures.
-	fixtureA = c->GetFixtureA();
-	fixtureB = c->GetFixtureB();
-	indexA = c->GetChildIndexA();
-	indexB = c->GetChildIndexB();
-	bodyA = fixtureA->GetBody();
-	bodyB = fixtureB->GetBody();
+	// Contact creation may swap fixtures, Insert uses the contact's own.
+	Insert(c);
+}
+
+void b2ContactManager::Insert(b2Contact* c)
+{
+	b2Body* bodyA = c->GetFixtureA()->GetBody();
+	b2Body* bodyB = c->GetFixtureB()->GetBody();
 
 	// Insert into the world.
 	c->m_prev = nullptr;
@@ -21,6 +21,7 @@
 // SOFTWARE.
 
 #include "b2_contact_solver.h"
+#include "b2_island.h"
 
 #include "box2d/b2_body.h"
 #include "box2d/b2_contact.h"
@@ -77,13 +78,16 @@ b2ContactSolver::b2ContactSolver(b2ContactSolverDef* def)
 		int32 pointCount = manifold->pointCount;
 		b2Assert(pointCount > 0);
 
+		int32 indexA = b2Island::GetIndex(bodyA, def->staticIndices, def->staticCount);
+		int32 indexB = b2Island::GetIndex(bodyB, def->staticIndices, def->staticCount);
+
 		b2ContactVelocityConstraint* vc = m_velocityConstraints + i;
 		vc->friction = contact->m_friction;
 		vc->restitution = contact->m_restitution;
 		vc->threshold = contact->m_restitutionThreshold;
 		vc->tangentSpeed = contact->m_tangentSpeed;
-		vc->indexA = bodyA->m_islandIndex;
-		vc->indexB = bodyB->m_islandIndex;
+		vc->indexA = indexA;
+		vc->indexB = indexB;
 		vc->invMassA = bodyA->m_invMass;
 		vc->invMassB = bodyB->m_invMass;
 		vc->invIA = bodyA->m_invI;
@@ -94,8 +98,8 @@ b2ContactSolver::b2ContactSolver(b2ContactSolverDef* def)
 		vc->normalMass.SetZero();
 
 		b2ContactPositionConstraint* pc = m_positionConstraints + i;
-		pc->indexA = bodyA->m_islandIndex;
-		pc->indexB = bodyB->m_islandIndex;
+		pc->indexA = indexA;
+		pc->indexB = indexB;
 		pc->invMassA = bodyA->m_invMass;
 		pc->invMassB = bodyB->m_invMass;
 		pc->localCenterA = bodyA->m_sweep.localCenter;
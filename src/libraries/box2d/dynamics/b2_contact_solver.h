@@ -68,6 +68,8 @@ struct b2ContactSolverDef
 	int32 count;
 	b2Position* positions;
 	b2Velocity* velocities;
+	const b2StaticIndex* staticIndices;
+	int32 staticCount;
 	b2StackAllocator* allocator;
 };
 
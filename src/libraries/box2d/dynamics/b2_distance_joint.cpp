@@ -23,6 +23,7 @@
 #include "box2d/b2_body.h"
 #include "box2d/b2_draw.h"
 #include "box2d/b2_distance_joint.h"
+#include "box2d/b2_state_stream.h"
 #include "box2d/b2_time_step.h"
 
 // 1-D constrained system
@@ -75,8 +76,8 @@ b2DistanceJoint::b2DistanceJoint(const b2DistanceJointDef* def)
 
 void b2DistanceJoint::InitVelocityConstraints(const b2SolverData& data)
 {
-	m_indexA = m_bodyA->m_islandIndex;
-	m_indexB = m_bodyB->m_islandIndex;
+	m_indexA = data.GetIndex(m_bodyA);
+	m_indexB = data.GetIndex(m_bodyB);
 	m_localCenterA = m_bodyA->m_sweep.localCenter;
 	m_localCenterB = m_bodyB->m_sweep.localCenter;
 	m_invMassA = m_bodyA->m_invMass;
@@ -419,3 +420,19 @@ void b2DistanceJoint::Draw(b2Draw* draw) const
 		}
 	}
 }
+
+void b2DistanceJoint::SerializeState(b2StateStream& stream)
+{
+	stream.Value(m_stiffness);
+	stream.Value(m_damping);
+	stream.Value(m_bias);
+	stream.Value(m_length);
+	stream.Value(m_minLength);
+	stream.Value(m_maxLength);
+	stream.Value(m_localAnchorA);
+	stream.Value(m_localAnchorB);
+	stream.Value(m_gamma);
+	stream.Value(m_impulse);
+	stream.Value(m_lowerImpulse);
+	stream.Value(m_upperImpulse);
+}
@@ -22,6 +22,7 @@
 
 #include "box2d/b2_friction_joint.h"
 #include "box2d/b2_body.h"
+#include "box2d/b2_state_stream.h"
 #include "box2d/b2_time_step.h"
 
 // Point-to-point constraint
@@ -59,8 +60,8 @@ b2FrictionJoint::b2FrictionJoint(const b2FrictionJointDef* def)
 
 void b2FrictionJoint::InitVelocityConstraints(const b2SolverData& data)
 {
-	m_indexA = m_bodyA->m_islandIndex;
-	m_indexB = m_bodyB->m_islandIndex;
+	m_indexA = data.GetIndex(m_bodyA);
+	m_indexB = data.GetIndex(m_bodyB);
 	m_localCenterA = m_bodyA->m_sweep.localCenter;
 	m_localCenterB = m_bodyB->m_sweep.localCenter;
 	m_invMassA = m_bodyA->m_invMass;
@@ -253,3 +254,13 @@ void b2FrictionJoint::Dump()
 	b2Dump("  jd.maxTorque = %.9g;\n", m_maxTorque);
 	b2Dump("  joints[%d] = m_world->CreateJoint(&jd);\n", m_index);
 }
+
+void b2FrictionJoint::SerializeState(b2StateStream& stream)
+{
+	stream.Value(m_localAnchorA);
+	stream.Value(m_localAnchorB);
+	stream.Value(m_linearImpulse);
+	stream.Value(m_angularImpulse);
+	stream.Value(m_maxForce);
+	stream.Value(m_maxTorque);
+}
@@ -24,6 +24,7 @@
 #include "box2d/b2_revolute_joint.h"
 #include "box2d/b2_prismatic_joint.h"
 #include "box2d/b2_body.h"
+#include "box2d/b2_state_stream.h"
 #include "box2d/b2_time_step.h"
 
 // Gear Joint:
@@ -140,10 +141,10 @@ b2GearJoint::b2GearJoint(const b2GearJointDef* def)
 
 void b2GearJoint::InitVelocityConstraints(const b2SolverData& data)
 {
-	m_indexA = m_bodyA->m_islandIndex;
-	m_indexB = m_bodyB->m_islandIndex;
-	m_indexC = m_bodyC->m_islandIndex;
-	m_indexD = m_bodyD->m_islandIndex;
+	m_indexA = data.GetIndex(m_bodyA);
+	m_indexB = data.GetIndex(m_bodyB);
+	m_indexC = data.GetIndex(m_bodyC);
+	m_indexD = data.GetIndex(m_bodyD);
 	m_lcA = m_bodyA->m_sweep.localCenter;
 	m_lcB = m_bodyB->m_sweep.localCenter;
 	m_lcC = m_bodyC->m_sweep.localCenter;
@@ -427,3 +428,18 @@ void b2GearJoint::Dump()
 	b2Dump("  jd.ratio = %.9g;\n", m_ratio);
 	b2Dump("  joints[%d] = m_world->CreateJoint(&jd);\n", m_index);
 }
+
+void b2GearJoint::SerializeState(b2StateStream& stream)
+{
+	stream.Value(m_localAnchorA);
+	stream.Value(m_localAnchorB);
+	stream.Value(m_localAnchorC);
+	stream.Value(m_localAnchorD);
+	stream.Value(m_localAxisC);
+	stream.Value(m_localAxisD);
+	stream.Value(m_referenceAngleA);
+	stream.Value(m_referenceAngleB);
+	stream.Value(m_constant);
+	stream.Value(m_ratio);
+	stream.Value(m_impulse);
+}
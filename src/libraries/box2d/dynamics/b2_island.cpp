@@ -28,10 +28,13 @@
 #include "box2d/b2_stack_allocator.h"
 #include "box2d/b2_timer.h"
 #include "box2d/b2_world.h"
+#include "box2d/b2_world_callbacks.h"
 
 #include "b2_island.h"
 #include "b2_contact_solver.h"
 
+#include <algorithm>
+
 /*
 Position Correction Notes
 =========================
@@ -173,11 +176,19 @@ b2Island::b2Island(
 
 	m_velocities = (b2Velocity*)m_allocator->Allocate(m_bodyCapacity * sizeof(b2Velocity));
 	m_positions = (b2Position*)m_allocator->Allocate(m_bodyCapacity * sizeof(b2Position));
+
+	m_staticIndices = nullptr;
+	m_staticCount = 0;
+	m_impulses = nullptr;
 }
 
 b2Island::~b2Island()
 {
 	// Warning: the order should reverse the constructor order.
+	if (m_staticIndices)
+	{
+		m_allocator->Free(m_staticIndices);
+	}
 	m_allocator->Free(m_positions);
 	m_allocator->Free(m_velocities);
 	m_allocator->Free(m_joints);
@@ -185,12 +196,53 @@ b2Island::~b2Island()
 	m_allocator->Free(m_bodies);
 }
 
+void b2Island::SetShared(b2ContactImpulse* impulses)
+{
+	b2Assert(m_bodyCount == 0 && m_staticIndices == nullptr);
+	m_staticIndices = (b2StaticIndex*)m_allocator->Allocate(m_bodyCapacity * sizeof(b2StaticIndex));
+	m_staticCount = 0;
+	m_impulses = impulses;
+}
+
+static bool b2StaticIndexLess(const b2StaticIndex& a, const b2StaticIndex& b)
+{
+	return a.body < b.body;
+}
+
+int32 b2Island::GetIndex(const b2Body* body, const b2StaticIndex* staticIndices, int32 staticCount)
+{
+	if (staticCount == 0 || body->m_type != b2_staticBody)
+	{
+		return body->m_islandIndex;
+	}
+
+	b2StaticIndex key;
+	key.body = body;
+	key.index = 0;
+	const b2StaticIndex* end = staticIndices + staticCount;
+	const b2StaticIndex* it = std::lower_bound(staticIndices, end, key, b2StaticIndexLess);
+	b2Assert(it != end && it->body == body);
+	return it->index;
+}
+
+int32 b2SolverData::GetIndex(const b2Body* body) const
+{
+	return b2Island::GetIndex(body, staticIndices, staticCount);
+}
+
 void b2Island::Solve(b2Profile* profile, const b2TimeStep& step, const b2Vec2& gravity, bool allowSleep)
 {
 	b2Timer timer;
 
 	float h = step.dt;
 
+	// Static bodies shared with other islands are never written, so skip them below.
+	const bool shared = m_staticIndices != nullptr;
+	if (shared)
+	{
+		std::sort(m_staticIndices, m_staticIndices + m_staticCount, b2StaticIndexLess);
+	}
+
 	// Integrate velocities and apply damping. Initialize the body state.
 	for (int32 i = 0; i < m_bodyCount; ++i)
 	{
@@ -202,8 +254,11 @@ void b2Island::Solve(b2Profile* profile, const b2TimeStep& step, const b2Vec2& g
 		float w = b->m_angularVelocity;
 
 		// Store positions for continuous collision.
-		b->m_sweep.c0 = b->m_sweep.c;
-		b->m_sweep.a0 = b->m_sweep.a;
+		if (shared == false || b->m_type != b2_staticBody)
+		{
+			b->m_sweep.c0 = b->m_sweep.c;
+			b->m_sweep.a0 = b->m_sweep.a;
+		}
 
 		if (b->m_type == b2_dynamicBody)
 		{
@@ -235,6 +290,8 @@ void b2Island::Solve(b2Profile* profile, const b2TimeStep& step, const b2Vec2& g
 	solverData.step = step;
 	solverData.positions = m_positions;
 	solverData.velocities = m_velocities;
+	solverData.staticIndices = m_staticIndices;
+	solverData.staticCount = m_staticCount;
 
 	// Initialize velocity constraints.
 	b2ContactSolverDef contactSolverDef;
@@ -243,6 +300,8 @@ void b2Island::Solve(b2Profile* profile, const b2TimeStep& step, const b2Vec2& g
 	contactSolverDef.count = m_contactCount;
 	contactSolverDef.positions = m_positions;
 	contactSolverDef.velocities = m_velocities;
+	contactSolverDef.staticIndices = m_staticIndices;
+	contactSolverDef.staticCount = m_staticCount;
 	contactSolverDef.allocator = m_allocator;
 
 	b2ContactSolver contactSolver(&contactSolverDef);
@@ -335,6 +394,11 @@ void b2Island::Solve(b2Profile* profile, const b2TimeStep& step, const b2Vec2& g
 	for (int32 i = 0; i < m_bodyCount; ++i)
 	{
 		b2Body* body = m_bodies[i];
+		if (shared && body->m_type == b2_staticBody)
+		{
+			continue;
+		}
+
 		body->m_sweep.c = m_positions[i].c;
 		body->m_sweep.a = m_positions[i].a;
 		body->m_linearVelocity = m_velocities[i].v;
@@ -380,6 +444,11 @@ void b2Island::Solve(b2Profile* profile, const b2TimeStep& step, const b2Vec2& g
 			for (int32 i = 0; i < m_bodyCount; ++i)
 			{
 				b2Body* b = m_bodies[i];
+				if (shared && b->GetType() == b2_staticBody)
+				{
+					continue;
+				}
+
 				b->SetAwake(false);
 			}
 		}
@@ -408,6 +477,8 @@ void b2Island::SolveTOI(const b2TimeStep& subStep, int32 toiIndexA, int32 toiInd
 	contactSolverDef.step = subStep;
 	contactSolverDef.positions = m_positions;
 	contactSolverDef.velocities = m_velocities;
+	contactSolverDef.staticIndices = nullptr;
+	contactSolverDef.staticCount = 0;
 	b2ContactSolver contactSolver(&contactSolverDef);
 
 	// Solve position constraints.
@@ -520,6 +591,24 @@ void b2Island::SolveTOI(const b2TimeStep& subStep, int32 toiIndexA, int32 toiInd
 
 void b2Island::Report(const b2ContactVelocityConstraint* constraints)
 {
+	if (m_impulses != nullptr)
+	{
+		// The listener is called later by the world, in island order.
+		for (int32 i = 0; i < m_contactCount; ++i)
+		{
+			const b2ContactVelocityConstraint* vc = constraints + i;
+
+			b2ContactImpulse* impulse = m_impulses + i;
+			impulse->count = vc->pointCount;
+			for (int32 j = 0; j < vc->pointCount; ++j)
+			{
+				impulse->normalImpulses[j] = vc->points[j].normalImpulse;
+				impulse->tangentImpulses[j] = vc->points[j].tangentImpulse;
+			}
+		}
+		return;
+	}
+
 	if (m_listener == nullptr)
 	{
 		return;
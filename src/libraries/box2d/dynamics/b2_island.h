@@ -32,6 +32,7 @@ class b2Joint;
 class b2StackAllocator;
 class b2ContactListener;
 struct b2ContactVelocityConstraint;
+struct b2ContactImpulse;
 struct b2Profile;
 
 /// This is an internal class.
@@ -53,10 +54,24 @@ class b2Island
 
 	void SolveTOI(const b2TimeStep& subStep, int32 toiIndexA, int32 toiIndexB);
 
+	/// Prepare the island to be solved concurrently with other islands. Static
+	/// bodies added afterwards are indexed locally and never written to, and contact
+	/// impulses are stored in the given array instead of being sent to the listener.
+	void SetShared(b2ContactImpulse* impulses);
+
 	void Add(b2Body* body)
 	{
 		b2Assert(m_bodyCount < m_bodyCapacity);
-		body->m_islandIndex = m_bodyCount;
+		if (m_staticIndices != nullptr && body->m_type == b2_staticBody)
+		{
+			m_staticIndices[m_staticCount].body = body;
+			m_staticIndices[m_staticCount].index = m_bodyCount;
+			++m_staticCount;
+		}
+		else
+		{
+			body->m_islandIndex = m_bodyCount;
+		}
 		m_bodies[m_bodyCount] = body;
 		++m_bodyCount;
 	}
@@ -75,6 +90,9 @@ class b2Island
 
 	void Report(const b2ContactVelocityConstraint* constraints);
 
+	/// Get the index of a body in the solver arrays. staticIndices must be sorted.
+	static int32 GetIndex(const b2Body* body, const b2StaticIndex* staticIndices, int32 staticCount);
+
 	b2StackAllocator* m_allocator;
 	b2ContactListener* m_listener;
 
@@ -85,6 +103,10 @@ class b2Island
 	b2Position* m_positions;
 	b2Velocity* m_velocities;
 
+	b2StaticIndex* m_staticIndices;
+	int32 m_staticCount;
+	b2ContactImpulse* m_impulses;
+
 	int32 m_bodyCount;
 	int32 m_jointCount;
 	int32 m_contactCount;
@@ -22,6 +22,7 @@
 
 #include "box2d/b2_body.h"
 #include "box2d/b2_motor_joint.h"
+#include "box2d/b2_state_stream.h"
 #include "box2d/b2_time_step.h"
 
 // Point-to-point constraint
@@ -67,8 +68,8 @@ b2MotorJoint::b2MotorJoint(const b2MotorJointDef* def)
 
 void b2MotorJoint::InitVelocityConstraints(const b2SolverData& data)
 {
-	m_indexA = m_bodyA->m_islandIndex;
-	m_indexB = m_bodyB->m_islandIndex;
+	m_indexA = data.GetIndex(m_bodyA);
+	m_indexB = data.GetIndex(m_bodyB);
 	m_localCenterA = m_bodyA->m_sweep.localCenter;
 	m_localCenterB = m_bodyB->m_sweep.localCenter;
 	m_invMassA = m_bodyA->m_invMass;
@@ -309,3 +310,14 @@ void b2MotorJoint::Dump()
 	b2Dump("  jd.correctionFactor = %.9g;\n", m_correctionFactor);
 	b2Dump("  joints[%d] = m_world->CreateJoint(&jd);\n", m_index);
 }
+
+void b2MotorJoint::SerializeState(b2StateStream& stream)
+{
+	stream.Value(m_linearOffset);
+	stream.Value(m_angularOffset);
+	stream.Value(m_linearImpulse);
+	stream.Value(m_angularImpulse);
+	stream.Value(m_maxForce);
+	stream.Value(m_maxTorque);
+	stream.Value(m_correctionFactor);
+}
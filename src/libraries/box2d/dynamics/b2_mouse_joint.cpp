@@ -22,6 +22,7 @@
 
 #include "box2d/b2_body.h"
 #include "box2d/b2_mouse_joint.h"
+#include "box2d/b2_state_stream.h"
 #include "box2d/b2_time_step.h"
 
 // p = attached point, m = mouse point
@@ -72,7 +73,7 @@ float b2MouseJoint::GetMaxForce() const
 
 void b2MouseJoint::InitVelocityConstraints(const b2SolverData& data)
 {
-	m_indexB = m_bodyB->m_islandIndex;
+	m_indexB = data.GetIndex(m_bodyB);
 	m_localCenterB = m_bodyB->m_sweep.localCenter;
 	m_invMassB = m_bodyB->m_invMass;
 	m_invIB = m_bodyB->m_invI;
@@ -190,3 +191,15 @@ void b2MouseJoint::ShiftOrigin(const b2Vec2& newOrigin)
 {
 	m_targetA -= newOrigin;
 }
+
+void b2MouseJoint::SerializeState(b2StateStream& stream)
+{
+	stream.Value(m_localAnchorB);
+	stream.Value(m_targetA);
+	stream.Value(m_stiffness);
+	stream.Value(m_damping);
+	stream.Value(m_beta);
+	stream.Value(m_impulse);
+	stream.Value(m_maxForce);
+	stream.Value(m_gamma);
+}
@@ -23,6 +23,7 @@
 #include "box2d/b2_body.h"
 #include "box2d/b2_draw.h"
 #include "box2d/b2_prismatic_joint.h"
+#include "box2d/b2_state_stream.h"
 #include "box2d/b2_time_step.h"
 
 // Linear constraint (point-to-line)
@@ -113,8 +114,8 @@ b2PrismaticJoint::b2PrismaticJoint(const b2PrismaticJointDef* def)
 
 void b2PrismaticJoint::InitVelocityConstraints(const b2SolverData& data)
 {
-	m_indexA = m_bodyA->m_islandIndex;
-	m_indexB = m_bodyB->m_islandIndex;
+	m_indexA = data.GetIndex(m_bodyA);
+	m_indexB = data.GetIndex(m_bodyB);
 	m_localCenterA = m_bodyA->m_sweep.localCenter;
 	m_localCenterB = m_bodyB->m_sweep.localCenter;
 	m_invMassA = m_bodyA->m_invMass;
@@ -641,3 +642,22 @@ void b2PrismaticJoint::Draw(b2Draw* draw) const
 	draw->DrawPoint(pA, 5.0f, c1);
 	draw->DrawPoint(pB, 5.0f, c4);
 }
+
+void b2PrismaticJoint::SerializeState(b2StateStream& stream)
+{
+	stream.Value(m_localAnchorA);
+	stream.Value(m_localAnchorB);
+	stream.Value(m_localXAxisA);
+	stream.Value(m_localYAxisA);
+	stream.Value(m_referenceAngle);
+	stream.Value(m_impulse);
+	stream.Value(m_motorImpulse);
+	stream.Value(m_lowerImpulse);
+	stream.Value(m_upperImpulse);
+	stream.Value(m_lowerTranslation);
+	stream.Value(m_upperTranslation);
+	stream.Value(m_maxMotorForce);
+	stream.Value(m_motorSpeed);
+	stream.Value(m_enableLimit);
+	stream.Value(m_enableMotor);
+}
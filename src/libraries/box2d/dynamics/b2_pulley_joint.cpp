@@ -22,6 +22,7 @@
 
 #include "box2d/b2_body.h"
 #include "box2d/b2_pulley_joint.h"
+#include "box2d/b2_state_stream.h"
 #include "box2d/b2_time_step.h"
 
 // Pulley:
@@ -76,8 +77,8 @@ b2PulleyJoint::b2PulleyJoint(const b2PulleyJointDef* def)
 
 void b2PulleyJoint::InitVelocityConstraints(const b2SolverData& data)
 {
-	m_indexA = m_bodyA->m_islandIndex;
-	m_indexB = m_bodyB->m_islandIndex;
+	m_indexA = data.GetIndex(m_bodyA);
+	m_indexB = data.GetIndex(m_bodyB);
 	m_localCenterA = m_bodyA->m_sweep.localCenter;
 	m_localCenterB = m_bodyB->m_sweep.localCenter;
 	m_invMassA = m_bodyA->m_invMass;
@@ -350,3 +351,16 @@ void b2PulleyJoint::ShiftOrigin(const b2Vec2& newOrigin)
 	m_groundAnchorA -= newOrigin;
 	m_groundAnchorB -= newOrigin;
 }
+
+void b2PulleyJoint::SerializeState(b2StateStream& stream)
+{
+	stream.Value(m_groundAnchorA);
+	stream.Value(m_groundAnchorB);
+	stream.Value(m_lengthA);
+	stream.Value(m_lengthB);
+	stream.Value(m_localAnchorA);
+	stream.Value(m_localAnchorB);
+	stream.Value(m_constant);
+	stream.Value(m_ratio);
+	stream.Value(m_impulse);
+}
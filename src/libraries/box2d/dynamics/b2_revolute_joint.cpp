@@ -23,6 +23,7 @@
 #include "box2d/b2_body.h"
 #include "box2d/b2_draw.h"
 #include "box2d/b2_revolute_joint.h"
+#include "box2d/b2_state_stream.h"
 #include "box2d/b2_time_step.h"
 
 // Point-to-point constraint
@@ -72,8 +73,8 @@ b2RevoluteJoint::b2RevoluteJoint(const b2RevoluteJointDef* def)
 
 void b2RevoluteJoint::InitVelocityConstraints(const b2SolverData& data)
 {
-	m_indexA = m_bodyA->m_islandIndex;
-	m_indexB = m_bodyB->m_islandIndex;
+	m_indexA = data.GetIndex(m_bodyA);
+	m_indexB = data.GetIndex(m_bodyB);
 	m_localCenterA = m_bodyA->m_sweep.localCenter;
 	m_localCenterB = m_bodyB->m_sweep.localCenter;
 	m_invMassA = m_bodyA->m_invMass;
@@ -499,3 +500,20 @@ void b2RevoluteJoint::Draw(b2Draw* draw) const
 	draw->DrawSegment(pA, pB, color);
 	draw->DrawSegment(xfB.p, pB, color);
 }
+
+void b2RevoluteJoint::SerializeState(b2StateStream& stream)
+{
+	stream.Value(m_localAnchorA);
+	stream.Value(m_localAnchorB);
+	stream.Value(m_impulse);
+	stream.Value(m_motorImpulse);
+	stream.Value(m_lowerImpulse);
+	stream.Value(m_upperImpulse);
+	stream.Value(m_enableMotor);
+	stream.Value(m_maxMotorTorque);
+	stream.Value(m_motorSpeed);
+	stream.Value(m_enableLimit);
+	stream.Value(m_referenceAngle);
+	stream.Value(m_lowerAngle);
+	stream.Value(m_upperAngle);
+}
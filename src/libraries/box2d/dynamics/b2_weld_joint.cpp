@@ -21,6 +21,7 @@
 // SOFTWARE.
 
 #include "box2d/b2_body.h"
+#include "box2d/b2_state_stream.h"
 #include "box2d/b2_time_step.h"
 #include "box2d/b2_weld_joint.h"
 
@@ -61,8 +62,8 @@ b2WeldJoint::b2WeldJoint(const b2WeldJointDef* def)
 
 void b2WeldJoint::InitVelocityConstraints(const b2SolverData& data)
 {
-	m_indexA = m_bodyA->m_islandIndex;
-	m_indexB = m_bodyB->m_islandIndex;
+	m_indexA = data.GetIndex(m_bodyA);
+	m_indexB = data.GetIndex(m_bodyB);
 	m_localCenterA = m_bodyA->m_sweep.localCenter;
 	m_localCenterB = m_bodyB->m_sweep.localCenter;
 	m_invMassA = m_bodyA->m_invMass;
@@ -342,3 +343,15 @@ void b2WeldJoint::Dump()
 	b2Dump("  jd.damping = %.9g;\n", m_damping);
 	b2Dump("  joints[%d] = m_world->CreateJoint(&jd);\n", m_index);
 }
+
+void b2WeldJoint::SerializeState(b2StateStream& stream)
+{
+	stream.Value(m_stiffness);
+	stream.Value(m_damping);
+	stream.Value(m_bias);
+	stream.Value(m_localAnchorA);
+	stream.Value(m_localAnchorB);
+	stream.Value(m_referenceAngle);
+	stream.Value(m_gamma);
+	stream.Value(m_impulse);
+}
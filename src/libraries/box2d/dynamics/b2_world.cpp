@@ -34,10 +34,13 @@
 #include "box2d/b2_fixture.h"
 #include "box2d/b2_polygon_shape.h"
 #include "box2d/b2_pulley_joint.h"
+#include "box2d/b2_state_stream.h"
 #include "box2d/b2_time_of_impact.h"
 #include "box2d/b2_timer.h"
 #include "box2d/b2_world.h"
 
+#include <algorithm>
+#include <atomic>
 #include <new>
 
 b2World::b2World(const b2Vec2& gravity)
@@ -45,6 +48,10 @@ b2World::b2World(const b2Vec2& gravity)
 	m_destructionListener = nullptr;
 	m_debugDraw = nullptr;
 
+	m_taskExecutor = nullptr;
+	m_taskAllocators = nullptr;
+	m_taskAllocatorCount = 0;
+
 	m_bodyList = nullptr;
 	m_jointList = nullptr;
 
@@ -90,6 +97,12 @@ b2World::~b2World()
 
 		b = bNext;
 	}
+
+	for (int32 i = 0; i < m_taskAllocatorCount; ++i)
+	{
+		m_taskAllocators[i].~b2StackAllocator();
+	}
+	b2Free(m_taskAllocators);
 }
 
 void b2World::SetDestructionListener(b2DestructionListener* listener)
@@ -107,6 +120,18 @@ void b2World::SetContactListener(b2ContactListener* listener)
 	m_contactManager.m_contactListener = listener;
 }
 
+void b2World::SetTaskExecutor(b2TaskExecutor* executor)
+{
+	b2Assert(IsLocked() == false);
+	if (IsLocked())
+	{
+		return;
+	}
+
+	m_taskExecutor = executor;
+	m_contactManager.m_taskExecutor = executor;
+}
+
 void b2World::SetDebugDraw(b2Draw* debugDraw)
 {
 	m_debugDraw = debugDraw;
@@ -397,13 +422,6 @@ void b2World::Solve(const b2TimeStep& step)
 	m_profile.solveVelocity = 0.0f;
 	m_profile.solvePosition = 0.0f;
 
-	// Size the island for the worst case.
-	b2Island island(m_bodyCount,
-					m_contactManager.m_contactCount,
-					m_jointCount,
-					&m_stackAllocator,
-					m_contactManager.m_contactListener);
-
 	// Clear all the island flags.
 	for (b2Body* b = m_bodyList; b; b = b->m_next)
 	{
@@ -419,122 +437,172 @@ void b2World::Solve(const b2TimeStep& step)
 	}
 
 	// Build and simulate all awake islands.
-	int32 stackSize = m_bodyCount;
-	b2Body** stack = (b2Body**)m_stackAllocator.Allocate(stackSize * sizeof(b2Body*));
-	for (b2Body* seed = m_bodyList; seed; seed = seed->m_next)
+	if (m_taskExecutor && m_taskExecutor->GetWorkerCount() > 1)
 	{
-		if (seed->m_flags & b2Body::e_islandFlag)
-		{
-			continue;
-		}
+		SolveIslandsParallel(step);
+	}
+	else
+	{
+		SolveIslands(step);
+	}
 
-		if (seed->IsAwake() == false || seed->IsEnabled() == false)
+	{
+		b2Timer timer;
+		// Synchronize fixtures, check for out of range bodies.
+		for (b2Body* b = m_bodyList; b; b = b->GetNext())
 		{
-			continue;
+			// If a body was not in an island then it did not move.
+			if ((b->m_flags & b2Body::e_islandFlag) == 0)
+			{
+				continue;
+			}
+
+			if (b->GetType() == b2_staticBody)
+			{
+				continue;
+			}
+
+			// Update fixtures (for broad-phase).
+			b->SynchronizeFixtures();
 		}
 
-		// The seed can be dynamic or kinematic.
-		if (seed->GetType() == b2_staticBody)
+		// Look for new contacts.
+		m_contactManager.FindNewContacts();
+		m_profile.broadphase = timer.GetMilliseconds();
+	}
+}
+
+// Perform a depth first search (DFS) on the constraint graph, adding
+// everything reachable from the seed to the island.
+void b2World::BuildIsland(b2Body* seed, b2Body** stack, int32 stackSize, b2Island* island)
+{
+	int32 stackCount = 0;
+	stack[stackCount++] = seed;
+	seed->m_flags |= b2Body::e_islandFlag;
+
+	while (stackCount > 0)
+	{
+		// Grab the next body off the stack and add it to the island.
+		b2Body* b = stack[--stackCount];
+		b2Assert(b->IsEnabled() == true);
+		island->Add(b);
+
+		// To keep islands as small as possible, we don't
+		// propagate islands across static bodies.
+		if (b->GetType() == b2_staticBody)
 		{
 			continue;
 		}
 
-		// Reset island and stack.
-		island.Clear();
-		int32 stackCount = 0;
-		stack[stackCount++] = seed;
-		seed->m_flags |= b2Body::e_islandFlag;
+		// Make sure the body is awake (without resetting sleep timer).
+		b->m_flags |= b2Body::e_awakeFlag;
 
-		// Perform a depth first search (DFS) on the constraint graph.
-		while (stackCount > 0)
+		// Search all contacts connected to this body.
+		for (b2ContactEdge* ce = b->m_contactList; ce; ce = ce->next)
 		{
-			// Grab the next body off the stack and add it to the island.
-			b2Body* b = stack[--stackCount];
-			b2Assert(b->IsEnabled() == true);
-			island.Add(b);
+			b2Contact* contact = ce->contact;
 
-			// To keep islands as small as possible, we don't
-			// propagate islands across static bodies.
-			if (b->GetType() == b2_staticBody)
+			// Has this contact already been added to an island?
+			if (contact->m_flags & b2Contact::e_islandFlag)
 			{
 				continue;
 			}
 
-			// Make sure the body is awake (without resetting sleep timer).
-			b->m_flags |= b2Body::e_awakeFlag;
+			// Is this contact solid and touching?
+			if (contact->IsEnabled() == false ||
+				contact->IsTouching() == false)
+			{
+				continue;
+			}
 
-			// Search all contacts connected to this body.
-			for (b2ContactEdge* ce = b->m_contactList; ce; ce = ce->next)
+			// Skip sensors.
+			bool sensorA = contact->m_fixtureA->m_isSensor;
+			bool sensorB = contact->m_fixtureB->m_isSensor;
+			if (sensorA || sensorB)
 			{
-				b2Contact* contact = ce->contact;
+				continue;
+			}
 
-				// Has this contact already been added to an island?
-				if (contact->m_flags & b2Contact::e_islandFlag)
-				{
-					continue;
-				}
+			island->Add(contact);
+			contact->m_flags |= b2Contact::e_islandFlag;
 
-				// Is this contact solid and touching?
-				if (contact->IsEnabled() == false ||
-					contact->IsTouching() == false)
-				{
-					continue;
-				}
+			b2Body* other = ce->other;
 
-				// Skip sensors.
-				bool sensorA = contact->m_fixtureA->m_isSensor;
-				bool sensorB = contact->m_fixtureB->m_isSensor;
-				if (sensorA || sensorB)
-				{
-					continue;
-				}
+			// Was the other body already added to this island?
+			if (other->m_flags & b2Body::e_islandFlag)
+			{
+				continue;
+			}
 
-				island.Add(contact);
-				contact->m_flags |= b2Contact::e_islandFlag;
+			b2Assert(stackCount < stackSize);
+			stack[stackCount++] = other;
+			other->m_flags |= b2Body::e_islandFlag;
+		}
 
-				b2Body* other = ce->other;
+		// Search all joints connect to this body.
+		for (b2JointEdge* je = b->m_jointList; je; je = je->next)
+		{
+			if (je->joint->m_islandFlag == true)
+			{
+				continue;
+			}
 
-				// Was the other body already added to this island?
-				if (other->m_flags & b2Body::e_islandFlag)
-				{
-					continue;
-				}
+			b2Body* other = je->other;
 
-				b2Assert(stackCount < stackSize);
-				stack[stackCount++] = other;
-				other->m_flags |= b2Body::e_islandFlag;
+			// Don't simulate joints connected to diabled bodies.
+			if (other->IsEnabled() == false)
+			{
+				continue;
 			}
 
-			// Search all joints connect to this body.
-			for (b2JointEdge* je = b->m_jointList; je; je = je->next)
+			island->Add(je->joint);
+			je->joint->m_islandFlag = true;
+
+			if (other->m_flags & b2Body::e_islandFlag)
 			{
-				if (je->joint->m_islandFlag == true)
-				{
-					continue;
-				}
+				continue;
+			}
 
-				b2Body* other = je->other;
+			b2Assert(stackCount < stackSize);
+			stack[stackCount++] = other;
+			other->m_flags |= b2Body::e_islandFlag;
+		}
+	}
+}
 
-				// Don't simulate joints connected to diabled bodies.
-				if (other->IsEnabled() == false)
-				{
-					continue;
-				}
+// Build and solve islands one at a time.
+void b2World::SolveIslands(const b2TimeStep& step)
+{
+	// Size the island for the worst case.
+	b2Island island(m_bodyCount,
+					m_contactManager.m_contactCount,
+					m_jointCount,
+					&m_stackAllocator,
+					m_contactManager.m_contactListener);
 
-				island.Add(je->joint);
-				je->joint->m_islandFlag = true;
+	int32 stackSize = m_bodyCount;
+	b2Body** stack = (b2Body**)m_stackAllocator.Allocate(stackSize * sizeof(b2Body*));
+	for (b2Body* seed = m_bodyList; seed; seed = seed->m_next)
+	{
+		if (seed->m_flags & b2Body::e_islandFlag)
+		{
+			continue;
+		}
 
-				if (other->m_flags & b2Body::e_islandFlag)
-				{
-					continue;
-				}
+		if (seed->IsAwake() == false || seed->IsEnabled() == false)
+		{
+			continue;
+		}
 
-				b2Assert(stackCount < stackSize);
-				stack[stackCount++] = other;
-				other->m_flags |= b2Body::e_islandFlag;
-			}
+		// The seed can be dynamic or kinematic.
+		if (seed->GetType() == b2_staticBody)
+		{
+			continue;
 		}
 
+		island.Clear();
+		BuildIsland(seed, stack, stackSize, &island);
+
 		b2Profile profile;
 		island.Solve(&profile, step, m_gravity, m_allowSleep);
 		m_profile.solveInit += profile.solveInit;
@@ -554,31 +622,217 @@ void b2World::Solve(const b2TimeStep& step)
 	}
 
 	m_stackAllocator.Free(stack);
+}
+
+// The bodies, contacts and joints of one island within the shared island arrays.
+struct b2IslandRange
+{
+	int32 bodyStart;
+	int32 bodyCount;
+	int32 contactStart;
+	int32 contactCount;
+	int32 jointStart;
+	int32 jointCount;
+};
 
+struct b2SolveIslandsContext
+{
+	b2TimeStep step;
+	b2Vec2 gravity;
+	bool allowSleep;
+
+	const b2Island* islands;
+	const b2IslandRange* ranges;
+	const int32* order;
+	int32 islandCount;
+
+	b2Profile* profiles;
+	b2ContactImpulse* impulses;
+	b2StackAllocator* allocators;
+
+	std::atomic<int32> next;
+};
+
+static void b2SolveIslandsTask(int32 taskIndex, void* context)
+{
+	b2SolveIslandsContext* ctx = (b2SolveIslandsContext*)context;
+	b2StackAllocator* allocator = ctx->allocators + taskIndex;
+
+	// Islands are handed out largest first. Which task solves an island does not
+	// change its result.
+	for (;;)
 	{
-		b2Timer timer;
-		// Synchronize fixtures, check for out of range bodies.
-		for (b2Body* b = m_bodyList; b; b = b->GetNext())
+		int32 n = ctx->next.fetch_add(1, std::memory_order_relaxed);
+		if (n >= ctx->islandCount)
 		{
-			// If a body was not in an island then it did not move.
-			if ((b->m_flags & b2Body::e_islandFlag) == 0)
-			{
-				continue;
-			}
+			break;
+		}
+
+		int32 index = ctx->order[n];
+		const b2IslandRange& range = ctx->ranges[index];
 
+		b2Island island(range.bodyCount, range.contactCount, range.jointCount, allocator, nullptr);
+		island.SetShared(ctx->impulses + range.contactStart);
+
+		for (int32 i = 0; i < range.bodyCount; ++i)
+		{
+			island.Add(ctx->islands->m_bodies[range.bodyStart + i]);
+		}
+		for (int32 i = 0; i < range.contactCount; ++i)
+		{
+			island.Add(ctx->islands->m_contacts[range.contactStart + i]);
+		}
+		for (int32 i = 0; i < range.jointCount; ++i)
+		{
+			island.Add(ctx->islands->m_joints[range.jointStart + i]);
+		}
+
+		island.Solve(ctx->profiles + index, ctx->step, ctx->gravity, ctx->allowSleep);
+	}
+}
+
+// Build all islands first, then solve them on the task executor. Each island is
+// solved exactly as SolveIslands would, and PostSolve is reported afterwards in
+// island order, so the results match the serial path.
+void b2World::SolveIslandsParallel(const b2TimeStep& step)
+{
+	int32 contactCount = m_contactManager.m_contactCount;
+
+	// Static bodies may appear in several islands, at most once per contact or joint.
+	b2Island islands(m_bodyCount + contactCount + m_jointCount,
+					 contactCount,
+					 m_jointCount,
+					 &m_stackAllocator,
+					 nullptr);
+
+	b2IslandRange* ranges = (b2IslandRange*)m_stackAllocator.Allocate(m_bodyCount * sizeof(b2IslandRange));
+	int32 islandCount = 0;
+
+	int32 stackSize = m_bodyCount;
+	b2Body** stack = (b2Body**)m_stackAllocator.Allocate(stackSize * sizeof(b2Body*));
+	for (b2Body* seed = m_bodyList; seed; seed = seed->m_next)
+	{
+		if (seed->m_flags & b2Body::e_islandFlag)
+		{
+			continue;
+		}
+
+		if (seed->IsAwake() == false || seed->IsEnabled() == false)
+		{
+			continue;
+		}
+
+		// The seed can be dynamic or kinematic.
+		if (seed->GetType() == b2_staticBody)
+		{
+			continue;
+		}
+
+		b2IslandRange* range = ranges + islandCount++;
+		range->bodyStart = islands.m_bodyCount;
+		range->contactStart = islands.m_contactCount;
+		range->jointStart = islands.m_jointCount;
+
+		BuildIsland(seed, stack, stackSize, &islands);
+
+		range->bodyCount = islands.m_bodyCount - range->bodyStart;
+		range->contactCount = islands.m_contactCount - range->contactStart;
+		range->jointCount = islands.m_jointCount - range->jointStart;
+
+		// Allow static bodies to participate in other islands.
+		for (int32 i = range->bodyStart; i < islands.m_bodyCount; ++i)
+		{
+			b2Body* b = islands.m_bodies[i];
 			if (b->GetType() == b2_staticBody)
 			{
-				continue;
+				b->m_flags &= ~b2Body::e_islandFlag;
 			}
+		}
+	}
+	m_stackAllocator.Free(stack);
 
-			// Update fixtures (for broad-phase).
-			b->SynchronizeFixtures();
+	if (islandCount == 0)
+	{
+		m_stackAllocator.Free(ranges);
+		return;
+	}
+
+	int32* order = (int32*)m_stackAllocator.Allocate(islandCount * sizeof(int32));
+	b2Profile* profiles = (b2Profile*)m_stackAllocator.Allocate(islandCount * sizeof(b2Profile));
+	b2ContactImpulse* impulses = (b2ContactImpulse*)m_stackAllocator.Allocate(b2Max(contactCount, 1) * sizeof(b2ContactImpulse));
+
+	for (int32 i = 0; i < islandCount; ++i)
+	{
+		order[i] = i;
+	}
+
+	std::sort(order, order + islandCount, [ranges](int32 a, int32 b)
+	{
+		int32 sizeA = ranges[a].bodyCount + ranges[a].contactCount + ranges[a].jointCount;
+		int32 sizeB = ranges[b].bodyCount + ranges[b].contactCount + ranges[b].jointCount;
+		return sizeA != sizeB ? sizeA > sizeB : a < b;
+	});
+
+	int32 taskCount = b2Min(m_taskExecutor->GetWorkerCount(), islandCount);
+	if (m_taskAllocatorCount < taskCount)
+	{
+		for (int32 i = 0; i < m_taskAllocatorCount; ++i)
+		{
+			m_taskAllocators[i].~b2StackAllocator();
 		}
+		b2Free(m_taskAllocators);
 
-		// Look for new contacts.
-		m_contactManager.FindNewContacts();
-		m_profile.broadphase = timer.GetMilliseconds();
+		m_taskAllocators = (b2StackAllocator*)b2Alloc(taskCount * sizeof(b2StackAllocator));
+		m_taskAllocatorCount = taskCount;
+		for (int32 i = 0; i < m_taskAllocatorCount; ++i)
+		{
+			new (m_taskAllocators + i) b2StackAllocator();
+		}
+	}
+
+	b2SolveIslandsContext context;
+	context.step = step;
+	context.gravity = m_gravity;
+	context.allowSleep = m_allowSleep;
+	context.islands = &islands;
+	context.ranges = ranges;
+	context.order = order;
+	context.islandCount = islandCount;
+	context.profiles = profiles;
+	context.impulses = impulses;
+	context.allocators = m_taskAllocators;
+	context.next = 0;
+
+	if (taskCount > 1)
+	{
+		m_taskExecutor->Run(taskCount, b2SolveIslandsTask, &context);
 	}
+	else
+	{
+		b2SolveIslandsTask(0, &context);
+	}
+
+	b2ContactListener* listener = m_contactManager.m_contactListener;
+	for (int32 i = 0; i < islandCount; ++i)
+	{
+		m_profile.solveInit += profiles[i].solveInit;
+		m_profile.solveVelocity += profiles[i].solveVelocity;
+		m_profile.solvePosition += profiles[i].solvePosition;
+
+		if (listener)
+		{
+			const b2IslandRange& range = ranges[i];
+			for (int32 j = range.contactStart; j < range.contactStart + range.contactCount; ++j)
+			{
+				listener->PostSolve(islands.m_contacts[j], impulses + j);
+			}
+		}
+	}
+
+	m_stackAllocator.Free(impulses);
+	m_stackAllocator.Free(profiles);
+	m_stackAllocator.Free(order);
+	m_stackAllocator.Free(ranges);
 }
 
 // Find TOI contacts and solve them.
@@ -1320,3 +1574,519 @@ void b2World::Dump()
 
 	b2CloseDump();
 }
+
+// Increment when the layout written by SaveState changes.
+static const int32 b2_stateVersion = 1;
+static const uint32 b2_stateMagic = 0x54533242; // "B2ST"
+
+struct b2StateHeader
+{
+	uint32 magic;
+	int32 version;
+	int32 size;
+	int32 bodyCount;
+	int32 jointCount;
+	int32 proxyCount;
+	int32 contactCount;
+	int32 nodeCapacity;
+	int32 moveCount;
+};
+
+// Free nodes only need to keep the free list linked.
+static void b2SerializeTreeNode(b2StateStream& stream, b2TreeNode& node, int32& proxyIndex)
+{
+	stream.Value(node.height);
+	stream.Value(node.parent);
+	if (node.height == -1)
+	{
+		return;
+	}
+
+	stream.Value(node.aabb);
+	stream.Value(node.child1);
+	stream.Value(node.child2);
+	stream.Value(node.moved);
+	stream.Value(proxyIndex);
+}
+
+static void b2SerializeManifold(b2StateStream& stream, b2Manifold& manifold)
+{
+	stream.Value(manifold.type);
+	stream.Value(manifold.localNormal);
+	stream.Value(manifold.localPoint);
+	stream.Value(manifold.pointCount);
+	b2Assert(0 <= manifold.pointCount && manifold.pointCount <= b2_maxManifoldPoints);
+	for (int32 i = 0; i < manifold.pointCount; ++i)
+	{
+		stream.Value(manifold.points[i]);
+	}
+}
+
+// Writes the shape of the world, or compares it against the shape that was written.
+bool b2World::SerializeTopology(b2StateStream& stream)
+{
+	bool match = true;
+	auto value = [&](int32 v)
+	{
+		int32 saved = v;
+		stream.Value(saved);
+		match = match && saved == v;
+	};
+
+	for (b2Body* b = m_bodyList; b; b = b->m_next)
+	{
+		value(b->m_fixtureCount);
+		for (b2Fixture* f = b->m_fixtureList; f; f = f->m_next)
+		{
+			value(f->m_shape->m_type);
+			value(f->m_proxyCount);
+		}
+	}
+
+	for (b2Joint* j = m_jointList; j; j = j->m_next)
+	{
+		value(j->m_type);
+	}
+
+	return match && stream.IsValid();
+}
+
+// Reads or writes everything that is owned by a single world object.
+void b2World::SerializeObjects(b2StateStream& stream)
+{
+	stream.Value(m_gravity);
+	stream.Value(m_allowSleep);
+	stream.Value(m_warmStarting);
+	stream.Value(m_continuousPhysics);
+	stream.Value(m_subStepping);
+	stream.Value(m_clearForces);
+	stream.Value(m_stepComplete);
+	stream.Value(m_newContacts);
+	stream.Value(m_inv_dt0);
+
+	for (b2Body* b = m_bodyList; b; b = b->m_next)
+	{
+		stream.Value(b->m_type);
+		stream.Value(b->m_flags);
+		stream.Value(b->m_xf);
+		stream.Value(b->m_sweep);
+		stream.Value(b->m_linearVelocity);
+		stream.Value(b->m_angularVelocity);
+		stream.Value(b->m_force);
+		stream.Value(b->m_torque);
+		stream.Value(b->m_mass);
+		stream.Value(b->m_invMass);
+		stream.Value(b->m_I);
+		stream.Value(b->m_invI);
+		stream.Value(b->m_linearDamping);
+		stream.Value(b->m_angularDamping);
+		stream.Value(b->m_gravityScale);
+		stream.Value(b->m_sleepTime);
+
+		for (b2Fixture* f = b->m_fixtureList; f; f = f->m_next)
+		{
+			stream.Value(f->m_density);
+			stream.Value(f->m_friction);
+			stream.Value(f->m_restitution);
+			stream.Value(f->m_restitutionThreshold);
+			stream.Value(f->m_filter);
+			stream.Value(f->m_isSensor);
+
+			for (int32 i = 0; i < f->m_proxyCount; ++i)
+			{
+				stream.Value(f->m_proxies[i].aabb);
+				stream.Value(f->m_proxies[i].proxyId);
+			}
+		}
+	}
+
+	for (b2Joint* j = m_jointList; j; j = j->m_next)
+	{
+		stream.Value(j->m_collideConnected);
+		j->SerializeState(stream);
+	}
+}
+
+int32 b2World::SaveState(void* data, int32 capacity)
+{
+	b2Assert(IsLocked() == false);
+
+	b2BroadPhase& broadPhase = m_contactManager.m_broadPhase;
+	b2DynamicTree& tree = broadPhase.m_tree;
+
+	b2StateHeader header;
+	header.magic = b2_stateMagic;
+	header.version = b2_stateVersion;
+	header.size = 0;
+	header.bodyCount = m_bodyCount;
+	header.jointCount = m_jointCount;
+	header.proxyCount = broadPhase.m_proxyCount;
+	header.contactCount = m_contactManager.m_contactCount;
+	header.nodeCapacity = tree.m_nodeCapacity;
+	header.moveCount = broadPhase.m_moveCount;
+
+	b2StateStream stream(b2StateStream::e_write, data, capacity);
+	stream.Value(header);
+	SerializeTopology(stream);
+	SerializeObjects(stream);
+
+	// Tree leaves and contacts refer to fixture proxies by their position in
+	// body, fixture and child order.
+	int32* proxyIndices = (int32*)m_stackAllocator.Allocate(tree.m_nodeCapacity * sizeof(int32));
+	for (int32 i = 0; i < tree.m_nodeCapacity; ++i)
+	{
+		proxyIndices[i] = b2_nullNode;
+	}
+
+	int32 proxyIndex = 0;
+	for (b2Body* b = m_bodyList; b; b = b->m_next)
+	{
+		for (b2Fixture* f = b->m_fixtureList; f; f = f->m_next)
+		{
+			for (int32 i = 0; i < f->m_proxyCount; ++i)
+			{
+				proxyIndices[f->m_proxies[i].proxyId] = proxyIndex++;
+			}
+		}
+	}
+
+	stream.Bytes(broadPhase.m_moveBuffer, header.moveCount * sizeof(int32));
+
+	stream.Value(tree.m_root);
+	stream.Value(tree.m_nodeCount);
+	stream.Value(tree.m_freeList);
+	stream.Value(tree.m_insertionCount);
+	for (int32 i = 0; i < tree.m_nodeCapacity; ++i)
+	{
+		b2SerializeTreeNode(stream, tree.m_nodes[i], proxyIndices[i]);
+	}
+
+	for (b2Contact* c = m_contactManager.m_contactList; c; c = c->m_next)
+	{
+		int32 indexA = proxyIndices[c->m_fixtureA->m_proxies[c->m_indexA].proxyId];
+		int32 indexB = proxyIndices[c->m_fixtureB->m_proxies[c->m_indexB].proxyId];
+		stream.Value(indexA);
+		stream.Value(indexB);
+		stream.Value(c->m_flags);
+		b2SerializeManifold(stream, c->m_manifold);
+		stream.Value(c->m_friction);
+		stream.Value(c->m_restitution);
+		stream.Value(c->m_restitutionThreshold);
+		stream.Value(c->m_tangentSpeed);
+		stream.Value(c->m_toiCount);
+		stream.Value(c->m_toi);
+	}
+
+	m_stackAllocator.Free(proxyIndices);
+
+	int32 size = stream.GetOffset();
+	if (stream.IsValid())
+	{
+		header.size = size;
+		memcpy(data, &header, sizeof(header));
+	}
+
+	return size;
+}
+
+bool b2World::ValidateState(const void* data, int32 size)
+{
+	b2BroadPhase& broadPhase = m_contactManager.m_broadPhase;
+
+	b2StateHeader header;
+	if (data == nullptr || size < (int32)sizeof(header))
+	{
+		return false;
+	}
+
+	memcpy(&header, data, sizeof(header));
+	if (header.magic != b2_stateMagic || header.version != b2_stateVersion || header.size != size ||
+		header.bodyCount != m_bodyCount || header.jointCount != m_jointCount ||
+		header.proxyCount != broadPhase.m_proxyCount || header.nodeCapacity < header.proxyCount ||
+		header.contactCount < 0 || header.moveCount < 0)
+	{
+		return false;
+	}
+
+	b2StateStream stream(b2StateStream::e_read, (void*)data, size);
+	stream.Value(header);
+	if (SerializeTopology(stream) == false)
+	{
+		return false;
+	}
+
+	// The object section has a fixed layout for a given topology, so it is
+	// measured by writing it nowhere.
+	b2StateStream objects(b2StateStream::e_write, nullptr, 0);
+	SerializeObjects(objects);
+	stream.Skip(objects.GetOffset());
+
+	const int32 nodeCapacity = header.nodeCapacity;
+	auto isNode = [nodeCapacity](int32 id) { return id == b2_nullNode || (0 <= id && id < nodeCapacity); };
+
+	for (int32 i = 0; i < header.moveCount; ++i)
+	{
+		int32 proxyId = 0;
+		stream.Value(proxyId);
+		if (isNode(proxyId) == false)
+		{
+			return false;
+		}
+	}
+
+	int32 root = 0, nodeCount = 0, freeList = 0, insertionCount = 0;
+	stream.Value(root);
+	stream.Value(nodeCount);
+	stream.Value(freeList);
+	stream.Value(insertionCount);
+	if (isNode(root) == false || isNode(freeList) == false || nodeCount < 0 || nodeCount > nodeCapacity)
+	{
+		return false;
+	}
+
+	// Per-proxy scratch: the shape type, for checking contacts, and whether a
+	// tree leaf refers to the proxy yet. Freed on every path below.
+	struct ProxyInfo
+	{
+		b2Shape::Type type;
+		bool inTree;
+	};
+
+	ProxyInfo* proxyInfos = (ProxyInfo*)m_stackAllocator.Allocate(header.proxyCount * sizeof(ProxyInfo));
+	int32 proxyIndex = 0;
+	for (b2Body* b = m_bodyList; b; b = b->m_next)
+	{
+		for (b2Fixture* f = b->m_fixtureList; f; f = f->m_next)
+		{
+			for (int32 i = 0; i < f->m_proxyCount; ++i)
+			{
+				proxyInfos[proxyIndex].type = f->GetType();
+				proxyInfos[proxyIndex].inTree = false;
+				++proxyIndex;
+			}
+		}
+	}
+
+	auto validateTreeAndContacts = [&]() -> bool
+	{
+		// Every proxy has to be a leaf exactly once so the tree can be relinked
+		// to the fixtures.
+		int32 leafCount = 0;
+		for (int32 i = 0; i < nodeCapacity; ++i)
+		{
+			b2TreeNode node;
+			int32 index = b2_nullNode;
+			b2SerializeTreeNode(stream, node, index);
+			if (stream.IsValid() == false || isNode(node.parent) == false)
+			{
+				return false;
+			}
+
+			if (node.height == -1)
+			{
+				continue;
+			}
+
+			if (isNode(node.child1) == false || isNode(node.child2) == false)
+			{
+				return false;
+			}
+
+			if (node.IsLeaf() == false)
+			{
+				if (index != b2_nullNode)
+				{
+					return false;
+				}
+				continue;
+			}
+
+			if (index < 0 || index >= header.proxyCount || proxyInfos[index].inTree)
+			{
+				return false;
+			}
+			proxyInfos[index].inTree = true;
+			++leafCount;
+		}
+
+		if (leafCount != header.proxyCount)
+		{
+			return false;
+		}
+
+		if (header.contactCount > 0 && b2Contact::s_initialized == false)
+		{
+			b2Contact::InitializeRegisters();
+			b2Contact::s_initialized = true;
+		}
+
+		for (int32 i = 0; i < header.contactCount; ++i)
+		{
+			int32 indexA = 0;
+			int32 indexB = 0;
+			stream.Value(indexA);
+			stream.Value(indexB);
+			if (stream.IsValid() == false || indexA < 0 || indexA >= header.proxyCount || indexB < 0 || indexB >= header.proxyCount)
+			{
+				return false;
+			}
+
+			// Saved contacts always have their fixtures in the order b2Contact::Create uses.
+			const b2ContactRegister& reg = b2Contact::s_registers[proxyInfos[indexA].type][proxyInfos[indexB].type];
+			if (reg.createFcn == nullptr || reg.primary == false)
+			{
+				return false;
+			}
+
+			b2Manifold manifold;
+			stream.Skip(sizeof(uint32)); // flags
+			stream.Value(manifold.type);
+			stream.Value(manifold.localNormal);
+			stream.Value(manifold.localPoint);
+			stream.Value(manifold.pointCount);
+			if (stream.IsValid() == false || manifold.pointCount < 0 || manifold.pointCount > b2_maxManifoldPoints)
+			{
+				return false;
+			}
+
+			stream.Skip(manifold.pointCount * sizeof(b2ManifoldPoint));
+			stream.Skip(4 * sizeof(float) + sizeof(int32) + sizeof(float)); // friction to toi
+		}
+
+		return stream.IsValid() && stream.GetOffset() == size;
+	};
+
+	bool valid = validateTreeAndContacts();
+
+	m_stackAllocator.Free(proxyInfos);
+
+	return valid;
+}
+
+bool b2World::RestoreState(const void* data, int32 size)
+{
+	b2Assert(IsLocked() == false);
+
+	// Everything below overwrites the world, so nothing may fail past this point.
+	if (ValidateState(data, size) == false)
+	{
+		return false;
+	}
+
+	b2BroadPhase& broadPhase = m_contactManager.m_broadPhase;
+	b2DynamicTree& tree = broadPhase.m_tree;
+
+	b2StateHeader header;
+	b2StateStream stream(b2StateStream::e_read, (void*)data, size);
+	stream.Value(header);
+	SerializeTopology(stream);
+
+	// The saved contacts replace the current ones wholesale.
+	while (m_contactManager.m_contactList)
+	{
+		m_contactManager.Remove(m_contactManager.m_contactList);
+	}
+
+	SerializeObjects(stream);
+
+	b2FixtureProxy** proxies = (b2FixtureProxy**)m_stackAllocator.Allocate(header.proxyCount * sizeof(b2FixtureProxy*));
+	int32 proxyIndex = 0;
+	for (b2Body* b = m_bodyList; b; b = b->m_next)
+	{
+		for (b2Fixture* f = b->m_fixtureList; f; f = f->m_next)
+		{
+			for (int32 i = 0; i < f->m_proxyCount; ++i)
+			{
+				proxies[proxyIndex++] = f->m_proxies + i;
+			}
+		}
+	}
+
+	if (header.moveCount > broadPhase.m_moveCapacity)
+	{
+		b2Free(broadPhase.m_moveBuffer);
+		broadPhase.m_moveCapacity = header.moveCount;
+		broadPhase.m_moveBuffer = (int32*)b2Alloc(broadPhase.m_moveCapacity * sizeof(int32));
+	}
+	broadPhase.m_moveCount = header.moveCount;
+	stream.Bytes(broadPhase.m_moveBuffer, header.moveCount * sizeof(int32));
+
+	if (header.nodeCapacity != tree.m_nodeCapacity)
+	{
+		b2Free(tree.m_nodes);
+		tree.m_nodeCapacity = header.nodeCapacity;
+		tree.m_nodes = (b2TreeNode*)b2Alloc(tree.m_nodeCapacity * sizeof(b2TreeNode));
+	}
+
+	stream.Value(tree.m_root);
+	stream.Value(tree.m_nodeCount);
+	stream.Value(tree.m_freeList);
+	stream.Value(tree.m_insertionCount);
+	for (int32 i = 0; i < tree.m_nodeCapacity; ++i)
+	{
+		int32 index = b2_nullNode;
+		b2SerializeTreeNode(stream, tree.m_nodes[i], index);
+		tree.m_nodes[i].userData = nullptr;
+		if (tree.m_nodes[i].height != -1 && index >= 0)
+		{
+			// Relink through the tree rather than trusting the saved proxy ids.
+			tree.m_nodes[i].userData = proxies[index];
+			proxies[index]->proxyId = i;
+		}
+	}
+
+	// Contacts are pushed onto the front of the world and body lists, so the
+	// lists are built in reverse and flipped afterwards.
+	for (int32 i = 0; i < header.contactCount; ++i)
+	{
+		int32 indexA = 0;
+		int32 indexB = 0;
+		stream.Value(indexA);
+		stream.Value(indexB);
+
+		b2FixtureProxy* proxyA = proxies[indexA];
+		b2FixtureProxy* proxyB = proxies[indexB];
+		b2Contact* c = b2Contact::Create(proxyA->fixture, proxyA->childIndex, proxyB->fixture, proxyB->childIndex, &m_blockAllocator);
+		b2Assert(c != nullptr && c->m_fixtureA == proxyA->fixture);
+
+		stream.Value(c->m_flags);
+		b2SerializeManifold(stream, c->m_manifold);
+		stream.Value(c->m_friction);
+		stream.Value(c->m_restitution);
+		stream.Value(c->m_restitutionThreshold);
+		stream.Value(c->m_tangentSpeed);
+		stream.Value(c->m_toiCount);
+		stream.Value(c->m_toi);
+
+		m_contactManager.Insert(c);
+	}
+
+	m_stackAllocator.Free(proxies);
+
+	b2Contact* prevContact = nullptr;
+	for (b2Contact* c = m_contactManager.m_contactList; c;)
+	{
+		b2Contact* next = c->m_next;
+		c->m_prev = next;
+		c->m_next = prevContact;
+		prevContact = c;
+		c = next;
+	}
+	m_contactManager.m_contactList = prevContact;
+
+	for (b2Body* b = m_bodyList; b; b = b->m_next)
+	{
+		b2ContactEdge* prevEdge = nullptr;
+		for (b2ContactEdge* ce = b->m_contactList; ce;)
+		{
+			b2ContactEdge* next = ce->next;
+			ce->prev = next;
+			ce->next = prevEdge;
+			prevEdge = ce;
+			ce = next;
+		}
+		b->m_contactList = prevEdge;
+	}
+
+	return stream.IsValid();
+}
@@ -20,6 +20,7 @@
 
 #include "Audio.h"
 #include "common/delay.h"
+#include "common/profiler.h"
 #include "RecordingDevice.h"
 #include "sound/Decoder.h"
 
@@ -61,7 +62,11 @@ void Audio::PoolThread::threadFunction()
 			}
 		}
 
-		pool->update();
+		{
+			LOVE_PROFILE_ZONE("Audio::PoolThread");
+			pool->update();
+		}
+
 		sleep(5);
 	}
 }
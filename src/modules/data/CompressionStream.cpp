@@ -0,0 +1,992 @@
+/**
+ * Copyright (c) 2006-2024 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+// LOVE
+#include "CompressionStream.h"
+#include "common/Exception.h"
+#include "common/int.h"
+#include "thread/ThreadPool.h"
+
+#include "libraries/lz4/lz4.h"
+#include "libraries/lz4/lz4hc.h"
+#include "libraries/xxHash/xxhash.h"
+
+#include <zlib.h>
+
+// C++
+#include <algorithm>
+
+// C
+#include <string.h>
+
+namespace love
+{
+namespace data
+{
+
+love::Type CompressionStream::type("CompressionStream", &Object::type);
+
+static void writeLE32(char *dst, uint32 value)
+{
+	dst[0] = (char) (value & 0xFF);
+	dst[1] = (char) ((value >> 8) & 0xFF);
+	dst[2] = (char) ((value >> 16) & 0xFF);
+	dst[3] = (char) ((value >> 24) & 0xFF);
+}
+
+static uint32 readLE32(const char *src)
+{
+	const uint8 *b = (const uint8 *) src;
+	return (uint32) b[0] | ((uint32) b[1] << 8) | ((uint32) b[2] << 16) | ((uint32) b[3] << 24);
+}
+
+/**
+ * Splits its input into fixed-size blocks which are compressed independently
+ * of each other, so several blocks can be compressed at once on different
+ * threads.
+ **/
+class BlockCompressionStream : public CompressionStream
+{
+public:
+
+	BlockCompressionStream(Compressor::Format format, const Settings &settings, size_t blockSize)
+		: CompressionStream(MODE_COMPRESS, format, settings)
+		, blockSize(blockSize)
+		, headerWritten(false)
+	{
+	}
+
+	virtual ~BlockCompressionStream() {}
+
+protected:
+
+	struct Block
+	{
+		const char *data;
+		size_t size;
+	};
+
+	virtual void writeHeader() = 0;
+	virtual void writeFooter() = 0;
+
+	// Called before a batch of blocks is compressed.
+	virtual void beginBatch(const Block *blocks, int count) = 0;
+
+	// Compresses a single block of the current batch. Called from multiple
+	// threads at once.
+	virtual void compressBlock(int index, const Block &block, bool last, std::vector<char> &out) = 0;
+
+	// Called in order for every block of the batch once they're all compressed.
+	virtual void endBlock(int index, const Block &block) = 0;
+
+	void process(const char *data, size_t size) override
+	{
+		std::vector<Block> blocks;
+
+		// Complete the partially filled block from previous calls first.
+		if (!buffer.empty())
+		{
+			size_t count = std::min(blockSize - buffer.size(), size);
+			buffer.insert(buffer.end(), data, data + count);
+			data += count;
+			size -= count;
+
+			if (buffer.size() == blockSize)
+				blocks.push_back({buffer.data(), buffer.size()});
+		}
+
+		// Full blocks are compressed straight from the input, without copying.
+		while (size >= blockSize)
+		{
+			blocks.push_back({data, blockSize});
+			data += blockSize;
+			size -= blockSize;
+		}
+
+		if (!blocks.empty())
+			compressBlocks(blocks, false);
+
+		if (buffer.size() == blockSize)
+			buffer.clear();
+
+		buffer.insert(buffer.end(), data, data + size);
+	}
+
+	void processFlush() override
+	{
+		if (buffer.empty())
+			return;
+
+		compressBlocks({{buffer.data(), buffer.size()}}, false);
+		buffer.clear();
+	}
+
+	void processFinish() override
+	{
+		compressBlocks({{buffer.data(), buffer.size()}}, true);
+		buffer.clear();
+		writeFooter();
+	}
+
+	size_t blockSize;
+
+private:
+
+	void compressBlocks(const std::vector<Block> &blocks, bool last)
+	{
+		if (!headerWritten)
+		{
+			writeHeader();
+			headerWritten = true;
+		}
+
+		size_t batchsize = (size_t) getBatchSize();
+
+		for (size_t start = 0; start < blocks.size(); start += batchsize)
+		{
+			int count = (int) std::min(batchsize, blocks.size() - start);
+			bool lastbatch = last && start + count == blocks.size();
+			const Block *batch = &blocks[start];
+
+			if ((int) outputs.size() < count)
+				outputs.resize(count);
+
+			beginBatch(batch, count);
+
+			parallelFor(count, [&](int i)
+			{
+				outputs[i].clear();
+				compressBlock(i, batch[i], lastbatch && i == count - 1, outputs[i]);
+			});
+
+			for (int i = 0; i < count; i++)
+			{
+				endBlock(i, batch[i]);
+				output(outputs[i].data(), outputs[i].size());
+			}
+		}
+	}
+
+	std::vector<char> buffer;
+	std::vector<std::vector<char>> outputs;
+	bool headerWritten;
+
+}; // BlockCompressionStream
+
+/**
+ * Writes LZ4 frames (the format used by the lz4 command line tool) made of
+ * independent blocks, with a content checksum.
+ **/
+class LZ4FrameCompressionStream : public BlockCompressionStream
+{
+public:
+
+	LZ4FrameCompressionStream(const Settings &settings)
+		: BlockCompressionStream(Compressor::FORMAT_LZ4_FRAME, settings, 0)
+		, blockSizeID(7)
+		, checksumState(XXH32_createState())
+	{
+		// The frame format only allows a few specific block sizes.
+		if (settings.blockSize > 0)
+		{
+			blockSizeID = 4;
+			while (blockSizeID < 7 && getMaxBlockSize(blockSizeID) < settings.blockSize)
+				blockSizeID++;
+		}
+
+		blockSize = getMaxBlockSize(blockSizeID);
+		XXH32_reset(checksumState, 0);
+	}
+
+	virtual ~LZ4FrameCompressionStream()
+	{
+		XXH32_freeState(checksumState);
+	}
+
+	static size_t getMaxBlockSize(int id)
+	{
+		return (size_t) 1 << (8 + 2 * id);
+	}
+
+protected:
+
+	void writeHeader() override
+	{
+		char header[7];
+		writeLE32(header, LZ4_FRAME_MAGIC);
+
+		// Version 01, independent blocks, content checksum.
+		header[4] = (char) (0x40 | 0x20 | 0x04);
+		header[5] = (char) (blockSizeID << 4);
+		header[6] = (char) ((XXH32(header + 4, 2, 0) >> 8) & 0xFF);
+
+		output(header, sizeof(header));
+	}
+
+	void writeFooter() override
+	{
+		char footer[8];
+		writeLE32(footer, 0); // EndMark
+		writeLE32(footer + 4, XXH32_digest(checksumState));
+		output(footer, sizeof(footer));
+	}
+
+	void beginBatch(const Block *, int) override
+	{
+	}
+
+	void compressBlock(int, const Block &block, bool, std::vector<char> &out) override
+	{
+		if (block.size == 0)
+			return;
+
+		int bound = LZ4_compressBound((int) block.size);
+		out.resize(sizeof(uint32) + bound);
+
+		char *dst = out.data() + sizeof(uint32);
+		int csize = 0;
+
+		// Use LZ4-HC for compression level 9 and higher.
+		if (settings.level > 8)
+			csize = LZ4_compress_HC(block.data, dst, (int) block.size, bound, LZ4HC_CLEVEL_DEFAULT);
+		else
+			csize = LZ4_compress_default(block.data, dst, (int) block.size, bound);
+
+		if (csize <= 0 || (size_t) csize >= block.size)
+		{
+			// Incompressible blocks are stored as-is, marked by the high bit.
+			out.resize(sizeof(uint32) + block.size);
+			memcpy(out.data() + sizeof(uint32), block.data, block.size);
+			writeLE32(out.data(), (uint32) block.size | 0x80000000);
+		}
+		else
+		{
+			out.resize(sizeof(uint32) + csize);
+			writeLE32(out.data(), (uint32) csize);
+		}
+	}
+
+	void endBlock(int, const Block &block) override
+	{
+		XXH32_update(checksumState, block.data, block.size);
+	}
+
+private:
+
+	static constexpr uint32 LZ4_FRAME_MAGIC = 0x184D2204;
+
+	int blockSizeID;
+	XXH32_state_t *checksumState;
+
+}; // LZ4FrameCompressionStream
+
+/**
+ * Writes zlib, gzip or raw deflate data, compressing blocks in parallel the
+ * same way pigz does: every block is a separate raw deflate stream which is
+ * primed with the end of the previous block as a dictionary, and which ends
+ * on a byte boundary so the results can be concatenated.
+ **/
+class ZlibCompressionStream : public BlockCompressionStream
+{
+public:
+
+	ZlibCompressionStream(Compressor::Format format, const Settings &settings)
+		: BlockCompressionStream(format, settings, DEFAULT_BLOCK_SIZE)
+		, level(settings.level)
+		, checksum(0)
+		, totalSize(0)
+	{
+		if (settings.blockSize > 0)
+			blockSize = std::min(std::max(settings.blockSize, MIN_BLOCK_SIZE), MAX_BLOCK_SIZE);
+
+		if (level < 0)
+			level = Z_DEFAULT_COMPRESSION;
+		else if (level > 9)
+			level = 9;
+
+		if (format == Compressor::FORMAT_GZIP)
+			checksum = crc32(0, Z_NULL, 0);
+		else
+			checksum = adler32(0, Z_NULL, 0);
+	}
+
+	virtual ~ZlibCompressionStream() {}
+
+protected:
+
+	void writeHeader() override
+	{
+		if (format == Compressor::FORMAT_ZLIB)
+		{
+			// Deflate with a 32K window, and the compression level hint.
+			int flevel = 2;
+			if (level == 0 || level == 1)
+				flevel = 0;
+			else if (level >= 2 && level <= 5)
+				flevel = 1;
+			else if (level >= 7)
+				flevel = 3;
+
+			uint32 header = (0x78 << 8) | (flevel << 6);
+			header += 31 - (header % 31);
+
+			char bytes[2] = {(char) (header >> 8), (char) (header & 0xFF)};
+			output(bytes, sizeof(bytes));
+		}
+		else if (format == Compressor::FORMAT_GZIP)
+		{
+			// Magic, deflate, no flags, no modification time, unknown OS.
+			const char bytes[10] = {(char) 0x1F, (char) 0x8B, 8, 0, 0, 0, 0, 0, 0, (char) 0xFF};
+			output(bytes, sizeof(bytes));
+		}
+	}
+
+	void writeFooter() override
+	{
+		if (format == Compressor::FORMAT_ZLIB)
+		{
+			uint32 adler = (uint32) checksum;
+			char bytes[4] = {(char) (adler >> 24), (char) (adler >> 16), (char) (adler >> 8), (char) adler};
+			output(bytes, sizeof(bytes));
+		}
+		else if (format == Compressor::FORMAT_GZIP)
+		{
+			char bytes[8];
+			writeLE32(bytes, (uint32) checksum);
+			writeLE32(bytes + 4, (uint32) totalSize);
+			output(bytes, sizeof(bytes));
+		}
+	}
+
+	void beginBatch(const Block *blocks, int count) override
+	{
+		dictionaries.resize(count);
+		checksums.resize(count);
+
+		for (int i = 0; i < count; i++)
+		{
+			if (i == 0)
+				dictionaries[i] = {dictionary.data(), dictionary.size()};
+			else
+			{
+				size_t size = std::min(blocks[i - 1].size, WINDOW_SIZE);
+				dictionaries[i] = {blocks[i - 1].data + blocks[i - 1].size - size, size};
+			}
+		}
+	}
+
+	void compressBlock(int index, const Block &block, bool last, std::vector<char> &out) override
+	{
+		z_stream stream = {};
+
+		if (deflateInit2(&stream, level, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+			throw love::Exception("Could not initialize zlib compression.");
+
+		const Block &dict = dictionaries[index];
+		if (dict.size > 0)
+			deflateSetDictionary(&stream, (const Bytef *) dict.data, (uInt) dict.size);
+
+		stream.next_in = (Bytef *) block.data;
+		stream.avail_in = (uInt) block.size;
+
+		// Room for the sync flush marker or final block on top of the bound.
+		out.resize(deflateBound(&stream, (uLong) block.size) + 16);
+
+		int flush = last ? Z_FINISH : Z_SYNC_FLUSH;
+		size_t written = 0;
+
+		while (true)
+		{
+			stream.next_out = (Bytef *) out.data() + written;
+			stream.avail_out = (uInt) (out.size() - written);
+
+			int err = deflate(&stream, flush);
+			written = out.size() - stream.avail_out;
+
+			if (err == Z_STREAM_END)
+				break;
+
+			if (err != Z_OK && err != Z_BUF_ERROR)
+			{
+				deflateEnd(&stream);
+				throw love::Exception("Could not zlib/gzip-compress data.");
+			}
+
+			if (!last && stream.avail_in == 0 && stream.avail_out > 0)
+				break;
+
+			out.resize(out.size() * 2);
+		}
+
+		deflateEnd(&stream);
+		out.resize(written);
+
+		if (format == Compressor::FORMAT_GZIP)
+			checksums[index] = crc32(crc32(0, Z_NULL, 0), (const Bytef *) block.data, (uInt) block.size);
+		else if (format == Compressor::FORMAT_ZLIB)
+			checksums[index] = adler32(adler32(0, Z_NULL, 0), (const Bytef *) block.data, (uInt) block.size);
+	}
+
+	void endBlock(int index, const Block &block) override
+	{
+		if (format == Compressor::FORMAT_GZIP)
+			checksum = crc32_combine(checksum, checksums[index], (z_off_t) block.size);
+		else if (format == Compressor::FORMAT_ZLIB)
+			checksum = adler32_combine(checksum, checksums[index], (z_off_t) block.size);
+
+		totalSize += block.size;
+
+		// Keep the end of the block around as the next block's dictionary,
+		// since the block's memory may not outlive this batch.
+		size_t size = std::min(block.size, WINDOW_SIZE);
+		if (size == WINDOW_SIZE)
+			dictionary.assign(block.data + block.size - size, block.data + block.size);
+		else
+		{
+			dictionary.insert(dictionary.end(), block.data, block.data + block.size);
+			if (dictionary.size() > WINDOW_SIZE)
+				dictionary.erase(dictionary.begin(), dictionary.end() - WINDOW_SIZE);
+		}
+	}
+
+private:
+
+	static constexpr size_t WINDOW_SIZE = 32 * 1024;
+	static constexpr size_t MIN_BLOCK_SIZE = 64 * 1024;
+	static constexpr size_t DEFAULT_BLOCK_SIZE = 1024 * 1024;
+	static constexpr size_t MAX_BLOCK_SIZE = 64 * 1024 * 1024;
+
+	int level;
+
+	uLong checksum;
+	uint64 totalSize;
+
+	std::vector<char> dictionary;
+	std::vector<Block> dictionaries;
+	std::vector<uLong> checksums;
+
+}; // ZlibCompressionStream
+
+/**
+ * Reads LZ4 frames. Independent blocks are decompressed in parallel.
+ **/
+class LZ4FrameDecompressionStream : public CompressionStream
+{
+public:
+
+	LZ4FrameDecompressionStream(const Settings &settings)
+		: CompressionStream(MODE_DECOMPRESS, Compressor::FORMAT_LZ4_FRAME, settings)
+		, state(STATE_MAGIC)
+		, skipRemaining(0)
+		, independent(true)
+		, blockChecksums(false)
+		, contentChecksum(false)
+		, maxBlockSize(0)
+		, checksumState(XXH32_createState())
+	{
+	}
+
+	virtual ~LZ4FrameDecompressionStream()
+	{
+		XXH32_freeState(checksumState);
+	}
+
+protected:
+
+	void process(const char *data, size_t size) override
+	{
+		// Avoid copying the input when there's nothing left over from before.
+		if (input.empty())
+		{
+			size_t consumed = parse(data, size);
+			if (!finished)
+				input.assign(data + consumed, data + size);
+		}
+		else
+		{
+			input.insert(input.end(), data, data + size);
+			size_t consumed = parse(input.data(), input.size());
+			input.erase(input.begin(), input.begin() + consumed);
+		}
+	}
+
+	void processFlush() override
+	{
+	}
+
+	void processFinish() override
+	{
+		// The stream is marked as finished as soon as the frame ends, so
+		// getting here means the data is incomplete.
+		throw love::Exception("Could not decompress LZ4 frame data: the data is incomplete.");
+	}
+
+private:
+
+	enum State
+	{
+		STATE_MAGIC,
+		STATE_SKIP,
+		STATE_HEADER,
+		STATE_BLOCKS,
+		STATE_CHECKSUM,
+	};
+
+	struct Block
+	{
+		const char *data;
+		size_t size;
+		bool compressed;
+	};
+
+	static constexpr uint32 LZ4_FRAME_MAGIC = 0x184D2204;
+	static constexpr uint32 LZ4_SKIPPABLE_MAGIC = 0x184D2A50;
+	static constexpr size_t DICTIONARY_SIZE = 64 * 1024;
+
+	size_t parse(const char *data, size_t size)
+	{
+		size_t offset = 0;
+
+		while (!finished)
+		{
+			const char *src = data + offset;
+			size_t avail = size - offset;
+
+			if (state == STATE_MAGIC)
+			{
+				if (avail < 4)
+					break;
+
+				uint32 magic = readLE32(src);
+
+				if ((magic & 0xFFFFFFF0) == LZ4_SKIPPABLE_MAGIC)
+				{
+					if (avail < 8)
+						break;
+					skipRemaining = readLE32(src + 4);
+					offset += 8;
+					state = STATE_SKIP;
+				}
+				else if (magic == LZ4_FRAME_MAGIC)
+				{
+					offset += 4;
+					state = STATE_HEADER;
+				}
+				else
+					throw love::Exception("Could not decompress LZ4 frame data: invalid frame.");
+			}
+			else if (state == STATE_SKIP)
+			{
+				size_t count = std::min(avail, skipRemaining);
+				offset += count;
+				skipRemaining -= count;
+
+				if (skipRemaining > 0)
+					break;
+
+				state = STATE_MAGIC;
+			}
+			else if (state == STATE_HEADER)
+			{
+				if (avail < 2)
+					break;
+
+				uint8 flags = (uint8) src[0];
+				uint8 blockdesc = (uint8) src[1];
+				size_t headersize = 3 + ((flags & 0x08) ? 8 : 0) + ((flags & 0x01) ? 4 : 0);
+
+				if (avail < headersize)
+					break;
+
+				if ((flags >> 6) != 1)
+					throw love::Exception("Could not decompress LZ4 frame data: unsupported version.");
+
+				if ((uint8) src[headersize - 1] != ((XXH32(src, headersize - 1, 0) >> 8) & 0xFF))
+					throw love::Exception("Could not decompress LZ4 frame data: corrupt frame header.");
+
+				if (flags & 0x01)
+					throw love::Exception("Could not decompress LZ4 frame data: frames which use a dictionary are not supported.");
+
+				int blocksizeid = (blockdesc >> 4) & 0x7;
+				if (blocksizeid < 4)
+					throw love::Exception("Could not decompress LZ4 frame data: invalid block size.");
+
+				independent = (flags & 0x20) != 0;
+				blockChecksums = (flags & 0x10) != 0;
+				contentChecksum = (flags & 0x04) != 0;
+				maxBlockSize = LZ4FrameCompressionStream::getMaxBlockSize(blocksizeid);
+
+				XXH32_reset(checksumState, 0);
+				dictionary.clear();
+
+				offset += headersize;
+				state = STATE_BLOCKS;
+			}
+			else if (state == STATE_BLOCKS)
+			{
+				size_t consumed = decodeBlocks(src, avail);
+				offset += consumed;
+
+				if (state == STATE_BLOCKS)
+					break;
+			}
+			else if (state == STATE_CHECKSUM)
+			{
+				if (avail < 4)
+					break;
+
+				if (readLE32(src) != XXH32_digest(checksumState))
+					throw love::Exception("Could not decompress LZ4 frame data: checksum mismatch.");
+
+				offset += 4;
+				finished = true;
+			}
+		}
+
+		return offset;
+	}
+
+	// Decodes all complete blocks in the given data, and returns the number of
+	// bytes used.
+	size_t decodeBlocks(const char *data, size_t size)
+	{
+		size_t offset = 0;
+		bool ended = false;
+
+		blocks.clear();
+
+		while (size - offset >= 4)
+		{
+			uint32 word = readLE32(data + offset);
+
+			if (word == 0)
+			{
+				offset += 4;
+				ended = true;
+				break;
+			}
+
+			size_t blocksize = word & 0x7FFFFFFF;
+			size_t total = 4 + blocksize + (blockChecksums ? 4 : 0);
+
+			if (blocksize > maxBlockSize)
+				throw love::Exception("Could not decompress LZ4 frame data: invalid block size.");
+
+			if (size - offset < total)
+				break;
+
+			const char *blockdata = data + offset + 4;
+
+			if (blockChecksums && XXH32(blockdata, blocksize, 0) != readLE32(blockdata + blocksize))
+				throw love::Exception("Could not decompress LZ4 frame data: block checksum mismatch.");
+
+			blocks.push_back({blockdata, blocksize, (word & 0x80000000) == 0});
+			offset += total;
+		}
+
+		size_t batchsize = independent ? (size_t) getBatchSize() : 1;
+
+		for (size_t start = 0; start < blocks.size(); start += batchsize)
+		{
+			int count = (int) std::min(batchsize, blocks.size() - start);
+
+			if ((int) outputs.size() < count)
+			{
+				outputs.resize(count);
+				outputSizes.resize(count);
+			}
+
+			if (independent)
+				parallelFor(count, [&](int i) { decodeBlock(blocks[start + i], i); });
+			else
+				decodeBlock(blocks[start], 0);
+
+			for (int i = 0; i < count; i++)
+			{
+				const char *out = outputs[i].data();
+				size_t outsize = outputSizes[i];
+
+				if (contentChecksum)
+					XXH32_update(checksumState, out, outsize);
+
+				if (!independent)
+				{
+					dictionary.insert(dictionary.end(), out, out + outsize);
+					if (dictionary.size() > DICTIONARY_SIZE)
+						dictionary.erase(dictionary.begin(), dictionary.end() - DICTIONARY_SIZE);
+				}
+
+				output(out, outsize);
+			}
+		}
+
+		if (ended)
+		{
+			if (contentChecksum)
+				state = STATE_CHECKSUM;
+			else
+				finished = true;
+		}
+
+		return offset;
+	}
+
+	void decodeBlock(const Block &block, int index)
+	{
+		std::vector<char> &out = outputs[index];
+		if (out.size() < maxBlockSize)
+			out.resize(maxBlockSize);
+
+		if (!block.compressed)
+		{
+			memcpy(out.data(), block.data, block.size);
+			outputSizes[index] = block.size;
+			return;
+		}
+
+		int result = 0;
+		if (!independent && !dictionary.empty())
+			result = LZ4_decompress_safe_usingDict(block.data, out.data(), (int) block.size, (int) maxBlockSize, dictionary.data(), (int) dictionary.size());
+		else
+			result = LZ4_decompress_safe(block.data, out.data(), (int) block.size, (int) maxBlockSize);
+
+		if (result < 0)
+			throw love::Exception("Could not decompress LZ4 frame data.");
+
+		outputSizes[index] = (size_t) result;
+	}
+
+	State state;
+	size_t skipRemaining;
+
+	bool independent;
+	bool blockChecksums;
+	bool contentChecksum;
+	size_t maxBlockSize;
+
+	XXH32_state_t *checksumState;
+
+	std::vector<char> input;
+	std::vector<char> dictionary;
+
+	std::vector<Block> blocks;
+	std::vector<std::vector<char>> outputs;
+	std::vector<size_t> outputSizes;
+
+}; // LZ4FrameDecompressionStream
+
+class ZlibDecompressionStream : public CompressionStream
+{
+public:
+
+	ZlibDecompressionStream(Compressor::Format format, const Settings &settings)
+		: CompressionStream(MODE_DECOMPRESS, format, settings)
+		, stream()
+		, buffer(BUFFER_SIZE)
+	{
+		// 15 is the default. Adding 32 makes zlib auto-detect the header type.
+		int windowbits = format == Compressor::FORMAT_DEFLATE ? -15 : 15 + 32;
+
+		if (inflateInit2(&stream, windowbits) != Z_OK)
+			throw love::Exception("Could not initialize zlib decompression.");
+	}
+
+	virtual ~ZlibDecompressionStream()
+	{
+		inflateEnd(&stream);
+	}
+
+protected:
+
+	void process(const char *data, size_t size) override
+	{
+		while (size > 0 && !finished)
+		{
+			uInt count = (uInt) std::min(size, (size_t) 1 << 30);
+			stream.next_in = (Bytef *) data;
+			stream.avail_in = count;
+
+			do
+			{
+				stream.next_out = (Bytef *) buffer.data();
+				stream.avail_out = (uInt) buffer.size();
+
+				int err = inflate(&stream, Z_NO_FLUSH);
+
+				if (err != Z_OK && err != Z_STREAM_END && err != Z_BUF_ERROR)
+					throw love::Exception("Could not decompress zlib/gzip-compressed data.");
+
+				output(buffer.data(), buffer.size() - stream.avail_out);
+
+				if (err == Z_STREAM_END)
+					finished = true;
+				else if (err == Z_BUF_ERROR)
+					break;
+			}
+			while (!finished && (stream.avail_in > 0 || stream.avail_out == 0));
+
+			data += count;
+			size -= count;
+		}
+	}
+
+	void processFlush() override
+	{
+	}
+
+	void processFinish() override
+	{
+		throw love::Exception("Could not decompress zlib/gzip-compressed data: the data is incomplete.");
+	}
+
+private:
+
+	static constexpr size_t BUFFER_SIZE = 64 * 1024;
+
+	z_stream stream;
+	std::vector<char> buffer;
+
+}; // ZlibDecompressionStream
+
+CompressionStream *CompressionStream::create(Mode mode, Compressor::Format format, const Settings &settings)
+{
+	switch (format)
+	{
+	case Compressor::FORMAT_LZ4_FRAME:
+		if (mode == MODE_COMPRESS)
+			return new LZ4FrameCompressionStream(settings);
+		else
+			return new LZ4FrameDecompressionStream(settings);
+	case Compressor::FORMAT_ZLIB:
+	case Compressor::FORMAT_GZIP:
+	case Compressor::FORMAT_DEFLATE:
+		if (mode == MODE_COMPRESS)
+			return new ZlibCompressionStream(format, settings);
+		else
+			return new ZlibDecompressionStream(format, settings);
+	default:
+		break;
+	}
+
+	const char *name = "unknown";
+	Compressor::getConstant(format, name);
+	throw love::Exception("The %s format does not support streaming. Use lz4frame instead.", name);
+}
+
+CompressionStream::CompressionStream(Mode mode, Compressor::Format format, const Settings &settings)
+	: mode(mode)
+	, format(format)
+	, settings(settings)
+	, finished(false)
+{
+}
+
+CompressionStream::~CompressionStream()
+{
+}
+
+void CompressionStream::setOutput(Stream *stream)
+{
+	if (stream != nullptr && !stream->isWritable())
+		throw love::Exception("The output stream must be writable.");
+
+	outputStream.set(stream);
+}
+
+Stream *CompressionStream::getOutput() const
+{
+	return outputStream.get();
+}
+
+void CompressionStream::feed(const void *data, size_t size)
+{
+	if (finished)
+		throw love::Exception("Cannot feed data to a compression stream which has finished.");
+
+	if (size > 0)
+		process((const char *) data, size);
+}
+
+void CompressionStream::flush()
+{
+	if (!finished)
+		processFlush();
+
+	if (outputStream.get() != nullptr)
+		outputStream->flush();
+}
+
+void CompressionStream::finish()
+{
+	if (!finished)
+	{
+		processFinish();
+		finished = true;
+	}
+
+	if (outputStream.get() != nullptr)
+		outputStream->flush();
+}
+
+void CompressionStream::takeOutput(std::vector<char> &out)
+{
+	out.clear();
+	std::swap(out, pending);
+}
+
+void CompressionStream::output(const void *data, size_t size)
+{
+	if (size == 0)
+		return;
+
+	if (outputStream.get() != nullptr)
+	{
+		if (!outputStream->write(data, (int64) size))
+			throw love::Exception("Could not write to the compression stream's output.");
+	}
+	else
+		pending.insert(pending.end(), (const char *) data, (const char *) data + size);
+}
+
+void CompressionStream::parallelFor(int count, const std::function<void(int)> &func)
+{
+	if (settings.threads == 1 || count <= 1)
+	{
+		for (int i = 0; i < count; i++)
+			func(i);
+	}
+	else
+		thread::ThreadPool::getShared()->parallelFor(count, func);
+}
+
+int CompressionStream::getBatchSize() const
+{
+	if (settings.threads == 1)
+		return 1;
+
+	int threads = thread::ThreadPool::getShared()->getThreadCount() + 1;
+	if (settings.threads > 0)
+		threads = std::min(threads, settings.threads);
+
+	return threads;
+}
+
+} // data
+} // love
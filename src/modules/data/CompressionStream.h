@@ -0,0 +1,143 @@
+/**
+ * Copyright (c) 2006-2024 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#pragma once
+
+// LOVE
+#include "common/Object.h"
+#include "common/Stream.h"
+#include "Compressor.h"
+
+// C++
+#include <functional>
+#include <vector>
+
+namespace love
+{
+namespace data
+{
+
+/**
+ * Incrementally compresses or decompresses data which is fed to it in pieces,
+ * instead of requiring the whole input at once. Output is either written to
+ * a Stream (such as a File) as it's produced, or kept until it's taken.
+ **/
+class CompressionStream : public Object
+{
+public:
+
+	static love::Type type;
+
+	enum Mode
+	{
+		MODE_COMPRESS,
+		MODE_DECOMPRESS,
+	};
+
+	struct Settings
+	{
+		// The amount of compression to apply (between 0 and 9), or -1 for
+		// the format's default.
+		int level = -1;
+
+		// The maximum number of threads used to compress or decompress
+		// independent blocks, or 0 to use every available core.
+		int threads = 0;
+
+		// The size in bytes of independently compressed blocks, or 0 for the
+		// format's default. Only used by lz4frame, zlib, gzip and deflate
+		// compression.
+		size_t blockSize = 0;
+	};
+
+	static CompressionStream *create(Mode mode, Compressor::Format format, const Settings &settings);
+
+	virtual ~CompressionStream();
+
+	Mode getMode() const { return mode; }
+	Compressor::Format getFormat() const { return format; }
+
+	/**
+	 * Sets a Stream that output is written to as it's produced. When no output
+	 * Stream is set, output is kept until takeOutput is called.
+	 **/
+	void setOutput(Stream *stream);
+	Stream *getOutput() const;
+
+	/**
+	 * Compresses or decompresses the given input. Some or all of it may be
+	 * buffered internally until more input is given or flush is called.
+	 **/
+	void feed(const void *data, size_t size);
+
+	/**
+	 * Makes sure all input given so far has been processed and output.
+	 **/
+	void flush();
+
+	/**
+	 * Processes any remaining input and ends the stream. When decompressing,
+	 * an exception is thrown if the compressed data was incomplete.
+	 **/
+	void finish();
+
+	/**
+	 * Gets whether the stream has ended, either because finish was called or
+	 * because the end of the compressed data was reached.
+	 **/
+	bool isFinished() const { return finished; }
+
+	/**
+	 * Moves the output produced since the last call into the given vector.
+	 **/
+	void takeOutput(std::vector<char> &out);
+
+protected:
+
+	CompressionStream(Mode mode, Compressor::Format format, const Settings &settings);
+
+	virtual void process(const char *data, size_t size) = 0;
+	virtual void processFlush() = 0;
+	virtual void processFinish() = 0;
+
+	void output(const void *data, size_t size);
+
+	// Calls func(i) for every i in [0, count), using up to the thread count
+	// given in the stream's settings.
+	void parallelFor(int count, const std::function<void(int)> &func);
+
+	// The number of blocks worth processing together on separate threads.
+	int getBatchSize() const;
+
+	Mode mode;
+	Compressor::Format format;
+	Settings settings;
+
+	bool finished;
+
+private:
+
+	StrongRef<Stream> outputStream;
+	std::vector<char> pending;
+
+}; // CompressionStream
+
+} // data
+} // love
@@ -20,6 +20,7 @@
 
 // LOVE
 #include "Compressor.h"
+#include "CompressionStream.h"
 #include "common/config.h"
 #include "common/int.h"
 #include "common/Exception.h"
@@ -29,11 +30,48 @@
 
 #include <zlib.h>
 
+// C++
+#include <algorithm>
+#include <vector>
+
 namespace love
 {
 namespace data
 {
 
+// Compresses or decompresses a whole buffer at once with a CompressionStream,
+// which may split the work across multiple threads.
+static char *streamProcess(CompressionStream::Mode mode, Compressor::Format format, const char *data, size_t dataSize, int level, size_t &outSize)
+{
+	CompressionStream::Settings settings;
+	settings.level = level;
+
+	StrongRef<CompressionStream> stream(CompressionStream::create(mode, format, settings), Acquire::NORETAIN);
+
+	stream->feed(data, dataSize);
+	stream->finish();
+
+	std::vector<char> result;
+	stream->takeOutput(result);
+
+	char *bytes = nullptr;
+
+	try
+	{
+		bytes = new char[std::max(result.size(), (size_t) 1)];
+	}
+	catch (std::bad_alloc &)
+	{
+		throw love::Exception("Out of memory.");
+	}
+
+	if (!result.empty())
+		memcpy(bytes, result.data(), result.size());
+
+	outSize = result.size();
+	return bytes;
+}
+
 class LZ4Compressor : public Compressor
 {
 public:
@@ -167,10 +205,45 @@ class LZ4Compressor : public Compressor
 }; // LZ4Compressor
 
 
+/**
+ * The standard LZ4 frame format, made of independently compressed blocks.
+ * Unlike the plain lz4 format it can be read by other LZ4 tools, and it's
+ * compressed and decompressed on multiple threads.
+ **/
+class LZ4FrameCompressor : public Compressor
+{
+public:
+
+	char *compress(Format format, const char *data, size_t dataSize, int level, size_t &compressedSize) override
+	{
+		if (format != FORMAT_LZ4_FRAME)
+			throw love::Exception("Invalid format (expecting LZ4 frame)");
+
+		return streamProcess(CompressionStream::MODE_COMPRESS, format, data, dataSize, level, compressedSize);
+	}
+
+	char *decompress(Format format, const char *data, size_t dataSize, size_t &decompressedSize) override
+	{
+		if (format != FORMAT_LZ4_FRAME)
+			throw love::Exception("Invalid format (expecting LZ4 frame)");
+
+		return streamProcess(CompressionStream::MODE_DECOMPRESS, format, data, dataSize, -1, decompressedSize);
+	}
+
+	bool isSupported(Format format) const override
+	{
+		return format == FORMAT_LZ4_FRAME;
+	}
+
+}; // LZ4FrameCompressor
+
+
 class zlibCompressor : public Compressor
 {
 private:
 
+	static constexpr size_t PARALLEL_MIN_SIZE = 4 * 1024 * 1024;
+
 	// The following three functions are mostly copied from the zlib source
 	// (compressBound, compress2, and uncompress), but modified to support both
 	// zlib and gzip.
@@ -263,6 +336,10 @@ class zlibCompressor : public Compressor
 		if (!isSupported(format))
 			throw love::Exception("Invalid format (expecting zlib or gzip)");
 
+		// Large inputs are split into blocks which are compressed in parallel.
+		if (dataSize >= PARALLEL_MIN_SIZE)
+			return streamProcess(CompressionStream::MODE_COMPRESS, format, data, dataSize, level, compressedSize);
+
 		if (level < 0)
 			level = Z_DEFAULT_COMPRESSION;
 		else if (level > 9)
@@ -363,8 +440,9 @@ Compressor *Compressor::getCompressor(Format format)
 {
 	static LZ4Compressor lz4compressor;
 	static zlibCompressor zlibcompressor;
+	static LZ4FrameCompressor lz4framecompressor;
 
-	Compressor *compressors[] = {&lz4compressor, &zlibcompressor};
+	Compressor *compressors[] = {&lz4compressor, &zlibcompressor, &lz4framecompressor};
 
 	for (Compressor *c : compressors)
 	{
@@ -392,10 +470,11 @@ std::vector<std::string> Compressor::getConstants(Format)
 
 StringMap<Compressor::Format, Compressor::FORMAT_MAX_ENUM>::Entry Compressor::formatEntries[] =
 {
-	{ "lz4",     FORMAT_LZ4     },
-	{ "zlib",    FORMAT_ZLIB    },
-	{ "gzip",    FORMAT_GZIP    },
-	{ "deflate", FORMAT_DEFLATE },
+	{ "lz4",      FORMAT_LZ4       },
+	{ "zlib",     FORMAT_ZLIB      },
+	{ "gzip",     FORMAT_GZIP      },
+	{ "deflate",  FORMAT_DEFLATE   },
+	{ "lz4frame", FORMAT_LZ4_FRAME },
 };
 
 StringMap<Compressor::Format, Compressor::FORMAT_MAX_ENUM> Compressor::formatNames(Compressor::formatEntries, sizeof(Compressor::formatEntries));
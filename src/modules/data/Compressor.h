@@ -41,6 +41,7 @@ class Compressor
 		FORMAT_ZLIB,
 		FORMAT_GZIP,
 		FORMAT_DEFLATE,
+		FORMAT_LZ4_FRAME,
 		FORMAT_MAX_ENUM
 	};
 
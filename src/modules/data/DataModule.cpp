@@ -23,8 +23,10 @@
 #include "common/b64.h"
 #include "common/int.h"
 #include "common/StringMap.h"
+#include "thread/ThreadPool.h"
 
 // STL
+#include <algorithm>
 #include <cmath>
 #include <list>
 #include <iostream>
@@ -213,6 +215,40 @@ void hash(HashFunction::Function function, const char *input, uint64_t size, Has
 	hashfunction->hash(function, input, size, output);
 }
 
+void hash(HashFunction::Function function, const std::vector<HashInput> &inputs, std::vector<HashFunction::Value> &outputs)
+{
+	HashFunction *hashfunction = HashFunction::getHashFunction(function);
+	if (hashfunction == nullptr)
+		throw love::Exception("Invalid hash function.");
+
+	outputs.resize(inputs.size());
+
+	uint64_t totalsize = 0;
+	for (const HashInput &input : inputs)
+		totalsize += input.size;
+
+	// Not worth waking up other threads for small amounts of data.
+	if (totalsize < 256 * 1024 || inputs.size() < 2)
+	{
+		for (size_t i = 0; i < inputs.size(); i++)
+			hashfunction->hash(function, inputs[i].data, inputs[i].size, outputs[i]);
+		return;
+	}
+
+	// Hash contiguous ranges of inputs per task, so lots of tiny inputs don't
+	// turn into lots of tiny tasks.
+	thread::ThreadPool *pool = thread::ThreadPool::getShared();
+	int taskcount = (int) std::min(inputs.size(), (size_t) (pool->getThreadCount() + 1) * 4);
+	size_t pertask = (inputs.size() + taskcount - 1) / taskcount;
+
+	pool->parallelFor(taskcount, [&](int task)
+	{
+		size_t end = std::min(inputs.size(), (task + 1) * pertask);
+		for (size_t i = task * pertask; i < end; i++)
+			hashfunction->hash(function, inputs[i].data, inputs[i].size, outputs[i]);
+	});
+}
+
 DataModule::DataModule()
 	: Module(M_DATA, "love.data")
 {
@@ -222,6 +258,11 @@ DataModule::~DataModule()
 {
 }
 
+Hasher *DataModule::newHasher(HashFunction::Function function)
+{
+	return new Hasher(function);
+}
+
 DataView *DataModule::newDataView(Data *data, size_t offset, size_t size)
 {
 	return new DataView(data, offset, size);
@@ -25,6 +25,7 @@
 #include "HashFunction.h"
 #include "DataView.h"
 #include "ByteData.h"
+#include "Hasher.h"
 
 // LOVE
 #include "common/Module.h"
@@ -100,6 +101,22 @@ std::string hash(HashFunction::Function function, const char *input, uint64_t si
 void hash(HashFunction::Function function, Data *input, HashFunction::Value &output);
 void hash(HashFunction::Function function, const char *input, uint64_t size, HashFunction::Value &output);
 
+struct HashInput
+{
+	const char *data;
+	uint64_t size;
+};
+
+/**
+ * Hash many separate inputs with the same function. The work is spread across
+ * worker threads.
+ *
+ * @param[in] function The selected hash function.
+ * @param[in] inputs The input data to hash.
+ * @param[out] outputs The result of the hash function for each input.
+ **/
+void hash(HashFunction::Function function, const std::vector<HashInput> &inputs, std::vector<HashFunction::Value> &outputs);
+
 
 bool getConstant(const char *in, EncodeFormat &out);
 bool getConstant(EncodeFormat in, const char *&out);
@@ -121,6 +138,7 @@ class DataModule : public Module
 	ByteData *newByteData(size_t size);
 	ByteData *newByteData(const void *d, size_t size);
 	ByteData *newByteData(void *d, size_t size, bool own);
+	Hasher *newHasher(HashFunction::Function function);
 
 }; // DataModule
 
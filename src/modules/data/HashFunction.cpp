@@ -21,6 +21,13 @@
 #include "HashFunction.h"
 #include "common/Exception.h"
 
+#include "libraries/xxHash/xxhash.h"
+
+#if defined(__SSE4_2__) && defined(__x86_64__)
+#define LOVE_CRC32C_SSE42
+#include <nmmintrin.h>
+#endif
+
 // FIXME: Probably trivial by having tole and tobe functions, which can be ifdeffed to being identity functions
 #ifdef LOVE_BIG_ENDIAN
 #	error Hashing not yet implemented for big endian
@@ -586,6 +593,237 @@ const uint64 SHA512::constants[80] = {
 	0x4cc5d4becb3e42b6, 0x597f299cfc657e2a, 0x5fcb6fab3ad6faec, 0x6c44198c4a475817,
 };
 
+/**
+ * xxHash: a fast non-cryptographic hash, used through the bundled library.
+ * Values are stored in xxHash's canonical (big endian) byte order.
+ **/
+class XXHash : public HashFunction
+{
+private:
+
+	class State32 : public State
+	{
+	public:
+
+		State32() : state(XXH32_createState()) { XXH32_reset(state, 0); }
+		~State32() { XXH32_freeState(state); }
+
+		void update(const char *input, uint64 length) override
+		{
+			XXH32_update(state, input, (size_t) length);
+		}
+
+		void digest(Value &output) const override
+		{
+			XXH32_canonicalFromHash((XXH32_canonical_t *) output.data, XXH32_digest(state));
+			output.size = sizeof(XXH32_canonical_t);
+		}
+
+		void reset() override
+		{
+			XXH32_reset(state, 0);
+		}
+
+	private:
+
+		XXH32_state_t *state;
+	};
+
+	class State64 : public State
+	{
+	public:
+
+		State64() : state(XXH64_createState()) { XXH64_reset(state, 0); }
+		~State64() { XXH64_freeState(state); }
+
+		void update(const char *input, uint64 length) override
+		{
+			XXH64_update(state, input, (size_t) length);
+		}
+
+		void digest(Value &output) const override
+		{
+			XXH64_canonicalFromHash((XXH64_canonical_t *) output.data, XXH64_digest(state));
+			output.size = sizeof(XXH64_canonical_t);
+		}
+
+		void reset() override
+		{
+			XXH64_reset(state, 0);
+		}
+
+	private:
+
+		XXH64_state_t *state;
+	};
+
+public:
+
+	bool isSupported(Function function) const override
+	{
+		return function == FUNCTION_XXH32 || function == FUNCTION_XXH64;
+	}
+
+	void hash(Function function, const char *input, uint64 length, Value &output) const override
+	{
+		if (function == FUNCTION_XXH32)
+		{
+			XXH32_canonicalFromHash((XXH32_canonical_t *) output.data, XXH32(input, (size_t) length, 0));
+			output.size = sizeof(XXH32_canonical_t);
+		}
+		else if (function == FUNCTION_XXH64)
+		{
+			XXH64_canonicalFromHash((XXH64_canonical_t *) output.data, XXH64(input, (size_t) length, 0));
+			output.size = sizeof(XXH64_canonical_t);
+		}
+		else
+			throw love::Exception("Hash function not supported by xxHash implementation");
+	}
+
+	State *newState(Function function) const override
+	{
+		if (function == FUNCTION_XXH32)
+			return new State32();
+		else if (function == FUNCTION_XXH64)
+			return new State64();
+		return nullptr;
+	}
+
+} xxhash;
+
+/**
+ * CRC-32C (Castagnoli), as used by iSCSI, ext4 and others. Uses the SSE 4.2
+ * crc32 instruction when the compiler targets it, and slicing-by-8 tables
+ * otherwise. The value is stored in big endian byte order.
+ **/
+class CRC32C : public HashFunction
+{
+private:
+
+	class CRCState : public State
+	{
+	public:
+
+		CRCState(const CRC32C *owner) : owner(owner), crc(0) {}
+
+		void update(const char *input, uint64 length) override
+		{
+			crc = owner->update(crc, (const uint8 *) input, length);
+		}
+
+		void digest(Value &output) const override
+		{
+			owner->toValue(crc, output);
+		}
+
+		void reset() override
+		{
+			crc = 0;
+		}
+
+	private:
+
+		const CRC32C *owner;
+		uint32 crc;
+	};
+
+	uint32 tables[8][256];
+
+public:
+
+	CRC32C()
+	{
+		for (uint32 i = 0; i < 256; i++)
+		{
+			uint32 crc = i;
+			for (int j = 0; j < 8; j++)
+				crc = (crc >> 1) ^ (0x82F63B78 & (0 - (crc & 1)));
+			tables[0][i] = crc;
+		}
+
+		for (uint32 i = 0; i < 256; i++)
+		{
+			for (int t = 1; t < 8; t++)
+				tables[t][i] = (tables[t - 1][i] >> 8) ^ tables[0][tables[t - 1][i] & 0xFF];
+		}
+	}
+
+	// Continues a CRC from its previous (finalized) value.
+	uint32 update(uint32 crc, const uint8 *input, uint64 length) const
+	{
+		crc = ~crc;
+
+#ifdef LOVE_CRC32C_SSE42
+		while (length >= 8)
+		{
+			uint64 word;
+			memcpy(&word, input, sizeof(word));
+			crc = (uint32) _mm_crc32_u64(crc, word);
+			input += 8;
+			length -= 8;
+		}
+
+		while (length > 0)
+		{
+			crc = _mm_crc32_u8(crc, *input++);
+			length--;
+		}
+#else
+		while (length >= 8)
+		{
+			uint32 lo, hi;
+			memcpy(&lo, input, sizeof(lo));
+			memcpy(&hi, input + 4, sizeof(hi));
+			lo ^= crc;
+
+			crc = tables[7][lo & 0xFF] ^ tables[6][(lo >> 8) & 0xFF]
+				^ tables[5][(lo >> 16) & 0xFF] ^ tables[4][lo >> 24]
+				^ tables[3][hi & 0xFF] ^ tables[2][(hi >> 8) & 0xFF]
+				^ tables[1][(hi >> 16) & 0xFF] ^ tables[0][hi >> 24];
+
+			input += 8;
+			length -= 8;
+		}
+
+		while (length > 0)
+		{
+			crc = (crc >> 8) ^ tables[0][(crc ^ *input++) & 0xFF];
+			length--;
+		}
+#endif
+
+		return ~crc;
+	}
+
+	void toValue(uint32 crc, Value &output) const
+	{
+		for (int i = 0; i < 4; i++)
+			output.data[i] = (char) ((crc >> (24 - i * 8)) & 0xFF);
+		output.size = 4;
+	}
+
+	bool isSupported(Function function) const override
+	{
+		return function == FUNCTION_CRC32C;
+	}
+
+	void hash(Function function, const char *input, uint64 length, Value &output) const override
+	{
+		if (function != FUNCTION_CRC32C)
+			throw love::Exception("Hash function not supported by CRC-32C implementation");
+
+		toValue(update(0, (const uint8 *) input, length), output);
+	}
+
+	State *newState(Function function) const override
+	{
+		if (function != FUNCTION_CRC32C)
+			return nullptr;
+		return new CRCState(this);
+	}
+
+} crc32c;
+
 } // impl
 }
 
@@ -603,6 +841,11 @@ HashFunction *HashFunction::getHashFunction(Function function)
 	case FUNCTION_SHA384:
 	case FUNCTION_SHA512:
 		return &impl::sha512;
+	case FUNCTION_XXH32:
+	case FUNCTION_XXH64:
+		return &impl::xxhash;
+	case FUNCTION_CRC32C:
+		return &impl::crc32c;
 	case FUNCTION_MAX_ENUM:
 		return nullptr;
 	// No default for compiler warnings
@@ -632,6 +875,9 @@ StringMap<HashFunction::Function, HashFunction::FUNCTION_MAX_ENUM>::Entry HashFu
 	{"sha256", FUNCTION_SHA256},
 	{"sha384", FUNCTION_SHA384},
 	{"sha512", FUNCTION_SHA512},
+	{"xxh32", FUNCTION_XXH32},
+	{"xxh64", FUNCTION_XXH64},
+	{"crc32c", FUNCTION_CRC32C},
 };
 
 StringMap<HashFunction::Function, HashFunction::FUNCTION_MAX_ENUM> HashFunction::functionNames(HashFunction::functionEntries, sizeof(HashFunction::functionEntries));
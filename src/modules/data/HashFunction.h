@@ -42,6 +42,9 @@ class HashFunction
 		FUNCTION_SHA256,
 		FUNCTION_SHA384,
 		FUNCTION_SHA512,
+		FUNCTION_XXH32,
+		FUNCTION_XXH64,
+		FUNCTION_CRC32C,
 		FUNCTION_MAX_ENUM
 	};
 
@@ -51,6 +54,24 @@ class HashFunction
 		size_t size;
 	};
 
+	/**
+	 * The running state of an incremental hash, for functions which support
+	 * hashing their input in pieces.
+	 **/
+	class State
+	{
+	public:
+
+		virtual ~State() {}
+
+		virtual void update(const char *input, uint64 length) = 0;
+
+		// Gets the hash of all input so far. More input can still be added.
+		virtual void digest(Value &output) const = 0;
+
+		virtual void reset() = 0;
+	};
+
 	/**
 	 * Get a HashFunction instance for the given function.
 	 *
@@ -72,6 +93,15 @@ class HashFunction
 	 **/
 	virtual void hash(Function function, const char *input, uint64 length, Value &output) const = 0;
 
+	/**
+	 * Creates the state for hashing input incrementally.
+	 *
+	 * @param[in] function The selected hash function.
+	 * @return A new State (allocated with new), or NULL if this HashFunction
+	 *         can't hash the given function incrementally.
+	 **/
+	virtual State *newState(Function /*function*/) const { return nullptr; }
+
 	/**
 	 * @param[in] function The requested hash function.
 	 * @return Whether this HashFunction instance implements the given function.
@@ -0,0 +1,125 @@
+/**
+ * Copyright (c) 2006-2024 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+// LOVE
+#include "wrap_CompressionStream.h"
+#include "wrap_Data.h"
+
+namespace love
+{
+namespace data
+{
+
+CompressionStream *luax_checkcompressionstream(lua_State *L, int idx)
+{
+	return luax_checktype<CompressionStream>(L, idx);
+}
+
+// Returns the output produced so far as a string, unless it's being written to
+// an output Stream.
+static int pushOutput(lua_State *L, CompressionStream *s)
+{
+	if (s->getOutput() != nullptr)
+		return 0;
+
+	std::vector<char> out;
+	s->takeOutput(out);
+	lua_pushlstring(L, out.data(), out.size());
+	return 1;
+}
+
+int w_CompressionStream_feed(lua_State *L)
+{
+	CompressionStream *s = luax_checkcompressionstream(L, 1);
+
+	size_t size = 0;
+	const char *bytes = nullptr;
+
+	if (lua_isstring(L, 2))
+		bytes = luaL_checklstring(L, 2, &size);
+	else
+	{
+		Data *data = luax_checkdata(L, 2);
+		bytes = (const char *) data->getData();
+		size = data->getSize();
+	}
+
+	luax_catchexcept(L, [&](){ s->feed(bytes, size); });
+	return pushOutput(L, s);
+}
+
+int w_CompressionStream_flush(lua_State *L)
+{
+	CompressionStream *s = luax_checkcompressionstream(L, 1);
+	luax_catchexcept(L, [&](){ s->flush(); });
+	return pushOutput(L, s);
+}
+
+int w_CompressionStream_finish(lua_State *L)
+{
+	CompressionStream *s = luax_checkcompressionstream(L, 1);
+	luax_catchexcept(L, [&](){ s->finish(); });
+	return pushOutput(L, s);
+}
+
+int w_CompressionStream_isFinished(lua_State *L)
+{
+	CompressionStream *s = luax_checkcompressionstream(L, 1);
+	luax_pushboolean(L, s->isFinished());
+	return 1;
+}
+
+int w_CompressionStream_isCompressing(lua_State *L)
+{
+	CompressionStream *s = luax_checkcompressionstream(L, 1);
+	luax_pushboolean(L, s->getMode() == CompressionStream::MODE_COMPRESS);
+	return 1;
+}
+
+int w_CompressionStream_getFormat(lua_State *L)
+{
+	CompressionStream *s = luax_checkcompressionstream(L, 1);
+
+	const char *fname = nullptr;
+	if (!Compressor::getConstant(s->getFormat(), fname))
+		return luax_enumerror(L, "compressed data format", Compressor::getConstants(Compressor::FORMAT_MAX_ENUM), fname);
+
+	lua_pushstring(L, fname);
+	return 1;
+}
+
+static const luaL_Reg w_CompressionStream_functions[] =
+{
+	{ "feed", w_CompressionStream_feed },
+	{ "flush", w_CompressionStream_flush },
+	{ "finish", w_CompressionStream_finish },
+	{ "isFinished", w_CompressionStream_isFinished },
+	{ "isCompressing", w_CompressionStream_isCompressing },
+	{ "getFormat", w_CompressionStream_getFormat },
+	{ 0, 0 },
+};
+
+extern "C" int luaopen_compressionstream(lua_State *L)
+{
+	return luax_register_type(L, &CompressionStream::type, w_CompressionStream_functions, nullptr);
+}
+
+} // data
+} // love
@@ -24,6 +24,8 @@
 #include "wrap_ByteData.h"
 #include "wrap_DataView.h"
 #include "wrap_CompressedData.h"
+#include "wrap_CompressionStream.h"
+#include "wrap_Hasher.h"
 #include "DataModule.h"
 #include "common/b64.h"
 
@@ -52,6 +54,21 @@ ContainerType luax_checkcontainertype(lua_State *L, int idx)
 	return ctype;
 }
 
+void luax_pushhashvalue(lua_State *L, ContainerType ctype, const HashFunction::Value &value)
+{
+	if (ctype == CONTAINER_DATA)
+	{
+		Data* d = nullptr;
+		luax_catchexcept(L, [&]() { d = instance()->newByteData(value.size); });
+		memcpy(d->getData(), value.data, value.size);
+
+		luax_pushtype(L, Data::type, d);
+		d->release();
+	}
+	else
+		lua_pushlstring(L, value.data, value.size);
+}
+
 int w_newDataView(lua_State *L)
 {
 	Data *data = luax_checkdata(L, 1);
@@ -88,7 +105,7 @@ int w_newByteData(lua_State *L)
 		lua_Integer size = luaL_optinteger(L, 3, data->getSize() - offset);
 		if (size <= 0)
 			return luaL_error(L, "Size argument must be greater than zero.");
-		else if ((size_t)(offset + size) > data->getSize())
+		else if ((size_t) offset > data->getSize() || (size_t) size > data->getSize() - (size_t) offset)
 			return luaL_error(L, "Offset and size arguments must fit within the given Data's size.");
 
 		const char *bytes = (const char *) data->getData() + offset;
@@ -200,6 +217,61 @@ int w_decompress(lua_State *L)
 	return 1;
 }
 
+static int newCompressionStream(lua_State *L, CompressionStream::Mode mode)
+{
+	const char *fstr = luaL_checkstring(L, 1);
+	Compressor::Format format = Compressor::FORMAT_LZ4_FRAME;
+
+	if (!Compressor::getConstant(fstr, format))
+		return luax_enumerror(L, "compressed data format", Compressor::getConstants(format), fstr);
+
+	CompressionStream::Settings settings;
+	Stream *output = nullptr;
+
+	if (!lua_isnoneornil(L, 2))
+	{
+		luaL_checktype(L, 2, LUA_TTABLE);
+
+		settings.level = luax_intflag(L, 2, "level", settings.level);
+		settings.threads = std::max(luax_intflag(L, 2, "threads", settings.threads), 0);
+		settings.blockSize = (size_t) std::max(luax_intflag(L, 2, "blocksize", 0), 0);
+
+		lua_getfield(L, 2, "output");
+		if (!lua_isnoneornil(L, -1))
+			output = luax_checktype<Stream>(L, -1);
+		lua_pop(L, 1);
+	}
+
+	CompressionStream *stream = nullptr;
+	luax_catchexcept(L, [&]()
+	{
+		stream = CompressionStream::create(mode, format, settings);
+		try
+		{
+			stream->setOutput(output);
+		}
+		catch (love::Exception &)
+		{
+			stream->release();
+			throw;
+		}
+	});
+
+	luax_pushtype(L, stream);
+	stream->release();
+	return 1;
+}
+
+int w_newCompressionStream(lua_State *L)
+{
+	return newCompressionStream(L, CompressionStream::MODE_COMPRESS);
+}
+
+int w_newDecompressionStream(lua_State *L)
+{
+	return newCompressionStream(L, CompressionStream::MODE_DECOMPRESS);
+}
+
 int w_encode(lua_State *L)
 {
 	ContainerType ctype = luax_checkcontainertype(L, 1);
@@ -336,18 +408,92 @@ int w_hash(lua_State *L)
 		luax_catchexcept(L, [&](){ love::data::hash(function, rawdata, hashvalue); });
 	}
 
-	if (ctype == CONTAINER_DATA)
+	luax_pushhashvalue(L, ctype, hashvalue);
+	return 1;
+}
+
+int w_hashBatch(lua_State *L)
+{
+	ContainerType ctype = luax_checkcontainertype(L, 1);
+
+	HashFunction::Function function;
+	const char *fstr = luaL_checkstring(L, 2);
+	if (!HashFunction::getConstant(fstr, function))
+		return luax_enumerror(L, "hash function", HashFunction::getConstants(function), fstr);
+
+	luaL_checktype(L, 3, LUA_TTABLE);
+	int count = (int) luax_objlen(L, 3);
+
+	// The inputs stay referenced by the table while they're hashed, so their
+	// memory can be used directly.
+	std::vector<HashInput> inputs(count);
+
+	for (int i = 0; i < count; i++)
 	{
-		Data* d = nullptr;
-		luax_catchexcept(L, [&]() { d = instance()->newByteData(hashvalue.size); });
-		memcpy(d->getData(), hashvalue.data, hashvalue.size);
+		lua_rawgeti(L, 3, i + 1);
 
-		luax_pushtype(L, Data::type, d);
-		d->release();
+		if (lua_type(L, -1) == LUA_TSTRING)
+		{
+			size_t size = 0;
+			inputs[i].data = lua_tolstring(L, -1, &size);
+			inputs[i].size = size;
+		}
+		else if (lua_istable(L, -1))
+		{
+			// { data, offset, size } slice of a Data object.
+			lua_rawgeti(L, -1, 1);
+			Data *data = luax_checktype<Data>(L, -1);
+			lua_pop(L, 1);
+
+			lua_rawgeti(L, -1, 2);
+			lua_Integer offset = luaL_optinteger(L, -1, 0);
+			lua_pop(L, 1);
+
+			lua_rawgeti(L, -1, 3);
+			lua_Integer size = luaL_optinteger(L, -1, (lua_Integer) data->getSize() - offset);
+			lua_pop(L, 1);
+
+			if (offset < 0 || size < 0 || (size_t) offset > data->getSize() || (size_t) size > data->getSize() - (size_t) offset)
+				return luaL_error(L, "The offset and size of input %d must fit within its Data's size.", i + 1);
+
+			inputs[i].data = (const char *) data->getData() + offset;
+			inputs[i].size = (uint64_t) size;
+		}
+		else
+		{
+			Data *data = luax_checktype<Data>(L, -1);
+			inputs[i].data = (const char *) data->getData();
+			inputs[i].size = data->getSize();
+		}
+
+		lua_pop(L, 1);
 	}
-	else
-		lua_pushlstring(L, hashvalue.data, hashvalue.size);
 
+	std::vector<HashFunction::Value> outputs;
+	luax_catchexcept(L, [&](){ hash(function, inputs, outputs); });
+
+	lua_createtable(L, count, 0);
+	for (int i = 0; i < count; i++)
+	{
+		luax_pushhashvalue(L, ctype, outputs[i]);
+		lua_rawseti(L, -2, i + 1);
+	}
+
+	return 1;
+}
+
+int w_newHasher(lua_State *L)
+{
+	HashFunction::Function function;
+	const char *fstr = luaL_checkstring(L, 1);
+	if (!HashFunction::getConstant(fstr, function))
+		return luax_enumerror(L, "hash function", HashFunction::getConstants(function), fstr);
+
+	Hasher *hasher = nullptr;
+	luax_catchexcept(L, [&](){ hasher = instance()->newHasher(function); });
+
+	luax_pushtype(L, hasher);
+	hasher->release();
 	return 1;
 }
 
@@ -422,9 +568,13 @@ static const luaL_Reg functions[] =
 	{ "newByteData", w_newByteData },
 	{ "compress", w_compress },
 	{ "decompress", w_decompress },
+	{ "newCompressionStream", w_newCompressionStream },
+	{ "newDecompressionStream", w_newDecompressionStream },
 	{ "encode", w_encode },
 	{ "decode", w_decode },
 	{ "hash", w_hash },
+	{ "hashBatch", w_hashBatch },
+	{ "newHasher", w_newHasher },
 
 	{ "pack", w_pack },
 	{ "unpack", w_unpack },
@@ -439,6 +589,8 @@ static const lua_CFunction types[] =
 	luaopen_bytedata,
 	luaopen_dataview,
 	luaopen_compresseddata,
+	luaopen_compressionstream,
+	luaopen_hasher,
 	nullptr
 };
 
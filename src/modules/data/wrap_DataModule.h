@@ -31,8 +31,11 @@ namespace data
 {
 
 ContainerType luax_checkcontainertype(lua_State *L, int idx);
+void luax_pushhashvalue(lua_State *L, ContainerType ctype, const HashFunction::Value &value);
 int w_compress(lua_State *L);
 int w_decompress(lua_State *L);
+int w_newCompressionStream(lua_State *L);
+int w_newDecompressionStream(lua_State *L);
 extern "C" LOVE_EXPORT int luaopen_love_data(lua_State *L);
 
 } // data
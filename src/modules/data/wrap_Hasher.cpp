@@ -0,0 +1,103 @@
+/**
+ * Copyright (c) 2006-2024 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+// LOVE
+#include "wrap_Hasher.h"
+#include "wrap_Data.h"
+#include "wrap_DataModule.h"
+
+namespace love
+{
+namespace data
+{
+
+Hasher *luax_checkhasher(lua_State *L, int idx)
+{
+	return luax_checktype<Hasher>(L, idx);
+}
+
+int w_Hasher_update(lua_State *L)
+{
+	Hasher *h = luax_checkhasher(L, 1);
+
+	if (lua_isstring(L, 2))
+	{
+		size_t size = 0;
+		const char *bytes = luaL_checklstring(L, 2, &size);
+		h->update(bytes, size);
+	}
+	else
+	{
+		Data *data = luax_checkdata(L, 2);
+		h->update(data->getData(), data->getSize());
+	}
+
+	return 0;
+}
+
+int w_Hasher_digest(lua_State *L)
+{
+	Hasher *h = luax_checkhasher(L, 1);
+	ContainerType ctype = CONTAINER_STRING;
+	if (!lua_isnoneornil(L, 2))
+		ctype = luax_checkcontainertype(L, 2);
+
+	HashFunction::Value value;
+	h->digest(value);
+
+	luax_pushhashvalue(L, ctype, value);
+	return 1;
+}
+
+int w_Hasher_reset(lua_State *L)
+{
+	Hasher *h = luax_checkhasher(L, 1);
+	h->reset();
+	return 0;
+}
+
+int w_Hasher_getFunction(lua_State *L)
+{
+	Hasher *h = luax_checkhasher(L, 1);
+
+	const char *fname = nullptr;
+	if (!HashFunction::getConstant(h->getFunction(), fname))
+		return luax_enumerror(L, "hash function", HashFunction::getConstants(HashFunction::FUNCTION_MAX_ENUM), fname);
+
+	lua_pushstring(L, fname);
+	return 1;
+}
+
+static const luaL_Reg w_Hasher_functions[] =
+{
+	{ "update", w_Hasher_update },
+	{ "digest", w_Hasher_digest },
+	{ "reset", w_Hasher_reset },
+	{ "getFunction", w_Hasher_getFunction },
+	{ 0, 0 },
+};
+
+extern "C" int luaopen_hasher(lua_State *L)
+{
+	return luax_register_type(L, &Hasher::type, w_Hasher_functions, nullptr);
+}
+
+} // data
+} // love
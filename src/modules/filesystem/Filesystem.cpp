@@ -48,8 +48,12 @@ namespace filesystem
 
 love::Type Filesystem::type("filesystem", &Module::type);
 
+const char *Filesystem::BYTECODE_CACHE_DIRECTORY = ".bytecodecache";
+
 Filesystem::Filesystem(const char *name)
 	: Module(M_FILESYSTEM, name)
+	, useExternal(false)
+	, bytecodeCacheEnabled(false)
 {
 }
 
@@ -57,6 +61,16 @@ Filesystem::~Filesystem()
 {
 }
 
+void Filesystem::setBytecodeCacheEnabled(bool enable)
+{
+	bytecodeCacheEnabled = enable;
+}
+
+bool Filesystem::isBytecodeCacheEnabled() const
+{
+	return bytecodeCacheEnabled;
+}
+
 void Filesystem::setAndroidSaveExternal(bool useExternal)
 {	
 	this->useExternal = useExternal;
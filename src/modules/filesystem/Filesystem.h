@@ -283,6 +283,29 @@ class Filesystem : public Module
 	 **/
 	virtual bool areSymlinksEnabled() const = 0;
 
+	/**
+	 * Enable or disable the in-memory index of all paths in the search path.
+	 * When enabled, getInfo, exists, getRealDirectory and getDirectoryItems
+	 * are answered from the index, which is rebuilt when the search path
+	 * changes. Changes made to mounted directories outside of love.filesystem
+	 * aren't seen while it's enabled.
+	 **/
+	virtual void setPathIndexEnabled(bool enable) = 0;
+
+	/**
+	 * Gets whether the path index is enabled.
+	 **/
+	virtual bool isPathIndexEnabled() const = 0;
+
+	/**
+	 * Enable or disable caching of compiled Lua chunks loaded through
+	 * love.filesystem.load and require. Cached bytecode is written to
+	 * BYTECODE_CACHE_DIRECTORY in the save directory, and is also looked up in
+	 * the game's own files so a prebuilt cache can be shipped with a game.
+	 **/
+	void setBytecodeCacheEnabled(bool enable);
+	bool isBytecodeCacheEnabled() const;
+
 	// Require path accessors
 	// Not const because it's R/W
 	virtual std::vector<std::string> &getRequirePath() = 0;
@@ -319,6 +342,8 @@ class Filesystem : public Module
 	STRINGMAP_CLASS_DECLARE(MountPermissions);
 	STRINGMAP_CLASS_DECLARE(LoadMode);
 
+	static const char *BYTECODE_CACHE_DIRECTORY;
+
 protected:
 
 	Filesystem(const char *name);
@@ -330,6 +355,8 @@ class Filesystem : public Module
 	// Should we save external or internal for Android
 	bool useExternal;
 
+	bool bytecodeCacheEnabled;
+
 }; // Filesystem
 
 } // filesystem
@@ -45,6 +45,13 @@ static bool setupWriteDirectory()
 	return fs != nullptr && fs->setupWriteDirectory();
 }
 
+static void updatePathIndex(const std::string &filename)
+{
+	auto fs = Module::getInstance<Filesystem>(Module::M_FILESYSTEM);
+	if (fs != nullptr)
+		fs->updatePathIndex(filename.c_str());
+}
+
 File::File(const std::string &filename, Mode mode)
 	: filename(filename)
 	, file(nullptr)
@@ -145,6 +152,9 @@ bool File::open(Mode mode)
 
 	this->mode = mode;
 
+	if (mode == MODE_APPEND || mode == MODE_WRITE)
+		updatePathIndex(filename);
+
 	if (file != nullptr && !setBuffer(bufferMode, bufferSize))
 	{
 		// Revert to buffer defaults if we don't successfully set the buffer.
@@ -160,9 +170,15 @@ bool File::close()
 	if (file == nullptr || !PHYSFS_close(file))
 		return false;
 
+	bool written = mode == MODE_APPEND || mode == MODE_WRITE;
+
 	mode = MODE_CLOSED;
 	file = nullptr;
 
+	// The size and modification time only settle once the file is closed.
+	if (written)
+		updatePathIndex(filename);
+
 	return true;
 }
 
@@ -106,6 +106,76 @@ static bool isAppCommonPath(Filesystem::CommonPath path)
 	}
 }
 
+static bool statPath(const char *filepath, Filesystem::Info &info)
+{
+	PHYSFS_Stat stat = {};
+	if (!PHYSFS_stat(filepath, &stat))
+		return false;
+
+	info.size = (int64) stat.filesize;
+	info.modtime = (int64) stat.modtime;
+	info.readonly = stat.readonly != 0;
+
+	if (stat.filetype == PHYSFS_FILETYPE_REGULAR)
+		info.type = Filesystem::FILETYPE_FILE;
+	else if (stat.filetype == PHYSFS_FILETYPE_DIRECTORY)
+		info.type = Filesystem::FILETYPE_DIRECTORY;
+	else if (stat.filetype == PHYSFS_FILETYPE_SYMLINK)
+		info.type = Filesystem::FILETYPE_SYMLINK;
+	else
+		info.type = Filesystem::FILETYPE_OTHER;
+
+	return true;
+}
+
+// Converts a path to the form used as a key in the path index, the same way
+// PhysFS sanitizes it. Returns false for paths PhysFS would reject, which are
+// then left to PhysFS to report.
+static bool getPathIndexKey(const char *path, std::string &key)
+{
+	key.clear();
+
+	const char *p = path;
+	while (*p != '\0')
+	{
+		while (*p == '/')
+			p++;
+
+		const char *start = p;
+		while (*p != '\0' && *p != '/')
+		{
+			if (*p == ':' || *p == '\\')
+				return false;
+			p++;
+		}
+
+		size_t len = p - start;
+		if (len == 0)
+			break;
+
+		if ((len == 1 && start[0] == '.') || (len == 2 && start[0] == '.' && start[1] == '.'))
+			return false;
+
+		if (!key.empty())
+			key += '/';
+		key.append(start, len);
+	}
+
+	return true;
+}
+
+static std::string getParentPath(const std::string &path)
+{
+	size_t pos = path.rfind('/');
+	return pos == std::string::npos ? std::string() : path.substr(0, pos);
+}
+
+static std::string getBaseName(const std::string &path)
+{
+	size_t pos = path.rfind('/');
+	return pos == std::string::npos ? path : path.substr(pos + 1);
+}
+
 Filesystem::Filesystem()
 	: love::filesystem::Filesystem("love.filesystem.physfs")
 	, appendIdentityToPath(false)
@@ -114,6 +184,8 @@ Filesystem::Filesystem()
 	, fullPaths()
 	, commonPathMountInfo()
 	, saveDirectoryNeedsMounting(false)
+	, pathIndexEnabled(false)
+	, pathIndexValid(false)
 {
 	requirePath = {"?.lua", "?/init.lua"};
 	cRequirePath = {"??"};
@@ -162,6 +234,8 @@ bool Filesystem::setIdentity(const char *ident, bool appendToPath)
 	if (!PHYSFS_isInit())
 		return false;
 
+	invalidatePathIndex();
+
 	if (ident == nullptr || strlen(ident) == 0)
 		return false;
 
@@ -242,6 +316,8 @@ bool Filesystem::setSource(const char *source)
 	if (!gameSource.empty())
 		return false;
 
+	invalidatePathIndex();
+
 	std::string new_search_path = canonicalizeRealPath(source);
 
 #ifdef LOVE_ANDROID
@@ -349,6 +425,7 @@ bool Filesystem::setupWriteDirectory()
 		return false;
 
 	saveDirectoryNeedsMounting = false;
+	invalidatePathIndex();
 	return true;
 }
 
@@ -402,6 +479,8 @@ bool Filesystem::mountFullPath(const char *archive, const char *mountpoint, Moun
 
 	std::string canonarchive = canonicalizeRealPath(archive);
 
+	invalidatePathIndex();
+
 	if (permissions == MOUNT_PERMISSIONS_READWRITE)
 		return PHYSFS_mountRW(canonarchive.c_str(), mountpoint, appendToPath) != 0;
 
@@ -440,6 +519,8 @@ bool Filesystem::mount(Data *data, const char *archivename, const char *mountpoi
 	if (!PHYSFS_isInit())
 		return false;
 
+	invalidatePathIndex();
+
 	if (PHYSFS_mountMemory(data->getData(), data->getSize(), nullptr, archivename, mountpoint, appendToPath) != 0)
 	{
 		mountedData[archivename] = data;
@@ -454,6 +535,8 @@ bool Filesystem::unmount(const char *archive)
 	if (!PHYSFS_isInit() || !archive)
 		return false;
 
+	invalidatePathIndex();
+
 	auto datait = mountedData.find(archive);
 
 	if (datait != mountedData.end() && PHYSFS_unmount(archive) != 0)
@@ -496,6 +579,8 @@ bool Filesystem::unmountFullPath(const char *fullpath)
 
 	std::string canonpath = canonicalizeRealPath(fullpath);
 
+	invalidatePathIndex();
+
 	return PHYSFS_unmount(canonpath.c_str()) != 0;
 }
 
@@ -760,6 +845,19 @@ std::string Filesystem::getRealDirectory(const char *filename) const
 	if (!PHYSFS_isInit())
 		throw love::Exception("PhysFS is not initialized.");
 
+	if (pathIndexEnabled)
+	{
+		thread::Lock lock(pathIndexMutex);
+
+		const PathIndexEntry *entry = nullptr;
+		PathIndexResult result = findInPathIndex(filename, entry);
+
+		if (result == PATHINDEX_FOUND && entry->realDirectory >= 0)
+			return pathIndexRealDirs[entry->realDirectory];
+		else if (result == PATHINDEX_MISSING)
+			throw love::Exception("File does not exist on disk.");
+	}
+
 	const char *dir = PHYSFS_getRealDir(filename);
 
 	if (dir == nullptr)
@@ -773,6 +871,17 @@ bool Filesystem::exists(const char *filepath) const
 	if (!PHYSFS_isInit())
 		return false;
 
+	if (pathIndexEnabled)
+	{
+		thread::Lock lock(pathIndexMutex);
+
+		const PathIndexEntry *entry = nullptr;
+		PathIndexResult result = findInPathIndex(filepath, entry);
+
+		if (result != PATHINDEX_UNKNOWN)
+			return result == PATHINDEX_FOUND;
+	}
+
 	return PHYSFS_exists(filepath) != 0;
 }
 
@@ -781,24 +890,23 @@ bool Filesystem::getInfo(const char *filepath, Info &info) const
 	if (!PHYSFS_isInit())
 		return false;
 
-	PHYSFS_Stat stat = {};
-	if (!PHYSFS_stat(filepath, &stat))
-		return false;
+	if (pathIndexEnabled)
+	{
+		thread::Lock lock(pathIndexMutex);
 
-	info.size = (int64) stat.filesize;
-	info.modtime = (int64) stat.modtime;
-	info.readonly = stat.readonly != 0;
+		const PathIndexEntry *entry = nullptr;
+		PathIndexResult result = findInPathIndex(filepath, entry);
 
-	if (stat.filetype == PHYSFS_FILETYPE_REGULAR)
-		info.type = FILETYPE_FILE;
-	else if (stat.filetype == PHYSFS_FILETYPE_DIRECTORY)
-		info.type = FILETYPE_DIRECTORY;
-	else if (stat.filetype == PHYSFS_FILETYPE_SYMLINK)
-		info.type = FILETYPE_SYMLINK;
-	else
-		info.type = FILETYPE_OTHER;
+		if (result == PATHINDEX_FOUND)
+		{
+			info = entry->info;
+			return true;
+		}
+		else if (result == PATHINDEX_MISSING)
+			return false;
+	}
 
-	return true;
+	return statPath(filepath, info);
 }
 
 bool Filesystem::createDirectory(const char *dir)
@@ -812,6 +920,8 @@ bool Filesystem::createDirectory(const char *dir)
 	if (!PHYSFS_mkdir(dir))
 		return false;
 
+	updatePathIndex(dir);
+
 #ifdef LOVE_ANDROID
 	// In Android with t.externalstorage = true, make sure the directory
     // created in the save directory has permissions of ugo+rwx (0777) so that
@@ -836,6 +946,8 @@ bool Filesystem::remove(const char *file)
 	if (!PHYSFS_delete(file))
 		return false;
 
+	updatePathIndex(file);
+
 	return true;
 }
 
@@ -878,6 +990,18 @@ bool Filesystem::getDirectoryItems(const char *dir, std::vector<std::string> &it
 	if (!PHYSFS_isInit())
 		return false;
 
+	if (pathIndexEnabled)
+	{
+		thread::Lock lock(pathIndexMutex);
+
+		const PathIndexEntry *entry = nullptr;
+		if (findInPathIndex(dir, entry) == PATHINDEX_FOUND && entry->info.type == FILETYPE_DIRECTORY)
+		{
+			items.insert(items.end(), entry->items.begin(), entry->items.end());
+			return true;
+		}
+	}
+
 	char **rc = PHYSFS_enumerateFiles(dir);
 
 	if (rc == nullptr)
@@ -896,6 +1020,7 @@ void Filesystem::setSymlinksEnabled(bool enable)
 		return;
 
 	PHYSFS_permitSymbolicLinks(enable ? 1 : 0);
+	invalidatePathIndex();
 }
 
 bool Filesystem::areSymlinksEnabled() const
@@ -906,6 +1031,187 @@ bool Filesystem::areSymlinksEnabled() const
 	return PHYSFS_symbolicLinksPermitted() != 0;
 }
 
+void Filesystem::setPathIndexEnabled(bool enable)
+{
+	thread::Lock lock(pathIndexMutex);
+
+	pathIndexEnabled = enable;
+	pathIndexValid = false;
+	pathIndex.clear();
+	pathIndexRealDirs.clear();
+}
+
+bool Filesystem::isPathIndexEnabled() const
+{
+	return pathIndexEnabled;
+}
+
+void Filesystem::invalidatePathIndex()
+{
+	thread::Lock lock(pathIndexMutex);
+
+	pathIndexValid = false;
+	pathIndex.clear();
+	pathIndexRealDirs.clear();
+}
+
+void Filesystem::updatePathIndex(const char *path)
+{
+	thread::Lock lock(pathIndexMutex);
+
+	// A stale index is rebuilt from scratch on the next query anyway.
+	if (!pathIndexValid)
+		return;
+
+	std::string key;
+	if (!getPathIndexKey(path, key) || key.empty())
+	{
+		pathIndexValid = false;
+		pathIndex.clear();
+		pathIndexRealDirs.clear();
+		return;
+	}
+
+	if (!indexPath(key))
+		removeFromPathIndex(key);
+}
+
+Filesystem::PathIndexResult Filesystem::findInPathIndex(const char *path, const PathIndexEntry *&entry) const
+{
+	std::string key;
+	if (!getPathIndexKey(path, key))
+		return PATHINDEX_UNKNOWN;
+
+	if (!pathIndexValid)
+		buildPathIndex();
+
+	return lookupPathIndex(key, entry);
+}
+
+Filesystem::PathIndexResult Filesystem::lookupPathIndex(const std::string &key, const PathIndexEntry *&entry) const
+{
+	auto it = pathIndex.find(key);
+	if (it != pathIndex.end())
+	{
+		entry = &it->second;
+		return PATHINDEX_FOUND;
+	}
+
+	if (key.empty())
+		return PATHINDEX_UNKNOWN;
+
+	// Anything inside a fully indexed directory that isn't in the index
+	// doesn't exist. Symlinked directories aren't descended into, so paths
+	// inside them are left to PhysFS.
+	const PathIndexEntry *parent = nullptr;
+	PathIndexResult result = lookupPathIndex(getParentPath(key), parent);
+
+	if (result == PATHINDEX_FOUND)
+		return parent->info.type == FILETYPE_SYMLINK ? PATHINDEX_UNKNOWN : PATHINDEX_MISSING;
+
+	return result;
+}
+
+void Filesystem::buildPathIndex() const
+{
+	pathIndex.clear();
+	pathIndexRealDirs.clear();
+
+	PathIndexEntry &root = pathIndex[""];
+	root.realDirectory = -1;
+	if (!statPath("", root.info))
+		root.info.type = FILETYPE_DIRECTORY;
+
+	indexDirectory("");
+	pathIndexValid = true;
+}
+
+void Filesystem::indexDirectory(const std::string &dir) const
+{
+	char **rc = PHYSFS_enumerateFiles(dir.c_str());
+	if (rc == nullptr)
+		return;
+
+	std::vector<std::string> items;
+	for (char **i = rc; *i != 0; i++)
+		items.push_back(*i);
+
+	PHYSFS_freeList(rc);
+
+	for (const std::string &item : items)
+		indexPath(dir.empty() ? item : dir + "/" + item);
+
+	pathIndex[dir].items = std::move(items);
+}
+
+bool Filesystem::indexPath(const std::string &path) const
+{
+	Info info = {};
+	if (!statPath(path.c_str(), info))
+		return false;
+
+	int realdir = -1;
+	const char *realdirstr = PHYSFS_getRealDir(path.c_str());
+	if (realdirstr != nullptr)
+	{
+		auto it = std::find(pathIndexRealDirs.begin(), pathIndexRealDirs.end(), realdirstr);
+		realdir = (int) (it - pathIndexRealDirs.begin());
+		if (it == pathIndexRealDirs.end())
+			pathIndexRealDirs.push_back(realdirstr);
+	}
+
+	auto it = pathIndex.find(path);
+	bool isnew = it == pathIndex.end();
+
+	PathIndexEntry &entry = pathIndex[path];
+	entry.info = info;
+	entry.realDirectory = realdir;
+
+	if (isnew && !path.empty())
+	{
+		// Keep the parent's listing in the sorted order PhysFS uses, adding
+		// the parent itself first if it was created at the same time.
+		std::string parentpath = getParentPath(path);
+		auto parentit = pathIndex.find(parentpath);
+		if (parentit == pathIndex.end())
+		{
+			if (!indexPath(parentpath))
+				return true;
+			parentit = pathIndex.find(parentpath);
+		}
+
+		std::vector<std::string> &siblings = parentit->second.items;
+		std::string name = getBaseName(path);
+		auto pos = std::lower_bound(siblings.begin(), siblings.end(), name);
+		if (pos == siblings.end() || *pos != name)
+			siblings.insert(pos, name);
+	}
+
+	if (isnew && info.type == FILETYPE_DIRECTORY)
+		indexDirectory(path);
+
+	return true;
+}
+
+void Filesystem::removeFromPathIndex(const std::string &path) const
+{
+	auto it = pathIndex.find(path);
+	if (it == pathIndex.end())
+		return;
+
+	for (const std::string &item : it->second.items)
+		removeFromPathIndex(path + "/" + item);
+
+	pathIndex.erase(path);
+
+	auto parentit = pathIndex.find(getParentPath(path));
+	if (parentit != pathIndex.end())
+	{
+		std::vector<std::string> &siblings = parentit->second.items;
+		siblings.erase(std::remove(siblings.begin(), siblings.end(), getBaseName(path)), siblings.end());
+	}
+}
+
 std::vector<std::string> &Filesystem::getRequirePath()
 {
 	return requirePath;
@@ -25,9 +25,11 @@
 #include <cstdlib>
 #include <cstring>
 #include <map>
+#include <unordered_map>
 
 // LOVE
 #include "filesystem/Filesystem.h"
+#include "thread/threads.h"
 
 namespace love
 {
@@ -96,6 +98,20 @@ class Filesystem final : public love::filesystem::Filesystem
 	void setSymlinksEnabled(bool enable) override;
 	bool areSymlinksEnabled() const override;
 
+	void setPathIndexEnabled(bool enable) override;
+	bool isPathIndexEnabled() const override;
+
+	/**
+	 * Discards the whole path index. Used when the search path changes.
+	 **/
+	void invalidatePathIndex();
+
+	/**
+	 * Re-reads a single path (and any missing parents) into the path index
+	 * after it was created, written or removed through the write directory.
+	 **/
+	void updatePathIndex(const char *path);
+
 	std::vector<std::string> &getRequirePath() override;
 	std::vector<std::string> &getCRequirePath() override;
 
@@ -103,6 +119,30 @@ class Filesystem final : public love::filesystem::Filesystem
 
 private:
 
+	struct PathIndexEntry
+	{
+		Info info;
+		// Index into pathIndexRealDirs, or -1 if PhysFS doesn't know it.
+		int realDirectory;
+		// Directory contents, in the same order PhysFS enumerates them.
+		std::vector<std::string> items;
+	};
+
+	enum PathIndexResult
+	{
+		PATHINDEX_FOUND,
+		PATHINDEX_MISSING,
+		PATHINDEX_UNKNOWN,
+	};
+
+	// These must be called with pathIndexMutex locked.
+	PathIndexResult findInPathIndex(const char *path, const PathIndexEntry *&entry) const;
+	PathIndexResult lookupPathIndex(const std::string &key, const PathIndexEntry *&entry) const;
+	void buildPathIndex() const;
+	void indexDirectory(const std::string &dir) const;
+	bool indexPath(const std::string &path) const;
+	void removeFromPathIndex(const std::string &path) const;
+
 	struct CommonPathMountInfo
 	{
 		bool mounted;
@@ -140,6 +180,14 @@ class Filesystem final : public love::filesystem::Filesystem
 
 	bool saveDirectoryNeedsMounting;
 
+	// In-memory snapshot of the merged search path, so existence checks and
+	// directory listings don't have to search every mounted archive.
+	bool pathIndexEnabled;
+	mutable bool pathIndexValid;
+	mutable std::unordered_map<std::string, PathIndexEntry> pathIndex;
+	mutable std::vector<std::string> pathIndexRealDirs;
+	love::thread::MutexRef pathIndexMutex;
+
 }; // Filesystem
 
 } // physfs
@@ -28,6 +28,14 @@
 #include "data/wrap_DataModule.h"
 
 #include "physfs/Filesystem.h"
+#include "common/version.h"
+
+// xxHash
+#include "libraries/xxHash/xxhash.h"
+
+#ifdef LUA_JITLIBNAME
+#include <luajit.h>
+#endif
 
 #ifdef LOVE_ANDROID
 #include "common/android.h"
@@ -720,6 +728,97 @@ int w_lines(lua_State *L)
 	return 1;
 }
 
+// Bytecode is only valid for the VM flavour and pointer size that produced it.
+#ifdef LUA_JITLIBNAME
+static const char *BYTECODE_FLAVOUR = LUAJIT_VERSION;
+#else
+static const char *BYTECODE_FLAVOUR = LUA_RELEASE;
+#endif
+
+static std::string getBytecodeCachePath(const std::string &filename, const void *source, size_t size)
+{
+	std::stringstream key;
+	key << BYTECODE_FLAVOUR << "/" << sizeof(void *) << "/" << love::VERSION << "/" << filename;
+
+	std::string keystr = key.str();
+	unsigned long long seed = XXH64(keystr.data(), keystr.size(), 0);
+	unsigned long long hash = XXH64(source, size, seed);
+
+	char name[32];
+	snprintf(name, sizeof(name), "/%016llx.luac", hash);
+
+	return std::string(Filesystem::BYTECODE_CACHE_DIRECTORY) + name;
+}
+
+static bool loadCachedBytecode(lua_State *L, const std::string &cachepath, const std::string &chunkname)
+{
+	auto *inst = instance();
+
+	Filesystem::Info info = {};
+	if (!inst->getInfo(cachepath.c_str(), info) || info.type != Filesystem::FILETYPE_FILE)
+		return false;
+
+	Data *data = nullptr;
+	try
+	{
+		data = inst->read(cachepath.c_str());
+	}
+	catch (love::Exception &)
+	{
+		return false;
+	}
+
+	const char *bytes = (const char *) data->getData();
+	int status = LUA_ERRSYNTAX;
+
+	if (data->getSize() > 0 && bytes[0] == LUA_SIGNATURE[0])
+	{
+#if (LUA_VERSION_NUM > 501) || defined(LUA_JITLIBNAME)
+		status = luaL_loadbufferx(L, bytes, data->getSize(), chunkname.c_str(), "b");
+#else
+		status = luaL_loadbuffer(L, bytes, data->getSize(), chunkname.c_str());
+#endif
+		// A stale or corrupt entry is treated like a miss.
+		if (status != 0)
+			lua_pop(L, 1);
+	}
+
+	data->release();
+	return status == 0;
+}
+
+static int writeBytecode(lua_State *, const void *p, size_t size, void *ud)
+{
+	((std::string *) ud)->append((const char *) p, size);
+	return 0;
+}
+
+static void saveCachedBytecode(lua_State *L, const std::string &cachepath)
+{
+	std::string bytecode;
+
+#if LUA_VERSION_NUM >= 503
+	lua_dump(L, writeBytecode, &bytecode, 0);
+#else
+	lua_dump(L, writeBytecode, &bytecode);
+#endif
+
+	if (bytecode.empty())
+		return;
+
+	// The cache is best-effort: a missing or read-only save directory just
+	// means the chunk gets compiled from source again next time.
+	try
+	{
+		auto *inst = instance();
+		inst->createDirectory(Filesystem::BYTECODE_CACHE_DIRECTORY);
+		inst->write(cachepath.c_str(), bytecode.data(), (int64) bytecode.size());
+	}
+	catch (love::Exception &)
+	{
+	}
+}
+
 int w_load(lua_State *L)
 {
 	std::string filename = std::string(luaL_checkstring(L, 1));
@@ -744,6 +843,23 @@ int w_load(lua_State *L)
 		return luax_ioError(L, "%s", e.what());
 	}
 
+	std::string chunkname = "@" + filename;
+	const char *source = (const char *) data->getData();
+
+	// Precompiled files and text-only loads bypass the bytecode cache.
+	std::string cachepath;
+	if (instance()->isBytecodeCacheEnabled() && loadMode != Filesystem::LOADMODE_TEXT
+		&& data->getSize() > 0 && source[0] != LUA_SIGNATURE[0])
+	{
+		cachepath = getBytecodeCachePath(filename, source, data->getSize());
+
+		if (loadCachedBytecode(L, cachepath, chunkname))
+		{
+			data->release();
+			return 1;
+		}
+	}
+
 	int status;
 
 #if (LUA_VERSION_NUM > 501) || defined(LUA_JITLIBNAME)
@@ -751,10 +867,10 @@ int w_load(lua_State *L)
 	const char *mode;
 	Filesystem::getConstant(loadMode, mode);
 
-	status = luaL_loadbufferx(L, (const char *)data->getData(), data->getSize(), ("@" + filename).c_str(), mode);
+	status = luaL_loadbufferx(L, source, data->getSize(), chunkname.c_str(), mode);
 #else
 	if (loadMode == Filesystem::LOADMODE_ANY)
-		status = luaL_loadbuffer(L, (const char *)data->getData(), data->getSize(), ("@" + filename).c_str());
+		status = luaL_loadbuffer(L, source, data->getSize(), chunkname.c_str());
 	else
 	{
 		// Unsupported
@@ -773,6 +889,8 @@ int w_load(lua_State *L)
 	case LUA_ERRSYNTAX:
 		return luaL_error(L, "Syntax error: %s\n", lua_tostring(L, -1));
 	default: // success
+		if (!cachepath.empty())
+			saveCachedBytecode(L, cachepath);
 		return 1;
 	}
 }
@@ -789,6 +907,30 @@ int w_areSymlinksEnabled(lua_State *L)
 	return 1;
 }
 
+int w_setPathIndexEnabled(lua_State *L)
+{
+	instance()->setPathIndexEnabled(luax_checkboolean(L, 1));
+	return 0;
+}
+
+int w_isPathIndexEnabled(lua_State *L)
+{
+	luax_pushboolean(L, instance()->isPathIndexEnabled());
+	return 1;
+}
+
+int w_setBytecodeCacheEnabled(lua_State *L)
+{
+	instance()->setBytecodeCacheEnabled(luax_checkboolean(L, 1));
+	return 0;
+}
+
+int w_isBytecodeCacheEnabled(lua_State *L)
+{
+	luax_pushboolean(L, instance()->isBytecodeCacheEnabled());
+	return 1;
+}
+
 int w_getRequirePath(lua_State *L)
 {
 	std::stringstream path;
@@ -1054,6 +1196,10 @@ static const luaL_Reg functions[] =
 	{ "getInfo", w_getInfo },
 	{ "setSymlinksEnabled", w_setSymlinksEnabled },
 	{ "areSymlinksEnabled", w_areSymlinksEnabled },
+	{ "setPathIndexEnabled", w_setPathIndexEnabled },
+	{ "isPathIndexEnabled", w_isPathIndexEnabled },
+	{ "setBytecodeCacheEnabled", w_setBytecodeCacheEnabled },
+	{ "isBytecodeCacheEnabled", w_isBytecodeCacheEnabled },
 	{ "newFileData", w_newFileData },
 	{ "getRequirePath", w_getRequirePath },
 	{ "setRequirePath", w_setRequirePath },
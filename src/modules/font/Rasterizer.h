@@ -143,11 +143,18 @@ class Rasterizer : public Object
 
 	float getDPIScale() const;
 
+	/**
+	 * Gets whether glyphs are signed distance fields rather than coverage
+	 * bitmaps. The distance is stored in the alpha channel, with 0.5 on the
+	 * glyph's outline.
+	 **/
+	bool isSDF() const;
+
 protected:
 
 	FontMetrics metrics;
 	float dpiScale;
-	bool sdf;
+	bool sdf = false;
 
 }; // Rasterizer
 
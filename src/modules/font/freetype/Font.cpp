@@ -40,6 +40,12 @@ Font::Font()
 {
 	if (FT_Init_FreeType(&library))
 		throw love::Exception("TrueTypeFont Loading error: FT_Init_FreeType failed");
+
+	// FreeType's default spread of 2 pixels is too small to scale SDF glyphs
+	// up much, or to draw outlines and shadows from them.
+	FT_Int spread = TrueTypeRasterizer::SDF_SPREAD;
+	FT_Property_Set(library, "sdf", "spread", &spread);
+	FT_Property_Set(library, "bsdf", "spread", &spread);
 }
 
 Font::~Font()
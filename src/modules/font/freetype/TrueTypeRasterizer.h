@@ -62,6 +62,9 @@ class TrueTypeRasterizer : public love::font::TrueTypeRasterizer
 
 	static bool accepts(FT_Library library, love::Data *data);
 
+	// Distance in pixels covered by the values of SDF glyphs.
+	static const int SDF_SPREAD = 8;
+
 private:
 
 	static FT_UInt hintingToLoadOption(Hinting hinting);
@@ -22,6 +22,9 @@
 #include "Graphics.h"
 #include "common/memory.h"
 
+// C++
+#include <algorithm>
+
 namespace love
 {
 namespace graphics
@@ -258,6 +261,54 @@ int Buffer::getDataMemberIndex(const std::string &name) const
 	return -1;
 }
 
+void Buffer::fillRanges(RangeSet &ranges, size_t unitSize, const void *data)
+{
+	if (ranges.isEmpty())
+		return;
+
+	const uint8 *bytes = (const uint8 *) data;
+
+	// Separate uploads have a fixed cost each, so small gaps aren't worth it.
+	ranges.coalesce(std::max<size_t>(FILL_RANGE_MIN_GAP / unitSize, 1));
+
+	size_t modifiedsize = ranges.getTotalSize() * unitSize;
+	Range bounds = ranges.getBounds();
+	size_t boundsoffset = bounds.getOffset() * unitSize;
+
+	if (boundsoffset >= getSize())
+	{
+		ranges.clear();
+		return;
+	}
+
+	size_t boundssize = std::min(bounds.getSize() * unitSize, getSize() - boundsoffset);
+
+	if (dataUsage == BUFFERDATAUSAGE_STREAM && modifiedsize >= getSize() / 2)
+	{
+		// Full-size fills of stream buffers can orphan the old storage instead
+		// of waiting for the GPU to finish with it.
+		fill(0, getSize(), bytes);
+	}
+	else if (ranges.getRanges().size() == 1 || modifiedsize >= boundssize / 2)
+	{
+		fill(boundsoffset, boundssize, bytes + boundsoffset);
+	}
+	else
+	{
+		for (const Range &r : ranges.getRanges())
+		{
+			size_t offset = r.getOffset() * unitSize;
+			if (offset >= getSize())
+				break;
+
+			size_t size = std::min(r.getSize() * unitSize, getSize() - offset);
+			fill(offset, size, bytes + offset);
+		}
+	}
+
+	ranges.clear();
+}
+
 void Buffer::clear(size_t offset, size_t size)
 {
 	if (isImmutable())
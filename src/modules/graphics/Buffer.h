@@ -25,6 +25,7 @@
 #include "common/int.h"
 #include "common/Object.h"
 #include "common/Optional.h"
+#include "common/RangeSet.h"
 #include "vertex.h"
 #include "Resource.h"
 
@@ -54,6 +55,10 @@ class Buffer : public love::Object, public Resource
 
 	static const size_t SHADER_STORAGE_BUFFER_MAX_STRIDE = 2048;
 
+	// Gaps between modified ranges smaller than this (in bytes) are uploaded
+	// rather than split into separate fills.
+	static constexpr size_t FILL_RANGE_MIN_GAP = 4096;
+
 	enum MapType
 	{
 		MAP_WRITE_INVALIDATE,
@@ -138,6 +143,15 @@ class Buffer : public love::Object, public Resource
 	 */
 	virtual bool fill(size_t offset, size_t size, const void *data) = 0;
 
+	/**
+	 * Upload the modified ranges of a client-side copy of this buffer's data.
+	 * Ranges are in units of unitSize bytes, and data points to the start of
+	 * the client-side copy. Depending on how much was modified this does a
+	 * single full or bounding-range upload, or one upload per range. The
+	 * RangeSet is cleared afterward.
+	 **/
+	void fillRanges(RangeSet &ranges, size_t unitSize, const void *data);
+
 	/**
 	 * Reset the given portion of this buffer's data to 0.
 	 */
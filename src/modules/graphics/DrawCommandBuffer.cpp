@@ -0,0 +1,224 @@
+/**
+ * Copyright (c) 2006-2024 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+
+#include "DrawCommandBuffer.h"
+#include "Graphics.h"
+#include "Quad.h"
+#include "Shader.h"
+
+// C++
+#include <algorithm>
+
+namespace love
+{
+namespace graphics
+{
+
+love::Type DrawCommandBuffer::type("DrawCommandBuffer", &Drawable::type);
+
+DrawCommandBuffer::DrawCommandBuffer()
+	: color(255, 255, 255, 255)
+	, colorf(1.0f, 1.0f, 1.0f, 1.0f)
+	, hasBlend(false)
+	, blend()
+	, vertexBuffer(nullptr)
+	, modified(false)
+{
+}
+
+DrawCommandBuffer::~DrawCommandBuffer()
+{
+}
+
+void DrawCommandBuffer::add(Texture *texture, const Matrix4 &m)
+{
+	add(texture, texture->getQuad(), m);
+}
+
+void DrawCommandBuffer::add(Texture *texture, Quad *quad, const Matrix4 &m)
+{
+	if (texture->getTextureType() != TEXTURE_2D)
+		throw love::Exception("Only 2D textures can be drawn with a DrawCommandBuffer.");
+
+	thread::Lock lock(mutex);
+
+	int start = (int) (vertices.size() / 4);
+
+	bool merge = !commands.empty();
+	if (merge)
+	{
+		const Command &last = commands.back();
+		merge = last.texture.get() == texture && last.hasBlend == hasBlend
+			&& (!hasBlend || last.blend == blend);
+	}
+
+	if (!merge)
+	{
+		Command cmd;
+		cmd.texture.set(texture);
+		cmd.hasBlend = hasBlend;
+		cmd.blend = blend;
+		cmd.start = start;
+		cmd.count = 0;
+		commands.push_back(cmd);
+	}
+
+	commands.back().count++;
+
+	vertices.resize(vertices.size() + 4);
+	XYf_STf_RGBAub *verts = &vertices[start * 4];
+
+	const Vector2 *quadpositions = quad->getVertexPositions();
+	const Vector2 *quadtexcoords = quad->getVertexTexCoords();
+
+	m.transformXY(verts, quadpositions, 4);
+
+	for (int i = 0; i < 4; i++)
+	{
+		verts[i].s = quadtexcoords[i].x;
+		verts[i].t = quadtexcoords[i].y;
+		verts[i].color = color;
+	}
+
+	modified = true;
+}
+
+void DrawCommandBuffer::clear()
+{
+	thread::Lock lock(mutex);
+
+	vertices.clear();
+	commands.clear();
+	modified = true;
+}
+
+void DrawCommandBuffer::setColor(const Colorf &c)
+{
+	thread::Lock lock(mutex);
+
+	colorf.r = std::min(std::max(c.r, 0.0f), 1.0f);
+	colorf.g = std::min(std::max(c.g, 0.0f), 1.0f);
+	colorf.b = std::min(std::max(c.b, 0.0f), 1.0f);
+	colorf.a = std::min(std::max(c.a, 0.0f), 1.0f);
+
+	color = toColor32(colorf);
+}
+
+Colorf DrawCommandBuffer::getColor() const
+{
+	thread::Lock lock(mutex);
+	return colorf;
+}
+
+void DrawCommandBuffer::setBlendState(const BlendState &b)
+{
+	thread::Lock lock(mutex);
+	hasBlend = true;
+	blend = b;
+}
+
+void DrawCommandBuffer::resetBlendState()
+{
+	thread::Lock lock(mutex);
+	hasBlend = false;
+}
+
+bool DrawCommandBuffer::getBlendState(BlendState &b) const
+{
+	thread::Lock lock(mutex);
+	b = blend;
+	return hasBlend;
+}
+
+int DrawCommandBuffer::getCount() const
+{
+	thread::Lock lock(mutex);
+	return (int) (vertices.size() / 4);
+}
+
+int DrawCommandBuffer::getCommandCount() const
+{
+	thread::Lock lock(mutex);
+	return (int) commands.size();
+}
+
+void DrawCommandBuffer::draw(Graphics *gfx, const Matrix4 &m)
+{
+	thread::Lock lock(mutex);
+
+	if (commands.empty())
+		return;
+
+	gfx->flushBatchedDraws();
+
+	size_t datasize = vertices.size() * sizeof(XYf_STf_RGBAub);
+
+	if (vertexBuffer.get() == nullptr || vertexBuffer->getSize() < datasize)
+	{
+		size_t buffersize = datasize;
+		if (vertexBuffer.get() != nullptr)
+			buffersize = std::max(datasize, vertexBuffer->getSize() * 2);
+
+		Buffer::Settings settings(BUFFERUSAGEFLAG_VERTEX, BUFFERDATAUSAGE_DYNAMIC);
+		auto decl = Buffer::getCommonFormatDeclaration(CommonFormat::XYf_STf_RGBAub);
+
+		vertexBuffer.set(gfx->newBuffer(settings, decl, nullptr, buffersize, 0), Acquire::NORETAIN);
+		modified = true;
+	}
+
+	if (modified)
+	{
+		vertexBuffer->fill(0, datasize, vertices.data());
+		modified = false;
+	}
+
+	VertexAttributes attributes;
+	BufferBindings buffers;
+
+	buffers.set(0, vertexBuffer, 0);
+	attributes.setCommonFormat(CommonFormat::XYf_STf_RGBAub, 0);
+
+	BlendState prevblend = gfx->getBlendState();
+
+	Graphics::TempTransform transform(gfx, m);
+
+	for (const Command &cmd : commands)
+	{
+		const BlendState &cmdblend = cmd.hasBlend ? cmd.blend : prevblend;
+		if (!(cmdblend == gfx->getBlendState()))
+			gfx->setBlendState(cmdblend);
+
+		if (Shader::isDefaultActive())
+			Shader::attachDefault(Shader::STANDARD_DEFAULT);
+
+		if (Shader::current)
+			Shader::current->validateDrawState(PRIMITIVE_TRIANGLES, cmd.texture);
+
+		Texture *tex = gfx->getTextureOrDefaultForActiveShader(cmd.texture);
+		gfx->drawQuads(cmd.start, cmd.count, attributes, buffers, tex);
+	}
+
+	if (!(prevblend == gfx->getBlendState()))
+		gfx->setBlendState(prevblend);
+}
+
+} // graphics
+} // love
@@ -0,0 +1,116 @@
+/**
+ * Copyright (c) 2006-2024 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#pragma once
+
+// LOVE
+#include "common/Matrix.h"
+#include "common/Color.h"
+#include "Drawable.h"
+#include "Texture.h"
+#include "Buffer.h"
+#include "renderstate.h"
+#include "vertex.h"
+#include "thread/threads.h"
+
+// C++
+#include <vector>
+
+namespace love
+{
+namespace graphics
+{
+
+class Graphics;
+class Quad;
+
+/**
+ * A list of sprite draws which can be recorded from any thread and submitted
+ * on the main thread. Recording only touches CPU memory: each sprite is
+ * transformed into four vertices in the buffer's own arena, and consecutive
+ * sprites which share a texture and blend mode are merged into one command.
+ * Drawing the buffer uploads the arena once and issues one drawQuads call per
+ * command.
+ *
+ * The buffer is internally locked, so one thread can record into it while
+ * another holds a reference to it. Textures referenced by recorded commands
+ * are kept alive until the buffer is cleared.
+ **/
+class DrawCommandBuffer : public Drawable
+{
+public:
+
+	static love::Type type;
+
+	DrawCommandBuffer();
+	virtual ~DrawCommandBuffer();
+
+	void add(Texture *texture, const Matrix4 &m);
+	void add(Texture *texture, Quad *quad, const Matrix4 &m);
+
+	void clear();
+
+	void setColor(const Colorf &color);
+	Colorf getColor() const;
+
+	/**
+	 * Sets the blend state used by sprites added after this call. Commands
+	 * recorded without a blend state use whatever is active when the buffer
+	 * is drawn.
+	 **/
+	void setBlendState(const BlendState &blend);
+	void resetBlendState();
+	bool getBlendState(BlendState &blend) const;
+
+	int getCount() const;
+	int getCommandCount() const;
+
+	// Implements Drawable.
+	void draw(Graphics *gfx, const Matrix4 &m) override;
+
+private:
+
+	struct Command
+	{
+		StrongRef<Texture> texture;
+		bool hasBlend;
+		BlendState blend;
+		int start;
+		int count;
+	};
+
+	std::vector<XYf_STf_RGBAub> vertices;
+	std::vector<Command> commands;
+
+	Color32 color;
+	Colorf colorf;
+
+	bool hasBlend;
+	BlendState blend;
+
+	StrongRef<Buffer> vertexBuffer;
+	bool modified;
+
+	love::thread::MutexRef mutex;
+
+}; // DrawCommandBuffer
+
+} // graphics
+} // love
@@ -23,6 +23,7 @@
 
 #include "common/math.h"
 #include "common/Matrix.h"
+#include "common/profiler.h"
 #include "Graphics.h"
 
 #include <math.h>
@@ -61,6 +62,7 @@ Font::Font(love::font::Rasterizer *r, const SamplerState &s)
 	, textureHeight(128)
 	, samplerState()
 	, dpiScale(r->getDPIScale())
+	, sdf(r->isSDF())
 	, textureCacheID(0)
 {
 	samplerState.minFilter = s.minFilter;
@@ -234,6 +236,8 @@ love::font::GlyphData *Font::getRasterizerGlyphData(love::font::TextShaper::Glyp
 
 const Font::Glyph &Font::addGlyph(love::font::TextShaper::GlyphIndex glyphindex)
 {
+	LOVE_PROFILE_ZONE("Font::addGlyph");
+
 	float glyphdpiscale = getDPIScale();
 	StrongRef<love::font::GlyphData> gd(getRasterizerGlyphData(glyphindex, glyphdpiscale), Acquire::NORETAIN);
 
@@ -571,6 +575,8 @@ void Font::printv(graphics::Graphics *gfx, const Matrix4 &t, const std::vector<D
 		streamcmd.indexMode = TRIANGLEINDEX_QUADS;
 		streamcmd.vertexCount = cmd.vertexcount;
 		streamcmd.texture = cmd.texture;
+		if (sdf)
+			streamcmd.standardShaderType = Shader::STANDARD_SDF;
 
 		Graphics::BatchedVertexData data = gfx->requestBatchedDraw(streamcmd);
 		GlyphVertex *vertexdata = (GlyphVertex *) data.stream[0];
@@ -676,7 +682,13 @@ void Font::setFallbacks(const std::vector<Font *> &fallbacks)
 {
 	std::vector<love::font::Rasterizer*> rasterizerfallbacks;
 	for (const Font* f : fallbacks)
+	{
+		// Glyphs from all fallbacks share this Font's textures and shader.
+		if (f->isSDF() != sdf)
+			throw love::Exception("Font fallbacks must all use the same SDF setting as the main Font.");
+
 		rasterizerfallbacks.push_back(f->shaper->getRasterizers()[0]);
+	}
 
 	shaper->setFallbacks(rasterizerfallbacks);
 
@@ -694,6 +706,11 @@ float Font::getDPIScale() const
 	return dpiScale;
 }
 
+bool Font::isSDF() const
+{
+	return sdf;
+}
+
 uint32 Font::getTextureCacheID() const
 {
 	return textureCacheID;
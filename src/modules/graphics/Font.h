@@ -148,6 +148,12 @@ class Font : public Object, public Volatile
 
 	float getDPIScale() const;
 
+	/**
+	 * Whether the glyphs are signed distance fields. These are drawn with the
+	 * built-in SDF shader, so one Font can be scaled to any size.
+	 **/
+	bool isSDF() const;
+
 	uint32 getTextureCacheID() const;
 
 	// Implements Volatile.
@@ -198,6 +204,8 @@ class Font : public Object, public Volatile
 
 	float dpiScale;
 
+	bool sdf;
+
 	int textureX, textureY;
 	int rowHeight;
 
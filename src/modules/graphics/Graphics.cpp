@@ -31,11 +31,15 @@
 #include "Font.h"
 #include "Video.h"
 #include "TextBatch.h"
+#include "TileMap.h"
 #include "common/deprecation.h"
+#include "common/profiler.h"
 #include "common/config.h"
 
 // C++
 #include <algorithm>
+#include <cmath>
+#include <functional>
 #include <stdlib.h>
 
 namespace love
@@ -190,6 +194,8 @@ Graphics::Graphics(const char *name)
 	, backbufferHasDepth(false)
 	, created(false)
 	, active(true)
+	, defaultShaderCompileTime(0.0)
+	, gpuTimingFrame(0)
 	, batchedDrawState()
 	, deviceProjectionMatrix()
 	, renderTargetSwitchCount(0)
@@ -201,6 +207,8 @@ Graphics::Graphics(const char *name)
 	, defaultTextures()
 	, defaultTexelBuffers()
 	, defaultStorageBuffer(nullptr)
+	, renderPassTimingActive(false)
+	, gpuFrameTime(0.0)
 	, cachedShaderStages()
 {
 	transformStack.reserve(16);
@@ -249,6 +257,8 @@ Graphics::~Graphics()
 	if (batchedDrawState.indexBuffer)
 		batchedDrawState.indexBuffer->release();
 
+	meshDrawState = MeshDrawState();
+
 	for (int i = 0; i < (int) SHADERSTAGE_MAX_ENUM; i++)
 		cachedShaderStages[i].clear();
 
@@ -317,9 +327,9 @@ Video *Graphics::newVideo(love::video::VideoStream *stream, float dpiscale)
 	return new Video(this, stream, dpiscale);
 }
 
-love::graphics::SpriteBatch *Graphics::newSpriteBatch(Texture *texture, int size, BufferDataUsage usage)
+love::graphics::SpriteBatch *Graphics::newSpriteBatch(Texture *texture, int size, BufferDataUsage usage, SpriteBatch::StorageMode storage)
 {
-	return new SpriteBatch(this, texture, size, usage);
+	return new SpriteBatch(this, texture, size, usage, storage);
 }
 
 love::graphics::ParticleSystem *Graphics::newParticleSystem(Texture *texture, int size)
@@ -327,6 +337,11 @@ love::graphics::ParticleSystem *Graphics::newParticleSystem(Texture *texture, in
 	return new ParticleSystem(texture, size);
 }
 
+love::graphics::TileMap *Graphics::newTileMap(Texture *tileset, int width, int height, int tilewidth, int tileheight, PixelFormat format)
+{
+	return new TileMap(this, tileset, width, height, tilewidth, tileheight, format);
+}
+
 ShaderStage *Graphics::newShaderStage(ShaderStageType stage, const std::string &source, const Shader::CompileOptions &options, const Shader::SourceInfo &info, bool cache)
 {
 	ShaderStage *s = nullptr;
@@ -775,6 +790,11 @@ bool Graphics::isCreated() const
 	return created;
 }
 
+double Graphics::getDefaultShaderCompileTime() const
+{
+	return defaultShaderCompileTime;
+}
+
 bool Graphics::isActive() const
 {
 	// The graphics module is only completely 'active' if there's a window, a
@@ -969,13 +989,19 @@ void Graphics::setShader(love::graphics::Shader *shader)
 	if (shader == nullptr)
 		return setShader();
 
+	batchedDrawState.flushReason = BATCHFLUSH_SHADER;
 	shader->attach();
+	batchedDrawState.flushReason = BATCHFLUSH_OTHER;
+
 	states.back().shader.set(shader);
 }
 
 void Graphics::setShader()
 {
+	batchedDrawState.flushReason = BATCHFLUSH_SHADER;
 	Shader::attachDefault(Shader::STANDARD_DEFAULT);
+	batchedDrawState.flushReason = BATCHFLUSH_OTHER;
+
 	states.back().shader.set(nullptr);
 }
 
@@ -1400,6 +1426,58 @@ void Graphics::clearTemporaryResources()
 	temporaryTextures.clear();
 }
 
+void Graphics::nextBatchedDrawFrame()
+{
+	BatchedDrawState &state = batchedDrawState;
+
+	StreamBuffer **buffers[3] = {&state.vb[0], &state.vb[1], &state.indexBuffer};
+	BufferUsage usages[3] = {BUFFERUSAGE_VERTEX, BUFFERUSAGE_VERTEX, BUFFERUSAGE_INDEX};
+
+	int historyframe = state.historyFrame;
+	state.historyFrame = (state.historyFrame + 1) % BATCH_HISTORY_FRAMES;
+
+	for (int i = 0; i < BATCHFLUSH_MAX_ENUM; i++)
+		state.flushCounts[i] = 0;
+
+	meshDrawState.argsOffset = 0;
+	meshDrawState.drawDataOffset = 0;
+
+	for (int i = 0; i < 3; i++)
+	{
+		StreamBuffer *&buffer = *buffers[i];
+
+		buffer->resetStallCount();
+
+		size_t size = buffer->getSize();
+		if (state.minBufferSizes[i] == 0)
+			state.minBufferSizes[i] = size;
+
+		state.usedSizeHistory[historyframe][i] = state.frameUsedSizes[i];
+		state.frameUsedSizes[i] = 0;
+
+		size_t highwatermark = 0;
+		for (int frame = 0; frame < BATCH_HISTORY_FRAMES; frame++)
+			highwatermark = std::max(highwatermark, state.usedSizeHistory[frame][i]);
+
+		// Grow ahead of time once a frame gets close to filling the buffer,
+		// rather than resizing in the middle of a later frame. Shrink when the
+		// buffer has been mostly unused for all of the recent frames.
+		size_t newsize = size;
+		if (highwatermark > size - size / 4)
+			newsize = highwatermark * 2;
+		else if (highwatermark < size / 4 && size / 2 >= state.minBufferSizes[i])
+			newsize = size / 2;
+
+		if (newsize != size)
+		{
+			buffer->release();
+			buffer = newStreamBuffer(usages[i], newsize);
+		}
+		else
+			buffer->nextFrame();
+	}
+}
+
 void Graphics::updatePendingReadbacks()
 {
 	for (int i = (int)pendingReadbacks.size() - 1; i >= 0; i--)
@@ -1413,6 +1491,186 @@ void Graphics::updatePendingReadbacks()
 	}
 }
 
+int Graphics::writeGPUTimestamp()
+{
+	if (!isCreated() || !isTimestampQuerySupported())
+		return -1;
+
+	GPUTimingFrame &frame = gpuTimingFrames[gpuTimingFrame];
+	if (frame.queryCount >= MAX_GPU_TIMESTAMPS)
+		return -1;
+
+	int query = frame.queryCount++;
+	writeTimestampInternal(gpuTimingFrame, query);
+	return query;
+}
+
+void Graphics::beginProfileZone(const std::string &name)
+{
+	flushBatchedDraws();
+
+	GPUTimingZone zone;
+	zone.name = name;
+	zone.depth = (int) gpuZoneStack.size();
+	zone.beginQuery = writeGPUTimestamp();
+
+	gpuZoneStack.push_back(zone);
+}
+
+void Graphics::endProfileZone()
+{
+	if (gpuZoneStack.empty())
+		throw love::Exception("endProfileZone must be called after a matching beginProfileZone.");
+
+	flushBatchedDraws();
+
+	GPUTimingZone zone = gpuZoneStack.back();
+	gpuZoneStack.pop_back();
+
+	// Zones that were open when the previous frame ended were already
+	// recorded as part of that frame.
+	if (zone.beginQuery < 0)
+		return;
+
+	zone.endQuery = writeGPUTimestamp();
+	if (zone.endQuery >= 0)
+		gpuTimingFrames[gpuTimingFrame].zones.push_back(zone);
+}
+
+void Graphics::beginRenderPassTiming(Texture *firsttarget)
+{
+	endRenderPassTiming();
+
+	if (firsttarget == nullptr)
+		renderPassZone.name = "window";
+	else if (!firsttarget->getDebugName().empty())
+		renderPassZone.name = firsttarget->getDebugName();
+	else
+		renderPassZone.name = "rendertarget";
+
+	renderPassZone.depth = (int) gpuZoneStack.size();
+	renderPassZone.renderPass = true;
+	renderPassZone.beginQuery = writeGPUTimestamp();
+	renderPassTimingActive = true;
+}
+
+void Graphics::endRenderPassTiming()
+{
+	if (!renderPassTimingActive)
+		return;
+
+	renderPassTimingActive = false;
+
+	if (renderPassZone.beginQuery < 0)
+		return;
+
+	renderPassZone.endQuery = writeGPUTimestamp();
+	if (renderPassZone.endQuery >= 0)
+		gpuTimingFrames[gpuTimingFrame].zones.push_back(renderPassZone);
+}
+
+void Graphics::finishGPUTimingFrame()
+{
+	endRenderPassTiming();
+
+	GPUTimingFrame &frame = gpuTimingFrames[gpuTimingFrame];
+
+	// Profile zones which are still open are cut off at the end of the frame.
+	for (GPUTimingZone &zone : gpuZoneStack)
+	{
+		if (zone.beginQuery < 0)
+			continue;
+
+		GPUTimingZone finished = zone;
+		finished.endQuery = writeGPUTimestamp();
+		if (finished.endQuery >= 0)
+			frame.zones.push_back(finished);
+
+		zone.beginQuery = -1;
+	}
+
+	frame.pending = frame.queryCount > 0;
+
+	gpuTimingFrame = (gpuTimingFrame + 1) % GPU_TIMING_FRAMES;
+
+	// The oldest frame is reused for the next one. If its results still aren't
+	// available they're dropped rather than stalling.
+	GPUTimingFrame &next = gpuTimingFrames[gpuTimingFrame];
+	if (next.pending)
+		readGPUTimingFrame(gpuTimingFrame);
+
+	next.zones.clear();
+	next.queryCount = 0;
+	next.pending = false;
+}
+
+bool Graphics::readGPUTimingFrame(int index)
+{
+	GPUTimingFrame &frame = gpuTimingFrames[index];
+
+	gpuTimestamps.clear();
+	if (!getTimestampsInternal(index, frame.queryCount, gpuTimestamps))
+		return false;
+
+	frame.pending = false;
+
+	if ((int) gpuTimestamps.size() < frame.queryCount)
+		return true;
+
+	gpuTimings.clear();
+	gpuFrameTime = 0.0;
+
+	uint64 framestart = std::numeric_limits<uint64>::max();
+	uint64 frameend = 0;
+
+	for (const GPUTimingZone &zone : frame.zones)
+	{
+		uint64 start = gpuTimestamps[zone.beginQuery];
+		uint64 end = std::max(gpuTimestamps[zone.endQuery], start);
+
+		GPUTiming timing;
+		timing.name = zone.name;
+		timing.time = (double) (end - start) / 1000000000.0;
+		timing.depth = zone.depth;
+		timing.renderPass = zone.renderPass;
+		gpuTimings.push_back(timing);
+
+		framestart = std::min(framestart, start);
+		frameend = std::max(frameend, end);
+	}
+
+	if (frameend > framestart)
+		gpuFrameTime = (double) (frameend - framestart) / 1000000000.0;
+
+	return true;
+}
+
+void Graphics::updateGPUTimings()
+{
+	// Frames complete in order, so stop at the first one that isn't done.
+	for (int i = 1; i <= GPU_TIMING_FRAMES; i++)
+	{
+		int index = (gpuTimingFrame + i) % GPU_TIMING_FRAMES;
+		if (gpuTimingFrames[index].pending && !readGPUTimingFrame(index))
+			break;
+	}
+}
+
+void Graphics::discardGPUTimings()
+{
+	for (GPUTimingFrame &frame : gpuTimingFrames)
+	{
+		frame.zones.clear();
+		frame.queryCount = 0;
+		frame.pending = false;
+	}
+
+	for (GPUTimingZone &zone : gpuZoneStack)
+		zone.beginQuery = -1;
+
+	renderPassTimingActive = false;
+}
+
 void Graphics::intersectScissor(const Rect &rect)
 {
 	Rect currect = states.back().scissorRect;
@@ -1613,6 +1871,8 @@ void Graphics::copyBuffer(Buffer *source, Buffer *dest, size_t sourceoffset, siz
 	if (sourceoffset % 4 != 0 || destoffset % 4 != 0 || size % 4 != 0)
 		throw love::Exception("Buffer copy source offset, destination offset, and size parameters must be multiples of 4 bytes.");
 
+	flushBatchedDraws();
+
 	source->copyTo(dest, sourceoffset, destoffset, size);
 }
 
@@ -1702,6 +1962,8 @@ void Graphics::copyTextureToBuffer(Texture *source, Buffer *dest, int slice, int
 	if (destrange.getMax() >= dest->getSize())
 		throw love::Exception("Buffer copy destination offset and width/height doesn't fit within the destination Buffer.");
 
+	flushBatchedDraws();
+
 	source->copyToBuffer(dest, slice, mipmap, rect, destoffset, destwidth, size);
 }
 
@@ -1797,11 +2059,17 @@ static const char *getIndirectArgsTypeName(Graphics::IndirectArgsType argstype)
 	return "(Unknown argument data)";
 }
 
-void Graphics::validateIndirectArgsBuffer(IndirectArgsType argstype, Buffer *indirectargs, int argsindex)
+void Graphics::validateIndirectArgsBuffer(IndirectArgsType argstype, Buffer *indirectargs, int argsindex, int drawcount)
 {
 	if (!capabilities.features[FEATURE_INDIRECT_DRAW])
 		throw love::Exception("Indirect draws and compute dispatches are not supported on this system.");
 
+	if (drawcount < 1)
+		throw love::Exception("The indirect draw count must be at least 1.");
+
+	if (drawcount > 1 && !capabilities.features[FEATURE_MULTI_DRAW_INDIRECT])
+		throw love::Exception("Multi-draw indirect is not supported on this system.");
+
 	if ((indirectargs->getUsageFlags() & BUFFERUSAGEFLAG_INDIRECT_ARGUMENTS) == 0)
 		throw love::Exception("The given Buffer must be created with the indirectarguments usage flag set, to be used for indirect arguments.");
 
@@ -1823,7 +2091,7 @@ void Graphics::validateIndirectArgsBuffer(IndirectArgsType argstype, Buffer *ind
 
 	size_t argsoffset = argsindex * indirectargs->getArrayStride();
 
-	if (indirectargs->getSize() < argsoffset + sizeof(uint32) * argelements)
+	if (indirectargs->getSize() < argsoffset + sizeof(uint32) * argelements * drawcount)
 		throw love::Exception("The given index into the indirect argument Buffer does not fit within the Buffer's size.");
 }
 
@@ -1861,7 +2129,7 @@ void Graphics::dispatchIndirect(Shader *shader, Buffer *indirectargs, int argsin
 	if (!shader->hasStage(SHADERSTAGE_COMPUTE))
 		throw love::Exception("Only compute shaders can have threads dispatched.");
 
-	validateIndirectArgsBuffer(INDIRECT_ARGS_DISPATCH, indirectargs, argsindex);
+	validateIndirectArgsBuffer(INDIRECT_ARGS_DISPATCH, indirectargs, argsindex, 1);
 
 	flushBatchedDraws();
 
@@ -1879,19 +2147,28 @@ void Graphics::dispatchIndirect(Shader *shader, Buffer *indirectargs, int argsin
 
 Graphics::BatchedVertexData Graphics::requestBatchedDraw(const BatchedDrawCommand &cmd)
 {
+	if (drawList.active && !drawList.replaying)
+		return recordDrawListItem(cmd);
+
+	flushMeshDraws();
+
 	BatchedDrawState &state = batchedDrawState;
 
 	bool shouldflush = false;
 	bool shouldresize = false;
+	BatchFlushReason reason = BATCHFLUSH_OVERFLOW;
 
-	if (cmd.primitiveMode != state.primitiveMode
+	if (cmd.texture != state.texture)
+		reason = BATCHFLUSH_TEXTURE;
+	else if (cmd.standardShaderType != state.standardShaderType)
+		reason = BATCHFLUSH_SHADER;
+	else if (cmd.primitiveMode != state.primitiveMode
 		|| cmd.formats[0] != state.formats[0] || cmd.formats[1] != state.formats[1]
-		|| ((cmd.indexMode != TRIANGLEINDEX_NONE) != (state.indexCount > 0))
-		|| cmd.texture != state.texture
-		|| cmd.standardShaderType != state.standardShaderType)
-	{
+		|| ((cmd.indexMode != TRIANGLEINDEX_NONE) != (state.indexCount > 0)))
+		reason = BATCHFLUSH_FORMAT;
+
+	if (reason != BATCHFLUSH_OVERFLOW)
 		shouldflush = true;
-	}
 
 	int totalvertices = state.vertexCount + cmd.vertexCount;
 
@@ -1941,6 +2218,7 @@ Graphics::BatchedVertexData Graphics::requestBatchedDraw(const BatchedDrawComman
 
 	if (shouldflush || shouldresize)
 	{
+		state.flushReason = reason;
 		flushBatchedDraws();
 
 		state.primitiveMode = cmd.primitiveMode;
@@ -2016,9 +2294,21 @@ void Graphics::flushBatchedDraws()
 {
 	auto &sbstate = batchedDrawState;
 
+	BatchFlushReason reason = sbstate.flushReason;
+	sbstate.flushReason = BATCHFLUSH_OTHER;
+
+	// Shader and blend state are recorded with each draw in a draw list. Any
+	// other reason to flush has to see the draws recorded before it.
+	if (drawList.active && !drawList.replaying && reason != BATCHFLUSH_SHADER && reason != BATCHFLUSH_BLEND)
+		replayDrawList();
+
+	flushMeshDraws();
+
 	if ((sbstate.vertexCount == 0 && sbstate.indexCount == 0) || sbstate.flushing)
 		return;
 
+	LOVE_PROFILE_ZONE("Graphics::flushBatchedDraws");
+
 	VertexAttributes attributes;
 	BufferBindings buffers;
 
@@ -2042,6 +2332,7 @@ void Graphics::flushBatchedDraws()
 		return;
 
 	sbstate.flushing = true;
+	sbstate.flushCounts[reason]++;
 
 	Colorf nc = getColor();
 	if (attributes.isEnabled(ATTRIB_COLOR))
@@ -2082,6 +2373,9 @@ void Graphics::flushBatchedDraws()
 	if (usedsizes[2] > 0)
 		sbstate.indexBuffer->markUsed(usedsizes[2]);
 
+	for (int i = 0; i < 3; i++)
+		sbstate.frameUsedSizes[i] += usedsizes[i];
+
 	popTransform();
 
 	if (attributes.isEnabled(ATTRIB_COLOR))
@@ -2099,6 +2393,376 @@ void Graphics::flushBatchedDrawsGlobal()
 		instance->flushBatchedDraws();
 }
 
+bool Graphics::canBatchMeshDraws() const
+{
+	return capabilities.features[FEATURE_MULTI_DRAW_INDIRECT]
+		&& capabilities.features[FEATURE_TEXEL_BUFFER]
+		&& Shader::standardShaders[Shader::STANDARD_MULTI_DRAW] != nullptr
+		&& Shader::isDefaultActive()
+		&& !drawList.active;
+}
+
+static bool bufferBindingsEqual(const BufferBindings &a, const BufferBindings &b)
+{
+	if (a.useBits != b.useBits)
+		return false;
+
+	for (uint32 i = 0; i < BufferBindings::MAX; i++)
+	{
+		if ((a.useBits & (1u << i)) == 0)
+			continue;
+
+		if (a.info[i].buffer != b.info[i].buffer || a.info[i].offset != b.info[i].offset)
+			return false;
+	}
+
+	return true;
+}
+
+void Graphics::queueMeshDraw(const VertexAttributes &attributes, const BufferBindings &buffers, Resource *indexbuffer, IndexDataType indextype, PrimitiveType primtype, Texture *texture, CullMode cullmode)
+{
+	auto &state = meshDrawState;
+
+	if (batchedDrawState.vertexCount > 0 || batchedDrawState.indexCount > 0)
+		flushBatchedDraws();
+
+	Buffer *indexbuf = indexbuffer != nullptr ? static_cast<Buffer *>(indexbuffer) : nullptr;
+
+	if (state.drawCount > 0)
+	{
+		if (state.attributes == attributes && bufferBindingsEqual(state.buffers, buffers)
+			&& state.indexBuffer.get() == indexbuf && (indexbuf == nullptr || state.indexType == indextype)
+			&& state.primitiveType == primtype && state.texture.get() == texture && state.cullMode == cullmode)
+		{
+			drawCallsBatched++;
+			return;
+		}
+
+		flushMeshDraws();
+	}
+
+	state.attributes = attributes;
+	state.buffers = buffers;
+	state.indexBuffer.set(indexbuf);
+	state.indexType = indextype;
+	state.primitiveType = primtype;
+	state.texture.set(texture);
+	state.cullMode = cullmode;
+
+	// The queued draws can outlive the Mesh's attachments.
+	for (uint32 i = 0; i < BufferBindings::MAX; i++)
+	{
+		if ((buffers.useBits & (1u << i)) != 0)
+			state.bufferRefs.emplace_back(static_cast<Buffer *>(buffers.info[i].buffer));
+	}
+}
+
+void Graphics::batchMeshDraw(const DrawCommand &cmd)
+{
+	queueMeshDraw(*cmd.attributes, *cmd.buffers, nullptr, INDEX_UINT16, cmd.primitiveType, cmd.texture, cmd.cullMode);
+
+	auto &state = meshDrawState;
+
+	// { vertexcount, instancecount, firstvertex, baseinstance }
+	uint32 args[] = {(uint32) cmd.vertexCount, 1, (uint32) cmd.vertexStart, 0};
+	state.args.insert(state.args.end(), args, args + 4);
+
+	const float *transform = getTransform().getElements();
+	state.drawData.insert(state.drawData.end(), transform, transform + 16);
+
+	Colorf c = gammaCorrectColor(getColor());
+	float color[] = {c.r, c.g, c.b, c.a};
+	state.drawData.insert(state.drawData.end(), color, color + 4);
+
+	state.drawCount++;
+}
+
+void Graphics::batchMeshDraw(const DrawIndexedCommand &cmd)
+{
+	queueMeshDraw(*cmd.attributes, *cmd.buffers, cmd.indexBuffer, cmd.indexType, cmd.primitiveType, cmd.texture, cmd.cullMode);
+
+	auto &state = meshDrawState;
+
+	// { indexcount, instancecount, firstindex, basevertex, baseinstance }
+	uint32 firstindex = (uint32) (cmd.indexBufferOffset / getIndexDataSize(cmd.indexType));
+	uint32 args[] = {(uint32) cmd.indexCount, 1, firstindex, 0, 0};
+	state.args.insert(state.args.end(), args, args + 5);
+
+	const float *transform = getTransform().getElements();
+	state.drawData.insert(state.drawData.end(), transform, transform + 16);
+
+	Colorf c = gammaCorrectColor(getColor());
+	float color[] = {c.r, c.g, c.b, c.a};
+	state.drawData.insert(state.drawData.end(), color, color + 4);
+
+	state.drawCount++;
+}
+
+void Graphics::reserveMeshDrawBuffer(StrongRef<Buffer> &buffer, size_t &offset, size_t size, DataFormat format, BufferUsageFlags usage)
+{
+	if (buffer.get() != nullptr && offset + size <= buffer->getSize())
+		return;
+
+	size_t newsize = std::max(size, (size_t) 1024 * 64);
+	if (buffer.get() != nullptr)
+		newsize = std::max(newsize, buffer->getSize() * 2);
+
+	Buffer::Settings settings(usage, BUFFERDATAUSAGE_DYNAMIC);
+	buffer.set(newBuffer(settings, format, nullptr, newsize, 0), Acquire::NORETAIN);
+	offset = 0;
+}
+
+void Graphics::flushMeshDraws()
+{
+	auto &state = meshDrawState;
+
+	if (state.drawCount == 0 || state.flushing)
+		return;
+
+	LOVE_PROFILE_ZONE("Graphics::flushMeshDraws");
+
+	state.flushing = true;
+
+	size_t argssize = state.args.size() * sizeof(uint32);
+	size_t datasize = state.drawData.size() * sizeof(float);
+
+	reserveMeshDrawBuffer(state.argsBuffer, state.argsOffset, argssize, DATAFORMAT_UINT32, BUFFERUSAGEFLAG_INDIRECT_ARGUMENTS);
+	reserveMeshDrawBuffer(state.drawDataBuffer, state.drawDataOffset, datasize, DATAFORMAT_FLOAT_VEC4, BUFFERUSAGEFLAG_TEXEL);
+
+	state.argsBuffer->fill(state.argsOffset, argssize, state.args.data());
+	state.drawDataBuffer->fill(state.drawDataOffset, datasize, state.drawData.data());
+
+	Shader::attachDefault(Shader::STANDARD_MULTI_DRAW);
+
+	Shader *shader = Shader::current;
+
+	const Shader::UniformInfo *datainfo = shader->getUniformInfo(Shader::BUILTIN_BUFFER_DRAW_DATA);
+	if (datainfo != nullptr)
+	{
+		Buffer *databuffer = state.drawDataBuffer.get();
+		shader->sendBuffers(datainfo, &databuffer, 1);
+	}
+
+	const Shader::UniformInfo *offsetinfo = shader->getUniformInfo(Shader::BUILTIN_DRAW_DATA_OFFSET);
+	if (offsetinfo != nullptr)
+	{
+		offsetinfo->ints[0] = (int) (state.drawDataOffset / (sizeof(float) * 20));
+		shader->updateUniform(offsetinfo, 1);
+	}
+
+	if (state.indexBuffer.get() != nullptr)
+	{
+		DrawIndexedCommand cmd(&state.attributes, &state.buffers, state.indexBuffer.get());
+		cmd.primitiveType = state.primitiveType;
+		cmd.indexType = state.indexType;
+		cmd.texture = state.texture.get();
+		cmd.cullMode = state.cullMode;
+		cmd.indirectBuffer = state.argsBuffer.get();
+		cmd.indirectBufferOffset = state.argsOffset;
+		cmd.indirectDrawCount = state.drawCount;
+		draw(cmd);
+	}
+	else
+	{
+		DrawCommand cmd(&state.attributes, &state.buffers);
+		cmd.primitiveType = state.primitiveType;
+		cmd.texture = state.texture.get();
+		cmd.cullMode = state.cullMode;
+		cmd.indirectBuffer = state.argsBuffer.get();
+		cmd.indirectBufferOffset = state.argsOffset;
+		cmd.indirectDrawCount = state.drawCount;
+		draw(cmd);
+	}
+
+	state.argsOffset += argssize;
+	state.drawDataOffset += datasize;
+
+	state.args.clear();
+	state.drawData.clear();
+	state.bufferRefs.clear();
+	state.indexBuffer.set(nullptr);
+	state.texture.set(nullptr);
+	state.drawCount = 0;
+	state.flushing = false;
+}
+
+void Graphics::beginDrawList()
+{
+	if (drawList.active)
+		throw love::Exception("A draw list is already being recorded.");
+
+	flushBatchedDraws();
+
+	drawList.active = true;
+	drawList.layer = 0.0f;
+}
+
+void Graphics::submitDrawList()
+{
+	if (!drawList.active)
+		throw love::Exception("No draw list is being recorded.");
+
+	replayDrawList();
+	drawList.active = false;
+}
+
+bool Graphics::isDrawListActive() const
+{
+	return drawList.active;
+}
+
+void Graphics::setDrawListLayer(float layer)
+{
+	// NaN doesn't order against other layers, which would break the sort.
+	if (std::isnan(layer))
+		throw love::Exception("Draw list layer cannot be NaN.");
+
+	drawList.layer = layer;
+}
+
+float Graphics::getDrawListLayer() const
+{
+	return drawList.layer;
+}
+
+Graphics::BatchedVertexData Graphics::recordDrawListItem(const BatchedDrawCommand &cmd)
+{
+	DrawListItem item;
+	item.layer = drawList.layer;
+	item.command = cmd;
+	item.command.texture = nullptr;
+	item.texture.set(cmd.texture);
+	item.shader.set(states.back().shader.get());
+	item.blend = states.back().blend;
+
+	BatchedVertexData d;
+
+	for (int i = 0; i < 2; i++)
+	{
+		item.vertexOffsets[i] = drawList.vertices[i].size();
+		d.stream[i] = nullptr;
+
+		if (cmd.formats[i] == CommonFormat::NONE)
+			continue;
+
+		size_t size = getFormatStride(cmd.formats[i]) * cmd.vertexCount;
+		drawList.vertices[i].resize(item.vertexOffsets[i] + size);
+		d.stream[i] = drawList.vertices[i].data() + item.vertexOffsets[i];
+	}
+
+	drawList.items.push_back(item);
+	return d;
+}
+
+static uint32 getBlendStateKey(const BlendState &b)
+{
+	if (!b.enable)
+		return 0;
+
+	return 1u << 24 | (uint32) b.operationRGB << 20 | (uint32) b.operationA << 16
+		| (uint32) b.srcFactorRGB << 12 | (uint32) b.srcFactorA << 8
+		| (uint32) b.dstFactorRGB << 4 | (uint32) b.dstFactorA;
+}
+
+void Graphics::replayDrawList()
+{
+	if (drawList.items.empty())
+		return;
+
+	LOVE_PROFILE_ZONE("Graphics::replayDrawList");
+
+	auto &items = drawList.items;
+
+	std::vector<int> order(items.size());
+	for (int i = 0; i < (int) order.size(); i++)
+		order[i] = i;
+
+	std::stable_sort(order.begin(), order.end(), [&](int ai, int bi)
+	{
+		const DrawListItem &a = items[ai];
+		const DrawListItem &b = items[bi];
+
+		if (a.layer != b.layer)
+			return a.layer < b.layer;
+		if (a.shader.get() != b.shader.get())
+			return std::less<Shader *>()(a.shader.get(), b.shader.get());
+		if (a.command.standardShaderType != b.command.standardShaderType)
+			return a.command.standardShaderType < b.command.standardShaderType;
+		if (a.texture.get() != b.texture.get())
+			return std::less<Texture *>()(a.texture.get(), b.texture.get());
+
+		uint32 ablend = getBlendStateKey(a.blend);
+		uint32 bblend = getBlendStateKey(b.blend);
+		if (ablend != bblend)
+			return ablend < bblend;
+
+		if (a.command.primitiveMode != b.command.primitiveMode)
+			return a.command.primitiveMode < b.command.primitiveMode;
+		return (a.command.indexMode != TRIANGLEINDEX_NONE) < (b.command.indexMode != TRIANGLEINDEX_NONE);
+	});
+
+	StrongRef<Shader> shader = states.back().shader;
+	BlendState blend = states.back().blend;
+
+	drawList.replaying = true;
+
+	try
+	{
+		for (int index : order)
+		{
+			const DrawListItem &item = items[index];
+
+			if (item.shader.get() != states.back().shader.get())
+			{
+				if (item.shader.get() != nullptr)
+					setShader(item.shader.get());
+				else
+					setShader();
+			}
+
+			if (!(item.blend == states.back().blend))
+				setBlendState(item.blend);
+
+			BatchedDrawCommand cmd = item.command;
+			cmd.texture = item.texture;
+
+			BatchedVertexData data = requestBatchedDraw(cmd);
+
+			for (int i = 0; i < 2; i++)
+			{
+				if (cmd.formats[i] == CommonFormat::NONE)
+					continue;
+
+				size_t size = getFormatStride(cmd.formats[i]) * cmd.vertexCount;
+				memcpy(data.stream[i], drawList.vertices[i].data() + item.vertexOffsets[i], size);
+			}
+		}
+
+		flushBatchedDraws();
+
+		if (shader.get() != nullptr)
+			setShader(shader.get());
+		else
+			setShader();
+
+		setBlendState(blend);
+	}
+	catch (love::Exception &)
+	{
+		drawList.replaying = false;
+		items.clear();
+		drawList.vertices[0].clear();
+		drawList.vertices[1].clear();
+		throw;
+	}
+
+	drawList.replaying = false;
+
+	items.clear();
+	drawList.vertices[0].clear();
+	drawList.vertices[1].clear();
+}
+
 /**
  * Drawing
  **/
@@ -2128,9 +2792,9 @@ void Graphics::drawInstanced(Mesh *mesh, const Matrix4 &m, int instancecount)
 	mesh->drawInstanced(this, m, instancecount);
 }
 
-void Graphics::drawIndirect(Mesh *mesh, const Matrix4 &m, Buffer *indirectargs, int argsindex)
+void Graphics::drawIndirect(Mesh *mesh, const Matrix4 &m, Buffer *indirectargs, int argsindex, int drawcount)
 {
-	mesh->drawIndirect(this, m, indirectargs, argsindex);
+	mesh->drawIndirect(this, m, indirectargs, argsindex, drawcount);
 }
 
 void Graphics::drawFromShader(PrimitiveType primtype, int vertexcount, int instancecount, Texture *maintexture)
@@ -2207,7 +2871,7 @@ void Graphics::drawFromShader(Buffer *indexbuffer, int indexcount, int instancec
 	draw(cmd);
 }
 
-void Graphics::drawFromShaderIndirect(PrimitiveType primtype, Buffer *indirectargs, int argsindex, Texture *maintexture)
+void Graphics::drawFromShaderIndirect(PrimitiveType primtype, Buffer *indirectargs, int argsindex, int drawcount, Texture *maintexture)
 {
 	flushBatchedDraws();
 
@@ -2217,7 +2881,7 @@ void Graphics::drawFromShaderIndirect(PrimitiveType primtype, Buffer *indirectar
 	if (Shader::isDefaultActive() || !Shader::current)
 		throw love::Exception("drawFromShaderIndirect can only be used with a custom shader.");
 
-	validateIndirectArgsBuffer(INDIRECT_ARGS_DRAW_VERTICES, indirectargs, argsindex);
+	validateIndirectArgsBuffer(INDIRECT_ARGS_DRAW_VERTICES, indirectargs, argsindex, drawcount);
 
 	Shader::current->validateDrawState(primtype, maintexture);
 
@@ -2229,12 +2893,13 @@ void Graphics::drawFromShaderIndirect(PrimitiveType primtype, Buffer *indirectar
 	cmd.primitiveType = primtype;
 	cmd.indirectBuffer = indirectargs;
 	cmd.indirectBufferOffset = argsindex * indirectargs->getArrayStride();
+	cmd.indirectDrawCount = drawcount;
 	cmd.texture = getTextureOrDefaultForActiveShader(maintexture);
 
 	draw(cmd);
 }
 
-void Graphics::drawFromShaderIndirect(Buffer *indexbuffer, Buffer *indirectargs, int argsindex, Texture *maintexture)
+void Graphics::drawFromShaderIndirect(Buffer *indexbuffer, Buffer *indirectargs, int argsindex, int drawcount, Texture *maintexture)
 {
 	flushBatchedDraws();
 
@@ -2244,7 +2909,7 @@ void Graphics::drawFromShaderIndirect(Buffer *indexbuffer, Buffer *indirectargs,
 	if (Shader::isDefaultActive() || !Shader::current)
 		throw love::Exception("drawFromShaderIndirect can only be used with a custom shader.");
 
-	validateIndirectArgsBuffer(INDIRECT_ARGS_DRAW_INDICES, indirectargs, argsindex);
+	validateIndirectArgsBuffer(INDIRECT_ARGS_DRAW_INDICES, indirectargs, argsindex, drawcount);
 
 	Shader::current->validateDrawState(PRIMITIVE_TRIANGLES, maintexture);
 
@@ -2256,7 +2921,8 @@ void Graphics::drawFromShaderIndirect(Buffer *indexbuffer, Buffer *indirectargs,
 	cmd.primitiveType = PRIMITIVE_TRIANGLES;
 	cmd.indexType = getIndexDataType(indexbuffer->getDataMember(0).decl.format);
 	cmd.indirectBuffer = indirectargs;
-	cmd.indexBufferOffset = argsindex * indirectargs->getArrayStride();
+	cmd.indirectBufferOffset = argsindex * indirectargs->getArrayStride();
+	cmd.indirectDrawCount = drawcount;
 	cmd.texture = getTextureOrDefaultForActiveShader(maintexture);
 
 	draw(cmd);
@@ -2664,7 +3330,7 @@ Graphics::Stats Graphics::getStats() const
 	getAPIStats(stats.shaderSwitches);
 
 	stats.drawCalls = drawCalls;
-	if (batchedDrawState.vertexCount > 0)
+	if (batchedDrawState.vertexCount > 0 || meshDrawState.drawCount > 0)
 		stats.drawCalls++;
 
 	stats.renderTargetSwitches = renderTargetSwitchCount;
@@ -2674,6 +3340,27 @@ Graphics::Stats Graphics::getStats() const
 	stats.buffers = Buffer::bufferCount;
 	stats.textureMemory = Texture::totalGraphicsMemory;
 	stats.bufferMemory = Buffer::totalGraphicsMemory;
+	stats.gpuTime = gpuFrameTime;
+
+	for (int i = 0; i < BATCHFLUSH_MAX_ENUM; i++)
+		stats.batchFlushes[i] = batchedDrawState.flushCounts[i];
+
+	stats.streamVertexBufferSize = 0;
+	stats.streamIndexBufferSize = 0;
+	stats.streamBufferStalls = 0;
+
+	for (StreamBuffer *buffer : {batchedDrawState.vb[0], batchedDrawState.vb[1], batchedDrawState.indexBuffer})
+	{
+		if (buffer == nullptr)
+			continue;
+
+		if (buffer->getMode() == BUFFERUSAGE_INDEX)
+			stats.streamIndexBufferSize += buffer->getSize();
+		else
+			stats.streamVertexBufferSize += buffer->getSize();
+
+		stats.streamBufferStalls += buffer->getStallCount();
+	}
 
 	return stats;
 }
@@ -2894,6 +3581,7 @@ STRINGMAP_CLASS_BEGIN(Graphics, Graphics::Feature, Graphics::FEATURE_MAX_ENUM, f
 	{ "texelbuffer",              Graphics::FEATURE_TEXEL_BUFFER         },
 	{ "copytexturetobuffer",      Graphics::FEATURE_COPY_TEXTURE_TO_BUFFER },
 	{ "indirectdraw",             Graphics::FEATURE_INDIRECT_DRAW        },
+	{ "multidrawindirect",        Graphics::FEATURE_MULTI_DRAW_INDIRECT  },
 }
 STRINGMAP_CLASS_END(Graphics, Graphics::Feature, Graphics::FEATURE_MAX_ENUM, feature)
 
@@ -2922,6 +3610,17 @@ STRINGMAP_CLASS_BEGIN(Graphics, Graphics::StackType, Graphics::STACK_MAX_ENUM, s
 }
 STRINGMAP_CLASS_END(Graphics, Graphics::StackType, Graphics::STACK_MAX_ENUM, stackType)
 
+STRINGMAP_CLASS_BEGIN(Graphics, Graphics::BatchFlushReason, Graphics::BATCHFLUSH_MAX_ENUM, batchFlushReason)
+{
+	{ "other",    Graphics::BATCHFLUSH_OTHER    },
+	{ "texture",  Graphics::BATCHFLUSH_TEXTURE  },
+	{ "shader",   Graphics::BATCHFLUSH_SHADER   },
+	{ "blend",    Graphics::BATCHFLUSH_BLEND    },
+	{ "format",   Graphics::BATCHFLUSH_FORMAT   },
+	{ "overflow", Graphics::BATCHFLUSH_OVERFLOW },
+}
+STRINGMAP_CLASS_END(Graphics, Graphics::BatchFlushReason, Graphics::BATCHFLUSH_MAX_ENUM, batchFlushReason)
+
 STRINGMAP_BEGIN(Renderer, RENDERER_MAX_ENUM, renderer)
 {
 	{ "opengl", RENDERER_OPENGL },
@@ -37,6 +37,7 @@
 #include "Shader.h"
 #include "Quad.h"
 #include "Mesh.h"
+#include "SpriteBatch.h"
 #include "GraphicsReadback.h"
 #include "Deprecations.h"
 #include "renderstate.h"
@@ -56,9 +57,9 @@ namespace love
 namespace graphics
 {
 
-class SpriteBatch;
 class ParticleSystem;
 class TextBatch;
+class TileMap;
 class Video;
 class Buffer;
 
@@ -160,6 +161,7 @@ class Graphics : public Module
 		FEATURE_TEXEL_BUFFER,
 		FEATURE_COPY_TEXTURE_TO_BUFFER,
 		FEATURE_INDIRECT_DRAW,
+		FEATURE_MULTI_DRAW_INDIRECT, // Multi-draw indirect plus love_DrawID in shaders.
 		FEATURE_MAX_ENUM
 	};
 
@@ -188,6 +190,18 @@ class Graphics : public Module
 		STACK_MAX_ENUM
 	};
 
+	// Why a batch of draws was submitted before more could be added to it.
+	enum BatchFlushReason
+	{
+		BATCHFLUSH_OTHER, // State changes, non-batched draws, present, etc.
+		BATCHFLUSH_TEXTURE,
+		BATCHFLUSH_SHADER,
+		BATCHFLUSH_BLEND,
+		BATCHFLUSH_FORMAT, // Vertex format, primitive type, or index mode.
+		BATCHFLUSH_OVERFLOW, // Stream buffer full, or too many vertices.
+		BATCHFLUSH_MAX_ENUM
+	};
+
 	enum TemporaryRenderTargetFlags
 	{
 		TEMPORARY_RT_DEPTH   = (1 << 0),
@@ -227,6 +241,19 @@ class Graphics : public Module
 		int buffers;
 		int64 textureMemory;
 		int64 bufferMemory;
+		double gpuTime;
+		int batchFlushes[BATCHFLUSH_MAX_ENUM];
+		int64 streamVertexBufferSize;
+		int64 streamIndexBufferSize;
+		int streamBufferStalls;
+	};
+
+	struct GPUTiming
+	{
+		std::string name;
+		double time;
+		int depth;
+		bool renderPass;
 	};
 
 	struct DrawCommand
@@ -243,6 +270,10 @@ class Graphics : public Module
 		Buffer *indirectBuffer = nullptr;
 		size_t indirectBufferOffset = 0;
 
+		// Number of tightly packed argument structs read from indirectBuffer.
+		// Values above 1 submit a single multi-draw.
+		int indirectDrawCount = 1;
+
 		Texture *texture = nullptr;
 
 		// TODO: This should be moved out to a state transition API?
@@ -271,6 +302,10 @@ class Graphics : public Module
 		Buffer *indirectBuffer = nullptr;
 		size_t indirectBufferOffset = 0;
 
+		// Number of tightly packed argument structs read from indirectBuffer.
+		// Values above 1 submit a single multi-draw.
+		int indirectDrawCount = 1;
+
 		Texture *texture = nullptr;
 
 		// TODO: This should be moved out to a state transition API?
@@ -456,8 +491,9 @@ class Graphics : public Module
 	Font *newDefaultFont(int size, const font::TrueTypeRasterizer::Settings &settings);
 	Video *newVideo(love::video::VideoStream *stream, float dpiscale);
 
-	SpriteBatch *newSpriteBatch(Texture *texture, int size, BufferDataUsage usage);
+	SpriteBatch *newSpriteBatch(Texture *texture, int size, BufferDataUsage usage, SpriteBatch::StorageMode storage);
 	ParticleSystem *newParticleSystem(Texture *texture, int size);
+	TileMap *newTileMap(Texture *tileset, int width, int height, int tilewidth, int tileheight, PixelFormat format);
 
 	Shader *newShader(const std::vector<std::string> &stagessource, const Shader::CompileOptions &options);
 	Shader *newComputeShader(const std::string &source, const Shader::CompileOptions &options);
@@ -535,6 +571,12 @@ class Graphics : public Module
 	 **/
 	bool isCreated() const;
 
+	/**
+	 * Seconds spent compiling the default shaders the last time a viewport
+	 * was created. Used by the startup profile.
+	 **/
+	double getDefaultShaderCompileTime() const;
+
 	int getWidth() const;
 	int getHeight() const;
 	int getPixelWidth() const;
@@ -716,12 +758,12 @@ class Graphics : public Module
 	void drawLayer(Texture *texture, int layer, const Matrix4 &m);
 	void drawLayer(Texture *texture, int layer, Quad *quad, const Matrix4 &m);
 	void drawInstanced(Mesh *mesh, const Matrix4 &m, int instancecount);
-	void drawIndirect(Mesh *mesh, const Matrix4 &m, Buffer *indirectargs, int argsindex);
+	void drawIndirect(Mesh *mesh, const Matrix4 &m, Buffer *indirectargs, int argsindex, int drawcount);
 
 	void drawFromShader(PrimitiveType primtype, int vertexcount, int instancecount, Texture *maintexture);
 	void drawFromShader(Buffer *indexbuffer, int indexcount, int instancecount, int startindex, Texture *maintexture);
-	void drawFromShaderIndirect(PrimitiveType primtype, Buffer *indirectargs, int argsindex, Texture *maintexture);
-	void drawFromShaderIndirect(Buffer *indexbuffer, Buffer *indirectargs, int argsindex, Texture *maintexture);
+	void drawFromShaderIndirect(PrimitiveType primtype, Buffer *indirectargs, int argsindex, int drawcount, Texture *maintexture);
+	void drawFromShaderIndirect(Buffer *indexbuffer, Buffer *indirectargs, int argsindex, int drawcount, Texture *maintexture);
 
 	/**
 	 * Draws text at the specified coordinates
@@ -853,6 +895,21 @@ class Graphics : public Module
 	 **/
 	Stats getStats() const;
 
+	/**
+	 * Starts a named region whose GPU execution time is measured with
+	 * timestamp queries. Regions can be nested.
+	 **/
+	void beginProfileZone(const std::string &name);
+	void endProfileZone();
+
+	/**
+	 * Returns the GPU times of the render passes and profile zones of the most
+	 * recent frame whose timestamp queries have completed. Results lag behind
+	 * the current frame by a few frames.
+	 **/
+	const std::vector<GPUTiming> &getGPUTimings() const { return gpuTimings; }
+	bool isGPUTimingSupported() const { return isTimestampQuerySupported(); }
+
 	size_t getStackDepth() const;
 	void push(StackType type = STACK_TRANSFORM);
 	void pop();
@@ -884,6 +941,41 @@ class Graphics : public Module
 
 	static void flushBatchedDrawsGlobal();
 
+	/**
+	 * Mesh draws which aren't instanced or indirect can be queued instead of
+	 * drawn right away, when the system supports multi-draw indirect and no
+	 * custom shader or draw list is active. Consecutive queued draws which
+	 * share vertex buffers, index buffer, texture and primitive type are
+	 * submitted together as one multi-draw. The standard multi-draw shader
+	 * must be active when a draw is queued.
+	 **/
+	bool canBatchMeshDraws() const;
+	void batchMeshDraw(const DrawCommand &cmd);
+	void batchMeshDraw(const DrawIndexedCommand &cmd);
+
+	/**
+	 * Starts recording batched draws (sprites, shapes, text printed directly)
+	 * into a draw list instead of drawing them right away. When the list is
+	 * submitted, the draws are stably sorted by layer, shader, texture and
+	 * blend state and replayed, so draws which share state end up in the same
+	 * batch. Draws in the same layer can be reordered.
+	 *
+	 * Anything else which would end a batch, such as a mesh draw, a canvas or
+	 * scissor change, or sending values to the active shader, submits the
+	 * draws recorded so far before it happens. Values sent to a shader which
+	 * isn't active apply to all of its recorded draws.
+	 **/
+	void beginDrawList();
+	void submitDrawList();
+	bool isDrawListActive() const;
+
+	/**
+	 * Sets the sort key of subsequently recorded draws. Lower layers are drawn
+	 * first.
+	 **/
+	void setDrawListLayer(float layer);
+	float getDrawListLayer() const;
+
 	Texture *getTemporaryTexture(PixelFormat format, int w, int h, int samples);
 	void releaseTemporaryTexture(Texture *texture);
 
@@ -892,7 +984,7 @@ class Graphics : public Module
 
 	void cleanupCachedShaderStage(ShaderStageType type, const std::string &cachekey);
 
-	void validateIndirectArgsBuffer(IndirectArgsType argstype, Buffer *indirectargs, int argsindex);
+	void validateIndirectArgsBuffer(IndirectArgsType argstype, Buffer *indirectargs, int argsindex, int drawcount);
 
 	template <typename T>
 	T *getScratchBuffer(size_t count)
@@ -917,6 +1009,7 @@ class Graphics : public Module
 	STRINGMAP_CLASS_DECLARE(Feature);
 	STRINGMAP_CLASS_DECLARE(SystemLimit);
 	STRINGMAP_CLASS_DECLARE(StackType);
+	STRINGMAP_CLASS_DECLARE(BatchFlushReason);
 
 protected:
 
@@ -962,6 +1055,9 @@ class Graphics : public Module
 		SamplerState defaultSamplerState = SamplerState();
 	};
 
+	// Number of frames of stream buffer usage kept to decide when to resize.
+	static const int BATCH_HISTORY_FRAMES = 120;
+
 	struct BatchedDrawState
 	{
 		StreamBuffer *vb[2];
@@ -979,7 +1075,23 @@ class Graphics : public Module
 
 		bool flushing = false;
 
+		BatchFlushReason flushReason = BATCHFLUSH_OTHER;
+		int flushCounts[BATCHFLUSH_MAX_ENUM];
+
+		// Bytes used in the two vertex buffers and the index buffer, this
+		// frame and in each of the recent frames.
+		size_t frameUsedSizes[3];
+		size_t usedSizeHistory[BATCH_HISTORY_FRAMES][3];
+		int historyFrame = 0;
+
+		// Stream buffers never shrink below their initial sizes.
+		size_t minBufferSizes[3];
+
 		BatchedDrawState()
+			: flushCounts()
+			, frameUsedSizes()
+			, usedSizeHistory()
+			, minBufferSizes()
 		{
 			vb[0] = vb[1] = nullptr;
 			formats[0] = formats[1] = CommonFormat::NONE;
@@ -987,6 +1099,51 @@ class Graphics : public Module
 		}
 	};
 
+	struct MeshDrawState
+	{
+		VertexAttributes attributes;
+		BufferBindings buffers;
+		std::vector<StrongRef<Buffer>> bufferRefs;
+		StrongRef<Buffer> indexBuffer;
+		IndexDataType indexType = INDEX_UINT16;
+		PrimitiveType primitiveType = PRIMITIVE_TRIANGLES;
+		StrongRef<Texture> texture;
+		CullMode cullMode = CULL_NONE;
+
+		// Indirect arguments and transform + color of each queued draw.
+		std::vector<uint32> args;
+		std::vector<float> drawData;
+		int drawCount = 0;
+
+		bool flushing = false;
+
+		// Written at increasing offsets during a frame, so draws submitted
+		// earlier in the frame keep their data.
+		StrongRef<Buffer> argsBuffer;
+		StrongRef<Buffer> drawDataBuffer;
+		size_t argsOffset = 0;
+		size_t drawDataOffset = 0;
+	};
+
+	struct DrawListItem
+	{
+		float layer;
+		BatchedDrawCommand command;
+		StrongRef<Texture> texture;
+		StrongRef<Shader> shader;
+		BlendState blend;
+		size_t vertexOffsets[2];
+	};
+
+	struct DrawListState
+	{
+		bool active = false;
+		bool replaying = false;
+		float layer = 0.0f;
+		std::vector<DrawListItem> items;
+		std::vector<uint8> vertices[2];
+	};
+
 	struct TemporaryBuffer
 	{
 		Buffer *buffer;
@@ -1035,8 +1192,37 @@ class Graphics : public Module
 
 	void updatePendingReadbacks();
 
+	// Resizes the batching stream buffers based on recent usage and advances
+	// them to the next frame. Called by backends when presenting.
+	void nextBatchedDrawFrame();
+
+	void queueMeshDraw(const VertexAttributes &attributes, const BufferBindings &buffers, Resource *indexbuffer, IndexDataType indextype, PrimitiveType primtype, Texture *texture, CullMode cullmode);
+	void flushMeshDraws();
+	void reserveMeshDrawBuffer(StrongRef<Buffer> &buffer, size_t &offset, size_t size, DataFormat format, BufferUsageFlags usage);
+
+	// Number of frames of timestamp queries that can be in flight, and the
+	// number of timestamps each of those frames can hold.
+	static const int GPU_TIMING_FRAMES = 4;
+	static const int MAX_GPU_TIMESTAMPS = 256;
+
+	virtual bool isTimestampQuerySupported() const { return false; }
+	virtual void writeTimestampInternal(int /*frame*/, int /*query*/) {}
+
+	// Returns false if the queries of the frame haven't completed yet. Leaves
+	// the output empty if the results of the frame can't be used.
+	virtual bool getTimestampsInternal(int /*frame*/, int /*count*/, std::vector<uint64> &/*nanoseconds*/) { return false; }
+
+	void beginRenderPassTiming(Texture *firsttarget);
+	void endRenderPassTiming();
+	void finishGPUTimingFrame();
+	void updateGPUTimings();
+	void discardGPUTimings();
+
 	void releaseDefaultResources();
 
+	BatchedVertexData recordDrawListItem(const BatchedDrawCommand &command);
+	void replayDrawList();
+
 	void validateStencilState(const StencilState &s) const;
 	void validateDepthState(bool depthwrite) const;
 
@@ -1060,13 +1246,21 @@ class Graphics : public Module
 	bool created;
 	bool active;
 
+	double defaultShaderCompileTime;
+
 	StrongRef<love::graphics::Font> defaultFont;
 
 	std::vector<ScreenshotInfo> pendingScreenshotCallbacks;
 	std::vector<StrongRef<GraphicsReadback>> pendingReadbacks;
 
+	int gpuTimingFrame;
+
 	BatchedDrawState batchedDrawState;
 
+	DrawListState drawList;
+
+	MeshDrawState meshDrawState;
+
 	std::vector<Matrix4> transformStack;
 	Matrix4 deviceProjectionMatrix;
 
@@ -1096,15 +1290,42 @@ class Graphics : public Module
 
 private:
 
+	struct GPUTimingZone
+	{
+		std::string name;
+		int beginQuery = -1;
+		int endQuery = -1;
+		int depth = 0;
+		bool renderPass = false;
+	};
+
+	struct GPUTimingFrame
+	{
+		std::vector<GPUTimingZone> zones;
+		int queryCount = 0;
+		bool pending = false;
+	};
+
 	void checkSetDefaultFont();
 	int calculateEllipsePoints(float rx, float ry) const;
 
+	int writeGPUTimestamp();
+	bool readGPUTimingFrame(int frame);
+
 	Texture *defaultTextures[TEXTURE_MAX_ENUM][DATA_BASETYPE_MAX_ENUM][2];
 	Buffer *defaultTexelBuffers[DATA_BASETYPE_MAX_ENUM];
 	Buffer *defaultStorageBuffer;
 
 	std::vector<uint8> scratchBuffer;
 
+	GPUTimingFrame gpuTimingFrames[GPU_TIMING_FRAMES];
+	std::vector<GPUTimingZone> gpuZoneStack;
+	GPUTimingZone renderPassZone;
+	bool renderPassTimingActive;
+	std::vector<uint64> gpuTimestamps;
+	std::vector<GPUTiming> gpuTimings;
+	double gpuFrameTime;
+
 	std::unordered_map<std::string, ShaderStage *> cachedShaderStages[SHADERSTAGE_MAX_ENUM];
 
 }; // Graphics
@@ -293,28 +293,21 @@ void *Mesh::getVertexData() const
 void Mesh::setVertexDataModified(size_t offset, size_t size)
 {
 	if (vertexData != nullptr)
-		modifiedVertexData.encapsulate(offset, size);
+		modifiedVertexData.add(offset, size);
 }
 
 void Mesh::flush()
 {
-	if (vertexBuffer.get() && vertexData != nullptr && modifiedVertexData.isValid())
-	{
-		if (vertexBuffer->getDataUsage() == BUFFERDATAUSAGE_STREAM)
-		{
-			vertexBuffer->fill(0, vertexBuffer->getSize(), vertexData);
-		}
-		else
-		{
-			size_t offset = modifiedVertexData.getOffset();
-			size_t size = modifiedVertexData.getSize();
-			vertexBuffer->fill(offset, size, vertexData + offset);
-		}
+	// Queued draws of this Mesh have to see the data they were issued with.
+	bool vertexmodified = vertexBuffer.get() && vertexData != nullptr && !modifiedVertexData.isEmpty();
+	bool indexmodified = indexDataModified && indexData != nullptr && indexBuffer != nullptr;
+	if (vertexmodified || indexmodified)
+		Graphics::flushBatchedDrawsGlobal();
 
-		modifiedVertexData.invalidate();
-	}
+	if (vertexmodified)
+		vertexBuffer->fillRanges(modifiedVertexData, 1, vertexData);
 
-	if (indexDataModified && indexData != nullptr && indexBuffer != nullptr)
+	if (indexmodified)
 	{
 		indexBuffer->fill(0, indexBuffer->getSize(), indexData);
 		indexDataModified = false;
@@ -548,20 +541,20 @@ bool Mesh::getDrawRange(int &start, int &count) const
 
 void Mesh::draw(Graphics *gfx, const love::Matrix4 &m)
 {
-	drawInternal(gfx, m, 1, nullptr, 0);
+	drawInternal(gfx, m, 1, nullptr, 0, 1);
 }
 
 void Mesh::drawInstanced(Graphics *gfx, const Matrix4 &m, int instancecount)
 {
-	drawInternal(gfx, m, instancecount, nullptr, 0);
+	drawInternal(gfx, m, instancecount, nullptr, 0, 1);
 }
 
-void Mesh::drawIndirect(Graphics *gfx, const Matrix4 &m, Buffer *indirectargs, int argsindex)
+void Mesh::drawIndirect(Graphics *gfx, const Matrix4 &m, Buffer *indirectargs, int argsindex, int drawcount)
 {
-	drawInternal(gfx, m, 0, indirectargs, argsindex);
+	drawInternal(gfx, m, 0, indirectargs, argsindex, drawcount);
 }
 
-void Mesh::drawInternal(Graphics *gfx, const Matrix4 &m, int instancecount, Buffer *indirectargs, int argsindex)
+void Mesh::drawInternal(Graphics *gfx, const Matrix4 &m, int instancecount, Buffer *indirectargs, int argsindex, int drawcount)
 {
 	if (vertexCount <= 0 || (instancecount <= 0 && indirectargs == nullptr))
 		return;
@@ -572,9 +565,9 @@ void Mesh::drawInternal(Graphics *gfx, const Matrix4 &m, int instancecount, Buff
 			throw love::Exception("The fan draw mode is not supported in indirect draws.");
 
 		if (useIndexBuffer && indexBuffer != nullptr)
-			gfx->validateIndirectArgsBuffer(Graphics::INDIRECT_ARGS_DRAW_INDICES, indirectargs, argsindex);
+			gfx->validateIndirectArgsBuffer(Graphics::INDIRECT_ARGS_DRAW_INDICES, indirectargs, argsindex, drawcount);
 		else
-			gfx->validateIndirectArgsBuffer(Graphics::INDIRECT_ARGS_DRAW_VERTICES, indirectargs, argsindex);
+			gfx->validateIndirectArgsBuffer(Graphics::INDIRECT_ARGS_DRAW_VERTICES, indirectargs, argsindex, drawcount);
 	}
 
 	// Some graphics backends don't natively support triangle fans. So we'd
@@ -583,11 +576,20 @@ void Mesh::drawInternal(Graphics *gfx, const Matrix4 &m, int instancecount, Buff
 	if (primitiveType == PRIMITIVE_TRIANGLE_FAN && useIndexBuffer && indexBuffer != nullptr)
 		throw love::Exception("The 'fan' Mesh draw mode cannot be used with an index buffer / vertex map.");
 
-	gfx->flushBatchedDraws();
+	// Plain draws with the default shader can be merged with neighbouring
+	// draws of the same vertex data into one multi-draw.
+	bool batch = instancecount == 1 && indirectargs == nullptr
+		&& primitiveType != PRIMITIVE_POINTS && primitiveType != PRIMITIVE_TRIANGLE_FAN
+		&& gfx->canBatchMeshDraws();
+
+	if (!batch)
+		gfx->flushBatchedDraws();
 
 	flush();
 
-	if (Shader::isDefaultActive())
+	if (batch)
+		Shader::attachDefault(Shader::STANDARD_MULTI_DRAW);
+	else if (Shader::isDefaultActive())
 		Shader::attachDefault(primitiveType == PRIMITIVE_POINTS ? Shader::STANDARD_POINTS : Shader::STANDARD_DEFAULT);
 
 	if (Shader::current)
@@ -673,8 +675,11 @@ void Mesh::drawInternal(Graphics *gfx, const Matrix4 &m, int instancecount, Buff
 
 		cmd.indirectBuffer = indirectargs;
 		cmd.indirectBufferOffset = argsindex * (indirectargs != nullptr ? indirectargs->getArrayStride() : 0);
+		cmd.indirectDrawCount = drawcount;
 
-		if (cmd.indexCount > 0)
+		if (cmd.indexCount > 0 && batch)
+			gfx->batchMeshDraw(cmd);
+		else if (cmd.indexCount > 0)
 			gfx->draw(cmd);
 	}
 	else if (vertexCount > 0 || indirectargs != nullptr)
@@ -694,8 +699,11 @@ void Mesh::drawInternal(Graphics *gfx, const Matrix4 &m, int instancecount, Buff
 
 		cmd.indirectBuffer = indirectargs;
 		cmd.indirectBufferOffset = argsindex * (indirectargs != nullptr ? indirectargs->getArrayStride() : 0);
+		cmd.indirectDrawCount = drawcount;
 
-		if (cmd.vertexCount > 0)
+		if (cmd.vertexCount > 0 && batch)
+			gfx->batchMeshDraw(cmd);
+		else if (cmd.vertexCount > 0)
 			gfx->draw(cmd);
 	}
 }
@@ -25,7 +25,7 @@
 #include "common/int.h"
 #include "common/math.h"
 #include "common/StringMap.h"
-#include "common/Range.h"
+#include "common/RangeSet.h"
 #include "Drawable.h"
 #include "Texture.h"
 #include "vertex.h"
@@ -178,7 +178,7 @@ class Mesh : public Drawable
 	void draw(Graphics *gfx, const Matrix4 &m) override;
 
 	void drawInstanced(Graphics *gfx, const Matrix4 &m, int instancecount);
-	void drawIndirect(Graphics *gfx, const Matrix4 &m, Buffer *indirectargs, int argsindex);
+	void drawIndirect(Graphics *gfx, const Matrix4 &m, Buffer *indirectargs, int argsindex, int drawcount);
 
 	static std::vector<Buffer::DataDeclaration> getDefaultVertexFormat();
 
@@ -190,7 +190,7 @@ class Mesh : public Drawable
 	int getAttachedAttributeIndex(const std::string &name) const;
 	void finalizeAttribute(BufferAttribute &attrib) const;
 
-	void drawInternal(Graphics *gfx, const Matrix4 &m, int instancecount, Buffer *indirectargs, int argsindex);
+	void drawInternal(Graphics *gfx, const Matrix4 &m, int instancecount, Buffer *indirectargs, int argsindex, int drawcount);
 
 	std::vector<Buffer::DataMember> vertexFormat;
 
@@ -199,7 +199,7 @@ class Mesh : public Drawable
 	// Vertex buffer, for the vertex data.
 	StrongRef<Buffer> vertexBuffer;
 	uint8 *vertexData = nullptr;
-	Range modifiedVertexData = Range();
+	RangeSet modifiedVertexData;
 
 	size_t vertexCount = 0;
 	size_t vertexStride = 0;
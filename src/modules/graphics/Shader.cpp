@@ -222,6 +222,11 @@ static const char vertex_header[] = R"(
 #define varying out
 #define love_VertexID gl_VertexID
 #define love_InstanceID gl_InstanceID
+#ifdef LOVE_DRAW_ID
+	#define love_DrawID gl_DrawIDARB
+#else
+	#define love_DrawID 0
+#endif
 )";
 
 static const char vertex_functions[] = R"(
@@ -610,6 +615,10 @@ std::string Shader::createShaderStageCode(Graphics *gfx, ShaderStageType stage,
 
 	ss << (gles ? glsl::versions[lang].glsles : glsl::versions[lang].glsl) << "\n";
 
+	// Lets vertex shaders index per-draw data in multi-draw indirect calls.
+	if (stage == SHADERSTAGE_VERTEX && !gles && gfx->getCapabilities().features[Graphics::FEATURE_MULTI_DRAW_INDIRECT])
+		ss << "#extension GL_ARB_shader_draw_parameters : enable\n#define LOVE_DRAW_ID 1\n";
+
 	if (isGammaCorrect())
 		ss << "#define LOVE_GAMMA_CORRECT 1\n";
 	if (info.usesMRT)
@@ -1627,6 +1636,50 @@ vec4 position(mat4 clipSpaceFromLocal, vec4 localPosition)
 }
 )";
 
+// Expands the per-instance data of instanced SpriteBatches into quads. Each
+// instance is drawn as a 4-vertex triangle strip, with the quad's geometry and
+// texture coordinates coming from the batch's quad table.
+static const std::string defaultSpritesVertex = R"(
+attribute vec3 love_SpriteTransformX;
+attribute vec3 love_SpriteTransformY;
+attribute uvec2 love_SpriteQuad;
+
+uniform highp samplerBuffer love_SpriteQuads;
+
+vec4 position(mat4 clipSpaceFromLocal, vec4 localPosition)
+{
+	vec2 corner = vec2(float(love_VertexID >> 1), float(love_VertexID & 1));
+	int quad = int(love_SpriteQuad.x) * 2;
+	vec4 quadpos = texelFetch(love_SpriteQuads, quad);
+	vec4 quadtex = texelFetch(love_SpriteQuads, quad + 1);
+	vec3 p = vec3(quadpos.xy + corner * quadpos.zw, 1.0);
+	localPosition.xy = vec2(dot(love_SpriteTransformX, p), dot(love_SpriteTransformY, p));
+	VaryingTexCoord = vec4(mix(quadtex.xy, quadtex.zw, corner), float(love_SpriteQuad.y), 1.0);
+	return clipSpaceFromLocal * localPosition;
+}
+)";
+
+// Mesh draws merged into one multi-draw fetch their transform and color from
+// the draw data buffer, five texels per draw: the four columns of the
+// view-from-local matrix followed by the (gamma-corrected) constant color.
+static const std::string defaultMultiDrawVertex = R"(
+uniform highp samplerBuffer love_DrawData;
+uniform int love_DrawDataOffset;
+
+vec4 position(mat4 clipSpaceFromLocal, vec4 localPosition)
+{
+	int i = (love_DrawDataOffset + love_DrawID) * 5;
+	mat4 viewFromLocal = mat4(
+		texelFetch(love_DrawData, i + 0),
+		texelFetch(love_DrawData, i + 1),
+		texelFetch(love_DrawData, i + 2),
+		texelFetch(love_DrawData, i + 3)
+	);
+	VaryingColor = gammaCorrectColor(VertexColor) * texelFetch(love_DrawData, i + 4);
+	return ClipSpaceFromView * (viewFromLocal * localPosition);
+}
+)";
+
 static const std::string defaultStandardPixel = R"(
 vec4 effect(vec4 vcolor, Image tex, vec2 texcoord, vec2 pixcoord)
 {
@@ -1634,6 +1687,19 @@ vec4 effect(vec4 vcolor, Image tex, vec2 texcoord, vec2 pixcoord)
 }
 )";
 
+// Signed distance field glyphs store the distance to the outline in alpha, with
+// 0.5 on the edge. Antialiasing over one screen pixel keeps them sharp at any
+// scale or rotation.
+static const std::string defaultSDFPixel = R"(
+vec4 effect(vec4 vcolor, Image tex, vec2 texcoord, vec2 pixcoord)
+{
+	float dist = Texel(tex, texcoord).a;
+	float width = max(fwidth(dist) * 0.5, 0.001);
+	float alpha = smoothstep(0.5 - width, 0.5 + width, dist);
+	return vec4(vcolor.rgb, vcolor.a * alpha);
+}
+)";
+
 static const std::string defaultVideoPixel = R"(
 void effect()
 {
@@ -1649,12 +1715,72 @@ void effect()
 }
 )";
 
+// Tile maps store one tile id per texel of an unsigned integer texture, and are
+// drawn as a single quad whose texture coordinates are in tile units. Id 0 is
+// an empty cell, id n is the n-th tile of the tileset (row-major in an atlas,
+// or layer n-1 of an array texture). love_TileMapParams.xy is the tile size in
+// tileset pixels and z is the number of tile columns in an atlas. Gradients
+// come from the continuous map coordinates so mipmap selection doesn't jump at
+// tile edges.
+static const std::string defaultTileMapPixel = R"(
+uniform Image MainTex;
+uniform highp usampler2D love_TileMapIDs;
+uniform highp vec4 love_TileMapParams;
+
+void effect()
+{
+	highp vec2 mappos = VaryingTexCoord.xy;
+	uint id = texelFetch(love_TileMapIDs, ivec2(floor(mappos)), 0).r;
+	if (id == 0u)
+		discard;
+
+	int index = int(id - 1u);
+	int columns = max(int(love_TileMapParams.z), 1);
+	highp vec2 tilesize = love_TileMapParams.xy;
+	highp vec2 tile = vec2(float(index % columns), float(index / columns));
+	highp vec2 local = clamp(fract(mappos) * tilesize, vec2(0.5), tilesize - 0.5);
+
+	highp vec2 texsize = vec2(textureSize(MainTex, 0));
+	highp vec2 texscale = tilesize / texsize;
+	highp vec2 uv = (tile * tilesize + local) / texsize;
+	love_PixelColor = textureGrad(MainTex, uv, dFdx(mappos) * texscale, dFdy(mappos) * texscale) * VaryingColor;
+}
+)";
+
+static const std::string defaultTileMapArrayPixel = R"(
+uniform ArrayImage MainTex;
+uniform highp usampler2D love_TileMapIDs;
+uniform highp vec4 love_TileMapParams;
+
+void effect()
+{
+	highp vec2 mappos = VaryingTexCoord.xy;
+	uint id = texelFetch(love_TileMapIDs, ivec2(floor(mappos)), 0).r;
+	if (id == 0u)
+		discard;
+
+	highp vec2 tilesize = love_TileMapParams.xy;
+	highp vec2 local = clamp(fract(mappos) * tilesize, vec2(0.5), tilesize - 0.5) / tilesize;
+	highp vec3 uvw = vec3(local, float(id - 1u));
+	love_PixelColor = textureGrad(MainTex, uvw, dFdx(mappos), dFdy(mappos)) * VaryingColor;
+}
+)";
+
+bool Shader::isDefaultTexelBufferShader(StandardShader shader)
+{
+	return shader == STANDARD_SPRITES || shader == STANDARD_SPRITES_ARRAY || shader == STANDARD_MULTI_DRAW;
+}
+
 const std::string &Shader::getDefaultCode(StandardShader shader, ShaderStageType stage)
 {
 	if (stage == SHADERSTAGE_VERTEX)
 	{
 		if (shader == STANDARD_POINTS)
 			return defaultPointsVertex;
+		else if (shader == STANDARD_SPRITES || shader == STANDARD_SPRITES_ARRAY)
+			return defaultSpritesVertex;
+		else if (shader == STANDARD_MULTI_DRAW)
+			return defaultMultiDrawVertex;
 		else
 			return defaultVertex;
 	}
@@ -1667,6 +1793,12 @@ const std::string &Shader::getDefaultCode(StandardShader shader, ShaderStageType
 		case STANDARD_VIDEO: return defaultVideoPixel;
 		case STANDARD_ARRAY: return defaultArrayPixel;
 		case STANDARD_POINTS: return defaultStandardPixel;
+		case STANDARD_SPRITES: return defaultStandardPixel;
+		case STANDARD_SPRITES_ARRAY: return defaultArrayPixel;
+		case STANDARD_SDF: return defaultSDFPixel;
+		case STANDARD_TILEMAP: return defaultTileMapPixel;
+		case STANDARD_TILEMAP_ARRAY: return defaultTileMapArrayPixel;
+		case STANDARD_MULTI_DRAW: return defaultStandardPixel;
 		case STANDARD_MAX_ENUM: return nocode;
 	}
 
@@ -1683,11 +1815,15 @@ static StringMap<Shader::Language, Shader::LANGUAGE_MAX_ENUM> languages(language
 
 static StringMap<Shader::BuiltinUniform, Shader::BUILTIN_MAX_ENUM>::Entry builtinNameEntries[] =
 {
-	{ "MainTex",               Shader::BUILTIN_TEXTURE_MAIN      },
-	{ "love_VideoYChannel",    Shader::BUILTIN_TEXTURE_VIDEO_Y   },
-	{ "love_VideoCbChannel",   Shader::BUILTIN_TEXTURE_VIDEO_CB  },
-	{ "love_VideoCrChannel",   Shader::BUILTIN_TEXTURE_VIDEO_CR  },
-	{ "love_UniformsPerDraw",  Shader::BUILTIN_UNIFORMS_PER_DRAW },
+	{ "MainTex",               Shader::BUILTIN_TEXTURE_MAIN        },
+	{ "love_VideoYChannel",    Shader::BUILTIN_TEXTURE_VIDEO_Y     },
+	{ "love_VideoCbChannel",   Shader::BUILTIN_TEXTURE_VIDEO_CB    },
+	{ "love_VideoCrChannel",   Shader::BUILTIN_TEXTURE_VIDEO_CR    },
+	{ "love_TileMapIDs",       Shader::BUILTIN_TEXTURE_TILEMAP_IDS },
+	{ "love_UniformsPerDraw",  Shader::BUILTIN_UNIFORMS_PER_DRAW   },
+	{ "love_TileMapParams",    Shader::BUILTIN_TILEMAP_PARAMS      },
+	{ "love_DrawData",         Shader::BUILTIN_BUFFER_DRAW_DATA    },
+	{ "love_DrawDataOffset",   Shader::BUILTIN_DRAW_DATA_OFFSET    },
 };
 
 static StringMap<Shader::BuiltinUniform, Shader::BUILTIN_MAX_ENUM> builtinNames(builtinNameEntries, sizeof(builtinNameEntries));
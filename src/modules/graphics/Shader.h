@@ -63,7 +63,11 @@ class Shader : public Object, public Resource
 		BUILTIN_TEXTURE_VIDEO_Y,
 		BUILTIN_TEXTURE_VIDEO_CB,
 		BUILTIN_TEXTURE_VIDEO_CR,
+		BUILTIN_TEXTURE_TILEMAP_IDS,
 		BUILTIN_UNIFORMS_PER_DRAW,
+		BUILTIN_TILEMAP_PARAMS,
+		BUILTIN_BUFFER_DRAW_DATA,
+		BUILTIN_DRAW_DATA_OFFSET,
 		BUILTIN_MAX_ENUM
 	};
 
@@ -89,6 +93,12 @@ class Shader : public Object, public Resource
 		STANDARD_VIDEO,
 		STANDARD_ARRAY,
 		STANDARD_POINTS,
+		STANDARD_SPRITES,
+		STANDARD_SPRITES_ARRAY,
+		STANDARD_SDF,
+		STANDARD_TILEMAP,
+		STANDARD_TILEMAP_ARRAY,
+		STANDARD_MULTI_DRAW,
 		STANDARD_MAX_ENUM
 	};
 
@@ -279,6 +289,10 @@ class Shader : public Object, public Resource
 
 	static const std::string &getDefaultCode(StandardShader shader, ShaderStageType stage);
 
+	// Whether the standard shader reads texel buffers, and so can only be
+	// created when they're supported.
+	static bool isDefaultTexelBufferShader(StandardShader shader);
+
 	static bool getConstant(const char *in, Language &out);
 	static bool getConstant(Language in, const char *&out);
 
@@ -40,7 +40,10 @@ namespace graphics
 
 love::Type SpriteBatch::type("SpriteBatch", &Drawable::type);
 
-SpriteBatch::SpriteBatch(Graphics *gfx, Texture *texture, int size, BufferDataUsage usage)
+// The instance buffer's format declaration has to match this layout.
+static_assert(sizeof(SpriteBatch::Instance) == 32, "Unexpected SpriteBatch::Instance size.");
+
+SpriteBatch::SpriteBatch(Graphics *gfx, Texture *texture, int size, BufferDataUsage usage, StorageMode storage)
 	: texture(texture)
 	, size(size)
 	, next(0)
@@ -49,6 +52,8 @@ SpriteBatch::SpriteBatch(Graphics *gfx, Texture *texture, int size, BufferDataUs
 	, array_buf(nullptr)
 	, vertex_data(nullptr)
 	, modified_sprites()
+	, storage_mode(storage)
+	, quad_table_modified(false)
 	, range_start(-1)
 	, range_count(-1)
 {
@@ -65,7 +70,13 @@ SpriteBatch::SpriteBatch(Graphics *gfx, Texture *texture, int size, BufferDataUs
 
 	vertex_stride = getFormatStride(vertex_format);
 
-	size_t vertex_size = vertex_stride * 4 * size;
+	if (storage_mode == STORAGE_INSTANCES)
+	{
+		if (!gfx->getCapabilities().features[Graphics::FEATURE_TEXEL_BUFFER])
+			throw love::Exception("Instanced SpriteBatches are not supported on this system (texel buffers are required).");
+	}
+
+	size_t vertex_size = getSpriteStride() * size;
 
 	vertex_data = (uint8 *) malloc(vertex_size);
 	if (vertex_data == nullptr)
@@ -74,7 +85,7 @@ SpriteBatch::SpriteBatch(Graphics *gfx, Texture *texture, int size, BufferDataUs
 	memset(vertex_data, 0, vertex_size);
 
 	Buffer::Settings settings(BUFFERUSAGEFLAG_VERTEX, usage);
-	auto decl = Buffer::getCommonFormatDeclaration(vertex_format);
+	auto decl = getArrayFormatDeclaration();
 
 	array_buf.set(gfx->newBuffer(settings, decl, nullptr, vertex_size, 0), Acquire::NORETAIN);
 }
@@ -91,9 +102,13 @@ int SpriteBatch::add(const Matrix4 &m, int index /*= -1*/)
 
 int SpriteBatch::add(Quad *quad, const Matrix4 &m, int index /*= -1*/)
 {
+	// addLayer validates the quad's layer, in both storage modes.
 	if (vertex_format == CommonFormat::XYf_STPf_RGBAub)
 		return addLayer(quad->getLayer(), quad, m, index);
 
+	if (storage_mode == STORAGE_INSTANCES)
+		return addInstance(0, quad, m, index);
+
 	if (index < -1 || index >= size)
 		throw love::Exception("Invalid sprite index: %d", index + 1);
 
@@ -117,7 +132,7 @@ int SpriteBatch::add(Quad *quad, const Matrix4 &m, int index /*= -1*/)
 		verts[i].color = color;
 	}
 
-	modified_sprites.encapsulate(spriteindex);
+	modified_sprites.add(spriteindex);
 
 	// Increment counter.
 	if (index == -1)
@@ -142,6 +157,9 @@ int SpriteBatch::addLayer(int layer, Quad *quad, const Matrix4 &m, int index)
 	if (layer < 0 || layer >= texture->getLayerCount())
 		throw love::Exception("Invalid layer: %d (Texture has %d layers)", layer + 1, texture->getLayerCount());
 
+	if (storage_mode == STORAGE_INSTANCES)
+		return addInstance(layer, quad, m, index);
+
 	if (index == -1 && next >= size)
 		setBufferSize(size * 2);
 
@@ -163,7 +181,43 @@ int SpriteBatch::addLayer(int layer, Quad *quad, const Matrix4 &m, int index)
 		verts[i].color = color;
 	}
 
-	modified_sprites.encapsulate(spriteindex);
+	modified_sprites.add(spriteindex);
+
+	// Increment counter.
+	if (index == -1)
+		return next++;
+
+	return index;
+}
+
+int SpriteBatch::addInstance(int layer, Quad *quad, const Matrix4 &m, int index)
+{
+	if (index < -1 || index >= size)
+		throw love::Exception("Invalid sprite index: %d", index + 1);
+
+	int quadindex = addQuad(quad);
+
+	if (index == -1 && next >= size)
+		setBufferSize(size * 2);
+
+	int spriteindex = (index == -1 ? next : index);
+
+	// Only the 2D affine part of the transform is used, the same as with
+	// Matrix4::transformXY in the vertex storage mode.
+	const float *e = m.getElements();
+	auto instance = (Instance *) (vertex_data + spriteindex * sizeof(Instance));
+
+	instance->transformX[0] = e[0];
+	instance->transformX[1] = e[4];
+	instance->transformX[2] = e[12];
+	instance->transformY[0] = e[1];
+	instance->transformY[1] = e[5];
+	instance->transformY[2] = e[13];
+	instance->quad = (uint16) quadindex;
+	instance->layer = (uint16) layer;
+	instance->color = color;
+
+	modified_sprites.add(spriteindex);
 
 	// Increment counter.
 	if (index == -1)
@@ -172,6 +226,98 @@ int SpriteBatch::addLayer(int layer, Quad *quad, const Matrix4 &m, int index)
 	return index;
 }
 
+int SpriteBatch::addQuad(Quad *quad)
+{
+	if (storage_mode != STORAGE_INSTANCES)
+		throw love::Exception("Quad tables are only used by instanced SpriteBatches.");
+
+	const Vector2 *positions = quad->getVertexPositions();
+	const Vector2 *texcoords = quad->getVertexTexCoords();
+
+	std::array<float, 8> entry = {
+		positions[0].x, positions[0].y,
+		positions[3].x - positions[0].x, positions[3].y - positions[0].y,
+		texcoords[0].x, texcoords[0].y,
+		texcoords[3].x, texcoords[3].y,
+	};
+
+	auto it = quad_indices.find(entry);
+	if (it != quad_indices.end())
+		return it->second;
+
+	int index = getQuadCount();
+	if (index >= MAX_QUADS)
+		throw love::Exception("Too many unique quads in SpriteBatch (the maximum is %d).", MAX_QUADS);
+
+	quad_table.insert(quad_table.end(), entry.begin(), entry.end());
+	quad_indices[entry] = index;
+	quad_table_modified = true;
+
+	return index;
+}
+
+int SpriteBatch::getQuadCount() const
+{
+	return (int) (quad_table.size() / 8);
+}
+
+void SpriteBatch::setInstances(int startindex, const Instance *instances, int count)
+{
+	if (storage_mode != STORAGE_INSTANCES)
+		throw love::Exception("setInstances can only be called on an instanced SpriteBatch.");
+
+	if (startindex < 0 || count < 0 || startindex > next)
+		throw love::Exception("Invalid sprite index: %d", startindex + 1);
+
+	int quadcount = getQuadCount();
+	int layercount = texture->getTextureType() == TEXTURE_2D_ARRAY ? texture->getLayerCount() : 1;
+
+	for (int i = 0; i < count; i++)
+	{
+		if (instances[i].quad >= quadcount)
+			throw love::Exception("Invalid quad index %d in instance %d (the SpriteBatch has %d quads).", instances[i].quad, i + 1, quadcount);
+		if (instances[i].layer >= layercount)
+			throw love::Exception("Invalid layer %d in instance %d.", instances[i].layer + 1, i + 1);
+	}
+
+	if (count == 0)
+		return;
+
+	if (startindex + count > size)
+	{
+		int newsize = size;
+		while (newsize < startindex + count)
+			newsize *= 2;
+		setBufferSize(newsize);
+	}
+
+	memcpy(vertex_data + startindex * sizeof(Instance), instances, count * sizeof(Instance));
+	modified_sprites.add(startindex, count);
+
+	next = std::max(next, startindex + count);
+}
+
+size_t SpriteBatch::getSpriteStride() const
+{
+	if (storage_mode == STORAGE_INSTANCES)
+		return sizeof(Instance);
+	else
+		return vertex_stride * 4;
+}
+
+std::vector<Buffer::DataDeclaration> SpriteBatch::getArrayFormatDeclaration() const
+{
+	if (storage_mode != STORAGE_INSTANCES)
+		return Buffer::getCommonFormatDeclaration(vertex_format);
+
+	return {
+		{ "love_SpriteTransformX", DATAFORMAT_FLOAT_VEC3 },
+		{ "love_SpriteTransformY", DATAFORMAT_FLOAT_VEC3 },
+		{ "love_SpriteQuad", DATAFORMAT_UINT16_VEC2 },
+		{ graphics::getConstant(ATTRIB_COLOR), DATAFORMAT_UNORM8_VEC4 },
+	};
+}
+
 void SpriteBatch::clear()
 {
 	// Reset the position of the next index.
@@ -180,18 +326,36 @@ void SpriteBatch::clear()
 
 void SpriteBatch::flush()
 {
-	if (modified_sprites.isValid())
+	if (!modified_sprites.isEmpty())
+		array_buf->fillRanges(modified_sprites, getSpriteStride(), vertex_data);
+
+	if (quad_table_modified)
+		flushQuadTable();
+}
+
+void SpriteBatch::flushQuadTable()
+{
+	size_t datasize = quad_table.size() * sizeof(float);
+
+	if (quad_buf.get() == nullptr || quad_buf->getSize() < datasize)
 	{
-		size_t offset = modified_sprites.getOffset() * vertex_stride * 4;
-		size_t size = modified_sprites.getSize() * vertex_stride * 4;
+		auto gfx = Module::getInstance<graphics::Graphics>(Module::M_GRAPHICS);
 
-		if (array_buf->getDataUsage() == BUFFERDATAUSAGE_STREAM)
-			array_buf->fill(0, array_buf->getSize(), vertex_data);
-		else
-			array_buf->fill(offset, size, vertex_data + offset);
+		size_t maxquads = (size_t) gfx->getCapabilities().limits[Graphics::LIMIT_TEXEL_BUFFER_SIZE] / 2;
+		if ((size_t) getQuadCount() > maxquads)
+			throw love::Exception("Too many unique quads in SpriteBatch (this system supports at most %d).", (int) maxquads);
+
+		// Grow geometrically, since quads are usually added a few at a time.
+		size_t quadcapacity = std::min(std::max<size_t>(64, (size_t) getQuadCount() * 2), maxquads);
+
+		Buffer::Settings settings(BUFFERUSAGEFLAG_TEXEL, BUFFERDATAUSAGE_DYNAMIC);
+		std::vector<Buffer::DataDeclaration> decl = {{"", DATAFORMAT_FLOAT_VEC4}};
 
-		modified_sprites.invalidate();
+		quad_buf.set(gfx->newBuffer(settings, decl, nullptr, quadcapacity * sizeof(float) * 8, 0), Acquire::NORETAIN);
 	}
+
+	quad_buf->fill(0, datasize, quad_table.data());
+	quad_table_modified = false;
 }
 
 void SpriteBatch::setTexture(Texture *newtexture)
@@ -235,7 +399,7 @@ void SpriteBatch::setBufferSize(int newsize)
 	if (newsize == size)
 		return;
 
-	size_t vertex_size = vertex_stride * 4 * newsize;
+	size_t vertex_size = getSpriteStride() * newsize;
 
 	int new_next = std::min(next, newsize);
 
@@ -245,11 +409,11 @@ void SpriteBatch::setBufferSize(int newsize)
 
 	auto gfx = Module::getInstance<graphics::Graphics>(Module::M_GRAPHICS);
 	Buffer::Settings settings(array_buf->getUsageFlags(), array_buf->getDataUsage());
-	auto decl = Buffer::getCommonFormatDeclaration(vertex_format);
+	auto decl = getArrayFormatDeclaration();
 
 	array_buf.set(gfx->newBuffer(settings, decl, nullptr, vertex_size, 0), Acquire::NORETAIN);
 
-	array_buf->fill(0, vertex_stride * 4 * new_next, new_vertex_data);
+	array_buf->fill(0, getSpriteStride() * new_next, new_vertex_data);
 
 	vertex_data = (uint8 *) new_vertex_data;
 
@@ -270,8 +434,9 @@ void SpriteBatch::attachAttribute(const std::string &name, Buffer *buffer, Mesh
 	AttachedAttribute oldattrib = {};
 	AttachedAttribute newattrib = {};
 
-	if (buffer->getArrayLength() < (size_t) next * 4)
-		throw love::Exception("Buffer has too few vertices to be attached to this SpriteBatch (at least %d vertices are required)", next*4);
+	int elementspersprite = storage_mode == STORAGE_INSTANCES ? 1 : 4;
+	if (buffer->getArrayLength() < (size_t) next * elementspersprite)
+		throw love::Exception("Buffer has too few vertices to be attached to this SpriteBatch (at least %d vertices are required)", next * elementspersprite);
 
 	auto it = attached_attributes.find(name);
 	if (it != attached_attributes.end())
@@ -286,7 +451,7 @@ void SpriteBatch::attachAttribute(const std::string &name, Buffer *buffer, Mesh
 	newattrib.mesh = mesh;
 
 	BuiltinVertexAttribute builtinattrib;
-	if (getConstant(name.c_str(), builtinattrib))
+	if (graphics::getConstant(name.c_str(), builtinattrib))
 		newattrib.builtinAttributeIndex = (int)builtinattrib;
 	else
 		newattrib.builtinAttributeIndex = -1;
@@ -325,26 +490,72 @@ void SpriteBatch::draw(Graphics *gfx, const Matrix4 &m)
 
 	gfx->flushBatchedDraws();
 
+	bool instanced = storage_mode == STORAGE_INSTANCES;
+
 	if (texture.get())
 	{
 		if (Shader::isDefaultActive())
 		{
 			Shader::StandardShader defaultshader = Shader::STANDARD_DEFAULT;
 			if (texture->getTextureType() == TEXTURE_2D_ARRAY)
-				defaultshader = Shader::STANDARD_ARRAY;
+				defaultshader = instanced ? Shader::STANDARD_SPRITES_ARRAY : Shader::STANDARD_ARRAY;
+			else if (instanced)
+				defaultshader = Shader::STANDARD_SPRITES;
 
 			Shader::attachDefault(defaultshader);
 		}
 	}
 
 	if (Shader::current)
-		Shader::current->validateDrawState(PRIMITIVE_TRIANGLES, texture);
+		Shader::current->validateDrawState(instanced ? PRIMITIVE_TRIANGLE_STRIP : PRIMITIVE_TRIANGLES, texture);
 
 	flush(); // Upload any modified sprite data to the GPU.
 
+	int start = std::min(std::max(0, range_start), next - 1);
+
+	int count = next;
+	if (range_count > 0)
+		count = std::min(count, range_count);
+
+	count = std::min(count, next - start);
+
 	VertexAttributes attributes;
 	BufferBindings buffers;
 
+	if (instanced)
+	{
+		if (Shader::current == nullptr)
+			throw love::Exception("A Shader is required to draw an instanced SpriteBatch.");
+
+		size_t stride = array_buf->getArrayStride();
+
+		buffers.set(0, array_buf, stride * start);
+		attributes.setBufferLayout(0, (uint16) stride, STEP_PER_INSTANCE);
+
+		for (const auto &member : array_buf->getDataMembers())
+		{
+			int attributeindex = -1;
+			BuiltinVertexAttribute builtinattrib;
+
+			if (graphics::getConstant(member.decl.name.c_str(), builtinattrib))
+				attributeindex = (int) builtinattrib;
+			else
+				attributeindex = Shader::current->getVertexAttributeIndex(member.decl.name);
+
+			if (attributeindex < 0)
+				throw love::Exception("The active Shader can't draw instanced SpriteBatches (it has no '%s' vertex input).", member.decl.name.c_str());
+
+			attributes.set(attributeindex, member.decl.format, (uint16) member.offset, 0);
+		}
+
+		const Shader::UniformInfo *quadsinfo = Shader::current->getUniformInfo("love_SpriteQuads");
+		if (quadsinfo == nullptr)
+			throw love::Exception("The active Shader can't draw instanced SpriteBatches (it has no 'love_SpriteQuads' uniform).");
+
+		Buffer *quadbuffer = quad_buf.get();
+		Shader::current->sendBuffers(quadsinfo, &quadbuffer, 1);
+	}
+	else
 	{
 		buffers.set(0, array_buf, 0);
 		attributes.setCommonFormat(vertex_format, 0);
@@ -352,13 +563,17 @@ void SpriteBatch::draw(Graphics *gfx, const Matrix4 &m)
 
 	int activebuffers = 1;
 
+	// Attached attributes are per-vertex in the vertex storage mode, and
+	// per-sprite in the instanced mode.
+	size_t elementspersprite = instanced ? 1 : 4;
+
 	for (const auto &it : attached_attributes)
 	{
 		Buffer *buffer = it.second.buffer.get();
 
 		// We have to do this check here as wll because setBufferSize can be
 		// called after attachAttribute.
-		if (buffer->getArrayLength() < (size_t) next * 4)
+		if (buffer->getArrayLength() < (size_t) next * elementspersprite)
 			throw love::Exception("Buffer with attribute '%s' attached to this SpriteBatch has too few vertices", it.first.c_str());
 
 		int attributeindex = it.second.builtinAttributeIndex;
@@ -379,30 +594,51 @@ void SpriteBatch::draw(Graphics *gfx, const Matrix4 &m)
 			uint16 stride = (uint16) buffer->getArrayStride();
 
 			attributes.set(attributeindex, member.decl.format, offset, activebuffers);
-			attributes.setBufferLayout(activebuffers, stride);
 
 			// TODO: We should reuse buffer bindings with the same buffer+stride+step.
-			buffers.set(activebuffers, buffer, 0);
+			if (instanced)
+			{
+				attributes.setBufferLayout(activebuffers, stride, STEP_PER_INSTANCE);
+				buffers.set(activebuffers, buffer, (size_t) stride * start);
+			}
+			else
+			{
+				attributes.setBufferLayout(activebuffers, stride);
+				buffers.set(activebuffers, buffer, 0);
+			}
+
 			activebuffers++;
 		}
 	}
 
 	Graphics::TempTransform transform(gfx, m);
 
-	int start = std::min(std::max(0, range_start), next - 1);
-
-	int count = next;
-	if (range_count > 0)
-		count = std::min(count, range_count);
-
-	count = std::min(count, next - start);
-
 	if (count > 0)
 	{
 		Texture *tex = gfx->getTextureOrDefaultForActiveShader(texture);
-		gfx->drawQuads(start, count, attributes, buffers, tex);
+
+		if (instanced)
+		{
+			// Each instance is expanded to a quad from the vertex ID.
+			Graphics::DrawCommand cmd(&attributes, &buffers);
+			cmd.primitiveType = PRIMITIVE_TRIANGLE_STRIP;
+			cmd.vertexStart = 0;
+			cmd.vertexCount = 4;
+			cmd.instanceCount = count;
+			cmd.texture = tex;
+			gfx->draw(cmd);
+		}
+		else
+			gfx->drawQuads(start, count, attributes, buffers, tex);
 	}
 }
 
+STRINGMAP_CLASS_BEGIN(SpriteBatch, SpriteBatch::StorageMode, SpriteBatch::STORAGE_MAX_ENUM, storageMode)
+{
+	{ "vertices",  SpriteBatch::STORAGE_VERTICES  },
+	{ "instances", SpriteBatch::STORAGE_INSTANCES },
+}
+STRINGMAP_CLASS_END(SpriteBatch, SpriteBatch::StorageMode, SpriteBatch::STORAGE_MAX_ENUM, storageMode)
+
 } // graphics
 } // love
@@ -25,12 +25,16 @@
 
 // C++
 #include <unordered_map>
+#include <map>
+#include <array>
+#include <vector>
 
 // LOVE
 #include "common/math.h"
 #include "common/Matrix.h"
 #include "common/Color.h"
-#include "common/Range.h"
+#include "common/RangeSet.h"
+#include "common/StringMap.h"
 #include "Drawable.h"
 #include "Mesh.h"
 #include "vertex.h"
@@ -52,7 +56,35 @@ class SpriteBatch : public Drawable
 
 	static love::Type type;
 
-	SpriteBatch(Graphics *gfx, Texture *texture, int size, BufferDataUsage usage);
+	/**
+	 * How sprites are stored in the SpriteBatch's GPU buffer.
+	 **/
+	enum StorageMode
+	{
+		// Four fully transformed vertices per sprite.
+		STORAGE_VERTICES,
+		// One Instance per sprite, expanded into a quad by the vertex shader.
+		STORAGE_INSTANCES,
+		STORAGE_MAX_ENUM
+	};
+
+	/**
+	 * The per-sprite data used by the instanced storage mode. The transform
+	 * rows map quad-local positions to batch-local positions, and quad is an
+	 * index into the batch's quad table (see addQuad).
+	 **/
+	struct Instance
+	{
+		float transformX[3];
+		float transformY[3];
+		uint16 quad;
+		uint16 layer;
+		Color32 color;
+	};
+
+	static const int MAX_QUADS = LOVE_UINT16_MAX + 1;
+
+	SpriteBatch(Graphics *gfx, Texture *texture, int size, BufferDataUsage usage, StorageMode storage);
 	virtual ~SpriteBatch();
 
 	int add(const Matrix4 &m, int index = -1);
@@ -64,6 +96,22 @@ class SpriteBatch : public Drawable
 
 	void flush();
 
+	StorageMode getStorageMode() const { return storage_mode; }
+
+	/**
+	 * Adds the quad's geometry and texture coordinates to the quad table used
+	 * by instanced SpriteBatches, if an identical entry isn't already there.
+	 * Returns the index of the entry, as stored in Instance::quad.
+	 **/
+	int addQuad(Quad *quad);
+	int getQuadCount() const;
+
+	/**
+	 * Replaces (or appends) count sprites starting at startindex with raw
+	 * Instance data. Only valid for instanced SpriteBatches.
+	 **/
+	void setInstances(int startindex, const Instance *instances, int count);
+
 	void setTexture(Texture *newtexture);
 	Texture *getTexture() const;
 
@@ -106,6 +154,8 @@ class SpriteBatch : public Drawable
 	// Implements Drawable.
 	void draw(Graphics *gfx, const Matrix4 &m) override;
 
+	STRINGMAP_CLASS_DECLARE(StorageMode);
+
 private:
 
 	struct AttachedAttribute
@@ -122,6 +172,12 @@ class SpriteBatch : public Drawable
 	 **/
 	void setBufferSize(int newsize);
 
+	int addInstance(int layer, Quad *quad, const Matrix4 &m, int index);
+	size_t getSpriteStride() const;
+	std::vector<Buffer::DataDeclaration> getArrayFormatDeclaration() const;
+
+	void flushQuadTable();
+
 	StrongRef<Texture> texture;
 
 	// Max number of sprites in the batch.
@@ -140,13 +196,22 @@ class SpriteBatch : public Drawable
 	StrongRef<love::graphics::Buffer> array_buf;
 	uint8 *vertex_data;
 
-	Range modified_sprites;
+	RangeSet modified_sprites;
+
+	StorageMode storage_mode;
+
+	// Quad table for instanced storage: two vec4s (position rect, texture
+	// coordinate rect) per unique quad.
+	std::vector<float> quad_table;
+	std::map<std::array<float, 8>, int> quad_indices;
+	StrongRef<love::graphics::Buffer> quad_buf;
+	bool quad_table_modified;
 
 	std::unordered_map<std::string, AttachedAttribute> attached_attributes;
 	
 	int range_start;
 	int range_count;
-	
+
 }; // SpriteBatch
 
 } // graphics
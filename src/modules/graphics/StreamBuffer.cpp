@@ -30,6 +30,7 @@ StreamBuffer::StreamBuffer(BufferUsage mode, size_t size)
 	: bufferSize(size)
 	, frameGPUReadOffset(0)
 	, mode(mode)
+	, stallCount(0)
 {
 }
 
@@ -57,6 +57,10 @@ class StreamBuffer : public love::Object, public Resource
 	BufferUsage getMode() const { return mode; }
 	size_t getUsableSize() const { return bufferSize - frameGPUReadOffset; }
 
+	// Number of times map() had to wait for the GPU to finish with memory.
+	int getStallCount() const { return stallCount; }
+	void resetStallCount() { stallCount = 0; }
+
 	virtual size_t getGPUReadOffset() const = 0;
 
 	virtual MapInfo map(size_t minsize) = 0;
@@ -72,6 +76,7 @@ class StreamBuffer : public love::Object, public Resource
 	size_t bufferSize;
 	size_t frameGPUReadOffset;
 	BufferUsage mode;
+	int stallCount;
 
 }; // StreamBuffer
 
@@ -260,7 +260,7 @@ void TextBatch::draw(Graphics *gfx, const Matrix4 &m)
 		regenerateVertices();
 
 	if (Shader::isDefaultActive())
-		Shader::attachDefault(Shader::STANDARD_DEFAULT);
+		Shader::attachDefault(font->isSDF() ? Shader::STANDARD_SDF : Shader::STANDARD_DEFAULT);
 
 	Texture *firsttex = nullptr;
 	if (!drawCommands.empty())
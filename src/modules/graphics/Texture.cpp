@@ -20,6 +20,7 @@
 
 // LOVE
 #include "common/config.h"
+#include "common/profiler.h"
 #include "Texture.h"
 #include "Graphics.h"
 
@@ -603,6 +604,8 @@ void Texture::uploadImageData(love::image::ImageDataBase *d, int level, int slic
 
 void Texture::replacePixels(love::image::ImageDataBase *d, int slice, int mipmap, int x, int y, bool reloadmipmaps)
 {
+	LOVE_PROFILE_ZONE("Texture::replacePixels");
+
 	if (!isReadable())
 		throw love::Exception("replacePixels can only be called on readable Textures.");
 
@@ -669,6 +672,8 @@ void Texture::replacePixels(love::image::ImageDataBase *d, int slice, int mipmap
 
 void Texture::replacePixels(const void *data, size_t size, int slice, int mipmap, const Rect &rect, bool reloadmipmaps)
 {
+	LOVE_PROFILE_ZONE("Texture::replacePixels");
+
 	if (!isReadable() || getMSAA() > 1)
 		return;
 
@@ -1137,6 +1142,7 @@ static StringMap<Texture::SettingType, Texture::SETTING_MAX_ENUM>::Entry setting
 	{ "viewformats",  Texture::SETTING_VIEW_FORMATS  },
 	{ "readable",     Texture::SETTING_READABLE      },
 	{ "debugname",    Texture::SETTING_DEBUGNAME     },
+	{ "compress",     Texture::SETTING_COMPRESS      },
 };
 
 static StringMap<Texture::SettingType, Texture::SETTING_MAX_ENUM> settingTypes(settingTypeEntries, sizeof(settingTypeEntries));
@@ -178,6 +178,7 @@ class Texture : public Drawable, public Resource
 		SETTING_VIEW_FORMATS,
 		SETTING_READABLE,
 		SETTING_DEBUGNAME,
+		SETTING_COMPRESS,
 		SETTING_MAX_ENUM
 	};
 
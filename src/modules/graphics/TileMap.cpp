@@ -0,0 +1,368 @@
+/**
+ * Copyright (c) 2006-2024 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+
+#include "TileMap.h"
+#include "Graphics.h"
+#include "Shader.h"
+
+// C++
+#include <algorithm>
+
+// C
+#include <string.h>
+
+namespace love
+{
+namespace graphics
+{
+
+love::Type TileMap::type("TileMap", &Drawable::type);
+
+TileMap::TileMap(Graphics *gfx, Texture *tileset, int width, int height, int tilewidth, int tileheight, PixelFormat format)
+	: tileset(tileset)
+	, idTexture(nullptr)
+	, vertexBuffer(nullptr)
+	, width(width)
+	, height(height)
+	, tileWidth(tilewidth)
+	, tileHeight(tileheight)
+	, format(format)
+	, idSize(0)
+	, modified(true)
+	, modifiedRect({0, 0, width, height})
+{
+	if (width <= 0 || height <= 0)
+		throw love::Exception("Invalid TileMap dimensions: %dx%d", width, height);
+
+	if (tilewidth <= 0 || tileheight <= 0)
+		throw love::Exception("Invalid TileMap tile dimensions: %dx%d", tilewidth, tileheight);
+
+	if (format == PIXELFORMAT_R16_UINT)
+		idSize = 2;
+	else if (format == PIXELFORMAT_R32_UINT)
+		idSize = 4;
+	else
+	{
+		const char *name = "unknown";
+		love::getConstant(format, name);
+		throw love::Exception("Invalid TileMap format '%s' (must be r16ui or r32ui).", name);
+	}
+
+	if (!gfx->isPixelFormatSupported(format, PIXELFORMATUSAGEFLAGS_SAMPLE))
+	{
+		const char *name = "unknown";
+		love::getConstant(format, name);
+		throw love::Exception("The %s pixel format is not supported for TileMaps on this system.", name);
+	}
+
+	validateTileset(tileset);
+
+	ids.resize((size_t) width * height * idSize, 0);
+
+	Texture::Settings settings;
+	settings.width = width;
+	settings.height = height;
+	settings.format = format;
+	settings.debugName = "TileMap ids";
+
+	idTexture.set(gfx->newTexture(settings, nullptr), Acquire::NORETAIN);
+
+	// The map is one quad whose texture coordinates are in tile units.
+	float w = (float) width * tilewidth;
+	float h = (float) height * tileheight;
+
+	XYf_STf_RGBAub vertices[4] =
+	{
+		{ 0.0f, 0.0f, 0.0f,           0.0f,            Color32(255, 255, 255, 255) },
+		{ 0.0f, h,    0.0f,           (float) height,  Color32(255, 255, 255, 255) },
+		{ w,    0.0f, (float) width,  0.0f,            Color32(255, 255, 255, 255) },
+		{ w,    h,    (float) width,  (float) height,  Color32(255, 255, 255, 255) },
+	};
+
+	Buffer::Settings buffersettings(BUFFERUSAGEFLAG_VERTEX, BUFFERDATAUSAGE_STATIC);
+	auto decl = Buffer::getCommonFormatDeclaration(CommonFormat::XYf_STf_RGBAub);
+
+	vertexBuffer.set(gfx->newBuffer(buffersettings, decl, vertices, sizeof(vertices), 0), Acquire::NORETAIN);
+}
+
+TileMap::~TileMap()
+{
+}
+
+void TileMap::validateTileset(Texture *tileset) const
+{
+	if (tileset == nullptr)
+		throw love::Exception("A tileset texture must be used with a TileMap.");
+
+	TextureType textype = tileset->getTextureType();
+
+	if (textype != TEXTURE_2D && textype != TEXTURE_2D_ARRAY)
+		throw love::Exception("TileMap tilesets must be 2D or array textures.");
+
+	if (textype == TEXTURE_2D && (tileWidth > tileset->getPixelWidth() || tileHeight > tileset->getPixelHeight()))
+		throw love::Exception("The TileMap's %dx%d tiles don't fit in its tileset texture.", tileWidth, tileHeight);
+
+	// ids.empty() while the TileMap is being constructed.
+	uint32 highest = ids.empty() ? 0 : getHighestUsedID();
+	if (highest > getTileCount(tileset))
+		throw love::Exception("The tileset only has %u tiles, but the TileMap uses tile id %u.", getTileCount(tileset), highest);
+}
+
+uint32 TileMap::getTileCount(Texture *tileset) const
+{
+	if (tileset->getTextureType() == TEXTURE_2D_ARRAY)
+		return (uint32) tileset->getLayerCount();
+
+	// Partial tiles at the right and bottom edges of an atlas aren't counted.
+	uint32 columns = (uint32) (tileset->getPixelWidth() / tileWidth);
+	uint32 rows = (uint32) (tileset->getPixelHeight() / tileHeight);
+	return columns * rows;
+}
+
+uint32 TileMap::getHighestUsedID() const
+{
+	uint32 highest = 0;
+	size_t count = (size_t) width * height;
+
+	if (idSize == 2)
+	{
+		const uint16 *data = (const uint16 *) ids.data();
+		for (size_t i = 0; i < count; i++)
+			highest = std::max(highest, (uint32) data[i]);
+	}
+	else
+	{
+		const uint32 *data = (const uint32 *) ids.data();
+		for (size_t i = 0; i < count; i++)
+			highest = std::max(highest, data[i]);
+	}
+
+	return highest;
+}
+
+void TileMap::checkTileID(uint32 id) const
+{
+	if (id > getMaxTileID())
+		throw love::Exception("Invalid tile id %u (the TileMap supports ids up to %u).", id, getMaxTileID());
+}
+
+void TileMap::markModified(int x, int y, int w, int h)
+{
+	if (!modified)
+	{
+		modifiedRect = {x, y, w, h};
+		modified = true;
+		return;
+	}
+
+	int x2 = std::max(modifiedRect.x + modifiedRect.w, x + w);
+	int y2 = std::max(modifiedRect.y + modifiedRect.h, y + h);
+
+	modifiedRect.x = std::min(modifiedRect.x, x);
+	modifiedRect.y = std::min(modifiedRect.y, y);
+	modifiedRect.w = x2 - modifiedRect.x;
+	modifiedRect.h = y2 - modifiedRect.y;
+}
+
+void TileMap::setID(size_t index, uint32 id)
+{
+	if (idSize == 2)
+		((uint16 *) ids.data())[index] = (uint16) id;
+	else
+		((uint32 *) ids.data())[index] = id;
+}
+
+void TileMap::setTile(int x, int y, uint32 id)
+{
+	if (x < 0 || y < 0 || x >= width || y >= height)
+		throw love::Exception("Invalid tile position: %d, %d", x, y);
+
+	checkTileID(id);
+	setID((size_t) y * width + x, id);
+	markModified(x, y, 1, 1);
+}
+
+uint32 TileMap::getTile(int x, int y) const
+{
+	if (x < 0 || y < 0 || x >= width || y >= height)
+		throw love::Exception("Invalid tile position: %d, %d", x, y);
+
+	size_t index = (size_t) y * width + x;
+
+	if (idSize == 2)
+		return ((const uint16 *) ids.data())[index];
+	else
+		return ((const uint32 *) ids.data())[index];
+}
+
+void TileMap::setTiles(int x, int y, int w, int h, const uint32 *tileids)
+{
+	if (w <= 0 || h <= 0)
+		return;
+
+	if (x < 0 || y < 0 || x + w > width || y + h > height)
+		throw love::Exception("Invalid tile region: %d, %d, %dx%d", x, y, w, h);
+
+	for (int i = 0; i < w * h; i++)
+		checkTileID(tileids[i]);
+
+	for (int row = 0; row < h; row++)
+	{
+		size_t index = (size_t) (y + row) * width + x;
+		for (int col = 0; col < w; col++)
+			setID(index + col, tileids[row * w + col]);
+	}
+
+	markModified(x, y, w, h);
+}
+
+void TileMap::fill(uint32 id)
+{
+	checkTileID(id);
+
+	size_t count = (size_t) width * height;
+	for (size_t i = 0; i < count; i++)
+		setID(i, id);
+
+	markModified(0, 0, width, height);
+}
+
+void TileMap::setTileset(Texture *tileset)
+{
+	validateTileset(tileset);
+	this->tileset.set(tileset);
+}
+
+Texture *TileMap::getTileset() const
+{
+	return tileset.get();
+}
+
+int TileMap::getWidth() const
+{
+	return width;
+}
+
+int TileMap::getHeight() const
+{
+	return height;
+}
+
+int TileMap::getTileWidth() const
+{
+	return tileWidth;
+}
+
+int TileMap::getTileHeight() const
+{
+	return tileHeight;
+}
+
+PixelFormat TileMap::getFormat() const
+{
+	return format;
+}
+
+uint32 TileMap::getMaxTileID() const
+{
+	uint32 formatmax = idSize == 2 ? 0xFFFF : 0xFFFFFFFF;
+	return std::min(formatmax, getTileCount(tileset));
+}
+
+void TileMap::flush()
+{
+	if (!modified)
+		return;
+
+	const Rect &r = modifiedRect;
+	size_t rowsize = (size_t) r.w * idSize;
+	const uint8 *src = ids.data() + ((size_t) r.y * width + r.x) * idSize;
+
+	// Full-width regions are already contiguous. Otherwise the modified rows
+	// are packed so only the touched texels are uploaded.
+	if (r.w == width)
+		idTexture->replacePixels(src, rowsize * r.h, 0, 0, r, false);
+	else
+	{
+		uploadData.resize(rowsize * r.h);
+		for (int row = 0; row < r.h; row++)
+			memcpy(uploadData.data() + row * rowsize, src + (size_t) row * width * idSize, rowsize);
+
+		idTexture->replacePixels(uploadData.data(), uploadData.size(), 0, 0, r, false);
+	}
+
+	modified = false;
+}
+
+void TileMap::draw(Graphics *gfx, const Matrix4 &m)
+{
+	gfx->flushBatchedDraws();
+
+	bool arraytileset = tileset->getTextureType() == TEXTURE_2D_ARRAY;
+
+	if (Shader::isDefaultActive())
+		Shader::attachDefault(arraytileset ? Shader::STANDARD_TILEMAP_ARRAY : Shader::STANDARD_TILEMAP);
+
+	if (Shader::current == nullptr)
+		throw love::Exception("A Shader is required to draw a TileMap.");
+
+	Shader::current->validateDrawState(PRIMITIVE_TRIANGLES, tileset);
+
+	flush(); // Upload any modified tile ids to the GPU.
+
+	const Shader::UniformInfo *idsinfo = Shader::current->getUniformInfo(Shader::BUILTIN_TEXTURE_TILEMAP_IDS);
+	if (idsinfo == nullptr)
+		throw love::Exception("The active Shader can't draw TileMaps (it has no 'love_TileMapIDs' uniform).");
+
+	Texture *idtex = idTexture.get();
+	Shader::current->sendTextures(idsinfo, &idtex, 1);
+
+	const Shader::UniformInfo *paramsinfo = Shader::current->getUniformInfo(Shader::BUILTIN_TILEMAP_PARAMS);
+	if (paramsinfo != nullptr && paramsinfo->baseType == Shader::UNIFORM_FLOAT && paramsinfo->components == 4)
+	{
+		float params[4] = {(float) tileWidth, (float) tileHeight, 0.0f, 0.0f};
+
+		if (arraytileset)
+		{
+			params[0] = (float) tileset->getPixelWidth();
+			params[1] = (float) tileset->getPixelHeight();
+		}
+		else
+			params[2] = (float) (tileset->getPixelWidth() / tileWidth);
+
+		memcpy(paramsinfo->floats, params, sizeof(params));
+		Shader::current->updateUniform(paramsinfo, 1);
+	}
+
+	VertexAttributes attributes;
+	BufferBindings buffers;
+
+	buffers.set(0, vertexBuffer, 0);
+	attributes.setCommonFormat(CommonFormat::XYf_STf_RGBAub, 0);
+
+	Graphics::TempTransform transform(gfx, m);
+
+	Texture *tex = gfx->getTextureOrDefaultForActiveShader(tileset);
+	gfx->drawQuads(0, 1, attributes, buffers, tex);
+}
+
+} // graphics
+} // love
@@ -0,0 +1,125 @@
+/**
+ * Copyright (c) 2006-2024 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+
+#pragma once
+
+// LOVE
+#include "common/int.h"
+#include "common/math.h"
+#include "common/Matrix.h"
+#include "common/pixelformat.h"
+#include "Drawable.h"
+#include "Texture.h"
+#include "Buffer.h"
+
+// C++
+#include <vector>
+
+namespace love
+{
+namespace graphics
+{
+
+class Graphics;
+
+/**
+ * A grid of tiles drawn from a tileset Texture. Tile ids are stored one per
+ * texel in an unsigned integer texture, and the whole map is drawn as a single
+ * quad whose pixel shader looks up the tile under each pixel, so the vertex
+ * cost doesn't depend on the size of the map. Changing a tile only touches the
+ * CPU copy of the ids; the modified region is uploaded on the next draw.
+ *
+ * Id 0 is an empty cell. Id n is the n-th tile of the tileset, counted
+ * row-major from the top-left of an atlas, or layer n-1 of an array texture.
+ * Ids past the last tile of the tileset are rejected.
+ **/
+class TileMap : public Drawable
+{
+public:
+
+	static love::Type type;
+
+	TileMap(Graphics *gfx, Texture *tileset, int width, int height, int tilewidth, int tileheight, PixelFormat format);
+	virtual ~TileMap();
+
+	void setTile(int x, int y, uint32 id);
+	uint32 getTile(int x, int y) const;
+
+	/**
+	 * Sets a w*h block of tiles starting at (x, y), from row-major ids.
+	 **/
+	void setTiles(int x, int y, int w, int h, const uint32 *ids);
+	void fill(uint32 id);
+
+	void setTileset(Texture *tileset);
+	Texture *getTileset() const;
+
+	int getWidth() const;
+	int getHeight() const;
+	int getTileWidth() const;
+	int getTileHeight() const;
+	PixelFormat getFormat() const;
+
+	/**
+	 * The highest id which can be set: the number of tiles in the tileset,
+	 * limited by the range of the id format.
+	 **/
+	uint32 getMaxTileID() const;
+
+	/**
+	 * Uploads any modified tile ids to the GPU.
+	 **/
+	void flush();
+
+	// Implements Drawable.
+	void draw(Graphics *gfx, const Matrix4 &m) override;
+
+private:
+
+	void validateTileset(Texture *tileset) const;
+	uint32 getTileCount(Texture *tileset) const;
+	uint32 getHighestUsedID() const;
+	void checkTileID(uint32 id) const;
+	void markModified(int x, int y, int w, int h);
+	void setID(size_t index, uint32 id);
+
+	StrongRef<Texture> tileset;
+	StrongRef<Texture> idTexture;
+	StrongRef<Buffer> vertexBuffer;
+
+	int width;
+	int height;
+	int tileWidth;
+	int tileHeight;
+
+	PixelFormat format;
+	size_t idSize;
+
+	std::vector<uint8> ids;
+	std::vector<uint8> uploadData;
+
+	bool modified;
+	Rect modifiedRect;
+
+}; // TileMap
+
+} // graphics
+} // love
@@ -98,6 +98,36 @@ Video::Video(Graphics *gfx, love::video::VideoStream *stream, float dpiscale)
 
 		textures[i].set(tex, Acquire::NORETAIN);
 	}
+
+	// Buffer to texture copies need offsets and sizes which are multiples of
+	// 4 bytes, which is the case when the plane widths are.
+	bool canstage = true;
+	size_t stagingsize = 0;
+
+	for (int i = 0; i < 3; i++)
+	{
+		if (widths[i] % 4 != 0)
+			canstage = false;
+
+		planeOffsets[i] = stagingsize;
+		stagingsize += getPixelFormatSliceSize(PIXELFORMAT_R8_UNORM, widths[i], heights[i]);
+	}
+
+	if (canstage)
+	{
+		Buffer::Settings buffersettings(BUFFERUSAGEFLAG_NONE, BUFFERDATAUSAGE_STREAM);
+		buffersettings.debugName = "Video staging buffer";
+
+		try
+		{
+			Buffer *buffer = gfx->newBuffer(buffersettings, DATAFORMAT_UINT32, nullptr, stagingsize, 0);
+			stagingBuffer.set(buffer, Acquire::NORETAIN);
+		}
+		catch (love::Exception &)
+		{
+			// Fall back to replacePixels.
+		}
+	}
 }
 
 Video::~Video()
@@ -113,7 +143,7 @@ love::video::VideoStream *Video::getStream()
 
 void Video::draw(Graphics *gfx, const Matrix4 &m)
 {
-	update();
+	update(gfx);
 
 	// setVideoTextures may call flushBatchedDraws before setting the textures, so
 	// we can't call it after requestBatchedDraw.
@@ -157,7 +187,7 @@ void Video::draw(Graphics *gfx, const Matrix4 &m)
 	gfx->flushBatchedDraws();
 }
 
-void Video::update()
+void Video::update(Graphics *gfx)
 {
 	bool bufferschanged = stream->swapBuffers();
 	stream->fillBackBuffer();
@@ -165,20 +195,44 @@ void Video::update()
 	if (bufferschanged)
 	{
 		auto frame = (const love::video::VideoStream::Frame*) stream->getFrontBuffer();
+		uploadPlanes(gfx, frame);
+	}
+}
 
-		int widths[3]  = {frame->yw, frame->cw, frame->cw};
-		int heights[3] = {frame->yh, frame->ch, frame->ch};
+void Video::uploadPlanes(Graphics *gfx, const love::video::VideoStream::Frame *frame)
+{
+	int widths[3]  = {frame->yw, frame->cw, frame->cw};
+	int heights[3] = {frame->yh, frame->ch, frame->ch};
 
-		const unsigned char *data[3] = {frame->yplane, frame->cbplane, frame->crplane};
+	const unsigned char *data[3] = {frame->yplane, frame->cbplane, frame->crplane};
+
+	if (stagingBuffer.get() != nullptr)
+	{
+		// One map and three GPU-side copies, instead of three synchronous
+		// uploads from client memory.
+		uint8 *dst = (uint8 *) stagingBuffer->map(Buffer::MAP_WRITE_INVALIDATE, 0, stagingBuffer->getSize());
 
 		for (int i = 0; i < 3; i++)
-		{
-			size_t bpp = getPixelFormatBlockSize(PIXELFORMAT_R8_UNORM);
-			size_t size = bpp * widths[i] * heights[i];
+			memcpy(dst + planeOffsets[i], data[i], (size_t) widths[i] * heights[i]);
 
+		stagingBuffer->unmap(0, stagingBuffer->getSize());
+
+		for (int i = 0; i < 3; i++)
+		{
 			Rect rect = {0, 0, widths[i], heights[i]};
-			textures[i]->replacePixels(data[i], size, 0, 0, rect, false);
+			gfx->copyBufferToTexture(stagingBuffer, textures[i], planeOffsets[i], widths[i], 0, 0, rect);
 		}
+
+		return;
+	}
+
+	for (int i = 0; i < 3; i++)
+	{
+		size_t bpp = getPixelFormatBlockSize(PIXELFORMAT_R8_UNORM);
+		size_t size = bpp * widths[i] * heights[i];
+
+		Rect rect = {0, 0, widths[i], heights[i]};
+		textures[i]->replacePixels(data[i], size, 0, 0, rect, false);
 	}
 }
 
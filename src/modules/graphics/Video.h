@@ -24,6 +24,7 @@
 #include "common/math.h"
 #include "Drawable.h"
 #include "Texture.h"
+#include "Buffer.h"
 #include "vertex.h"
 #include "video/VideoStream.h"
 #include "audio/Source.h"
@@ -63,7 +64,8 @@ class Video : public Drawable
 
 private:
 
-	void update();
+	void update(Graphics *gfx);
+	void uploadPlanes(Graphics *gfx, const love::video::VideoStream::Frame *frame);
 
 	StrongRef<love::video::VideoStream> stream;
 
@@ -75,6 +77,11 @@ class Video : public Drawable
 	Vertex vertices[4];
 
 	StrongRef<Texture> textures[3];
+
+	// Persistent staging buffer used to upload all three planes with GPU-side
+	// buffer to texture copies. Null if the plane sizes don't allow it.
+	StrongRef<Buffer> stagingBuffer;
+	size_t planeOffsets[3];
 	StrongRef<love::audio::Source> source;
 	
 }; // Video
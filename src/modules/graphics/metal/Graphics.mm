@@ -26,6 +26,7 @@
 #include "Shader.h"
 #include "ShaderStage.h"
 #include "window/Window.h"
+#include "timer/Timer.h"
 #include "image/Image.h"
 #include "common/memory.h"
 
@@ -363,6 +364,8 @@ Graphics::Graphics()
 	createQuadIndexBuffer();
 	createFanIndexBuffer();
 
+	double shaderstart = love::timer::Timer::getTime();
+
 	// We always need a default shader.
 	for (int i = 0; i < Shader::STANDARD_MAX_ENUM; i++)
 	{
@@ -377,6 +380,8 @@ Graphics::Graphics()
 		}
 	}
 
+	defaultShaderCompileTime = love::timer::Timer::getTime() - shaderstart;
+
 	// A shader should always be active, but the default shader shouldn't be
 	// returned by getShader(), so we don't do setShader(defaultShader).
 	if (!Shader::current)
@@ -1671,9 +1676,7 @@ void Graphics::present(void *screenshotCallbackData)
 		submitBlitEncoder();
 	}
 
-	for (StreamBuffer *buffer : batchedDrawState.vb)
-		buffer->nextFrame();
-	batchedDrawState.indexBuffer->nextFrame();
+	nextBatchedDrawFrame();
 
 	uniformBuffer->nextFrame();
 	uniformBufferData = {};
@@ -1843,6 +1846,7 @@ void Graphics::setBlendState(const BlendState &blend)
 {
 	if (!(blend == states.back().blend))
 	{
+		batchedDrawState.flushReason = BATCHFLUSH_BLEND;
 		flushBatchedDraws();
 		states.back().blend = blend;
 		dirtyRenderState |= STATEBIT_BLEND;
@@ -2242,8 +2246,11 @@ void Graphics::initCapabilities()
 		capabilities.features[FEATURE_INDIRECT_DRAW] = true;
 	else
 		capabilities.features[FEATURE_INDIRECT_DRAW] = false;
+
+	// Metal doesn't support multi-draw indirect.
+	capabilities.features[FEATURE_MULTI_DRAW_INDIRECT] = false;
 	
-	static_assert(FEATURE_MAX_ENUM == 13, "Graphics::initCapabilities must be updated when adding a new graphics feature!");
+	static_assert(FEATURE_MAX_ENUM == 14, "Graphics::initCapabilities must be updated when adding a new graphics feature!");
 
 	// https://developer.apple.com/metal/Metal-Feature-Set-Tables.pdf
 	capabilities.limits[LIMIT_POINT_SIZE] = 511;
@@ -77,7 +77,11 @@ public:
 		// Make sure this frame's section of the buffer is done being used.
 		if (!mappedFrames[frameIndex])
 		{
-			dispatch_semaphore_wait(frameSemaphores[frameIndex], DISPATCH_TIME_FOREVER);
+			if (dispatch_semaphore_wait(frameSemaphores[frameIndex], DISPATCH_TIME_NOW) != 0)
+			{
+				stallCount++;
+				dispatch_semaphore_wait(frameSemaphores[frameIndex], DISPATCH_TIME_FOREVER);
+			}
 			mappedFrames[frameIndex] = true;
 		}
 
@@ -132,6 +132,13 @@ bool Buffer::loadVolatile()
 
 void Buffer::unloadVolatile()
 {
+	if (uploadMap != nullptr)
+	{
+		auto gfx = Module::getInstance<Graphics>(Module::M_GRAPHICS);
+		gfx->unmapUploadMemory(mappedRange.getSize());
+		uploadMap = nullptr;
+	}
+
 	mapped = false;
 	if (buffer != 0)
 		gl.deleteBuffer(buffer);
@@ -175,6 +182,24 @@ bool Buffer::supportsOrphan() const
 	return dataUsage == BUFFERDATAUSAGE_STREAM || dataUsage == BUFFERDATAUSAGE_DYNAMIC;
 }
 
+bool Buffer::usesUploadBuffer() const
+{
+	// Frequently updated buffers write into persistently mapped memory and
+	// copy from it on the GPU, instead of going through a CPU-side copy and
+	// glBufferSubData.
+	return dataUsage == BUFFERDATAUSAGE_STREAM || dataUsage == BUFFERDATAUSAGE_DYNAMIC;
+}
+
+void Buffer::copyFromUploadBuffer(size_t uploadoffset, size_t offset, size_t size)
+{
+	auto gfx = Module::getInstance<Graphics>(Module::M_GRAPHICS);
+
+	glBindBuffer(GL_COPY_READ_BUFFER, gfx->getUploadBufferHandle());
+	glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+
+	glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, uploadoffset, offset, size);
+}
+
 void *Buffer::map(MapType map, size_t offset, size_t size)
 {
 	if (size == 0)
@@ -192,12 +217,17 @@ void *Buffer::map(MapType map, size_t offset, size_t size)
 		return nullptr;
 
 	char *data = nullptr;
+	auto gfx = Module::getInstance<Graphics>(Module::M_GRAPHICS);
 
 	if (map == MAP_READ_ONLY)
 	{
 		gl.bindBuffer(mapUsage, buffer);
 		data = (char *) glMapBufferRange(target, offset, size, GL_MAP_READ_BIT);
 	}
+	else if (usesUploadBuffer() && (uploadMap = (char *) gfx->mapUploadMemory(size)) != nullptr)
+	{
+		data = uploadMap;
+	}
 	else if (ownsMemoryMap)
 	{
 		if (memoryMap == nullptr)
@@ -206,7 +236,6 @@ void *Buffer::map(MapType map, size_t offset, size_t size)
 	}
 	else
 	{
-		auto gfx = Module::getInstance<Graphics>(Module::M_GRAPHICS);
 		data = (char *) gfx->getBufferMapMemory(size);
 	}
 
@@ -215,7 +244,7 @@ void *Buffer::map(MapType map, size_t offset, size_t size)
 		mapped = true;
 		mappedType = map;
 		mappedRange = r;
-		if (!ownsMemoryMap)
+		if (!ownsMemoryMap && uploadMap == nullptr)
 			memoryMap = data;
 	}
 
@@ -240,6 +269,17 @@ void Buffer::unmap(size_t usedoffset, size_t usedsize)
 		return;
 	}
 
+	if (uploadMap != nullptr)
+	{
+		auto gfx = Module::getInstance<Graphics>(Module::M_GRAPHICS);
+		size_t uploadoffset = gfx->unmapUploadMemory(mappedRange.getSize());
+		uploadMap = nullptr;
+
+		uploadoffset += usedoffset - mappedRange.getOffset();
+		copyFromUploadBuffer(uploadoffset, usedoffset, usedsize);
+		return;
+	}
+
 	// Orphan optimization - see fill().
 	if (supportsOrphan() && mappedRange.first == 0 && mappedRange.getSize() == getSize())
 	{
@@ -269,6 +309,19 @@ bool Buffer::fill(size_t offset, size_t size, const void *data)
 	if (!Range(0, buffersize).contains(Range(offset, size)))
 		return false;
 
+	if (usesUploadBuffer())
+	{
+		auto gfx = Module::getInstance<Graphics>(Module::M_GRAPHICS);
+		void *uploaddata = gfx->mapUploadMemory(size);
+
+		if (uploaddata != nullptr)
+		{
+			memcpy(uploaddata, data, size);
+			copyFromUploadBuffer(gfx->unmapUploadMemory(size), offset, size);
+			return true;
+		}
+	}
+
 	GLenum gldatausage = OpenGL::getGLBufferDataUsage(dataUsage);
 
 	gl.bindBuffer(mapUsage, buffer);
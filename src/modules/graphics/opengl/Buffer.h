@@ -64,6 +64,8 @@ class Buffer final : public love::graphics::Buffer, public Volatile
 
 	bool load(const void *initialdata);
 	bool supportsOrphan() const;
+	bool usesUploadBuffer() const;
+	void copyFromUploadBuffer(size_t uploadoffset, size_t offset, size_t size);
 
 	void clearInternal(size_t offset, size_t size) override;
 
@@ -80,6 +82,9 @@ class Buffer final : public love::graphics::Buffer, public Volatile
 	char *memoryMap = nullptr;
 	bool ownsMemoryMap = false;
 
+	// Set while mapped memory is in the Graphics upload buffer instead.
+	char *uploadMap = nullptr;
+
 	Range mappedRange;
 
 }; // Buffer
@@ -68,6 +68,7 @@ bool FenceSync::cpuWait()
 
 	GLbitfield flags = 0;
 	GLuint64 duration = 0;
+	bool waited = false;
 
 	while (true)
 	{
@@ -81,11 +82,12 @@ bool FenceSync::cpuWait()
 
 		flags = GL_SYNC_FLUSH_COMMANDS_BIT;
 		duration = 1000000000; // 1 second in nanoseconds.
+		waited = true;
 	}
 
 	cleanup();
 
-	return true;
+	return waited;
 }
 
 void FenceSync::cleanup()
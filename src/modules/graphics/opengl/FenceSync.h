@@ -43,6 +43,8 @@ class FenceSync
 
 	bool fence();
 	bool isComplete() const;
+
+	// Returns true if the GPU wasn't done yet and the CPU had to wait for it.
 	bool cpuWait();
 	void cleanup();
 
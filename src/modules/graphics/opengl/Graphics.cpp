@@ -22,6 +22,7 @@
 #include "common/config.h"
 #include "common/math.h"
 #include "common/Vector.h"
+#include "common/memory.h"
 
 #include "Graphics.h"
 #include "font/Font.h"
@@ -29,6 +30,7 @@
 #include "GraphicsReadback.h"
 #include "math/MathModule.h"
 #include "window/Window.h"
+#include "timer/Timer.h"
 #include "Buffer.h"
 #include "ShaderStage.h"
 
@@ -113,6 +115,8 @@ Graphics::Graphics()
 	, requestedBackbufferMSAA(0)
 	, bufferMapMemory(nullptr)
 	, bufferMapMemorySize(2 * 1024 * 1024)
+	, uploadBuffer(nullptr)
+	, uploadBufferMapped(false)
 	, pixelFormatUsage()
 {
 	gl = OpenGL();
@@ -146,6 +150,9 @@ Graphics::Graphics()
 Graphics::~Graphics()
 {
 	delete[] bufferMapMemory;
+
+	if (uploadBuffer != nullptr)
+		uploadBuffer->release();
 }
 
 love::graphics::StreamBuffer *Graphics::newStreamBuffer(BufferUsage type, size_t size)
@@ -352,6 +359,8 @@ bool Graphics::setMode(void */*context*/, int width, int height, int pixelwidth,
 
 	setDebug(isDebugEnabled());
 
+	createTimestampQueries();
+
 	backbufferChanged(width, height, pixelwidth, pixelheight, backbufferstencil, backbufferdepth, msaa);
 
 	if (batchedDrawState.vb[0] == nullptr)
@@ -363,6 +372,9 @@ bool Graphics::setMode(void */*context*/, int width, int height, int pixelwidth,
 		batchedDrawState.indexBuffer = CreateStreamBuffer(BUFFERUSAGE_INDEX, sizeof(uint16) * LOVE_UINT16_MAX);
 	}
 
+	if (uploadBuffer == nullptr)
+		uploadBuffer = CreateUploadStreamBuffer(UPLOAD_BUFFER_SIZE);
+
 	// Reload all volatile objects.
 	if (!Volatile::loadAll())
 		::printf("Could not reload all volatile objects.\n");
@@ -372,11 +384,18 @@ bool Graphics::setMode(void */*context*/, int width, int height, int pixelwidth,
 	// Restore the graphics state.
 	restoreState(states.back());
 
+	double shaderstart = love::timer::Timer::getTime();
+
 	// We always need a default shader.
 	for (int i = 0; i < Shader::STANDARD_MAX_ENUM; i++)
 	{
 		auto stype = (Shader::StandardShader) i;
 
+		// Features which need these shaders check for texel buffer support
+		// themselves.
+		if (Shader::isDefaultTexelBufferShader(stype) && !capabilities.features[FEATURE_TEXEL_BUFFER])
+			continue;
+
 		if (!Shader::standardShaders[i])
 		{
 			std::vector<std::string> stages;
@@ -405,6 +424,8 @@ bool Graphics::setMode(void */*context*/, int width, int height, int pixelwidth,
 		}
 	}
 
+	defaultShaderCompileTime = love::timer::Timer::getTime() - shaderstart;
+
 	// A shader should always be active, but the default shader shouldn't be
 	// returned by getShader(), so we don't do setShader(defaultShader).
 	if (!Shader::current)
@@ -434,6 +455,8 @@ void Graphics::unSetMode()
 
 	framebufferObjects.clear();
 
+	deleteTimestampQueries();
+
 	if (mainVAO != 0)
 	{
 		glDeleteVertexArrays(1, &mainVAO);
@@ -579,7 +602,10 @@ void Graphics::draw(const DrawCommand &cmd)
 	if (cmd.indirectBuffer != nullptr)
 	{
 		gl.bindBuffer(BUFFERUSAGE_INDIRECT_ARGUMENTS, (GLuint) cmd.indirectBuffer->getHandle());
-		glDrawArraysIndirect(glprimitivetype, BUFFER_OFFSET(cmd.indirectBufferOffset));
+		if (cmd.indirectDrawCount > 1)
+			glMultiDrawArraysIndirect(glprimitivetype, BUFFER_OFFSET(cmd.indirectBufferOffset), cmd.indirectDrawCount, 0);
+		else
+			glDrawArraysIndirect(glprimitivetype, BUFFER_OFFSET(cmd.indirectBufferOffset));
 	}
 	else if (cmd.instanceCount > 1)
 		glDrawArraysInstanced(glprimitivetype, cmd.vertexStart, cmd.vertexCount, cmd.instanceCount);
@@ -607,7 +633,10 @@ void Graphics::draw(const DrawIndexedCommand &cmd)
 		// Note: OpenGL doesn't support indirect indexed draws with a non-zero
 		// index buffer offset.
 		gl.bindBuffer(BUFFERUSAGE_INDIRECT_ARGUMENTS, (GLuint) cmd.indirectBuffer->getHandle());
-		glDrawElementsIndirect(glprimitivetype, gldatatype, BUFFER_OFFSET(cmd.indirectBufferOffset));
+		if (cmd.indirectDrawCount > 1)
+			glMultiDrawElementsIndirect(glprimitivetype, gldatatype, BUFFER_OFFSET(cmd.indirectBufferOffset), cmd.indirectDrawCount, 0);
+		else
+			glDrawElementsIndirect(glprimitivetype, gldatatype, BUFFER_OFFSET(cmd.indirectBufferOffset));
 	}
 	else if (cmd.instanceCount > 1)
 		glDrawElementsInstanced(glprimitivetype, cmd.indexCount, gldatatype, gloffset, cmd.instanceCount);
@@ -779,6 +808,8 @@ void Graphics::setRenderTargetsInternal(const RenderTargets &rts, int pixelw, in
 
 	gl.setViewport({0, 0, pixelw, pixelh});
 
+	beginRenderPassTiming(rts.getFirstTarget().texture);
+
 	// Re-apply the scissor if it was active, since the rectangle passed to
 	// glScissor is affected by the viewport dimensions.
 	if (state.scissor)
@@ -794,6 +825,8 @@ void Graphics::setRenderTargetsInternal(const RenderTargets &rts, int pixelw, in
 
 void Graphics::endPass(bool presenting)
 {
+	endRenderPassTiming();
+
 	auto &rts = states.back().renderTargets;
 	love::graphics::Texture *depthstencil = rts.depthStencil.texture.get();
 
@@ -1186,6 +1219,8 @@ void Graphics::present(void *screenshotCallbackData)
 
 	endPass(true);
 
+	finishGPUTimingFrame();
+
 	int w = getPixelWidth();
 	int h = getPixelHeight();
 
@@ -1288,9 +1323,10 @@ void Graphics::present(void *screenshotCallbackData)
 	glBindRenderbuffer(GL_RENDERBUFFER, info.info.uikit.colorbuffer);
 #endif
 
-	for (StreamBuffer *buffer : batchedDrawState.vb)
-		buffer->nextFrame();
-	batchedDrawState.indexBuffer->nextFrame();
+	nextBatchedDrawFrame();
+
+	if (uploadBuffer != nullptr)
+		uploadBuffer->nextFrame();
 
 	auto window = getInstance<love::window::Window>(M_WINDOW);
 	if (window != nullptr)
@@ -1305,7 +1341,10 @@ void Graphics::present(void *screenshotCallbackData)
 	drawCallsBatched = 0;
 
 	updatePendingReadbacks();
+	updateGPUTimings();
 	updateTemporaryResources();
+
+	beginRenderPassTiming(states.back().renderTargets.getFirstTarget().texture.get());
 }
 
 int Graphics::getRequestedBackbufferMSAA() const
@@ -1482,7 +1521,10 @@ void Graphics::setColorMask(ColorChannelMask mask)
 void Graphics::setBlendState(const BlendState &blend)
 {
 	if (!(blend == states.back().blend))
+	{
+		batchedDrawState.flushReason = BATCHFLUSH_BLEND;
 		flushBatchedDraws();
+	}
 
 	if (blend.enable != gl.isStateEnabled(OpenGL::ENABLE_BLEND))
 		gl.setEnableState(OpenGL::ENABLE_BLEND, blend.enable);
@@ -1538,6 +1580,36 @@ void Graphics::releaseBufferMapMemory(void *mem)
 		free(mem);
 }
 
+void *Graphics::mapUploadMemory(size_t size)
+{
+	if (uploadBuffer == nullptr || uploadBufferMapped)
+		return nullptr;
+
+	size_t alignedsize = alignUp(size, UPLOAD_BUFFER_ALIGNMENT);
+	if (alignedsize > uploadBuffer->getUsableSize())
+		return nullptr;
+
+	uploadBufferMapped = true;
+	return uploadBuffer->map(alignedsize).data;
+}
+
+size_t Graphics::unmapUploadMemory(size_t size)
+{
+	// Every allocation is padded so the next one stays aligned.
+	size_t alignedsize = alignUp(size, UPLOAD_BUFFER_ALIGNMENT);
+
+	size_t offset = uploadBuffer->unmap(alignedsize);
+	uploadBuffer->markUsed(alignedsize);
+	uploadBufferMapped = false;
+
+	return offset;
+}
+
+GLuint Graphics::getUploadBufferHandle() const
+{
+	return uploadBuffer != nullptr ? (GLuint) uploadBuffer->getHandle() : 0;
+}
+
 Renderer Graphics::getRenderer() const
 {
 	return RENDERER_OPENGL;
@@ -1583,6 +1655,90 @@ void Graphics::getAPIStats(int &shaderswitches) const
 	shaderswitches = gl.stats.shaderSwitches;
 }
 
+void Graphics::createTimestampQueries()
+{
+	// Timestamps are in ARB_timer_query / GL 3.3. On ES they're only in
+	// EXT_disjoint_timer_query.
+	if (!GLAD_VERSION_3_3 && !GLAD_ARB_timer_query && !GLAD_EXT_disjoint_timer_query)
+		return;
+
+	timestampQueries.resize(GPU_TIMING_FRAMES * MAX_GPU_TIMESTAMPS);
+
+	if (GLAD_ES_VERSION_2_0)
+		glGenQueriesEXT((GLsizei) timestampQueries.size(), timestampQueries.data());
+	else
+		glGenQueries((GLsizei) timestampQueries.size(), timestampQueries.data());
+}
+
+void Graphics::deleteTimestampQueries()
+{
+	if (timestampQueries.empty())
+		return;
+
+	if (GLAD_ES_VERSION_2_0)
+		glDeleteQueriesEXT((GLsizei) timestampQueries.size(), timestampQueries.data());
+	else
+		glDeleteQueries((GLsizei) timestampQueries.size(), timestampQueries.data());
+
+	timestampQueries.clear();
+	discardGPUTimings();
+}
+
+bool Graphics::isTimestampQuerySupported() const
+{
+	return !timestampQueries.empty();
+}
+
+void Graphics::writeTimestampInternal(int frame, int query)
+{
+	GLuint id = timestampQueries[frame * MAX_GPU_TIMESTAMPS + query];
+
+	if (GLAD_ES_VERSION_2_0)
+		glQueryCounterEXT(id, GL_TIMESTAMP_EXT);
+	else
+		glQueryCounter(id, GL_TIMESTAMP);
+}
+
+bool Graphics::getTimestampsInternal(int frame, int count, std::vector<uint64> &nanoseconds)
+{
+	const GLuint *queries = &timestampQueries[frame * MAX_GPU_TIMESTAMPS];
+	bool es = GLAD_ES_VERSION_2_0;
+
+	// Queries complete in order, so the last one tells us about all of them.
+	GLuint available = GL_FALSE;
+	if (es)
+		glGetQueryObjectuivEXT(queries[count - 1], GL_QUERY_RESULT_AVAILABLE_EXT, &available);
+	else
+		glGetQueryObjectuiv(queries[count - 1], GL_QUERY_RESULT_AVAILABLE, &available);
+
+	if (!available)
+		return false;
+
+	if (es)
+	{
+		// A disjoint operation (e.g. a GPU frequency change) makes the results
+		// meaningless.
+		GLint disjoint = GL_FALSE;
+		glGetIntegerv(GL_GPU_DISJOINT_EXT, &disjoint);
+		if (disjoint)
+			return true;
+	}
+
+	nanoseconds.resize(count);
+
+	for (int i = 0; i < count; i++)
+	{
+		GLuint64 value = 0;
+		if (es)
+			glGetQueryObjectui64vEXT(queries[i], GL_QUERY_RESULT_EXT, &value);
+		else
+			glGetQueryObjectui64v(queries[i], GL_QUERY_RESULT, &value);
+		nanoseconds[i] = value;
+	}
+
+	return true;
+}
+
 void Graphics::initCapabilities()
 {
 	capabilities.features[FEATURE_MULTI_RENDER_TARGET_FORMATS] = true;
@@ -1598,7 +1754,8 @@ void Graphics::initCapabilities()
 	capabilities.features[FEATURE_TEXEL_BUFFER] = gl.isBufferUsageSupported(BUFFERUSAGE_TEXEL);
 	capabilities.features[FEATURE_COPY_TEXTURE_TO_BUFFER] = gl.isCopyTextureToBufferSupported();
 	capabilities.features[FEATURE_INDIRECT_DRAW] = capabilities.features[FEATURE_GLSL4];
-	static_assert(FEATURE_MAX_ENUM == 13, "Graphics::initCapabilities must be updated when adding a new graphics feature!");
+	capabilities.features[FEATURE_MULTI_DRAW_INDIRECT] = capabilities.features[FEATURE_GLSL4] && gl.isMultiDrawIndirectSupported();
+	static_assert(FEATURE_MAX_ENUM == 14, "Graphics::initCapabilities must be updated when adding a new graphics feature!");
 
 	capabilities.limits[LIMIT_POINT_SIZE] = gl.getMaxPointSize();
 	capabilities.limits[LIMIT_TEXTURE_SIZE] = gl.getMax2DTextureSize();
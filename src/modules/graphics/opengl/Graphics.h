@@ -113,6 +113,15 @@ class Graphics final : public love::graphics::Graphics
 	void *getBufferMapMemory(size_t size);
 	void releaseBufferMapMemory(void *mem);
 
+	// Staging memory in a persistently mapped buffer, which Buffers copy from
+	// on the GPU. Returns null if it's unsupported, full for this frame, or
+	// already mapped.
+	void *mapUploadMemory(size_t size);
+
+	// Returns the offset of the memory in the upload buffer.
+	size_t unmapUploadMemory(size_t size);
+	GLuint getUploadBufferHandle() const;
+
 private:
 
 	struct CachedFBOHasher
@@ -145,6 +154,13 @@ class Graphics final : public love::graphics::Graphics
 	void initCapabilities() override;
 	void getAPIStats(int &shaderswitches) const override;
 
+	bool isTimestampQuerySupported() const override;
+	void writeTimestampInternal(int frame, int query) override;
+	bool getTimestampsInternal(int frame, int count, std::vector<uint64> &nanoseconds) override;
+
+	void createTimestampQueries();
+	void deleteTimestampQueries();
+
 	void endPass(bool presenting);
 	GLuint bindCachedFBO(const RenderTargets &targets);
 	void discard(OpenGL::FramebufferTarget target, const std::vector<bool> &colorbuffers, bool depthstencil);
@@ -169,6 +185,18 @@ class Graphics final : public love::graphics::Graphics
 	char *bufferMapMemory;
 	size_t bufferMapMemorySize;
 
+	love::graphics::StreamBuffer *uploadBuffer;
+	bool uploadBufferMapped;
+
+	// Size of each frame's section of the upload buffer. Uploads that don't
+	// fit use glBufferSubData instead.
+	static const size_t UPLOAD_BUFFER_SIZE = 4 * 1024 * 1024;
+	static const size_t UPLOAD_BUFFER_ALIGNMENT = 16;
+
+	// GPU_TIMING_FRAMES * MAX_GPU_TIMESTAMPS timestamp queries, or empty if
+	// timer queries aren't supported.
+	std::vector<GLuint> timestampQueries;
+
 	// [non-readable, readable]
 	uint32 pixelFormatUsage[PIXELFORMAT_MAX_ENUM][2];
 
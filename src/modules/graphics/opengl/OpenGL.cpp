@@ -1291,6 +1291,12 @@ bool OpenGL::isCopyTextureToBufferSupported() const
 	return GLAD_VERSION_4_5 || GLAD_ARB_get_texture_sub_image;
 }
 
+bool OpenGL::isMultiDrawIndirectSupported() const
+{
+	// gl_DrawIDARB is needed for shaders to tell the sub-draws apart.
+	return (GLAD_VERSION_4_3 || GLAD_ARB_multi_draw_indirect) && GLAD_ARB_shader_draw_parameters;
+}
+
 int OpenGL::getMax2DTextureSize() const
 {
 	return std::max(max2DTextureSize, 1);
@@ -367,6 +367,7 @@ class OpenGL
 	bool isSamplerLODBiasSupported() const;
 	bool isBaseVertexSupported() const;
 	bool isCopyTextureToBufferSupported() const;
+	bool isMultiDrawIndirectSupported() const;
 
 	/**
 	 * Returns the maximum supported width or height of a texture.
@@ -253,7 +253,8 @@ class StreamBufferMapSync final : public StreamBufferSync, public Volatile
 		gl.bindBuffer(mode, vbo);
 
 		// Make sure this frame's section of the buffer is done being used.
-		syncs[frameIndex].cpuWait();
+		if (syncs[frameIndex].cpuWait())
+			stallCount++;
 
 		MapInfo info;
 		info.size = bufferSize - frameGPUReadOffset;
@@ -335,7 +336,8 @@ class StreamBufferPersistentMapSync final : public StreamBufferSync, public Vola
 	MapInfo map(size_t /*minsize*/) override
 	{
 		// Make sure this frame's section of the buffer is done being used.
-		syncs[frameIndex].cpuWait();
+		if (syncs[frameIndex].cpuWait())
+			stallCount++;
 
 		MapInfo info;
 		info.size = bufferSize - frameGPUReadOffset;
@@ -438,7 +440,8 @@ class StreamBufferPinnedMemory final : public StreamBufferSync, public Volatile
 	MapInfo map(size_t /*minsize*/) override
 	{
 		// Make sure this frame's section of the buffer is done being used.
-		syncs[frameIndex].cpuWait();
+		if (syncs[frameIndex].cpuWait())
+			stallCount++;
 
 		MapInfo info;
 		info.size = bufferSize - frameGPUReadOffset;
@@ -550,6 +553,14 @@ love::graphics::StreamBuffer *CreateStreamBuffer(BufferUsage mode, size_t size)
 		return new StreamBufferClientMemory(mode, size);
 }
 
+love::graphics::StreamBuffer *CreateUploadStreamBuffer(size_t size)
+{
+	if (gl.isCoreProfile() && !gl.bugs.clientWaitSyncStalls && (GLAD_VERSION_4_4 || GLAD_ARB_buffer_storage))
+		return new StreamBufferPersistentMapSync(BUFFERUSAGE_VERTEX, size);
+
+	return nullptr;
+}
+
 } // opengl
 } // graphics
 } // love
@@ -31,6 +31,12 @@ namespace opengl
 
 love::graphics::StreamBuffer *CreateStreamBuffer(BufferUsage mode, size_t size);
 
+/**
+ * Creates a persistently mapped StreamBuffer which Buffer uploads are staged
+ * in, or returns null if persistent mapping isn't usable on this system.
+ **/
+love::graphics::StreamBuffer *CreateUploadStreamBuffer(size_t size);
+
 } // opengl
 } // graphics
 } // love
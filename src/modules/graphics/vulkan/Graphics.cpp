@@ -23,6 +23,7 @@
 #include "common/version.h"
 #include "common/memory.h"
 #include "window/Window.h"
+#include "timer/Timer.h"
 #include "Buffer.h"
 #include "Graphics.h"
 #include "GraphicsReadback.h"
@@ -75,6 +76,11 @@ VmaAllocator Graphics::getVmaAllocator() const
 	return vmaAllocator;
 }
 
+bool Graphics::didFrameFenceWait() const
+{
+	return frameFenceWaited;
+}
+
 static void checkOptionalInstanceExtensions(OptionalInstanceExtensions& ext)
 {
 	uint32_t count;
@@ -545,6 +551,13 @@ void Graphics::present(void *screenshotCallbackdata)
 
 	deprecations.draw(this);
 
+	// The timestamps of this frame have to be written before its command
+	// buffer is submitted.
+	flushBatchedDraws();
+	if (renderPassState.active)
+		endRenderPass();
+	finishGPUTimingFrame();
+
 	submitGpuCommands(SUBMIT_PRESENT, screenshotCallbackdata);
 
 	VkResult result = VK_SUCCESS;
@@ -582,15 +595,14 @@ void Graphics::present(void *screenshotCallbackdata)
 	else if (result != VK_SUCCESS)
 		throw love::Exception("failed to present swap chain image");
 
-	for (love::graphics::StreamBuffer *buffer : batchedDrawState.vb)
-		buffer->nextFrame();
-	batchedDrawState.indexBuffer->nextFrame();
+	nextBatchedDrawFrame();
 
 	drawCalls = 0;
 	renderTargetSwitchCount = 0;
 	drawCallsBatched = 0;
 
 	updatePendingReadbacks();
+	updateGPUTimings();
 	updateTemporaryResources();
 
 	frameCounter++;
@@ -658,6 +670,7 @@ bool Graphics::setMode(void *context, int width, int height, int pixelwidth, int
 		createCommandPool();
 		createCommandBuffers();
 		createSyncObjects();
+		createTimestampQueryPool();
 	}
 
 	if (localUniformBuffer == nullptr)
@@ -749,7 +762,8 @@ void Graphics::initCapabilities()
 	capabilities.features[FEATURE_TEXEL_BUFFER] = true;
 	capabilities.features[FEATURE_COPY_TEXTURE_TO_BUFFER] = true;
 	capabilities.features[FEATURE_INDIRECT_DRAW] = true;
-	static_assert(FEATURE_MAX_ENUM == 13, "Graphics::initCapabilities must be updated when adding a new graphics feature!");
+	capabilities.features[FEATURE_MULTI_DRAW_INDIRECT] = multiDrawIndirectSupported;
+	static_assert(FEATURE_MAX_ENUM == 14, "Graphics::initCapabilities must be updated when adding a new graphics feature!");
 
 	VkPhysicalDeviceProperties properties;
 	vkGetPhysicalDeviceProperties(physicalDevice, &properties);
@@ -780,6 +794,38 @@ void Graphics::getAPIStats(int &shaderswitches) const
 	shaderswitches = static_cast<int>(Vulkan::getNumShaderSwitches());
 }
 
+bool Graphics::isTimestampQuerySupported() const
+{
+	return timestampQueryPool != VK_NULL_HANDLE;
+}
+
+void Graphics::writeTimestampInternal(int frame, int query)
+{
+	vkCmdWriteTimestamp(commandBuffers.at(currentFrame), VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, timestampQueryPool, frame * MAX_GPU_TIMESTAMPS + query);
+}
+
+bool Graphics::getTimestampsInternal(int frame, int count, std::vector<uint64> &nanoseconds)
+{
+	std::vector<uint64_t> values(count);
+
+	// Without VK_QUERY_RESULT_WAIT_BIT this returns VK_NOT_READY instead of
+	// stalling when any of the queries haven't completed.
+	VkResult result = vkGetQueryPoolResults(
+		device, timestampQueryPool, frame * MAX_GPU_TIMESTAMPS, count,
+		sizeof(uint64_t) * count, values.data(), sizeof(uint64_t), VK_QUERY_RESULT_64_BIT);
+
+	if (result == VK_NOT_READY)
+		return false;
+	if (result != VK_SUCCESS)
+		return true;
+
+	nanoseconds.resize(count);
+	for (int i = 0; i < count; i++)
+		nanoseconds[i] = (uint64) ((double) (values[i] & timestampMask) * timestampPeriod);
+
+	return true;
+}
+
 void Graphics::unSetMode()
 {
 	submitGpuCommands(SUBMIT_NOPRESENT);
@@ -832,6 +878,7 @@ void Graphics::setColorMask(ColorChannelMask mask)
 
 void Graphics::setBlendState(const BlendState &blend)
 {
+	batchedDrawState.flushReason = BATCHFLUSH_BLEND;
 	flushBatchedDraws();
 
 	states.back().blend = blend;
@@ -875,8 +922,8 @@ void Graphics::draw(const DrawCommand &cmd)
 			commandBuffers.at(currentFrame),
 			(VkBuffer) cmd.indirectBuffer->getHandle(),
 			cmd.indirectBufferOffset,
-			1,
-			0);
+			(uint32) cmd.indirectDrawCount,
+			sizeof(VkDrawIndirectCommand));
 	}
 	else
 	{
@@ -907,8 +954,8 @@ void Graphics::draw(const DrawIndexedCommand &cmd)
 			commandBuffers.at(currentFrame),
 			(VkBuffer) cmd.indirectBuffer->getHandle(),
 			cmd.indirectBufferOffset,
-			1,
-			0);
+			(uint32) cmd.indirectDrawCount,
+			sizeof(VkDrawIndexedIndirectCommand));
 	}
 	else
 	{
@@ -1269,6 +1316,7 @@ void Graphics::initDynamicState()
 
 void Graphics::beginFrame()
 {
+	frameFenceWaited = vkGetFenceStatus(device, inFlightFences[currentFrame]) == VK_NOT_READY;
 	vkWaitForFences(device, 1, &inFlightFences[currentFrame], VK_TRUE, UINT64_MAX);
 
 	if (frameCounter >= USAGES_POLL_INTERVAL)
@@ -1310,6 +1358,10 @@ void Graphics::beginFrame()
 
 	startRecordingGraphicsCommands();
 
+	// Queries have to be reset outside of a render pass before they're reused.
+	if (timestampQueryPool != VK_NULL_HANDLE)
+		vkCmdResetQueryPool(commandBuffers.at(currentFrame), timestampQueryPool, gpuTimingFrame * MAX_GPU_TIMESTAMPS, MAX_GPU_TIMESTAMPS);
+
 	if (!swapChainImages.empty())
 	{
 		Vulkan::cmdTransitionImageLayout(
@@ -1687,9 +1739,29 @@ void Graphics::createLogicalDevice()
 	if (optionalDeviceExtensions.spirv14 && deviceApiVersion < VK_API_VERSION_1_1)
 		optionalDeviceExtensions.spirv14 = false;
 
+	// Multi-draw indirect is only useful if shaders can see gl_DrawID, which
+	// needs the (core in 1.1) shaderDrawParameters feature.
+	VkPhysicalDeviceFeatures supportedFeatures{};
+	vkGetPhysicalDeviceFeatures(physicalDevice, &supportedFeatures);
+
+	VkPhysicalDeviceShaderDrawParametersFeatures drawParametersFeatures{};
+	drawParametersFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SHADER_DRAW_PARAMETERS_FEATURES;
+	drawParametersFeatures.pNext = nullptr;
+
+	multiDrawIndirectSupported = false;
+	if (supportedFeatures.multiDrawIndirect && deviceApiVersion >= VK_API_VERSION_1_1 && vkGetPhysicalDeviceFeatures2 != nullptr)
+	{
+		VkPhysicalDeviceFeatures2 features2{};
+		features2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+		features2.pNext = &drawParametersFeatures;
+		vkGetPhysicalDeviceFeatures2(physicalDevice, &features2);
+		multiDrawIndirectSupported = drawParametersFeatures.shaderDrawParameters == VK_TRUE;
+	}
+
 	VkPhysicalDeviceFeatures deviceFeatures{};
 	deviceFeatures.samplerAnisotropy = VK_TRUE;
 	deviceFeatures.fillModeNonSolid = VK_TRUE;
+	deviceFeatures.multiDrawIndirect = multiDrawIndirectSupported ? VK_TRUE : VK_FALSE;
 
 	VkDeviceCreateInfo createInfo{};
 	createInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
@@ -1730,6 +1802,13 @@ void Graphics::createLogicalDevice()
 	if (optionalDeviceExtensions.extendedDynamicState)
 		createInfo.pNext = &extendedDynamicStateFeatures;
 
+	if (multiDrawIndirectSupported)
+	{
+		drawParametersFeatures.shaderDrawParameters = VK_TRUE;
+		drawParametersFeatures.pNext = (void *) createInfo.pNext;
+		createInfo.pNext = &drawParametersFeatures;
+	}
+
 	if (vkCreateDevice(physicalDevice, &createInfo, nullptr, &device) != VK_SUCCESS)
 		throw love::Exception("failed to create logical device");
 
@@ -2115,6 +2194,8 @@ VkFramebuffer Graphics::getFramebuffer(FramebufferConfiguration &configuration)
 
 void Graphics::createDefaultShaders()
 {
+	double shaderstart = love::timer::Timer::getTime();
+
 	for (int i = 0; i < Shader::STANDARD_MAX_ENUM; i++)
 	{
 		auto stype = (Shader::StandardShader)i;
@@ -2127,6 +2208,8 @@ void Graphics::createDefaultShaders()
 			Shader::standardShaders[i] = newShader(stages, {});
 		}
 	}
+
+	defaultShaderCompileTime = love::timer::Timer::getTime() - shaderstart;
 }
 
 VkRenderPass Graphics::createRenderPass(RenderPassConfiguration &configuration)
@@ -2575,6 +2658,8 @@ void Graphics::startRenderPass()
 	for (const auto &[image, format, imageLayout, renderLayout, rootmip, rootlayer] : renderPassState.transitionImages)
 		Vulkan::cmdTransitionImageLayout(commandBuffers.at(currentFrame), image, format, imageLayout, renderLayout, rootmip, 1, rootlayer, 1);
 
+	beginRenderPassTiming(states.back().renderTargets.getFirstTarget().texture.get());
+
 	vkCmdBeginRenderPass(commandBuffers.at(currentFrame), &renderPassState.beginInfo, VK_SUBPASS_CONTENTS_INLINE);
 
 	applyScissor();
@@ -2586,6 +2671,8 @@ void Graphics::endRenderPass()
 
 	vkCmdEndRenderPass(commandBuffers.at(currentFrame));
 
+	endRenderPassTiming();
+
 	for (const auto &[image, format, imageLayout, renderLayout, rootmip, rootlayer] : renderPassState.transitionImages)
 		Vulkan::cmdTransitionImageLayout(commandBuffers.at(currentFrame), image, format, renderLayout, imageLayout, rootmip, 1, rootlayer, 1);
 
@@ -3098,6 +3185,35 @@ void Graphics::createSyncObjects()
 			throw love::Exception("failed to create synchronization objects for a frame!");
 }
 
+void Graphics::createTimestampQueryPool()
+{
+	VkPhysicalDeviceProperties properties;
+	vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+
+	uint32_t queueFamilyCount = 0;
+	vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamilyCount, nullptr);
+
+	std::vector<VkQueueFamilyProperties> queueFamilies(queueFamilyCount);
+	vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamilyCount, queueFamilies.data());
+
+	uint32_t validBits = queueFamilies.at(findQueueFamilies(physicalDevice).graphicsFamily.value).timestampValidBits;
+
+	// Timestamps aren't supported on the graphics queue.
+	if (validBits == 0 || properties.limits.timestampPeriod <= 0.0f)
+		return;
+
+	timestampPeriod = properties.limits.timestampPeriod;
+	timestampMask = validBits >= 64 ? ~0ull : (1ull << validBits) - 1;
+
+	VkQueryPoolCreateInfo poolInfo{};
+	poolInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+	poolInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+	poolInfo.queryCount = GPU_TIMING_FRAMES * MAX_GPU_TIMESTAMPS;
+
+	if (vkCreateQueryPool(device, &poolInfo, nullptr, &timestampQueryPool) != VK_SUCCESS)
+		timestampQueryPool = VK_NULL_HANDLE;
+}
+
 void Graphics::cleanup()
 {
 	for (auto &cleanUpFns : cleanUpFunctions)
@@ -3127,6 +3243,13 @@ void Graphics::cleanup()
 		vkDestroyFramebuffer(device, entry.second, nullptr);
 	framebuffers.clear();
 
+	if (timestampQueryPool != VK_NULL_HANDLE)
+	{
+		vkDestroyQueryPool(device, timestampQueryPool, nullptr);
+		timestampQueryPool = VK_NULL_HANDLE;
+		discardGPUTimings();
+	}
+
 	vkDestroyCommandPool(device, commandPool, nullptr);
 	vkDestroyPipelineCache(device, pipelineCache, nullptr);
 	vkDestroyDevice(device, nullptr);
@@ -262,6 +262,9 @@ class Graphics final : public love::graphics::Graphics
 
 	VkDevice getDevice() const;
 	VmaAllocator getVmaAllocator() const;
+	// Whether beginFrame had to wait for the GPU to finish this frame's
+	// previous use of its per-frame resources.
+	bool didFrameFenceWait() const;
 	VkCommandBuffer getCommandBufferForDataTransfer();
 	void queueCleanUp(std::function<void()> cleanUp);
 	void addReadbackCallback(std::function<void()> callback);
@@ -288,6 +291,9 @@ class Graphics final : public love::graphics::Graphics
 	bool dispatch(love::graphics::Shader *shader, love::graphics::Buffer *indirectargs, size_t argsoffset) override;
 	void initCapabilities() override;
 	void getAPIStats(int &shaderswitches) const override;
+	bool isTimestampQuerySupported() const override;
+	void writeTimestampInternal(int frame, int query) override;
+	bool getTimestampsInternal(int frame, int count, std::vector<uint64> &nanoseconds) override;
 	void setRenderTargetsInternal(const RenderTargets &rts, int pixelw, int pixelh, bool hasSRGBtexture) override;
 
 private:
@@ -319,6 +325,7 @@ class Graphics final : public love::graphics::Graphics
 	void createCommandPool();
 	void createCommandBuffers();
 	void createSyncObjects();
+	void createTimestampQueryPool();
 	void cleanup();
 	void cleanupSwapChain();
 	void recreateSwapChain();
@@ -351,6 +358,7 @@ class Graphics final : public love::graphics::Graphics
 	VkDevice device = VK_NULL_HANDLE; 
 	OptionalInstanceExtensions optionalInstanceExtensions;
 	OptionalDeviceExtensions optionalDeviceExtensions;
+	bool multiDrawIndirectSupported = false;
 	VkQueue graphicsQueue = VK_NULL_HANDLE;
 	VkQueue presentQueue = VK_NULL_HANDLE;
 	VkSurfaceKHR surface = VK_NULL_HANDLE;
@@ -382,9 +390,13 @@ class Graphics final : public love::graphics::Graphics
 	std::vector<VkSemaphore> renderFinishedSemaphores;
 	std::vector<VkFence> inFlightFences;
 	std::vector<VkFence> imagesInFlight;
+	VkQueryPool timestampQueryPool = VK_NULL_HANDLE;
+	double timestampPeriod = 1.0;
+	uint64 timestampMask = 0;
 	int vsync = 1;
 	VkDeviceSize minUniformBufferOffsetAlignment = 0;
 	bool imageRequested = false;
+	bool frameFenceWaited = false;
 	uint32_t frameCounter = 0;
 	size_t currentFrame = 0;
 	uint32_t imageIndex = 0;
@@ -103,7 +103,14 @@ size_t StreamBuffer::getGPUReadOffset() const
 
 love::graphics::StreamBuffer::MapInfo StreamBuffer::map(size_t /*minsize*/)
 {
-	// TODO: do we also need to wait until a fence is complete, here?
+	// This frame's section of the buffer is made available by the frame fence
+	// wait in Graphics::beginFrame, so a map stalled if that wait did.
+	if (!mappedThisFrame)
+	{
+		if (vgfx->didFrameFenceWait())
+			stallCount++;
+		mappedThisFrame = true;
+	}
 
 	MapInfo info;
 	info.size = bufferSize - frameGPUReadOffset;
@@ -130,6 +137,7 @@ void StreamBuffer::nextFrame()
 {
 	frameIndex = (frameIndex + 1) % MAX_FRAMES_IN_FLIGHT;
 	frameGPUReadOffset = 0;
+	mappedThisFrame = false;
 }
 
 } // vulkan
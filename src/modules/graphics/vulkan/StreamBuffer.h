@@ -63,6 +63,7 @@ class StreamBuffer final
 	VmaAllocationInfo allocInfo;
 	VkBuffer buffer = VK_NULL_HANDLE;
 	int frameIndex = 0;
+	bool mappedThisFrame = false;
 	bool coherent;
 
 };
@@ -20,6 +20,7 @@
 
 #include "wrap_Buffer.h"
 #include "Buffer.h"
+#include "Graphics.h"
 #include "common/Data.h"
 
 #include <limits>
@@ -257,7 +258,10 @@ static int w_Buffer_setArrayData(lua_State *L)
 		size_t datasize = std::min(d->getSize() - dataoffset, count * stride);
 		const void *sourcedata = (const uint8 *) d->getData() + dataoffset;
 
-		t->fill(bufferoffset, datasize, sourcedata);
+		luax_catchexcept(L, [&]() {
+			Graphics::flushBatchedDrawsGlobal();
+			t->fill(bufferoffset, datasize, sourcedata);
+		});
 		return 0;
 	}
 
@@ -289,6 +293,7 @@ static int w_Buffer_setArrayData(lua_State *L)
 	if (destindex + count > arraylength)
 		return luaL_error(L, "Too many array elements (expected at most %d, got %d)", arraylength - destindex, count);
 
+	luax_catchexcept(L, [&]() { Graphics::flushBatchedDrawsGlobal(); });
 	char *data = (char *) t->map(Buffer::MAP_WRITE_INVALIDATE, bufferoffset, count * stride);
 
 	if (tableoftables)
@@ -355,7 +360,10 @@ static int w_Buffer_clear(lua_State *L)
 		offset = (size_t) offsetp;
 		size = (size_t) sizep;
 	}
-	luax_catchexcept(L, [&]() { t->clear(offset, size); });
+	luax_catchexcept(L, [&]() {
+		Graphics::flushBatchedDrawsGlobal();
+		t->clear(offset, size);
+	});
 	return 0;
 }
 
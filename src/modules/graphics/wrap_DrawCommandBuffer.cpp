@@ -0,0 +1,204 @@
+/**
+ * Copyright (c) 2006-2024 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+
+#include "wrap_DrawCommandBuffer.h"
+#include "wrap_SpriteBatch.h"
+#include "wrap_Texture.h"
+#include "Quad.h"
+
+namespace love
+{
+namespace graphics
+{
+
+DrawCommandBuffer *luax_checkdrawcommandbuffer(lua_State *L, int idx)
+{
+	return luax_checktype<DrawCommandBuffer>(L, idx);
+}
+
+int w_DrawCommandBuffer_add(lua_State *L)
+{
+	DrawCommandBuffer *t = luax_checkdrawcommandbuffer(L, 1);
+	Texture *texture = luax_checktexture(L, 2);
+	int startidx = 3;
+
+	Quad *quad = luax_totype<Quad>(L, startidx);
+
+	if (quad != nullptr)
+		startidx++;
+	else if (lua_isnil(L, startidx) && !lua_isnoneornil(L, startidx + 1))
+		return luax_typerror(L, startidx, "Quad");
+
+	luax_checkstandardtransform(L, startidx, [&](const Matrix4 &m)
+	{
+		luax_catchexcept(L, [&]()
+		{
+			if (quad)
+				t->add(texture, quad, m);
+			else
+				t->add(texture, m);
+		});
+	});
+
+	return 0;
+}
+
+int w_DrawCommandBuffer_clear(lua_State *L)
+{
+	DrawCommandBuffer *t = luax_checkdrawcommandbuffer(L, 1);
+	t->clear();
+	return 0;
+}
+
+int w_DrawCommandBuffer_setColor(lua_State *L)
+{
+	DrawCommandBuffer *t = luax_checkdrawcommandbuffer(L, 1);
+	Colorf c;
+
+	if (lua_istable(L, 2))
+	{
+		for (int i = 1; i <= 4; i++)
+			lua_rawgeti(L, 2, i);
+
+		c.r = (float) luaL_checknumber(L, -4);
+		c.g = (float) luaL_checknumber(L, -3);
+		c.b = (float) luaL_checknumber(L, -2);
+		c.a = (float) luaL_optnumber(L, -1, 1.0);
+
+		lua_pop(L, 4);
+	}
+	else
+	{
+		c.r = (float) luaL_checknumber(L, 2);
+		c.g = (float) luaL_checknumber(L, 3);
+		c.b = (float) luaL_checknumber(L, 4);
+		c.a = (float) luaL_optnumber(L, 5, 1.0);
+	}
+
+	t->setColor(c);
+	return 0;
+}
+
+int w_DrawCommandBuffer_getColor(lua_State *L)
+{
+	DrawCommandBuffer *t = luax_checkdrawcommandbuffer(L, 1);
+	Colorf color = t->getColor();
+
+	lua_pushnumber(L, color.r);
+	lua_pushnumber(L, color.g);
+	lua_pushnumber(L, color.b);
+	lua_pushnumber(L, color.a);
+	return 4;
+}
+
+int w_DrawCommandBuffer_setBlendMode(lua_State *L)
+{
+	DrawCommandBuffer *t = luax_checkdrawcommandbuffer(L, 1);
+
+	// nil means sprites use the blend mode active when the buffer is drawn.
+	if (lua_isnoneornil(L, 2))
+	{
+		t->resetBlendState();
+		return 0;
+	}
+
+	BlendMode mode;
+	const char *str = luaL_checkstring(L, 2);
+	if (!getConstant(str, mode))
+		return luax_enumerror(L, "blend mode", getConstants(mode), str);
+
+	BlendAlpha alphamode = BLENDALPHA_MULTIPLY;
+	if (!lua_isnoneornil(L, 3))
+	{
+		const char *alphastr = luaL_checkstring(L, 3);
+		if (!getConstant(alphastr, alphamode))
+			return luax_enumerror(L, "blend alpha mode", getConstants(alphamode), alphastr);
+	}
+
+	if (alphamode == BLENDALPHA_MULTIPLY && !isAlphaMultiplyBlendSupported(mode))
+		return luaL_error(L, "The '%s' blend mode must be used with premultiplied alpha.", str);
+
+	t->setBlendState(computeBlendState(mode, alphamode));
+	return 0;
+}
+
+int w_DrawCommandBuffer_getBlendMode(lua_State *L)
+{
+	DrawCommandBuffer *t = luax_checkdrawcommandbuffer(L, 1);
+
+	BlendState state;
+	if (!t->getBlendState(state))
+	{
+		lua_pushnil(L);
+		return 1;
+	}
+
+	const char *str;
+	const char *alphastr;
+
+	BlendAlpha alphamode;
+	BlendMode mode = computeBlendMode(state, alphamode);
+
+	if (!getConstant(mode, str))
+		return luaL_error(L, "Unknown blend mode");
+
+	if (!getConstant(alphamode, alphastr))
+		return luaL_error(L, "Unknown blend alpha mode");
+
+	lua_pushstring(L, str);
+	lua_pushstring(L, alphastr);
+	return 2;
+}
+
+int w_DrawCommandBuffer_getCount(lua_State *L)
+{
+	DrawCommandBuffer *t = luax_checkdrawcommandbuffer(L, 1);
+	lua_pushinteger(L, t->getCount());
+	return 1;
+}
+
+int w_DrawCommandBuffer_getCommandCount(lua_State *L)
+{
+	DrawCommandBuffer *t = luax_checkdrawcommandbuffer(L, 1);
+	lua_pushinteger(L, t->getCommandCount());
+	return 1;
+}
+
+static const luaL_Reg w_DrawCommandBuffer_functions[] =
+{
+	{ "add", w_DrawCommandBuffer_add },
+	{ "clear", w_DrawCommandBuffer_clear },
+	{ "setColor", w_DrawCommandBuffer_setColor },
+	{ "getColor", w_DrawCommandBuffer_getColor },
+	{ "setBlendMode", w_DrawCommandBuffer_setBlendMode },
+	{ "getBlendMode", w_DrawCommandBuffer_getBlendMode },
+	{ "getCount", w_DrawCommandBuffer_getCount },
+	{ "getCommandCount", w_DrawCommandBuffer_getCommandCount },
+	{ 0, 0 }
+};
+
+extern "C" int luaopen_drawcommandbuffer(lua_State *L)
+{
+	return luax_register_type(L, &DrawCommandBuffer::type, w_DrawCommandBuffer_functions, nullptr);
+}
+
+} // graphics
+} // love
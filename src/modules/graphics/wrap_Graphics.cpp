@@ -23,6 +23,7 @@
 #include "Texture.h"
 #include "image/ImageData.h"
 #include "image/Image.h"
+#include "image/BlockEncoder.h"
 #include "font/Rasterizer.h"
 #include "filesystem/Filesystem.h"
 #include "filesystem/wrap_Filesystem.h"
@@ -186,6 +187,12 @@ int w_isCreated(lua_State *L)
 	return 1;
 }
 
+int w__getDefaultShaderCompileTime(lua_State *L)
+{
+	lua_pushnumber(L, instance()->getDefaultShaderCompileTime());
+	return 1;
+}
+
 int w_isActive(lua_State *L)
 {
 	luax_pushboolean(L, instance()->isActive());
@@ -469,15 +476,27 @@ static void screenshotFileCallback(const Graphics::ScreenshotInfo *info, love::i
 
 	if (i != nullptr && fileinfo != nullptr)
 	{
+		// Encoding and writing the file happens on a worker thread. The
+		// ImageData was created just for this callback, so it isn't copied.
+		image::EncodeJob *job = nullptr;
+
 		try
 		{
-			i->encode(fileinfo->format, fileinfo->filename.c_str(), true);
+			job = new image::EncodeJob(i, fileinfo->format, fileinfo->filename, true);
+			job->start([](image::EncodeJob *j)
+			{
+				if (j->hasError())
+					printf("Screenshot encoding or saving failed: %s", j->getError().c_str());
+			});
 		}
 		catch (love::Exception &e)
 		{
 			printf("Screenshot encoding or saving failed: %s", e.what());
 			// Do nothing...
 		}
+
+		if (job != nullptr)
+			job->release();
 	}
 
 	delete fileinfo;
@@ -864,6 +883,72 @@ static void luax_checktexturesettings(lua_State *L, int idx, bool opt, bool chec
 	lua_pop(L, 1);
 }
 
+/**
+ * Encodes ImageData to a GPU block-compressed format when the 'compress'
+ * texture setting asks for it. The setting is either a pixel format or true,
+ * in which case the first supported format from a preferred list is used.
+ * Returns null if nothing should be compressed.
+ **/
+static StrongRef<image::CompressedImageData> luax_compresstexturedata(lua_State *L, int idx, image::ImageData *idata, const Texture::Settings &settings)
+{
+	StrongRef<image::CompressedImageData> cdata;
+
+	if (!lua_istable(L, idx))
+		return cdata;
+
+	PixelFormat format = PIXELFORMAT_UNKNOWN;
+	bool compress = false;
+
+	lua_getfield(L, idx, Texture::getConstant(Texture::SETTING_COMPRESS));
+	if (lua_type(L, -1) == LUA_TBOOLEAN)
+		compress = luax_toboolean(L, -1);
+	else if (!lua_isnoneornil(L, -1))
+	{
+		const char *str = luaL_checkstring(L, -1);
+		if (!getConstant(str, format))
+			luax_enumerror(L, "pixel format", str);
+		compress = true;
+	}
+	lua_pop(L, 1);
+
+	if (!compress)
+		return cdata;
+
+	auto imagemodule = Module::getInstance<image::Image>(Module::M_IMAGE);
+	if (imagemodule == nullptr)
+		luaL_error(L, "Cannot compress images without the love.image module.");
+
+	if (format == PIXELFORMAT_UNKNOWN)
+	{
+		bool alpha = getPixelFormatColorComponents(idata->getFormat()) == 4;
+		if (alpha && idata->getFormat() == PIXELFORMAT_RGBA8_UNORM)
+			alpha = image::blockencoder::hasAlpha((const uint8 *) idata->getData(), idata->getWidth(), idata->getHeight());
+
+		const PixelFormat alphaformats[] = {PIXELFORMAT_BC7_UNORM, PIXELFORMAT_DXT5_UNORM, PIXELFORMAT_ETC2_RGBA_UNORM};
+		const PixelFormat opaqueformats[] = {PIXELFORMAT_DXT1_UNORM, PIXELFORMAT_ETC2_RGB_UNORM, PIXELFORMAT_BC7_UNORM};
+
+		for (PixelFormat candidate : alpha ? alphaformats : opaqueformats)
+		{
+			if (instance()->isPixelFormatSupported(candidate, PIXELFORMATUSAGEFLAGS_SAMPLE))
+			{
+				format = candidate;
+				break;
+			}
+		}
+
+		// Nothing suitable on this system, keep the uncompressed pixels.
+		if (format == PIXELFORMAT_UNKNOWN)
+			return cdata;
+	}
+	else if (!imagemodule->isCompressedEncodingSupported(format))
+		luaL_error(L, "Compressing textures to the %s pixel format is not supported.", getPixelFormatName(format));
+
+	bool mipmaps = settings.mipmaps != Texture::MIPMAPS_NONE;
+	luax_catchexcept(L, [&]() { cdata.set(imagemodule->newCompressedData(idata, format, mipmaps), Acquire::NORETAIN); });
+
+	return cdata;
+}
+
 int w_newCanvas(lua_State *L)
 {
 	luax_checkgraphicscreated(L);
@@ -959,9 +1044,12 @@ int w_newTexture(lua_State *L)
 		{
 			auto data = getImageData(L, 1, true, autodpiscale);
 			if (data.first.get())
-				slices.set(0, 0, data.first);
-			else
+				data.second = luax_compresstexturedata(L, 2, data.first, settings);
+
+			if (data.second.get())
 				slices.add(data.second, 0, 0, false, settings.mipmaps != Texture::MIPMAPS_NONE);
+			else
+				slices.set(0, 0, data.first);
 		}
 	}
 
@@ -1428,6 +1516,17 @@ int w_newImageFont(lua_State *L)
 	return 1;
 }
 
+int w_newDrawCommandBuffer(lua_State *L)
+{
+	// Doesn't touch the GPU, so this is safe to call from any thread.
+	DrawCommandBuffer *t = nullptr;
+	luax_catchexcept(L, [&]() { t = new DrawCommandBuffer(); });
+
+	luax_pushtype(L, t);
+	t->release();
+	return 1;
+}
+
 int w_newSpriteBatch(lua_State *L)
 {
 	luax_checkgraphicscreated(L);
@@ -1442,9 +1541,45 @@ int w_newSpriteBatch(lua_State *L)
 			return luax_enumerror(L, "usage hint", getConstants(usage), usagestr);
 	}
 
+	SpriteBatch::StorageMode storage = SpriteBatch::STORAGE_VERTICES;
+	if (!lua_isnoneornil(L, 4))
+	{
+		const char *storagestr = luaL_checkstring(L, 4);
+		if (!SpriteBatch::getConstant(storagestr, storage))
+			return luax_enumerror(L, "SpriteBatch storage mode", SpriteBatch::getConstants(storage), storagestr);
+	}
+
 	SpriteBatch *t = nullptr;
 	luax_catchexcept(L,
-		[&](){ t = instance()->newSpriteBatch(texture, size, usage); }
+		[&](){ t = instance()->newSpriteBatch(texture, size, usage, storage); }
+	);
+
+	luax_pushtype(L, t);
+	t->release();
+	return 1;
+}
+
+int w_newTileMap(lua_State *L)
+{
+	luax_checkgraphicscreated(L);
+
+	Texture *tileset = luax_checktexture(L, 1);
+	int width = (int) luaL_checkinteger(L, 2);
+	int height = (int) luaL_checkinteger(L, 3);
+	int tilewidth = (int) luaL_checkinteger(L, 4);
+	int tileheight = (int) luaL_checkinteger(L, 5);
+
+	PixelFormat format = PIXELFORMAT_R16_UINT;
+	if (!lua_isnoneornil(L, 6))
+	{
+		const char *formatstr = luaL_checkstring(L, 6);
+		if (!getConstant(formatstr, format))
+			return luax_enumerror(L, "pixel format", formatstr);
+	}
+
+	TileMap *t = nullptr;
+	luax_catchexcept(L,
+		[&](){ t = instance()->newTileMap(tileset, width, height, tilewidth, tileheight, format); }
 	);
 
 	luax_pushtype(L, t);
@@ -3107,7 +3242,7 @@ int w_getStats(lua_State *L)
 	if (lua_istable(L, 1))
 		lua_pushvalue(L, 1);
 	else
-		lua_createtable(L, 0, 7);
+		lua_createtable(L, 0, 14);
 
 	lua_pushinteger(L, stats.drawCalls);
 	lua_setfield(L, -2, "drawcalls");
@@ -3136,9 +3271,85 @@ int w_getStats(lua_State *L)
 	lua_pushnumber(L, (lua_Number) stats.bufferMemory);
 	lua_setfield(L, -2, "buffermemory");
 
+	lua_pushnumber(L, stats.gpuTime);
+	lua_setfield(L, -2, "gputime");
+
+	lua_pushnumber(L, (lua_Number) stats.streamVertexBufferSize);
+	lua_setfield(L, -2, "streamvertexsize");
+
+	lua_pushnumber(L, (lua_Number) stats.streamIndexBufferSize);
+	lua_setfield(L, -2, "streamindexsize");
+
+	lua_pushinteger(L, stats.streamBufferStalls);
+	lua_setfield(L, -2, "streamstalls");
+
+	// Reuse the nested table too, if one was passed in.
+	lua_getfield(L, -1, "batchflushes");
+	if (!lua_istable(L, -1))
+	{
+		lua_pop(L, 1);
+		lua_createtable(L, 0, Graphics::BATCHFLUSH_MAX_ENUM);
+	}
+
+	for (int i = 0; i < Graphics::BATCHFLUSH_MAX_ENUM; i++)
+	{
+		const char *name = nullptr;
+		if (!Graphics::getConstant((Graphics::BatchFlushReason) i, name))
+			continue;
+
+		lua_pushinteger(L, stats.batchFlushes[i]);
+		lua_setfield(L, -2, name);
+	}
+
+	lua_setfield(L, -2, "batchflushes");
+
 	return 1;
 }
 
+int w_getGPUTimings(lua_State *L)
+{
+	const auto &timings = instance()->getGPUTimings();
+
+	lua_createtable(L, (int) timings.size(), 0);
+
+	for (size_t i = 0; i < timings.size(); i++)
+	{
+		const Graphics::GPUTiming &timing = timings[i];
+
+		lua_createtable(L, 0, 4);
+
+		luax_pushstring(L, timing.name);
+		lua_setfield(L, -2, "name");
+
+		lua_pushnumber(L, timing.time);
+		lua_setfield(L, -2, "time");
+
+		lua_pushinteger(L, timing.depth);
+		lua_setfield(L, -2, "depth");
+
+		lua_pushboolean(L, timing.renderPass);
+		lua_setfield(L, -2, "renderpass");
+
+		lua_rawseti(L, -2, (int) i + 1);
+	}
+
+	luax_pushboolean(L, instance()->isGPUTimingSupported());
+	return 2;
+}
+
+int w_beginProfileZone(lua_State *L)
+{
+	std::string name = luax_checkstring(L, 1);
+	luax_catchexcept(L, [&]() { instance()->beginProfileZone(name); });
+	return 0;
+}
+
+int w_endProfileZone(lua_State *L)
+{
+	luax_catchexcept(L, [&]() { instance()->endProfileZone(); });
+	return 0;
+}
+
 int w_draw(lua_State *L)
 {
 	Drawable *drawable = nullptr;
@@ -3228,7 +3439,22 @@ int w_drawIndirect(lua_State *L)
 
 	luax_checkstandardtransform(L, 4, [&](const Matrix4 &m)
 	{
-		luax_catchexcept(L, [&]() { instance()->drawIndirect(t, m, argsbuffer, argsindex); });
+		luax_catchexcept(L, [&]() { instance()->drawIndirect(t, m, argsbuffer, argsindex, 1); });
+	});
+
+	return 0;
+}
+
+int w_multiDrawIndirect(lua_State *L)
+{
+	Mesh *t = luax_checkmesh(L, 1);
+	Buffer *argsbuffer = luax_checkbuffer(L, 2);
+	int argsindex = (int) luaL_checkinteger(L, 3) - 1;
+	int drawcount = (int) luaL_checkinteger(L, 4);
+
+	luax_checkstandardtransform(L, 5, [&](const Matrix4 &m)
+	{
+		luax_catchexcept(L, [&]() { instance()->drawIndirect(t, m, argsbuffer, argsindex, drawcount); });
 	});
 
 	return 0;
@@ -3283,7 +3509,7 @@ int w_drawFromShaderIndirect(lua_State *L)
 		if (!lua_isnoneornil(L, 4))
 			tex = luax_checktexture(L, 4);
 
-		luax_catchexcept(L, [&]() { instance()->drawFromShaderIndirect(t, argsbuffer, argsindex, tex); });
+		luax_catchexcept(L, [&]() { instance()->drawFromShaderIndirect(t, argsbuffer, argsindex, 1, tex); });
 	}
 	else
 	{
@@ -3299,7 +3525,43 @@ int w_drawFromShaderIndirect(lua_State *L)
 		if (!lua_isnoneornil(L, 4))
 			tex = luax_checktexture(L, 4);
 
-		luax_catchexcept(L, [&]() { instance()->drawFromShaderIndirect(primtype, argsbuffer, argsindex, tex); });
+		luax_catchexcept(L, [&]() { instance()->drawFromShaderIndirect(primtype, argsbuffer, argsindex, 1, tex); });
+	}
+	return 0;
+}
+
+int w_multiDrawFromShaderIndirect(lua_State *L)
+{
+	if (luax_istype(L, 1, Buffer::type))
+	{
+		// Indexed drawing.
+		Buffer *t = luax_checkbuffer(L, 1);
+		Buffer *argsbuffer = luax_checkbuffer(L, 2);
+		int argsindex = (int) luaL_checkinteger(L, 3) - 1;
+		int drawcount = (int) luaL_checkinteger(L, 4);
+
+		Texture *tex = nullptr;
+		if (!lua_isnoneornil(L, 5))
+			tex = luax_checktexture(L, 5);
+
+		luax_catchexcept(L, [&]() { instance()->drawFromShaderIndirect(t, argsbuffer, argsindex, drawcount, tex); });
+	}
+	else
+	{
+		const char *primstr = luaL_checkstring(L, 1);
+		PrimitiveType primtype = PRIMITIVE_TRIANGLES;
+		if (!getConstant(primstr, primtype))
+			return luax_enumerror(L, "primitive type", getConstants(primtype), primstr);
+
+		Buffer *argsbuffer = luax_checkbuffer(L, 2);
+		int argsindex = (int) luaL_checkinteger(L, 3) - 1;
+		int drawcount = (int) luaL_checkinteger(L, 4);
+
+		Texture *tex = nullptr;
+		if (!lua_isnoneornil(L, 5))
+			tex = luax_checktexture(L, 5);
+
+		luax_catchexcept(L, [&]() { instance()->drawFromShaderIndirect(primtype, argsbuffer, argsindex, drawcount, tex); });
 	}
 	return 0;
 }
@@ -3798,6 +4060,37 @@ int w_flushBatch(lua_State *)
 	return 0;
 }
 
+int w_beginDrawList(lua_State *L)
+{
+	luax_catchexcept(L, [&]() { instance()->beginDrawList(); });
+	return 0;
+}
+
+int w_submitDrawList(lua_State *L)
+{
+	luax_catchexcept(L, [&]() { instance()->submitDrawList(); });
+	return 0;
+}
+
+int w_isDrawListActive(lua_State *L)
+{
+	luax_pushboolean(L, instance()->isDrawListActive());
+	return 1;
+}
+
+int w_setDrawListLayer(lua_State *L)
+{
+	float layer = (float) luaL_checknumber(L, 1);
+	luax_catchexcept(L, [&]() { instance()->setDrawListLayer(layer); });
+	return 0;
+}
+
+int w_getDrawListLayer(lua_State *L)
+{
+	lua_pushnumber(L, instance()->getDrawListLayer());
+	return 1;
+}
+
 int w_getStackDepth(lua_State *L)
 {
 	lua_pushnumber(L, instance()->getStackDepth());
@@ -3958,6 +4251,8 @@ static const luaL_Reg functions[] =
 	{ "newFont", w_newFont },
 	{ "newImageFont", w_newImageFont },
 	{ "newSpriteBatch", w_newSpriteBatch },
+	{ "newTileMap", w_newTileMap },
+	{ "newDrawCommandBuffer", w_newDrawCommandBuffer },
 	{ "newParticleSystem", w_newParticleSystem },
 	{ "newShader", w_newShader },
 	{ "newComputeShader", w_newComputeShader },
@@ -4021,6 +4316,9 @@ static const luaL_Reg functions[] =
 	{ "getSystemLimits", w_getSystemLimits },
 	{ "getTextureTypes", w_getTextureTypes },
 	{ "getStats", w_getStats },
+	{ "getGPUTimings", w_getGPUTimings },
+	{ "beginProfileZone", w_beginProfileZone },
+	{ "endProfileZone", w_endProfileZone },
 
 	{ "captureScreenshot", w_captureScreenshot },
 
@@ -4030,6 +4328,8 @@ static const luaL_Reg functions[] =
 	{ "drawIndirect", w_drawIndirect },
 	{ "drawFromShader", w_drawFromShader },
 	{ "drawFromShaderIndirect", w_drawFromShaderIndirect },
+	{ "multiDrawIndirect", w_multiDrawIndirect },
+	{ "multiDrawFromShaderIndirect", w_multiDrawFromShaderIndirect },
 
 	{ "print", w_print },
 	{ "printf", w_printf },
@@ -4043,6 +4343,7 @@ static const luaL_Reg functions[] =
 
 	{ "isCreated", w_isCreated },
 	{ "isActive", w_isActive },
+	{ "_getDefaultShaderCompileTime", w__getDefaultShaderCompileTime },
 	{ "isGammaCorrect", w_isGammaCorrect },
 	{ "getWidth", w_getWidth },
 	{ "getHeight", w_getHeight },
@@ -4072,6 +4373,12 @@ static const luaL_Reg functions[] =
 
 	{ "flushBatch", w_flushBatch },
 
+	{ "beginDrawList", w_beginDrawList },
+	{ "submitDrawList", w_submitDrawList },
+	{ "isDrawListActive", w_isDrawListActive },
+	{ "setDrawListLayer", w_setDrawListLayer },
+	{ "getDrawListLayer", w_getDrawListLayer },
+
 	{ "getStackDepth", w_getStackDepth },
 	{ "push", w_push },
 	{ "pop", w_pop },
@@ -4115,10 +4422,12 @@ static const lua_CFunction types[] =
 	luaopen_graphicsbuffer,
 	luaopen_graphicsreadback,
 	luaopen_spritebatch,
+	luaopen_drawcommandbuffer,
 	luaopen_particlesystem,
 	luaopen_shader,
 	luaopen_mesh,
 	luaopen_textbatch,
+	luaopen_tilemap,
 	luaopen_video,
 	0
 };
@@ -26,10 +26,12 @@
 #include "wrap_Texture.h"
 #include "wrap_Quad.h"
 #include "wrap_SpriteBatch.h"
+#include "wrap_DrawCommandBuffer.h"
 #include "wrap_ParticleSystem.h"
 #include "wrap_Shader.h"
 #include "wrap_Mesh.h"
 #include "wrap_TextBatch.h"
+#include "wrap_TileMap.h"
 #include "wrap_Video.h"
 #include "wrap_Buffer.h"
 #include "wrap_GraphicsReadback.h"
@@ -22,6 +22,7 @@
 #include "wrap_SpriteBatch.h"
 #include "Texture.h"
 #include "wrap_Texture.h"
+#include "common/Data.h"
 
 namespace love
 {
@@ -260,6 +261,50 @@ int w_SpriteBatch_getDrawRange(lua_State *L)
 	return 2;
 }
 
+int w_SpriteBatch_getStorageMode(lua_State *L)
+{
+	SpriteBatch *t = luax_checkspritebatch(L, 1);
+	const char *str = nullptr;
+	if (!SpriteBatch::getConstant(t->getStorageMode(), str))
+		return luaL_error(L, "Unknown SpriteBatch storage mode.");
+	lua_pushstring(L, str);
+	return 1;
+}
+
+int w_SpriteBatch_addQuad(lua_State *L)
+{
+	SpriteBatch *t = luax_checkspritebatch(L, 1);
+	Quad *quad = luax_checktype<Quad>(L, 2);
+	int index = 0;
+	luax_catchexcept(L, [&](){ index = t->addQuad(quad); });
+	lua_pushinteger(L, index);
+	return 1;
+}
+
+int w_SpriteBatch_getQuadCount(lua_State *L)
+{
+	SpriteBatch *t = luax_checkspritebatch(L, 1);
+	lua_pushinteger(L, t->getQuadCount());
+	return 1;
+}
+
+int w_SpriteBatch_setInstances(lua_State *L)
+{
+	SpriteBatch *t = luax_checkspritebatch(L, 1);
+	int startindex = (int) luaL_checkinteger(L, 2) - 1;
+	Data *data = luax_checktype<Data>(L, 3);
+
+	size_t maxcount = data->getSize() / sizeof(SpriteBatch::Instance);
+	int count = (int) luaL_optinteger(L, 4, (lua_Integer) maxcount);
+
+	if (count < 0 || (size_t) count > maxcount)
+		return luaL_error(L, "Invalid instance count: %d (the Data holds %d instances)", count, (int) maxcount);
+
+	const auto *instances = (const SpriteBatch::Instance *) data->getData();
+	luax_catchexcept(L, [&](){ t->setInstances(startindex, instances, count); });
+	return 0;
+}
+
 static const luaL_Reg w_SpriteBatch_functions[] =
 {
 	{ "add", w_SpriteBatch_add },
@@ -277,6 +322,10 @@ static const luaL_Reg w_SpriteBatch_functions[] =
 	{ "attachAttribute", w_SpriteBatch_attachAttribute },
 	{ "setDrawRange", w_SpriteBatch_setDrawRange },
 	{ "getDrawRange", w_SpriteBatch_getDrawRange },
+	{ "getStorageMode", w_SpriteBatch_getStorageMode },
+	{ "addQuad", w_SpriteBatch_addQuad },
+	{ "getQuadCount", w_SpriteBatch_getQuadCount },
+	{ "setInstances", w_SpriteBatch_setInstances },
 	{ 0, 0 }
 };
 
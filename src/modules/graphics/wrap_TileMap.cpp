@@ -0,0 +1,194 @@
+/**
+ * Copyright (c) 2006-2024 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+
+#include "wrap_TileMap.h"
+#include "wrap_Texture.h"
+
+// C++
+#include <vector>
+
+namespace love
+{
+namespace graphics
+{
+
+TileMap *luax_checktilemap(lua_State *L, int idx)
+{
+	return luax_checktype<TileMap>(L, idx);
+}
+
+static uint32 luax_checktileid(lua_State *L, int idx)
+{
+	lua_Integer id = luaL_checkinteger(L, idx);
+	if (id < 0 || id > 0xFFFFFFFF)
+		luaL_error(L, "Invalid tile id (must be between 0 and 4294967295).");
+	return (uint32) id;
+}
+
+int w_TileMap_setTile(lua_State *L)
+{
+	TileMap *t = luax_checktilemap(L, 1);
+	int x = (int) luaL_checkinteger(L, 2);
+	int y = (int) luaL_checkinteger(L, 3);
+	uint32 id = luax_checktileid(L, 4);
+	luax_catchexcept(L, [&](){ t->setTile(x, y, id); });
+	return 0;
+}
+
+int w_TileMap_getTile(lua_State *L)
+{
+	TileMap *t = luax_checktilemap(L, 1);
+	int x = (int) luaL_checkinteger(L, 2);
+	int y = (int) luaL_checkinteger(L, 3);
+	uint32 id = 0;
+	luax_catchexcept(L, [&](){ id = t->getTile(x, y); });
+	lua_pushinteger(L, (lua_Integer) id);
+	return 1;
+}
+
+int w_TileMap_setTiles(lua_State *L)
+{
+	TileMap *t = luax_checktilemap(L, 1);
+	int x = (int) luaL_checkinteger(L, 2);
+	int y = (int) luaL_checkinteger(L, 3);
+	int w = (int) luaL_checkinteger(L, 4);
+	luaL_checktype(L, 5, LUA_TTABLE);
+
+	int count = (int) luax_objlen(L, 5);
+
+	if (w <= 0 || count % w != 0)
+		return luaL_error(L, "The number of tile ids (%d) must be a multiple of the region width (%d).", count, w);
+
+	std::vector<uint32> ids(count);
+	for (int i = 0; i < count; i++)
+	{
+		lua_rawgeti(L, 5, i + 1);
+		ids[i] = luax_checktileid(L, -1);
+		lua_pop(L, 1);
+	}
+
+	luax_catchexcept(L, [&](){ t->setTiles(x, y, w, count / w, ids.data()); });
+	return 0;
+}
+
+int w_TileMap_fill(lua_State *L)
+{
+	TileMap *t = luax_checktilemap(L, 1);
+	uint32 id = luax_checktileid(L, 2);
+	luax_catchexcept(L, [&](){ t->fill(id); });
+	return 0;
+}
+
+int w_TileMap_setTileset(lua_State *L)
+{
+	TileMap *t = luax_checktilemap(L, 1);
+	Texture *tex = luax_checktexture(L, 2);
+	luax_catchexcept(L, [&](){ t->setTileset(tex); });
+	return 0;
+}
+
+int w_TileMap_getTileset(lua_State *L)
+{
+	TileMap *t = luax_checktilemap(L, 1);
+	luax_pushtype(L, t->getTileset());
+	return 1;
+}
+
+int w_TileMap_getWidth(lua_State *L)
+{
+	TileMap *t = luax_checktilemap(L, 1);
+	lua_pushinteger(L, t->getWidth());
+	return 1;
+}
+
+int w_TileMap_getHeight(lua_State *L)
+{
+	TileMap *t = luax_checktilemap(L, 1);
+	lua_pushinteger(L, t->getHeight());
+	return 1;
+}
+
+int w_TileMap_getDimensions(lua_State *L)
+{
+	TileMap *t = luax_checktilemap(L, 1);
+	lua_pushinteger(L, t->getWidth());
+	lua_pushinteger(L, t->getHeight());
+	return 2;
+}
+
+int w_TileMap_getTileDimensions(lua_State *L)
+{
+	TileMap *t = luax_checktilemap(L, 1);
+	lua_pushinteger(L, t->getTileWidth());
+	lua_pushinteger(L, t->getTileHeight());
+	return 2;
+}
+
+int w_TileMap_getFormat(lua_State *L)
+{
+	TileMap *t = luax_checktilemap(L, 1);
+	const char *str;
+	if (!getConstant(t->getFormat(), str))
+		return luaL_error(L, "Unknown pixel format.");
+
+	lua_pushstring(L, str);
+	return 1;
+}
+
+int w_TileMap_getMaxTileID(lua_State *L)
+{
+	TileMap *t = luax_checktilemap(L, 1);
+	lua_pushinteger(L, (lua_Integer) t->getMaxTileID());
+	return 1;
+}
+
+int w_TileMap_flush(lua_State *L)
+{
+	TileMap *t = luax_checktilemap(L, 1);
+	luax_catchexcept(L, [&](){ t->flush(); });
+	return 0;
+}
+
+static const luaL_Reg w_TileMap_functions[] =
+{
+	{ "setTile", w_TileMap_setTile },
+	{ "getTile", w_TileMap_getTile },
+	{ "setTiles", w_TileMap_setTiles },
+	{ "fill", w_TileMap_fill },
+	{ "setTileset", w_TileMap_setTileset },
+	{ "getTileset", w_TileMap_getTileset },
+	{ "getWidth", w_TileMap_getWidth },
+	{ "getHeight", w_TileMap_getHeight },
+	{ "getDimensions", w_TileMap_getDimensions },
+	{ "getTileDimensions", w_TileMap_getTileDimensions },
+	{ "getFormat", w_TileMap_getFormat },
+	{ "getMaxTileID", w_TileMap_getMaxTileID },
+	{ "flush", w_TileMap_flush },
+	{ 0, 0 }
+};
+
+extern "C" int luaopen_tilemap(lua_State *L)
+{
+	return luax_register_type(L, &TileMap::type, w_TileMap_functions, nullptr);
+}
+
+} // graphics
+} // love
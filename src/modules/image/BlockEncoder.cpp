@@ -0,0 +1,949 @@
+/**
+ * Copyright (c) 2006-2024 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+// LOVE
+#include "BlockEncoder.h"
+#include "common/config.h"
+#include "thread/ThreadPool.h"
+
+// C++
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#if defined(LOVE_SIMD_SSE)
+#include <xmmintrin.h>
+#endif
+
+#if defined(LOVE_SIMD_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace love
+{
+namespace image
+{
+namespace blockencoder
+{
+
+// All encoders work on one 4x4 block at a time, with pixels in row-major order.
+// Most of the time goes into finding the closest palette entry for each pixel,
+// which is done 4 palette entries at a time with SSE or NEON when available.
+
+static const float MAX_ERROR = std::numeric_limits<float>::max();
+
+static inline int clampi(int v, int lo, int hi)
+{
+	return std::min(std::max(v, lo), hi);
+}
+
+static inline int roundf2i(float v)
+{
+	return (int) std::floor(v + 0.5f);
+}
+
+/**
+ * Computes the squared distance from a pixel to each of the first 'count'
+ * palette entries (a multiple of 4). The palette is stored one array per
+ * channel, and only the first 'channels' channels are compared.
+ **/
+static inline void paletteDistances(const float p[4], const float palette[4][16], int channels, int count, float out[16])
+{
+#if defined(LOVE_SIMD_SSE)
+	for (int j = 0; j < count; j += 4)
+	{
+		__m128 err = _mm_setzero_ps();
+		for (int c = 0; c < channels; c++)
+		{
+			__m128 d = _mm_sub_ps(_mm_set1_ps(p[c]), _mm_loadu_ps(&palette[c][j]));
+			err = _mm_add_ps(err, _mm_mul_ps(d, d));
+		}
+		_mm_storeu_ps(out + j, err);
+	}
+#elif defined(LOVE_SIMD_NEON)
+	for (int j = 0; j < count; j += 4)
+	{
+		float32x4_t err = vdupq_n_f32(0.0f);
+		for (int c = 0; c < channels; c++)
+		{
+			float32x4_t d = vsubq_f32(vdupq_n_f32(p[c]), vld1q_f32(&palette[c][j]));
+			err = vmlaq_f32(err, d, d);
+		}
+		vst1q_f32(out + j, err);
+	}
+#else
+	for (int j = 0; j < count; j++)
+	{
+		float err = 0.0f;
+		for (int c = 0; c < channels; c++)
+		{
+			float d = p[c] - palette[c][j];
+			err += d * d;
+		}
+		out[j] = err;
+	}
+#endif
+}
+
+// Index of the first smallest distance.
+static inline int closestIndex(const float dist[16], int count, float &best)
+{
+	int index = 0;
+	best = MAX_ERROR;
+	for (int j = 0; j < count; j++)
+	{
+		if (dist[j] < best)
+		{
+			best = dist[j];
+			index = j;
+		}
+	}
+	return index;
+}
+
+static void fetchBlock(const uint8 *rgba, int width, int height, int bx, int by, uint8 px[16][4])
+{
+	for (int y = 0; y < 4; y++)
+	{
+		int sy = std::min(by * 4 + y, height - 1);
+		for (int x = 0; x < 4; x++)
+		{
+			int sx = std::min(bx * 4 + x, width - 1);
+			memcpy(px[y * 4 + x], rgba + ((size_t) sy * width + sx) * 4, 4);
+		}
+	}
+}
+
+/**
+ * Finds the line through the (optionally masked) pixels which best fits them,
+ * using power iteration on their covariance matrix, and returns the ends of
+ * the pixels' projection onto it.
+ **/
+static void fitLine(const float px[16][4], const bool *mask, int channels, float e0[4], float e1[4])
+{
+	float mean[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+	int count = 0;
+
+	for (int i = 0; i < 16; i++)
+	{
+		if (mask != nullptr && !mask[i])
+			continue;
+		for (int c = 0; c < 4; c++)
+			mean[c] += px[i][c];
+		count++;
+	}
+
+	if (count == 0)
+	{
+		for (int c = 0; c < 4; c++)
+			e0[c] = e1[c] = 0.0f;
+		return;
+	}
+
+	for (int c = 0; c < 4; c++)
+		mean[c] /= (float) count;
+
+	float cov[4][4] = {};
+	for (int i = 0; i < 16; i++)
+	{
+		if (mask != nullptr && !mask[i])
+			continue;
+		float d[4];
+		for (int c = 0; c < 4; c++)
+			d[c] = c < channels ? px[i][c] - mean[c] : 0.0f;
+		for (int r = 0; r < 4; r++)
+		{
+			for (int c = 0; c < 4; c++)
+				cov[r][c] += d[r] * d[c];
+		}
+	}
+
+	// Start from the covariance row of the channel with the most variance, so
+	// the initial guess is never orthogonal to the principal axis.
+	int start = 0;
+	for (int c = 1; c < channels; c++)
+	{
+		if (cov[c][c] > cov[start][start])
+			start = c;
+	}
+
+	float axis[4];
+	for (int c = 0; c < 4; c++)
+		axis[c] = cov[start][c];
+
+	for (int iter = 0; iter < 8; iter++)
+	{
+		float next[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+		for (int r = 0; r < 4; r++)
+		{
+			for (int c = 0; c < 4; c++)
+				next[r] += cov[r][c] * axis[c];
+		}
+
+		float len = 0.0f;
+		for (int c = 0; c < 4; c++)
+			len = std::max(len, std::abs(next[c]));
+
+		if (len < 1e-6f)
+			break;
+
+		for (int c = 0; c < 4; c++)
+			axis[c] = next[c] / len;
+	}
+
+	float len2 = 0.0f;
+	for (int c = 0; c < 4; c++)
+		len2 += axis[c] * axis[c];
+
+	float tmin = 0.0f;
+	float tmax = 0.0f;
+
+	if (len2 > 1e-12f)
+	{
+		tmin = MAX_ERROR;
+		tmax = -MAX_ERROR;
+		for (int i = 0; i < 16; i++)
+		{
+			if (mask != nullptr && !mask[i])
+				continue;
+			float t = 0.0f;
+			for (int c = 0; c < channels; c++)
+				t += (px[i][c] - mean[c]) * axis[c];
+			t /= len2;
+			tmin = std::min(tmin, t);
+			tmax = std::max(tmax, t);
+		}
+	}
+
+	for (int c = 0; c < 4; c++)
+	{
+		e0[c] = std::min(std::max(mean[c] + axis[c] * tmin, 0.0f), 255.0f);
+		e1[c] = std::min(std::max(mean[c] + axis[c] * tmax, 0.0f), 255.0f);
+	}
+}
+
+/**
+ * Solves for the endpoints which minimize the squared error of the pixels,
+ * given each pixel's interpolation weight between them. Pixels with a
+ * negative weight are ignored.
+ **/
+static bool refineLine(const float px[16][4], const float t[16], int channels, float e0[4], float e1[4])
+{
+	float a = 0.0f, b = 0.0f, c = 0.0f;
+	float d0[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+	float d1[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+
+	for (int i = 0; i < 16; i++)
+	{
+		if (t[i] < 0.0f)
+			continue;
+		float s = 1.0f - t[i];
+		a += s * s;
+		b += s * t[i];
+		c += t[i] * t[i];
+		for (int ch = 0; ch < 4; ch++)
+		{
+			d0[ch] += s * px[i][ch];
+			d1[ch] += t[i] * px[i][ch];
+		}
+	}
+
+	float det = a * c - b * b;
+	if (std::abs(det) < 1e-6f)
+		return false;
+
+	for (int ch = 0; ch < channels; ch++)
+	{
+		e0[ch] = std::min(std::max((c * d0[ch] - b * d1[ch]) / det, 0.0f), 255.0f);
+		e1[ch] = std::min(std::max((a * d1[ch] - b * d0[ch]) / det, 0.0f), 255.0f);
+	}
+
+	return true;
+}
+
+static void toFloat(const uint8 px[16][4], float out[16][4])
+{
+	for (int i = 0; i < 16; i++)
+	{
+		for (int c = 0; c < 4; c++)
+			out[i][c] = (float) px[i][c];
+	}
+}
+
+// BC1 / DXT1
+
+struct BC1Block
+{
+	uint16 c0, c1;
+	uint8 indices[16];
+	float error;
+};
+
+static uint16 pack565(const float c[4])
+{
+	int r = clampi(roundf2i(c[0] * 31.0f / 255.0f), 0, 31);
+	int g = clampi(roundf2i(c[1] * 63.0f / 255.0f), 0, 63);
+	int b = clampi(roundf2i(c[2] * 31.0f / 255.0f), 0, 31);
+	return (uint16) ((r << 11) | (g << 5) | b);
+}
+
+static void unpack565(uint16 v, int out[3])
+{
+	int r = (v >> 11) & 31;
+	int g = (v >> 5) & 63;
+	int b = v & 31;
+	out[0] = (r << 3) | (r >> 2);
+	out[1] = (g << 2) | (g >> 4);
+	out[2] = (b << 3) | (b >> 2);
+}
+
+static void evaluateBC1(const float px[16][4], const bool mask[16], bool threecolor, uint16 c0, uint16 c1, BC1Block &block)
+{
+	// The endpoint order selects the mode: c0 > c1 means 4 colors, otherwise
+	// 3 colors plus transparent black.
+	if (threecolor ? c0 > c1 : c0 < c1)
+		std::swap(c0, c1);
+
+	block.c0 = c0;
+	block.c1 = c1;
+	block.error = 0.0f;
+
+	int palette[4][3];
+	unpack565(c0, palette[0]);
+	unpack565(c1, palette[1]);
+
+	int count = 4;
+	for (int c = 0; c < 3; c++)
+	{
+		if (threecolor || c0 == c1)
+		{
+			palette[2][c] = (palette[0][c] + palette[1][c]) / 2;
+			palette[3][c] = 0;
+		}
+		else
+		{
+			palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+			palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+		}
+	}
+
+	if (threecolor || c0 == c1)
+		count = 3;
+
+	float planar[4][16] = {};
+	for (int j = 0; j < 4; j++)
+	{
+		for (int c = 0; c < 3; c++)
+			planar[c][j] = (float) palette[j][c];
+	}
+
+	for (int i = 0; i < 16; i++)
+	{
+		if (!mask[i])
+		{
+			block.indices[i] = 3;
+			continue;
+		}
+
+		float dist[16];
+		float best;
+		paletteDistances(px[i], planar, 3, 4, dist);
+		block.indices[i] = (uint8) closestIndex(dist, count, best);
+		block.error += best;
+	}
+}
+
+static void encodeBC1(const uint8 px8[16][4], bool allowtransparency, uint8 *dst)
+{
+	float px[16][4];
+	toFloat(px8, px);
+
+	bool mask[16];
+	bool threecolor = false;
+	for (int i = 0; i < 16; i++)
+	{
+		mask[i] = !allowtransparency || px8[i][3] >= 128;
+		threecolor = threecolor || !mask[i];
+	}
+
+	float e0[4], e1[4];
+	fitLine(px, mask, 3, e0, e1);
+
+	BC1Block best;
+	evaluateBC1(px, mask, threecolor, pack565(e0), pack565(e1), best);
+
+	// One least-squares pass over the chosen indices usually pulls the
+	// endpoints closer to the block's colors than the projected extremes.
+	static const float weights4[4] = {0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f};
+	static const float weights3[4] = {0.0f, 1.0f, 0.5f, -1.0f};
+
+	float t[16];
+	bool is4 = !threecolor && best.c0 != best.c1;
+	for (int i = 0; i < 16; i++)
+		t[i] = mask[i] ? (is4 ? weights4 : weights3)[best.indices[i]] : -1.0f;
+
+	if (refineLine(px, t, 3, e0, e1))
+	{
+		BC1Block refined;
+		evaluateBC1(px, mask, threecolor, pack565(e0), pack565(e1), refined);
+		if (refined.error < best.error)
+			best = refined;
+	}
+
+	uint32 bits = 0;
+	for (int i = 0; i < 16; i++)
+		bits |= (uint32) best.indices[i] << (i * 2);
+
+	dst[0] = (uint8) (best.c0 & 0xFF);
+	dst[1] = (uint8) (best.c0 >> 8);
+	dst[2] = (uint8) (best.c1 & 0xFF);
+	dst[3] = (uint8) (best.c1 >> 8);
+	for (int i = 0; i < 4; i++)
+		dst[4 + i] = (uint8) (bits >> (i * 8));
+}
+
+// BC4-style alpha, used by BC3 / DXT5
+
+static void encodeBC3Alpha(const uint8 px[16][4], uint8 *dst)
+{
+	int amin = 255;
+	int amax = 0;
+	for (int i = 0; i < 16; i++)
+	{
+		amin = std::min(amin, (int) px[i][3]);
+		amax = std::max(amax, (int) px[i][3]);
+	}
+
+	memset(dst, 0, 8);
+	dst[0] = (uint8) amax;
+	dst[1] = (uint8) amin;
+
+	if (amin == amax)
+		return;
+
+	// a0 > a1 selects the mode with 6 interpolated values.
+	int palette[8];
+	palette[0] = amax;
+	palette[1] = amin;
+	for (int i = 1; i < 7; i++)
+		palette[i + 1] = ((7 - i) * amax + i * amin) / 7;
+
+	uint64 bits = 0;
+	for (int i = 0; i < 16; i++)
+	{
+		int besterr = std::numeric_limits<int>::max();
+		int bestindex = 0;
+		for (int j = 0; j < 8; j++)
+		{
+			int err = std::abs((int) px[i][3] - palette[j]);
+			if (err < besterr)
+			{
+				besterr = err;
+				bestindex = j;
+			}
+		}
+		bits |= (uint64) bestindex << (i * 3);
+	}
+
+	for (int i = 0; i < 6; i++)
+		dst[2 + i] = (uint8) (bits >> (i * 8));
+}
+
+// BC7, mode 6 only: a single RGBA subset with 7-bit endpoints, a p-bit per
+// endpoint, and 4-bit indices.
+
+struct BC7Block
+{
+	int endpoints[2][4];
+	int pbits[2];
+	uint8 indices[16];
+	float error;
+};
+
+static const int bc7Weights[16] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+static void evaluateBC7(const float px[16][4], const float e0[4], const float e1[4], BC7Block &block)
+{
+	const float *ends[2] = {e0, e1};
+	int values[2][4];
+
+	for (int e = 0; e < 2; e++)
+	{
+		float besterr = MAX_ERROR;
+		for (int p = 0; p < 2; p++)
+		{
+			int quant[4];
+			float err = 0.0f;
+			for (int c = 0; c < 4; c++)
+			{
+				quant[c] = clampi(roundf2i((ends[e][c] - (float) p) * 0.5f), 0, 127);
+				float d = (float) ((quant[c] << 1) | p) - ends[e][c];
+				err += d * d;
+			}
+
+			if (err < besterr)
+			{
+				besterr = err;
+				block.pbits[e] = p;
+				for (int c = 0; c < 4; c++)
+				{
+					block.endpoints[e][c] = quant[c];
+					values[e][c] = (quant[c] << 1) | p;
+				}
+			}
+		}
+	}
+
+	float palette[4][16];
+	for (int j = 0; j < 16; j++)
+	{
+		for (int c = 0; c < 4; c++)
+			palette[c][j] = (float) (((64 - bc7Weights[j]) * values[0][c] + bc7Weights[j] * values[1][c] + 32) >> 6);
+	}
+
+	block.error = 0.0f;
+	for (int i = 0; i < 16; i++)
+	{
+		float dist[16];
+		float best;
+		paletteDistances(px[i], palette, 4, 16, dist);
+		block.indices[i] = (uint8) closestIndex(dist, 16, best);
+		block.error += best;
+	}
+}
+
+struct BitWriter
+{
+	uint64 words[2] = {0, 0};
+	int pos = 0;
+
+	void write(uint32 value, int bits)
+	{
+		for (int i = 0; i < bits; i++, pos++)
+			words[pos / 64] |= (uint64) ((value >> i) & 1) << (pos % 64);
+	}
+};
+
+static void encodeBC7(const uint8 px8[16][4], uint8 *dst)
+{
+	float px[16][4];
+	toFloat(px8, px);
+
+	float e0[4], e1[4];
+	fitLine(px, nullptr, 4, e0, e1);
+
+	BC7Block best;
+	evaluateBC7(px, e0, e1, best);
+
+	float t[16];
+	for (int i = 0; i < 16; i++)
+		t[i] = (float) bc7Weights[best.indices[i]] / 64.0f;
+
+	if (refineLine(px, t, 4, e0, e1))
+	{
+		BC7Block refined;
+		evaluateBC7(px, e0, e1, refined);
+		if (refined.error < best.error)
+			best = refined;
+	}
+
+	// The most significant index bit of the first pixel is implicitly 0.
+	if (best.indices[0] >= 8)
+	{
+		for (int c = 0; c < 4; c++)
+			std::swap(best.endpoints[0][c], best.endpoints[1][c]);
+		std::swap(best.pbits[0], best.pbits[1]);
+		for (int i = 0; i < 16; i++)
+			best.indices[i] = (uint8) (15 - best.indices[i]);
+	}
+
+	BitWriter bits;
+	bits.write(1 << 6, 7);
+
+	for (int c = 0; c < 4; c++)
+	{
+		bits.write(best.endpoints[0][c], 7);
+		bits.write(best.endpoints[1][c], 7);
+	}
+
+	bits.write(best.pbits[0], 1);
+	bits.write(best.pbits[1], 1);
+
+	bits.write(best.indices[0], 3);
+	for (int i = 1; i < 16; i++)
+		bits.write(best.indices[i], 4);
+
+	for (int i = 0; i < 16; i++)
+		dst[i] = (uint8) (bits.words[i / 8] >> ((i % 8) * 8));
+}
+
+// ETC2 RGB, using the ETC1-compatible individual and differential modes.
+
+static const int etcModifiers[8][2] =
+{
+	{2, 8}, {5, 17}, {9, 29}, {13, 42}, {18, 60}, {24, 80}, {33, 106}, {47, 183},
+};
+
+static int fitETCSubblock(const uint8 px[16][4], const int pixels[8], const int base[3], int &table, uint8 selectors[16])
+{
+	int besterr = std::numeric_limits<int>::max();
+
+	// Squared 8-bit differences are exact in floats, so the errors match
+	// integer math.
+	float pf[8][4];
+	for (int i = 0; i < 8; i++)
+	{
+		for (int c = 0; c < 4; c++)
+			pf[i][c] = (float) px[pixels[i]][c];
+	}
+
+	for (int t = 0; t < 8; t++)
+	{
+		float colors[4][16] = {};
+		for (int s = 0; s < 4; s++)
+		{
+			int mod = (s & 2) ? -etcModifiers[t][s & 1] : etcModifiers[t][s & 1];
+			for (int c = 0; c < 3; c++)
+				colors[c][s] = (float) clampi(base[c] + mod, 0, 255);
+		}
+
+		int err = 0;
+		uint8 sel[8];
+		for (int i = 0; i < 8; i++)
+		{
+			float dist[16];
+			float best;
+			paletteDistances(pf[i], colors, 3, 4, dist);
+			sel[i] = (uint8) closestIndex(dist, 4, best);
+			err += (int) best;
+		}
+
+		if (err < besterr)
+		{
+			besterr = err;
+			table = t;
+			for (int i = 0; i < 8; i++)
+				selectors[pixels[i]] = sel[i];
+		}
+	}
+
+	return besterr;
+}
+
+static void encodeETC2Color(const uint8 px[16][4], uint8 *dst)
+{
+	int besterr = std::numeric_limits<int>::max();
+	uint32 besthigh = 0;
+	uint8 bestselectors[16] = {};
+
+	for (int flip = 0; flip < 2; flip++)
+	{
+		// Subblock 0 is the left half, or the top half when flipped.
+		int pixels[2][8];
+		int counts[2] = {0, 0};
+		for (int i = 0; i < 16; i++)
+		{
+			int x = i % 4;
+			int y = i / 4;
+			int sub = flip ? (y >= 2) : (x >= 2);
+			pixels[sub][counts[sub]++] = i;
+		}
+
+		float avg[2][3] = {};
+		for (int sub = 0; sub < 2; sub++)
+		{
+			for (int i = 0; i < 8; i++)
+			{
+				for (int c = 0; c < 3; c++)
+					avg[sub][c] += px[pixels[sub][i]][c];
+			}
+			for (int c = 0; c < 3; c++)
+				avg[sub][c] /= 8.0f;
+		}
+
+		for (int diff = 0; diff < 2; diff++)
+		{
+			int quant[2][3];
+			int base[2][3];
+
+			for (int c = 0; c < 3; c++)
+			{
+				if (diff)
+				{
+					// 5-bit base color plus a 3-bit signed delta for the second
+					// subblock, clamped into range.
+					quant[0][c] = clampi(roundf2i(avg[0][c] * 31.0f / 255.0f), 0, 31);
+					int q1 = clampi(roundf2i(avg[1][c] * 31.0f / 255.0f), 0, 31);
+					quant[1][c] = quant[0][c] + clampi(q1 - quant[0][c], -4, 3);
+					for (int sub = 0; sub < 2; sub++)
+						base[sub][c] = (quant[sub][c] << 3) | (quant[sub][c] >> 2);
+				}
+				else
+				{
+					for (int sub = 0; sub < 2; sub++)
+					{
+						quant[sub][c] = clampi(roundf2i(avg[sub][c] * 15.0f / 255.0f), 0, 15);
+						base[sub][c] = quant[sub][c] * 17;
+					}
+				}
+			}
+
+			uint8 selectors[16];
+			int tables[2];
+			int err = fitETCSubblock(px, pixels[0], base[0], tables[0], selectors);
+			err += fitETCSubblock(px, pixels[1], base[1], tables[1], selectors);
+
+			if (err >= besterr)
+				continue;
+
+			besterr = err;
+			memcpy(bestselectors, selectors, sizeof(selectors));
+
+			uint32 high = 0;
+			if (diff)
+			{
+				for (int c = 0; c < 3; c++)
+				{
+					int delta = quant[1][c] - quant[0][c];
+					high |= (uint32) ((quant[0][c] << 3) | (delta & 7)) << (24 - c * 8);
+				}
+			}
+			else
+			{
+				for (int c = 0; c < 3; c++)
+					high |= (uint32) ((quant[0][c] << 4) | quant[1][c]) << (24 - c * 8);
+			}
+
+			high |= (uint32) tables[0] << 5;
+			high |= (uint32) tables[1] << 2;
+			high |= (uint32) diff << 1;
+			high |= (uint32) flip;
+			besthigh = high;
+		}
+	}
+
+	// Selector bits are stored in column-major pixel order, with the low bits
+	// of every pixel in the lower half-word.
+	uint32 low = 0;
+	for (int i = 0; i < 16; i++)
+	{
+		int x = i % 4;
+		int y = i / 4;
+		int bit = x * 4 + y;
+		low |= (uint32) (bestselectors[i] & 1) << bit;
+		low |= (uint32) (bestselectors[i] >> 1) << (bit + 16);
+	}
+
+	for (int i = 0; i < 4; i++)
+	{
+		dst[i] = (uint8) (besthigh >> (24 - i * 8));
+		dst[4 + i] = (uint8) (low >> (24 - i * 8));
+	}
+}
+
+// EAC alpha, used by ETC2 RGBA
+
+static const int eacModifiers[16][8] =
+{
+	{-3, -6,  -9, -15, 2, 5, 8, 14},
+	{-3, -7, -10, -13, 2, 6, 9, 12},
+	{-2, -5,  -8, -13, 1, 4, 7, 12},
+	{-2, -4,  -6, -13, 1, 3, 5, 12},
+	{-3, -6,  -8, -12, 2, 5, 7, 11},
+	{-3, -7,  -9, -11, 2, 6, 8, 10},
+	{-4, -7,  -8, -11, 3, 6, 7, 10},
+	{-3, -5,  -8, -11, 2, 4, 7, 10},
+	{-2, -6,  -8, -10, 1, 5, 7,  9},
+	{-2, -5,  -8, -10, 1, 4, 7,  9},
+	{-2, -4,  -8, -10, 1, 3, 7,  9},
+	{-2, -5,  -7, -10, 1, 4, 6,  9},
+	{-3, -4,  -7, -10, 2, 3, 6,  9},
+	{-1, -2,  -3, -10, 0, 1, 2,  9},
+	{-4, -6,  -8,  -9, 3, 5, 7,  8},
+	{-3, -5,  -7,  -9, 2, 4, 6,  8},
+};
+
+static void encodeEACAlpha(const uint8 px[16][4], uint8 *dst)
+{
+	int amin = 255;
+	int amax = 0;
+	for (int i = 0; i < 16; i++)
+	{
+		amin = std::min(amin, (int) px[i][3]);
+		amax = std::max(amax, (int) px[i][3]);
+	}
+
+	// Table 13 has a zero modifier at index 4, which reproduces a constant
+	// alpha exactly.
+	int bestbase = amin;
+	int bestmul = 1;
+	int besttable = 13;
+	uint8 bestindices[16];
+	memset(bestindices, 4, sizeof(bestindices));
+
+	if (amin != amax)
+	{
+		int besterr = std::numeric_limits<int>::max();
+
+		float alphas[16][4] = {};
+		for (int i = 0; i < 16; i++)
+			alphas[i][0] = (float) px[i][3];
+
+		for (int t = 0; t < 16; t++)
+		{
+			int lo = eacModifiers[t][3];
+			int hi = eacModifiers[t][7];
+			int mul0 = clampi(roundf2i((float) (amax - amin) / (float) (hi - lo)), 1, 15);
+
+			for (int mul = std::max(mul0 - 1, 1); mul <= std::min(mul0 + 1, 15); mul++)
+			{
+				float center = (amin + amax) * 0.5f - (lo + hi) * mul * 0.5f;
+				int base0 = roundf2i(center);
+
+				for (int base = std::max(base0 - 1, 0); base <= std::min(base0 + 1, 255); base++)
+				{
+					float values[4][16] = {};
+					for (int j = 0; j < 8; j++)
+						values[0][j] = (float) clampi(base + eacModifiers[t][j] * mul, 0, 255);
+
+					int err = 0;
+					uint8 indices[16];
+					for (int i = 0; i < 16; i++)
+					{
+						float dist[16];
+						float best;
+						paletteDistances(alphas[i], values, 1, 8, dist);
+						indices[i] = (uint8) closestIndex(dist, 8, best);
+						err += (int) best;
+					}
+
+					if (err < besterr)
+					{
+						besterr = err;
+						bestbase = base;
+						bestmul = mul;
+						besttable = t;
+						memcpy(bestindices, indices, sizeof(indices));
+					}
+				}
+			}
+		}
+	}
+
+	uint64 bits = ((uint64) bestbase << 56) | ((uint64) bestmul << 52) | ((uint64) besttable << 48);
+	for (int i = 0; i < 16; i++)
+	{
+		int x = i % 4;
+		int y = i / 4;
+		bits |= (uint64) bestindices[i] << (45 - (x * 4 + y) * 3);
+	}
+
+	for (int i = 0; i < 8; i++)
+		dst[i] = (uint8) (bits >> (56 - i * 8));
+}
+
+static void encodeBlock(PixelFormat format, const uint8 px[16][4], uint8 *dst)
+{
+	switch (format)
+	{
+	case PIXELFORMAT_DXT1_UNORM:
+	case PIXELFORMAT_DXT1_sRGB:
+		encodeBC1(px, true, dst);
+		break;
+	case PIXELFORMAT_DXT5_UNORM:
+	case PIXELFORMAT_DXT5_sRGB:
+		encodeBC3Alpha(px, dst);
+		encodeBC1(px, false, dst + 8);
+		break;
+	case PIXELFORMAT_BC7_UNORM:
+	case PIXELFORMAT_BC7_sRGB:
+		encodeBC7(px, dst);
+		break;
+	case PIXELFORMAT_ETC2_RGB_UNORM:
+	case PIXELFORMAT_ETC2_RGB_sRGB:
+		encodeETC2Color(px, dst);
+		break;
+	case PIXELFORMAT_ETC2_RGBA_UNORM:
+	case PIXELFORMAT_ETC2_RGBA_sRGB:
+		encodeEACAlpha(px, dst);
+		encodeETC2Color(px, dst + 8);
+		break;
+	default:
+		break;
+	}
+}
+
+bool isFormatSupported(PixelFormat format)
+{
+	switch (format)
+	{
+	case PIXELFORMAT_DXT1_UNORM:
+	case PIXELFORMAT_DXT1_sRGB:
+	case PIXELFORMAT_DXT5_UNORM:
+	case PIXELFORMAT_DXT5_sRGB:
+	case PIXELFORMAT_BC7_UNORM:
+	case PIXELFORMAT_BC7_sRGB:
+	case PIXELFORMAT_ETC2_RGB_UNORM:
+	case PIXELFORMAT_ETC2_RGB_sRGB:
+	case PIXELFORMAT_ETC2_RGBA_UNORM:
+	case PIXELFORMAT_ETC2_RGBA_sRGB:
+		return true;
+	default:
+		return false;
+	}
+}
+
+void encode(PixelFormat format, const uint8 *rgba, int width, int height, uint8 *dst)
+{
+	if (!isFormatSupported(format) || width <= 0 || height <= 0)
+		return;
+
+	int blocksx = (width + 3) / 4;
+	int blocksy = (height + 3) / 4;
+	size_t blocksize = getPixelFormatBlockSize(format);
+
+	// One task per row of blocks.
+	thread::ThreadPool::getShared()->parallelFor(blocksy, [&](int by)
+	{
+		uint8 px[16][4];
+		uint8 *row = dst + (size_t) by * blocksx * blocksize;
+		for (int bx = 0; bx < blocksx; bx++)
+		{
+			fetchBlock(rgba, width, height, bx, by, px);
+			encodeBlock(format, px, row + bx * blocksize);
+		}
+	});
+}
+
+bool hasAlpha(const uint8 *rgba, int width, int height)
+{
+	size_t count = (size_t) width * height;
+	for (size_t i = 0; i < count; i++)
+	{
+		if (rgba[i * 4 + 3] != 255)
+			return true;
+	}
+	return false;
+}
+
+} // blockencoder
+} // image
+} // love
@@ -0,0 +1,59 @@
+/**
+ * Copyright (c) 2006-2024 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#pragma once
+
+// LOVE
+#include "common/int.h"
+#include "common/pixelformat.h"
+
+namespace love
+{
+namespace image
+{
+
+/**
+ * Encodes RGBA8 pixels into GPU block-compressed formats at runtime. BC1, BC3,
+ * BC7 (mode 6) and ETC2 RGB/RGBA are supported, in linear and sRGB variants.
+ * Blocks are spread over the shared thread pool.
+ **/
+namespace blockencoder
+{
+
+/**
+ * Whether the given compressed pixel format can be encoded.
+ **/
+bool isFormatSupported(PixelFormat format);
+
+/**
+ * Encodes a width x height image of tightly packed RGBA8 pixels. The
+ * destination must hold getPixelFormatSliceSize(format, width, height) bytes.
+ * Partial blocks at the right and bottom edges repeat the last pixels.
+ **/
+void encode(PixelFormat format, const uint8 *rgba, int width, int height, uint8 *dst);
+
+/**
+ * Whether any pixel in the tightly packed RGBA8 image isn't fully opaque.
+ **/
+bool hasAlpha(const uint8 *rgba, int width, int height);
+
+} // blockencoder
+} // image
+} // love
@@ -19,7 +19,15 @@
  **/
 
 #include "CompressedImageData.h"
+#include "ImageData.h"
+#include "Image.h"
+#include "BlockEncoder.h"
+#include "MipmapGenerator.h"
 #include "common/Exception.h"
+#include "filesystem/Filesystem.h"
+
+// C++
+#include <algorithm>
 
 namespace love
 {
@@ -61,6 +69,73 @@ CompressedImageData::CompressedImageData(const std::list<FormatHandler *> &forma
 	format = getLinearPixelFormat(format);
 }
 
+static void getRGBA8Pixels(ImageData *source, std::vector<uint8> &pixels)
+{
+	int width = source->getWidth();
+	int height = source->getHeight();
+
+	pixels.resize((size_t) width * height * 4);
+
+	if (source->getFormat() == PIXELFORMAT_RGBA8_UNORM)
+	{
+		memcpy(pixels.data(), source->getData(), pixels.size());
+		return;
+	}
+
+	for (int y = 0; y < height; y++)
+	{
+		for (int x = 0; x < width; x++)
+		{
+			Colorf c = source->getPixel(x, y);
+			uint8 *p = &pixels[((size_t) y * width + x) * 4];
+			p[0] = (uint8) (std::min(std::max(c.r, 0.0f), 1.0f) * 255.0f + 0.5f);
+			p[1] = (uint8) (std::min(std::max(c.g, 0.0f), 1.0f) * 255.0f + 0.5f);
+			p[2] = (uint8) (std::min(std::max(c.b, 0.0f), 1.0f) * 255.0f + 0.5f);
+			p[3] = (uint8) (std::min(std::max(c.a, 0.0f), 1.0f) * 255.0f + 0.5f);
+		}
+	}
+}
+
+CompressedImageData::CompressedImageData(ImageData *source, PixelFormat format, bool mipmaps)
+	: format(getLinearPixelFormat(format))
+{
+	if (!blockencoder::isFormatSupported(format))
+		throw love::Exception("Cannot encode ImageData to the %s pixel format.", getPixelFormatName(format));
+
+	std::vector<StrongRef<ImageData>> levels;
+	if (mipmaps)
+		levels = MipmapGenerator::generate(source, MipmapGenerator::Settings());
+
+	levels.insert(levels.begin(), source);
+
+	size_t totalsize = 0;
+	for (const auto &level : levels)
+		totalsize += getPixelFormatSliceSize(format, level->getWidth(), level->getHeight());
+
+	memory.set(new ByteData(totalsize, false), Acquire::NORETAIN);
+
+	std::vector<uint8> pixels;
+	size_t offset = 0;
+
+	for (const auto &level : levels)
+	{
+		int w = level->getWidth();
+		int h = level->getHeight();
+		size_t size = getPixelFormatSliceSize(format, w, h);
+
+		getRGBA8Pixels(level, pixels);
+		blockencoder::encode(format, pixels.data(), w, h, (uint8 *) memory->getData() + offset);
+
+		auto slice = new CompressedSlice(this->format, w, h, memory, offset, size);
+		dataImages.push_back(slice);
+		slice->release();
+
+		offset += size;
+	}
+
+	setLinear(source->isLinear());
+}
+
 CompressedImageData::CompressedImageData(const CompressedImageData &c)
 	: format(c.format)
 {
@@ -154,6 +229,67 @@ CompressedSlice *CompressedImageData::getSlice(int slice, int miplevel) const
 	return dataImages[miplevel].get();
 }
 
+love::filesystem::FileData *CompressedImageData::encode(FormatHandler::EncodedFormat encodedFormat, const char *filename, bool writefile) const
+{
+	auto module = Module::getInstance<Image>(Module::M_IMAGE);
+
+	if (module == nullptr)
+		throw love::Exception("love.image must be loaded in order to encode a CompressedImageData.");
+
+	FormatHandler *encoder = nullptr;
+	for (FormatHandler *handler : module->getFormatHandlers())
+	{
+		if (handler->canEncodeCompressed(format, encodedFormat))
+		{
+			encoder = handler;
+			break;
+		}
+	}
+
+	if (encoder == nullptr)
+		throw love::Exception("No suitable compressed image encoder for the %s pixel format.", getPixelFormatName(format));
+
+	FormatHandler::EncodedImage encodedimage = encoder->encodeCompressed(dataImages, format, encodedFormat);
+
+	love::filesystem::FileData *filedata = nullptr;
+
+	try
+	{
+		filedata = new love::filesystem::FileData(encodedimage.size, filename);
+	}
+	catch (love::Exception &)
+	{
+		encoder->freeEncodedImage(encodedimage.data);
+		throw;
+	}
+
+	memcpy(filedata->getData(), encodedimage.data, encodedimage.size);
+	encoder->freeEncodedImage(encodedimage.data);
+
+	if (writefile)
+	{
+		auto fs = Module::getInstance<filesystem::Filesystem>(Module::M_FILESYSTEM);
+
+		if (fs == nullptr)
+		{
+			filedata->release();
+			throw love::Exception("love.filesystem must be loaded in order to write an encoded CompressedImageData to a file.");
+		}
+
+		try
+		{
+			fs->write(filename, filedata->getData(), filedata->getSize());
+		}
+		catch (love::Exception &)
+		{
+			filedata->release();
+			throw;
+		}
+	}
+
+	return filedata;
+}
+
 void CompressedImageData::checkSliceExists(int slice, int miplevel) const
 {
 	if (slice != 0)
@@ -163,5 +299,27 @@ void CompressedImageData::checkSliceExists(int slice, int miplevel) const
 		throw love::Exception("Mipmap level %d does not exist", miplevel + 1);
 }
 
+bool CompressedImageData::getConstant(const char *in, FormatHandler::EncodedFormat &out)
+{
+	return encodedFormats.find(in, out);
+}
+
+bool CompressedImageData::getConstant(FormatHandler::EncodedFormat in, const char *&out)
+{
+	return encodedFormats.find(in, out);
+}
+
+std::vector<std::string> CompressedImageData::getConstants(FormatHandler::EncodedFormat)
+{
+	return encodedFormats.getNames();
+}
+
+StringMap<FormatHandler::EncodedFormat, FormatHandler::ENCODED_MAX_ENUM>::Entry CompressedImageData::encodedFormatEntries[] =
+{
+	{"ktx", FormatHandler::ENCODED_KTX},
+};
+
+StringMap<FormatHandler::EncodedFormat, FormatHandler::ENCODED_MAX_ENUM> CompressedImageData::encodedFormats(CompressedImageData::encodedFormatEntries, sizeof(CompressedImageData::encodedFormatEntries));
+
 } // image
 } // love
@@ -27,6 +27,7 @@
 #include "common/pixelformat.h"
 #include "CompressedSlice.h"
 #include "FormatHandler.h"
+#include "filesystem/FileData.h"
 
 // STL
 #include <vector>
@@ -37,6 +38,8 @@ namespace love
 namespace image
 {
 
+class ImageData;
+
 /**
  * CompressedImageData represents image data which is designed to be uploaded to
  * the GPU and rendered in its compressed form, without being decompressed.
@@ -49,6 +52,12 @@ class CompressedImageData : public Data
 	static love::Type type;
 
 	CompressedImageData(const std::list<FormatHandler *> &formats, Data *filedata);
+
+	/**
+	 * Encodes the given ImageData to a block-compressed pixel format on the
+	 * CPU, optionally with a full chain of box-filtered mipmaps.
+	 **/
+	CompressedImageData(ImageData *source, PixelFormat format, bool mipmaps);
 	CompressedImageData(const CompressedImageData &c);
 	virtual ~CompressedImageData();
 
@@ -98,6 +107,16 @@ class CompressedImageData : public Data
 
 	CompressedSlice *getSlice(int slice, int miplevel) const;
 
+	/**
+	 * Writes all mipmap levels to a container format such as KTX, so encoded
+	 * data can be cached and loaded back later without encoding it again.
+	 **/
+	love::filesystem::FileData *encode(FormatHandler::EncodedFormat format, const char *filename, bool writefile) const;
+
+	static bool getConstant(const char *in, FormatHandler::EncodedFormat &out);
+	static bool getConstant(FormatHandler::EncodedFormat in, const char *&out);
+	static std::vector<std::string> getConstants(FormatHandler::EncodedFormat);
+
 protected:
 
 	PixelFormat format;
@@ -110,6 +129,11 @@ class CompressedImageData : public Data
 
 	void checkSliceExists(int slice, int miplevel) const;
 
+private:
+
+	static StringMap<FormatHandler::EncodedFormat, FormatHandler::ENCODED_MAX_ENUM>::Entry encodedFormatEntries[];
+	static StringMap<FormatHandler::EncodedFormat, FormatHandler::ENCODED_MAX_ENUM> encodedFormats;
+
 }; // CompressedImageData
 
 } // image
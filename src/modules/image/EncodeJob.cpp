@@ -0,0 +1,132 @@
+/**
+ * Copyright (c) 2006-2024 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+// LOVE
+#include "EncodeJob.h"
+#include "ImageData.h"
+#include "common/Exception.h"
+#include "thread/ThreadPool.h"
+
+using love::thread::Lock;
+
+namespace love
+{
+namespace image
+{
+
+love::Type EncodeJob::type("EncodeJob", &Object::type);
+
+EncodeJob::EncodeJob(ImageData *imageData, FormatHandler::EncodedFormat format, const std::string &filename, bool writeFile)
+	: imageData(imageData)
+	, format(format)
+	, filename(filename)
+	, writeFile(writeFile)
+	, complete(false)
+	, started(false)
+{
+}
+
+EncodeJob::~EncodeJob()
+{
+}
+
+void EncodeJob::start(const CompleteCallback &oncomplete)
+{
+	if (started)
+		throw love::Exception("The encode job has already been started.");
+
+	started = true;
+
+	// The queued task keeps the job alive until it's done.
+	retain();
+
+	thread::ThreadPool::getShared()->enqueue([this, oncomplete]()
+	{
+		run();
+
+		if (oncomplete)
+			oncomplete(this);
+
+		release();
+	});
+}
+
+void EncodeJob::run()
+{
+	love::filesystem::FileData *result = nullptr;
+	std::string err;
+
+	try
+	{
+		result = imageData->encode(format, filename.c_str(), writeFile);
+	}
+	catch (std::exception &e)
+	{
+		err = e.what();
+	}
+
+	Lock lock(mutex);
+
+	fileData.set(result, Acquire::NORETAIN);
+	error = err;
+	complete = true;
+
+	// The pixels aren't needed anymore.
+	imageData.set(nullptr);
+
+	cond->broadcast();
+}
+
+bool EncodeJob::isComplete() const
+{
+	Lock lock(mutex);
+	return complete;
+}
+
+void EncodeJob::wait()
+{
+	if (!started)
+		throw love::Exception("The encode job has not been started.");
+
+	Lock lock(mutex);
+	while (!complete)
+		cond->wait(mutex);
+}
+
+bool EncodeJob::hasError() const
+{
+	Lock lock(mutex);
+	return complete && !error.empty();
+}
+
+std::string EncodeJob::getError() const
+{
+	Lock lock(mutex);
+	return error;
+}
+
+love::filesystem::FileData *EncodeJob::getFileData() const
+{
+	Lock lock(mutex);
+	return fileData.get();
+}
+
+} // image
+} // love
@@ -0,0 +1,97 @@
+/**
+ * Copyright (c) 2006-2024 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#pragma once
+
+// LOVE
+#include "common/Object.h"
+#include "filesystem/FileData.h"
+#include "thread/threads.h"
+#include "FormatHandler.h"
+
+// C++
+#include <functional>
+#include <string>
+
+namespace love
+{
+namespace image
+{
+
+class ImageData;
+
+/**
+ * Encodes an ImageData (and optionally writes the result to a file) on a
+ * worker thread. The job can be polled or waited on from the main thread.
+ **/
+class EncodeJob : public Object
+{
+public:
+
+	typedef std::function<void(EncodeJob *job)> CompleteCallback;
+
+	static love::Type type;
+
+	/**
+	 * The ImageData must not be modified while the job runs.
+	 **/
+	EncodeJob(ImageData *imageData, FormatHandler::EncodedFormat format, const std::string &filename, bool writeFile);
+	virtual ~EncodeJob();
+
+	/**
+	 * Queues the job on the shared worker thread pool. The optional callback
+	 * is called on the worker thread once the job is complete.
+	 **/
+	void start(const CompleteCallback &oncomplete = nullptr);
+
+	bool isComplete() const;
+	void wait();
+
+	bool hasError() const;
+	std::string getError() const;
+
+	/**
+	 * Gets the encoded data, or null if the job hasn't completed or failed.
+	 **/
+	love::filesystem::FileData *getFileData() const;
+
+	const std::string &getFilename() const { return filename; }
+
+private:
+
+	void run();
+
+	StrongRef<ImageData> imageData;
+	FormatHandler::EncodedFormat format;
+	std::string filename;
+	bool writeFile;
+
+	StrongRef<love::filesystem::FileData> fileData;
+	std::string error;
+	bool complete;
+	bool started;
+
+	love::thread::MutexRef mutex;
+	love::thread::ConditionalRef cond;
+
+}; // EncodeJob
+
+} // image
+} // love
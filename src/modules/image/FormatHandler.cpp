@@ -65,6 +65,16 @@ StrongRef<ByteData> FormatHandler::parseCompressed(Data* /*filedata*/, std::vect
 	throw love::Exception("Compressed image parsing is not implemented for this format backend.");
 }
 
+bool FormatHandler::canEncodeCompressed(PixelFormat /*compressedFormat*/, EncodedFormat /*encodedFormat*/)
+{
+	return false;
+}
+
+FormatHandler::EncodedImage FormatHandler::encodeCompressed(const std::vector<StrongRef<CompressedSlice>>& /*images*/, PixelFormat /*format*/, EncodedFormat /*encodedFormat*/)
+{
+	throw love::Exception("Compressed image encoding is not implemented for this format backend.");
+}
+
 void FormatHandler::freeRawPixels(unsigned char *mem)
 {
 	delete[] mem;
@@ -46,6 +46,7 @@ class FormatHandler : public love::Object
 		ENCODED_TGA,
 		ENCODED_PNG,
 		ENCODED_EXR,
+		ENCODED_KTX,
 		ENCODED_MAX_ENUM
 	};
 
@@ -113,6 +114,19 @@ class FormatHandler : public love::Object
 	        std::vector<StrongRef<CompressedSlice>> &images,
 	        PixelFormat &format);
 
+	/**
+	 * Whether this format handler can write compressed image data of the
+	 * given pixel format to a particular container format.
+	 **/
+	virtual bool canEncodeCompressed(PixelFormat compressedFormat, EncodedFormat encodedFormat);
+
+	/**
+	 * Writes all sub-images of compressed image data to a container format.
+	 * The sub-images are mipmap levels, largest first.
+	 **/
+	virtual EncodedImage encodeCompressed(const std::vector<StrongRef<CompressedSlice>> &images,
+	        PixelFormat format, EncodedFormat encodedFormat);
+
 	/**
 	 * Frees raw pixel memory allocated by the format handler.
 	 **/
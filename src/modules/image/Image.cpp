@@ -20,6 +20,7 @@
 
 // LOVE
 #include "Image.h"
+#include "BlockEncoder.h"
 #include "common/config.h"
 
 #include "magpie/PNGHandler.h"
@@ -86,6 +87,16 @@ love::image::CompressedImageData *Image::newCompressedData(Data *data)
 	return new CompressedImageData(formatHandlers, data);
 }
 
+love::image::CompressedImageData *Image::newCompressedData(ImageData *data, PixelFormat format, bool mipmaps)
+{
+	return new CompressedImageData(data, format, mipmaps);
+}
+
+bool Image::isCompressedEncodingSupported(PixelFormat format) const
+{
+	return blockencoder::isFormatSupported(format);
+}
+
 bool Image::isCompressed(Data *data)
 {
 	for (FormatHandler *handler : formatHandlers)
@@ -117,6 +128,11 @@ ImageData *Image::newPastedImageData(ImageData *src, int sx, int sy, int w, int
 	return res;
 }
 
+std::vector<StrongRef<ImageData>> Image::newMipmaps(ImageData *src, const MipmapGenerator::Settings &settings)
+{
+	return MipmapGenerator::generate(src, settings);
+}
+
 std::vector<StrongRef<ImageData>> Image::newCubeFaces(love::image::ImageData *src)
 {
 	// The faces array is always ordered +x, -x, +y, -y, +z, -z.
@@ -27,6 +27,7 @@
 #include "filesystem/File.h"
 #include "ImageData.h"
 #include "CompressedImageData.h"
+#include "MipmapGenerator.h"
 
 // C++
 #include <list>
@@ -85,12 +86,31 @@ class Image : public Module
 	 **/
 	CompressedImageData *newCompressedData(Data *data);
 
+	/**
+	 * Encodes ImageData to a block-compressed pixel format on the CPU.
+	 * @param data The ImageData to encode.
+	 * @param format A compressed format accepted by isCompressedEncodingSupported.
+	 * @param mipmaps Whether to also generate and encode a mipmap chain.
+	 * @return The new CompressedImageData.
+	 **/
+	CompressedImageData *newCompressedData(ImageData *data, PixelFormat format, bool mipmaps);
+
+	/**
+	 * Whether ImageData can be encoded to the given compressed format.
+	 **/
+	bool isCompressedEncodingSupported(PixelFormat format) const;
+
 	/**
 	 * Determines whether a FileData is Compressed image data or not.
 	 * @param data The FileData to test.
 	 **/
 	bool isCompressed(Data *data);
 
+	/**
+	 * Generates the mipmap levels below the given ImageData on the CPU.
+	 **/
+	std::vector<StrongRef<ImageData>> newMipmaps(ImageData *src, const MipmapGenerator::Settings &settings);
+
 	std::vector<StrongRef<ImageData>> newCubeFaces(ImageData *src);
 	std::vector<StrongRef<ImageData>> newVolumeLayers(ImageData *src);
 
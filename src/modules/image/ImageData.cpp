@@ -238,6 +238,26 @@ love::filesystem::FileData *ImageData::encode(FormatHandler::EncodedFormat encod
 	return filedata;
 }
 
+EncodeJob *ImageData::encodeAsync(FormatHandler::EncodedFormat encodedFormat, const char *filename, bool writefile) const
+{
+	// Encode a snapshot, so the pixels can keep being modified in the meantime.
+	StrongRef<ImageData> snapshot(clone(), Acquire::NORETAIN);
+
+	EncodeJob *job = new EncodeJob(snapshot, encodedFormat, filename, writefile);
+
+	try
+	{
+		job->start();
+	}
+	catch (love::Exception &)
+	{
+		job->release();
+		throw;
+	}
+
+	return job;
+}
+
 size_t ImageData::getSize() const
 {
 	return size_t(getWidth() * getHeight()) * getPixelSize();
@@ -31,6 +31,7 @@
 #include "thread/threads.h"
 #include "ImageDataBase.h"
 #include "FormatHandler.h"
+#include "EncodeJob.h"
 
 using love::thread::Mutex;
 
@@ -110,6 +111,12 @@ class ImageData : public ImageDataBase
 	 **/
 	love::filesystem::FileData *encode(FormatHandler::EncodedFormat format, const char *filename, bool writefile) const;
 
+	/**
+	 * Starts encoding a copy of the pixel data on a worker thread.
+	 * @return The running job, which holds the encoded data once complete.
+	 **/
+	EncodeJob *encodeAsync(FormatHandler::EncodedFormat format, const char *filename, bool writefile) const;
+
 	// Implements ImageDataBase.
 	ImageData *clone() const override;
 	void *getData() const override;
@@ -0,0 +1,535 @@
+/**
+ * Copyright (c) 2006-2024 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+// LOVE
+#include "MipmapGenerator.h"
+#include "ImageData.h"
+#include "common/config.h"
+#include "common/Exception.h"
+#include "common/math.h"
+#include "math/MathModule.h"
+#include "thread/ThreadPool.h"
+
+// C++
+#include <algorithm>
+#include <cmath>
+
+#if defined(LOVE_SIMD_SSE)
+#include <xmmintrin.h>
+#endif
+
+#if defined(LOVE_SIMD_SSE2)
+#include <emmintrin.h>
+#endif
+
+#if defined(LOVE_SIMD_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace love
+{
+namespace image
+{
+
+namespace
+{
+
+// Tightly packed RGBA32F pixels, used as the working format while filtering.
+struct FloatImage
+{
+	int width = 0;
+	int height = 0;
+	std::vector<float> pixels;
+
+	void resize(int w, int h)
+	{
+		width = w;
+		height = h;
+		pixels.resize((size_t) w * h * 4);
+	}
+};
+
+struct Tap
+{
+	int index;
+	float weight;
+};
+
+// Per-destination-pixel filter taps for one axis.
+struct Taps
+{
+	std::vector<int> offsets;
+	std::vector<Tap> taps;
+};
+
+const float KAISER_RADIUS = 3.0f;
+const float KAISER_ALPHA = 4.0f;
+
+float besselI0(float x)
+{
+	float sum = 1.0f;
+	float term = 1.0f;
+	for (int k = 1; k < 16; k++)
+	{
+		float f = x / (2.0f * (float) k);
+		term *= f * f;
+		sum += term;
+	}
+	return sum;
+}
+
+float kaiser(float t)
+{
+	float a = std::abs(t);
+	if (a >= KAISER_RADIUS)
+		return 0.0f;
+
+	float sinc = a < 1e-5f ? 1.0f : std::sin((float) LOVE_M_PI * a) / ((float) LOVE_M_PI * a);
+	float r = a / KAISER_RADIUS;
+	return sinc * besselI0(KAISER_ALPHA * std::sqrt(1.0f - r * r)) / besselI0(KAISER_ALPHA);
+}
+
+Taps computeTaps(int srcsize, int dstsize, MipmapGenerator::Filter filter)
+{
+	Taps taps;
+	taps.offsets.reserve(dstsize + 1);
+
+	float scale = (float) srcsize / (float) dstsize;
+
+	for (int x = 0; x < dstsize; x++)
+	{
+		taps.offsets.push_back((int) taps.taps.size());
+		size_t first = taps.taps.size();
+		float total = 0.0f;
+
+		if (filter == MipmapGenerator::FILTER_KAISER)
+		{
+			float center = ((float) x + 0.5f) * scale;
+			float radius = KAISER_RADIUS * scale;
+			int start = (int) std::floor(center - radius);
+			int end = (int) std::ceil(center + radius);
+
+			for (int i = start; i <= end; i++)
+			{
+				float w = kaiser(((float) i + 0.5f - center) / scale);
+				if (w == 0.0f)
+					continue;
+				taps.taps.push_back({std::min(std::max(i, 0), srcsize - 1), w});
+				total += w;
+			}
+		}
+		else
+		{
+			// Weight each source pixel by how much of it the destination pixel
+			// covers, which also handles odd sizes.
+			float start = (float) x * scale;
+			float end = (float) (x + 1) * scale;
+
+			for (int i = (int) std::floor(start); i < (int) std::ceil(end) && i < srcsize; i++)
+			{
+				float w = std::min((float) i + 1.0f, end) - std::max((float) i, start);
+				if (w <= 0.0f)
+					continue;
+				taps.taps.push_back({i, w});
+				total += w;
+			}
+		}
+
+		for (size_t i = first; i < taps.taps.size(); i++)
+			taps.taps[i].weight /= total;
+	}
+
+	taps.offsets.push_back((int) taps.taps.size());
+	return taps;
+}
+
+void resample(const FloatImage &src, FloatImage &dst, MipmapGenerator::Filter filter)
+{
+	Taps htaps = computeTaps(src.width, dst.width, filter);
+	Taps vtaps = computeTaps(src.height, dst.height, filter);
+
+	FloatImage temp;
+	temp.resize(dst.width, src.height);
+
+	auto pool = thread::ThreadPool::getShared();
+
+	pool->parallelFor(src.height, [&](int y)
+	{
+		const float *srcrow = &src.pixels[(size_t) y * src.width * 4];
+		float *dstrow = &temp.pixels[(size_t) y * temp.width * 4];
+
+		// One RGBA pixel is exactly one 4-wide float vector.
+		for (int x = 0; x < temp.width; x++)
+		{
+#if defined(LOVE_SIMD_SSE)
+			__m128 sum = _mm_setzero_ps();
+			for (int t = htaps.offsets[x]; t < htaps.offsets[x + 1]; t++)
+			{
+				const Tap &tap = htaps.taps[t];
+				__m128 p = _mm_loadu_ps(srcrow + tap.index * 4);
+				sum = _mm_add_ps(sum, _mm_mul_ps(p, _mm_set1_ps(tap.weight)));
+			}
+			_mm_storeu_ps(dstrow + x * 4, sum);
+#elif defined(LOVE_SIMD_NEON)
+			float32x4_t sum = vdupq_n_f32(0.0f);
+			for (int t = htaps.offsets[x]; t < htaps.offsets[x + 1]; t++)
+			{
+				const Tap &tap = htaps.taps[t];
+				sum = vmlaq_n_f32(sum, vld1q_f32(srcrow + tap.index * 4), tap.weight);
+			}
+			vst1q_f32(dstrow + x * 4, sum);
+#else
+			float sum[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+			for (int t = htaps.offsets[x]; t < htaps.offsets[x + 1]; t++)
+			{
+				const Tap &tap = htaps.taps[t];
+				const float *p = srcrow + tap.index * 4;
+				for (int c = 0; c < 4; c++)
+					sum[c] += p[c] * tap.weight;
+			}
+			for (int c = 0; c < 4; c++)
+				dstrow[x * 4 + c] = sum[c];
+#endif
+		}
+	});
+
+	pool->parallelFor(dst.height, [&](int y)
+	{
+		float *dstrow = &dst.pixels[(size_t) y * dst.width * 4];
+		std::fill(dstrow, dstrow + dst.width * 4, 0.0f);
+
+		for (int t = vtaps.offsets[y]; t < vtaps.offsets[y + 1]; t++)
+		{
+			const Tap &tap = vtaps.taps[t];
+			const float *srcrow = &temp.pixels[(size_t) tap.index * temp.width * 4];
+
+			// Rows are whole RGBA pixels, so always a multiple of 4 floats.
+#if defined(LOVE_SIMD_SSE)
+			__m128 weight = _mm_set1_ps(tap.weight);
+			for (int i = 0; i < dst.width * 4; i += 4)
+			{
+				__m128 sum = _mm_add_ps(_mm_loadu_ps(dstrow + i), _mm_mul_ps(_mm_loadu_ps(srcrow + i), weight));
+				_mm_storeu_ps(dstrow + i, sum);
+			}
+#elif defined(LOVE_SIMD_NEON)
+			for (int i = 0; i < dst.width * 4; i += 4)
+				vst1q_f32(dstrow + i, vmlaq_n_f32(vld1q_f32(dstrow + i), vld1q_f32(srcrow + i), tap.weight));
+#else
+			for (int i = 0; i < dst.width * 4; i++)
+				dstrow[i] += srcrow[i] * tap.weight;
+#endif
+		}
+	});
+}
+
+struct GammaTables
+{
+	float toLinear[256];
+	uint8 toGamma[4096];
+
+	GammaTables()
+	{
+		for (int i = 0; i < 256; i++)
+			toLinear[i] = math::gammaToLinear((float) i / 255.0f);
+		for (int i = 0; i < 4096; i++)
+			toGamma[i] = (uint8) (math::linearToGamma((float) i / 4095.0f) * 255.0f + 0.5f);
+	}
+};
+
+const GammaTables &getGammaTables()
+{
+	static GammaTables tables;
+	return tables;
+}
+
+// Converts 4 RGBA8 pixels (16 bytes) to floats in [0, 1].
+inline void loadRGBA8x4(const uint8 *src, float *out)
+{
+	const float scale = 1.0f / 255.0f;
+#if defined(LOVE_SIMD_SSE2)
+	const __m128i zero = _mm_setzero_si128();
+	const __m128 vscale = _mm_set1_ps(scale);
+	__m128i bytes = _mm_loadu_si128((const __m128i *) src);
+	__m128i lo = _mm_unpacklo_epi8(bytes, zero);
+	__m128i hi = _mm_unpackhi_epi8(bytes, zero);
+	_mm_storeu_ps(out + 0, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(lo, zero)), vscale));
+	_mm_storeu_ps(out + 4, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(lo, zero)), vscale));
+	_mm_storeu_ps(out + 8, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(hi, zero)), vscale));
+	_mm_storeu_ps(out + 12, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(hi, zero)), vscale));
+#elif defined(LOVE_SIMD_NEON)
+	uint8x16_t bytes = vld1q_u8(src);
+	uint16x8_t lo = vmovl_u8(vget_low_u8(bytes));
+	uint16x8_t hi = vmovl_u8(vget_high_u8(bytes));
+	vst1q_f32(out + 0, vmulq_n_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(lo))), scale));
+	vst1q_f32(out + 4, vmulq_n_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(lo))), scale));
+	vst1q_f32(out + 8, vmulq_n_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(hi))), scale));
+	vst1q_f32(out + 12, vmulq_n_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(hi))), scale));
+#else
+	for (int i = 0; i < 16; i++)
+		out[i] = (float) src[i] * scale;
+#endif
+}
+
+// Converts 4 float RGBA pixels to RGBA8, scaling alpha and clamping to [0, 1].
+// Without gamma the result is the 8-bit value, with gamma the color channels
+// are instead indices into the 12-bit linear-to-gamma table.
+inline void quantizeRGBA8x4(const float *in, float alphascale, bool gamma, int32 *out)
+{
+	const float colormax = gamma ? 4095.0f : 255.0f;
+#if defined(LOVE_SIMD_SSE2)
+	const __m128 scale = _mm_setr_ps(1.0f, 1.0f, 1.0f, alphascale);
+	const __m128 range = _mm_setr_ps(colormax, colormax, colormax, 255.0f);
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 one = _mm_set1_ps(1.0f);
+	const __m128 half = _mm_set1_ps(0.5f);
+	for (int i = 0; i < 16; i += 4)
+	{
+		__m128 v = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_loadu_ps(in + i), scale), zero), one);
+		__m128i q = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(v, range), half));
+		_mm_storeu_si128((__m128i *) (out + i), q);
+	}
+#elif defined(LOVE_SIMD_NEON)
+	const float scalev[4] = {1.0f, 1.0f, 1.0f, alphascale};
+	const float rangev[4] = {colormax, colormax, colormax, 255.0f};
+	float32x4_t scale = vld1q_f32(scalev);
+	float32x4_t range = vld1q_f32(rangev);
+	float32x4_t zero = vdupq_n_f32(0.0f);
+	float32x4_t one = vdupq_n_f32(1.0f);
+	float32x4_t half = vdupq_n_f32(0.5f);
+	for (int i = 0; i < 16; i += 4)
+	{
+		float32x4_t v = vminq_f32(vmaxq_f32(vmulq_f32(vld1q_f32(in + i), scale), zero), one);
+		vst1q_s32(out + i, vcvtq_s32_f32(vaddq_f32(vmulq_f32(v, range), half)));
+	}
+#else
+	for (int i = 0; i < 16; i++)
+	{
+		bool alpha = (i & 3) == 3;
+		float v = std::min(std::max(alpha ? in[i] * alphascale : in[i], 0.0f), 1.0f);
+		out[i] = (int32) (v * (alpha ? 255.0f : colormax) + 0.5f);
+	}
+#endif
+}
+
+void load(ImageData *source, bool gamma, FloatImage &dst)
+{
+	int w = source->getWidth();
+	int h = source->getHeight();
+	dst.resize(w, h);
+
+	const uint8 *data = (const uint8 *) source->getData();
+	size_t pixelsize = source->getPixelSize();
+
+	if (source->getFormat() == PIXELFORMAT_RGBA8_UNORM)
+	{
+		const GammaTables &tables = getGammaTables();
+		thread::ThreadPool::getShared()->parallelFor(h, [&](int y)
+		{
+			const uint8 *src = data + (size_t) y * w * 4;
+			float *out = &dst.pixels[(size_t) y * w * 4];
+			int i = 0;
+			if (!gamma)
+			{
+				for (; i + 16 <= w * 4; i += 16)
+					loadRGBA8x4(src + i, out + i);
+			}
+			for (; i < w * 4; i++)
+			{
+				bool color = gamma && (i & 3) != 3;
+				out[i] = color ? tables.toLinear[src[i]] : (float) src[i] * (1.0f / 255.0f);
+			}
+		});
+		return;
+	}
+
+	ImageData::PixelGetFunction getpixel = source->getPixelGetFunction();
+
+	thread::ThreadPool::getShared()->parallelFor(h, [&](int y)
+	{
+		for (int x = 0; x < w; x++)
+		{
+			Colorf c;
+			getpixel((const ImageData::Pixel *) (data + ((size_t) y * w + x) * pixelsize), c);
+			if (gamma)
+			{
+				c.r = math::gammaToLinear(c.r);
+				c.g = math::gammaToLinear(c.g);
+				c.b = math::gammaToLinear(c.b);
+			}
+			float *out = &dst.pixels[((size_t) y * w + x) * 4];
+			out[0] = c.r;
+			out[1] = c.g;
+			out[2] = c.b;
+			out[3] = c.a;
+		}
+	});
+}
+
+void store(const FloatImage &src, bool gamma, float alphascale, ImageData *dst)
+{
+	int w = src.width;
+	uint8 *data = (uint8 *) dst->getData();
+	size_t pixelsize = dst->getPixelSize();
+	bool clamp = getPixelFormatInfo(dst->getFormat()).dataType == PIXELFORMATTYPE_UNORM;
+
+	if (dst->getFormat() == PIXELFORMAT_RGBA8_UNORM)
+	{
+		const GammaTables &tables = getGammaTables();
+		thread::ThreadPool::getShared()->parallelFor(src.height, [&](int y)
+		{
+			const float *in = &src.pixels[(size_t) y * w * 4];
+			uint8 *out = data + (size_t) y * w * 4;
+			int i = 0;
+			for (; i + 16 <= w * 4; i += 16)
+			{
+				int32 q[16];
+				quantizeRGBA8x4(in + i, alphascale, gamma, q);
+				for (int j = 0; j < 16; j++)
+				{
+					bool alpha = (j & 3) == 3;
+					out[i + j] = gamma && !alpha ? tables.toGamma[q[j]] : (uint8) q[j];
+				}
+			}
+			for (; i < w * 4; i++)
+			{
+				bool alpha = (i & 3) == 3;
+				float v = std::min(std::max(alpha ? in[i] * alphascale : in[i], 0.0f), 1.0f);
+				if (gamma && !alpha)
+					out[i] = tables.toGamma[(int) (v * 4095.0f + 0.5f)];
+				else
+					out[i] = (uint8) (v * 255.0f + 0.5f);
+			}
+		});
+		return;
+	}
+
+	ImageData::PixelSetFunction setpixel = dst->getPixelSetFunction();
+
+	thread::ThreadPool::getShared()->parallelFor(src.height, [&](int y)
+	{
+		for (int x = 0; x < w; x++)
+		{
+			const float *in = &src.pixels[((size_t) y * w + x) * 4];
+			Colorf c(in[0], in[1], in[2], in[3] * alphascale);
+
+			// Sharper filters can ring past the representable range.
+			c.r = std::max(c.r, 0.0f);
+			c.g = std::max(c.g, 0.0f);
+			c.b = std::max(c.b, 0.0f);
+			c.a = std::max(c.a, 0.0f);
+			if (clamp)
+				c = Colorf(std::min(c.r, 1.0f), std::min(c.g, 1.0f), std::min(c.b, 1.0f), std::min(c.a, 1.0f));
+
+			if (gamma)
+			{
+				c.r = math::linearToGamma(c.r);
+				c.g = math::linearToGamma(c.g);
+				c.b = math::linearToGamma(c.b);
+			}
+
+			setpixel(c, (ImageData::Pixel *) (data + ((size_t) y * w + x) * pixelsize));
+		}
+	});
+}
+
+float getAlphaCoverage(const FloatImage &img, float threshold, float scale)
+{
+	size_t count = (size_t) img.width * img.height;
+	size_t covered = 0;
+	for (size_t i = 0; i < count; i++)
+	{
+		if (img.pixels[i * 4 + 3] * scale >= threshold)
+			covered++;
+	}
+	return (float) covered / (float) count;
+}
+
+// Finds the alpha scale which makes the level's coverage match the target.
+float findAlphaScale(const FloatImage &img, float threshold, float target)
+{
+	float lo = 0.0f;
+	float hi = 4.0f;
+	float scale = 1.0f;
+
+	for (int i = 0; i < 12; i++)
+	{
+		scale = (lo + hi) * 0.5f;
+		if (getAlphaCoverage(img, threshold, scale) > target)
+			hi = scale;
+		else
+			lo = scale;
+	}
+
+	return scale;
+}
+
+} // anonymous namespace
+
+std::vector<StrongRef<ImageData>> MipmapGenerator::generate(ImageData *source, const Settings &settings)
+{
+	PixelFormat format = source->getFormat();
+
+	if (source->getPixelGetFunction() == nullptr || source->getPixelSetFunction() == nullptr
+		|| !isPixelFormatColor(format) || isPixelFormatCompressed(format))
+		throw love::Exception("Mipmap generation does not support the %s pixel format.", getPixelFormatName(format));
+
+	bool gamma = settings.gammaCorrect.get(!source->isLinear());
+
+	std::vector<StrongRef<ImageData>> levels;
+
+	FloatImage current;
+	load(source, gamma, current);
+
+	float threshold = settings.alphaCoverage.value;
+	float coverage = 0.0f;
+	if (settings.alphaCoverage.hasValue)
+		coverage = getAlphaCoverage(current, threshold, 1.0f);
+
+	while (current.width > 1 || current.height > 1)
+	{
+		FloatImage next;
+		next.resize(std::max(current.width / 2, 1), std::max(current.height / 2, 1));
+		resample(current, next, settings.filter);
+
+		float alphascale = 1.0f;
+		if (settings.alphaCoverage.hasValue)
+			alphascale = findAlphaScale(next, threshold, coverage);
+
+		StrongRef<ImageData> level(new ImageData(next.width, next.height, format), Acquire::NORETAIN);
+		level->setLinear(source->isLinear());
+		store(next, gamma, alphascale, level);
+		levels.push_back(level);
+
+		// Keep filtering from the unscaled alpha so errors don't accumulate.
+		std::swap(current, next);
+	}
+
+	return levels;
+}
+
+STRINGMAP_CLASS_BEGIN(MipmapGenerator, MipmapGenerator::Filter, MipmapGenerator::FILTER_MAX_ENUM, filter)
+{
+	{ "box",    MipmapGenerator::FILTER_BOX    },
+	{ "kaiser", MipmapGenerator::FILTER_KAISER },
+}
+STRINGMAP_CLASS_END(MipmapGenerator, MipmapGenerator::Filter, MipmapGenerator::FILTER_MAX_ENUM, filter)
+
+} // image
+} // love
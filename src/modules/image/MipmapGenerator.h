@@ -0,0 +1,80 @@
+/**
+ * Copyright (c) 2006-2024 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#pragma once
+
+// LOVE
+#include "common/Object.h"
+#include "common/Optional.h"
+#include "common/StringMap.h"
+
+// C++
+#include <vector>
+
+namespace love
+{
+namespace image
+{
+
+class ImageData;
+
+/**
+ * Builds mipmap chains for ImageData on the CPU, for formats which can't be
+ * rendered to, for baking mipmaps offline, and for encoding to compressed
+ * formats. Rows of each level are filtered in parallel on the shared thread
+ * pool.
+ **/
+class MipmapGenerator
+{
+public:
+
+	enum Filter
+	{
+		FILTER_BOX,
+		FILTER_KAISER,
+		FILTER_MAX_ENUM
+	};
+
+	struct Settings
+	{
+		Filter filter = FILTER_BOX;
+
+		// Whether to filter RGB in linear space. Defaults to true for
+		// ImageData which isn't flagged as linear.
+		OptionalBool gammaCorrect;
+
+		// When set, the alpha of each level is scaled so the fraction of pixels
+		// with an alpha of at least this value matches the base level. This
+		// keeps alpha-tested cutouts from thinning out in the distance.
+		OptionalFloat alphaCoverage;
+	};
+
+	/**
+	 * Generates every mipmap level below the source's size down to 1x1,
+	 * largest first. The levels use the same pixel format as the source.
+	 **/
+	static std::vector<StrongRef<ImageData>> generate(ImageData *source, const Settings &settings);
+
+	STRINGMAP_CLASS_DECLARE(Filter);
+
+}; // MipmapGenerator
+
+} // image
+} // love
@@ -274,6 +274,65 @@ PixelFormat convertFormat(uint32 glformat)
 	}
 }
 
+uint32 convertFormat(PixelFormat format)
+{
+	switch (format)
+	{
+	case PIXELFORMAT_ETC1_UNORM:
+		return KTX_GL_ETC1_RGB8_OES;
+	case PIXELFORMAT_EAC_R_UNORM:
+		return KTX_GL_COMPRESSED_R11_EAC;
+	case PIXELFORMAT_EAC_R_SNORM:
+		return KTX_GL_COMPRESSED_SIGNED_R11_EAC;
+	case PIXELFORMAT_EAC_RG_UNORM:
+		return KTX_GL_COMPRESSED_RG11_EAC;
+	case PIXELFORMAT_EAC_RG_SNORM:
+		return KTX_GL_COMPRESSED_SIGNED_RG11_EAC;
+	case PIXELFORMAT_ETC2_RGB_UNORM:
+		return KTX_GL_COMPRESSED_RGB8_ETC2;
+	case PIXELFORMAT_ETC2_RGB_sRGB:
+		return KTX_GL_COMPRESSED_SRGB8_ETC2;
+	case PIXELFORMAT_ETC2_RGBA1_UNORM:
+		return KTX_GL_COMPRESSED_RGB8_PUNCHTHROUGH_ALPHA1_ETC2;
+	case PIXELFORMAT_ETC2_RGBA1_sRGB:
+		return KTX_GL_COMPRESSED_SRGB8_PUNCHTHROUGH_ALPHA1_ETC2;
+	case PIXELFORMAT_ETC2_RGBA_UNORM:
+		return KTX_GL_COMPRESSED_RGBA8_ETC2_EAC;
+	case PIXELFORMAT_ETC2_RGBA_sRGB:
+		return KTX_GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC;
+	case PIXELFORMAT_DXT1_UNORM:
+		return KTX_GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+	case PIXELFORMAT_DXT1_sRGB:
+		return KTX_GL_COMPRESSED_SRGB_S3TC_DXT1_EXT;
+	case PIXELFORMAT_DXT3_UNORM:
+		return KTX_GL_COMPRESSED_RGBA_S3TC_DXT3_EXT;
+	case PIXELFORMAT_DXT3_sRGB:
+		return KTX_GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3_EXT;
+	case PIXELFORMAT_DXT5_UNORM:
+		return KTX_GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+	case PIXELFORMAT_DXT5_sRGB:
+		return KTX_GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT;
+	case PIXELFORMAT_BC4_UNORM:
+		return KTX_GL_COMPRESSED_RED_RGTC1;
+	case PIXELFORMAT_BC4_SNORM:
+		return KTX_GL_COMPRESSED_SIGNED_RED_RGTC1;
+	case PIXELFORMAT_BC5_UNORM:
+		return KTX_GL_COMPRESSED_RG_RGTC2;
+	case PIXELFORMAT_BC5_SNORM:
+		return KTX_GL_COMPRESSED_SIGNED_RG_RGTC2;
+	case PIXELFORMAT_BC7_UNORM:
+		return KTX_GL_COMPRESSED_RGBA_BPTC_UNORM;
+	case PIXELFORMAT_BC7_sRGB:
+		return KTX_GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM;
+	case PIXELFORMAT_BC6H_FLOAT:
+		return KTX_GL_COMPRESSED_RGB_BPTC_SIGNED_FLOAT;
+	case PIXELFORMAT_BC6H_UFLOAT:
+		return KTX_GL_COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT;
+	default:
+		return 0;
+	}
+}
+
 } // Anonymous namespace.
 
 bool KTXHandler::canParseCompressed(Data *data)
@@ -383,6 +442,74 @@ StrongRef<ByteData> KTXHandler::parseCompressed(Data *filedata, std::vector<Stro
 	return memory;
 }
 
+bool KTXHandler::canEncodeCompressed(PixelFormat compressedFormat, EncodedFormat encodedFormat)
+{
+	return encodedFormat == ENCODED_KTX && convertFormat(compressedFormat) != 0;
+}
+
+FormatHandler::EncodedImage KTXHandler::encodeCompressed(const std::vector<StrongRef<CompressedSlice>> &images, PixelFormat format, EncodedFormat encodedFormat)
+{
+	if (!canEncodeCompressed(format, encodedFormat))
+		throw love::Exception("KTX encoder cannot encode to the %s pixel format.", getPixelFormatName(format));
+
+	if (images.empty())
+		throw love::Exception("Cannot encode empty compressed image data.");
+
+	KTXHeader header = {};
+	uint8 ktxidentifier[12] = KTX_IDENTIFIER_REF;
+	memcpy(header.identifier, ktxidentifier, 12);
+
+	// Compressed formats have no glType or glFormat, and a type size of 1.
+	header.endianness = KTX_ENDIAN_REF;
+	header.glTypeSize = 1;
+	header.glInternalFormat = convertFormat(format);
+
+	switch (getPixelFormatColorComponents(format))
+	{
+	case 1:
+		header.glBaseInternalFormat = 0x1903; // GL_RED
+		break;
+	case 2:
+		header.glBaseInternalFormat = 0x8227; // GL_RG
+		break;
+	case 3:
+		header.glBaseInternalFormat = 0x1907; // GL_RGB
+		break;
+	default:
+		header.glBaseInternalFormat = 0x1908; // GL_RGBA
+		break;
+	}
+
+	header.pixelWidth = (uint32) images[0]->getWidth();
+	header.pixelHeight = (uint32) images[0]->getHeight();
+	header.numberOfFaces = 1;
+	header.numberOfMipmapLevels = (uint32) images.size();
+
+	size_t totalsize = sizeof(KTXHeader);
+	for (const auto &image : images)
+		totalsize += sizeof(uint32) + ((image->getSize() + 3) & ~size_t(3));
+
+	EncodedImage encoded;
+	encoded.size = totalsize;
+	encoded.data = new unsigned char[totalsize];
+
+	memset(encoded.data, 0, totalsize);
+	memcpy(encoded.data, &header, sizeof(KTXHeader));
+
+	size_t offset = sizeof(KTXHeader);
+	for (const auto &image : images)
+	{
+		uint32 mipsize = (uint32) image->getSize();
+		memcpy(encoded.data + offset, &mipsize, sizeof(uint32));
+		offset += sizeof(uint32);
+
+		memcpy(encoded.data + offset, image->getData(), mipsize);
+		offset += (mipsize + 3) & ~uint32(3);
+	}
+
+	return encoded;
+}
+
 } // magpie
 } // image
 } // love
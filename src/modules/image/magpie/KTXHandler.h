@@ -46,6 +46,11 @@ class KTXHandler : public FormatHandler
 	        std::vector<StrongRef<CompressedSlice>> &images,
 	        PixelFormat &format) override;
 
+	bool canEncodeCompressed(PixelFormat compressedFormat, EncodedFormat encodedFormat) override;
+
+	EncodedImage encodeCompressed(const std::vector<StrongRef<CompressedSlice>> &images,
+	        PixelFormat format, EncodedFormat encodedFormat) override;
+
 }; // KTXHandler
 
 } // magpie
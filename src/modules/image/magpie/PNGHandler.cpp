@@ -23,6 +23,7 @@
 // LOVE
 #include "common/Exception.h"
 #include "common/math.h"
+#include "data/CompressionStream.h"
 
 // LodePNG
 #include "lodepng/lodepng.h"
@@ -32,9 +33,11 @@
 
 // C++
 #include <algorithm>
+#include <vector>
 
 // C
 #include <cstdlib>
+#include <cstring>
 
 namespace love
 {
@@ -97,10 +100,59 @@ static unsigned zlibDecompress(unsigned char **out, size_t *outsize, const unsig
 	return 0; // Success.
 }
 
+// Large images are deflated as separate blocks of scanline data on multiple
+// threads, instead of as one stream.
+static const size_t PARALLEL_COMPRESS_MIN_SIZE = 1024 * 1024;
+static const size_t PARALLEL_COMPRESS_BLOCK_SIZE = 256 * 1024;
+
+static unsigned zlibCompressParallel(unsigned char **out, size_t *outsize, const unsigned char *in, size_t insize)
+{
+	std::vector<char> result;
+
+	try
+	{
+		data::CompressionStream::Settings settings;
+		settings.blockSize = PARALLEL_COMPRESS_BLOCK_SIZE;
+
+		StrongRef<data::CompressionStream> stream(
+			data::CompressionStream::create(data::CompressionStream::MODE_COMPRESS, data::Compressor::FORMAT_ZLIB, settings),
+			Acquire::NORETAIN);
+
+		stream->feed(in, insize);
+		stream->finish();
+		stream->takeOutput(result);
+	}
+	catch (love::Exception &)
+	{
+		return 10000; // "Unknown error code" for LodePNG.
+	}
+
+	// LodePNG uses malloc, realloc, and free.
+	unsigned char *outdata = (unsigned char *) malloc(result.size());
+
+	if (!outdata)
+		return 83; // "Memory allocation failed" error code for LodePNG.
+
+	memcpy(outdata, result.data(), result.size());
+
+	if (out != nullptr)
+		*out = outdata;
+	else
+		free(outdata);
+
+	if (outsize != nullptr)
+		*outsize = result.size();
+
+	return 0; // Success.
+}
+
 // Custom PNG compression function for LodePNG, using zlib.
 static unsigned zlibCompress(unsigned char **out, size_t *outsize, const unsigned char *in,
                              size_t insize, const LodePNGCompressSettings* /*settings*/)
 {
+	if (insize >= PARALLEL_COMPRESS_MIN_SIZE)
+		return zlibCompressParallel(out, outsize, in, insize);
+
 	// Get the maximum compressed size of the data.
 	uLongf outdatasize = compressBound(insize);
 
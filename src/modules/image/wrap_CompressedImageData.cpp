@@ -117,6 +117,33 @@ int w_CompressedImageData_isLinear(lua_State *L)
 	return 1;
 }
 
+int w_CompressedImageData_encode(lua_State *L)
+{
+	CompressedImageData *t = luax_checkcompressedimagedata(L, 1);
+
+	FormatHandler::EncodedFormat format;
+	const char *fmt = luaL_checkstring(L, 2);
+	if (!CompressedImageData::getConstant(fmt, format))
+		return luax_enumerror(L, "encoded compressed image format", CompressedImageData::getConstants(format), fmt);
+
+	bool hasfilename = false;
+
+	std::string filename = "Image." + std::string(fmt);
+	if (!lua_isnoneornil(L, 3))
+	{
+		hasfilename = true;
+		filename = luax_checkstring(L, 3);
+	}
+
+	love::filesystem::FileData *filedata = nullptr;
+	luax_catchexcept(L, [&](){ filedata = t->encode(format, filename.c_str(), hasfilename); });
+
+	luax_pushtype(L, filedata);
+	filedata->release();
+
+	return 1;
+}
+
 static const luaL_Reg w_CompressedImageData_functions[] =
 {
 	{ "clone", w_CompressedImageData_clone },
@@ -127,6 +154,7 @@ static const luaL_Reg w_CompressedImageData_functions[] =
 	{ "getFormat", w_CompressedImageData_getFormat },
 	{ "setLinear", w_CompressedImageData_setLinear },
 	{ "isLinear", w_CompressedImageData_isLinear },
+	{ "encode", w_CompressedImageData_encode },
 	{ 0, 0 },
 };
 
@@ -0,0 +1,88 @@
+/**
+ * Copyright (c) 2006-2024 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+// LOVE
+#include "wrap_EncodeJob.h"
+
+namespace love
+{
+namespace image
+{
+
+EncodeJob *luax_checkencodejob(lua_State *L, int idx)
+{
+	return luax_checktype<EncodeJob>(L, idx);
+}
+
+int w_EncodeJob_isComplete(lua_State *L)
+{
+	EncodeJob *t = luax_checkencodejob(L, 1);
+	luax_pushboolean(L, t->isComplete());
+	return 1;
+}
+
+int w_EncodeJob_wait(lua_State *L)
+{
+	EncodeJob *t = luax_checkencodejob(L, 1);
+	luax_catchexcept(L, [&]() { t->wait(); });
+	return 0;
+}
+
+int w_EncodeJob_hasError(lua_State *L)
+{
+	EncodeJob *t = luax_checkencodejob(L, 1);
+	luax_pushboolean(L, t->hasError());
+	return 1;
+}
+
+int w_EncodeJob_getError(lua_State *L)
+{
+	EncodeJob *t = luax_checkencodejob(L, 1);
+	if (!t->hasError())
+		return 0;
+
+	luax_pushstring(L, t->getError());
+	return 1;
+}
+
+int w_EncodeJob_getFileData(lua_State *L)
+{
+	EncodeJob *t = luax_checkencodejob(L, 1);
+	luax_pushtype(L, t->getFileData());
+	return 1;
+}
+
+static const luaL_Reg w_EncodeJob_functions[] =
+{
+	{ "isComplete", w_EncodeJob_isComplete },
+	{ "wait", w_EncodeJob_wait },
+	{ "hasError", w_EncodeJob_hasError },
+	{ "getError", w_EncodeJob_getError },
+	{ "getFileData", w_EncodeJob_getFileData },
+	{ 0, 0 }
+};
+
+extern "C" int luaopen_encodejob(lua_State *L)
+{
+	return luax_register_type(L, &EncodeJob::type, w_EncodeJob_functions, nullptr);
+}
+
+} // image
+} // love
@@ -105,6 +105,29 @@ int w_newImageData(lua_State *L)
 
 int w_newCompressedData(lua_State *L)
 {
+	// Encode ImageData at runtime.
+	if (luax_istype(L, 1, ImageData::type))
+	{
+		ImageData *source = luax_checkimagedata(L, 1);
+
+		const char *fstr = luaL_checkstring(L, 2);
+		PixelFormat format = PIXELFORMAT_UNKNOWN;
+		if (!getConstant(fstr, format))
+			return luax_enumerror(L, "pixel format", fstr);
+
+		if (!instance()->isCompressedEncodingSupported(format))
+			return luaL_error(L, "Encoding ImageData to the %s pixel format is not supported.", fstr);
+
+		bool mipmaps = luax_optboolean(L, 3, false);
+
+		CompressedImageData *t = nullptr;
+		luax_catchexcept(L, [&]() { t = instance()->newCompressedData(source, format, mipmaps); });
+
+		luax_pushtype(L, CompressedImageData::type, t);
+		t->release();
+		return 1;
+	}
+
 	Data *data = love::filesystem::luax_getdata(L, 1);
 
 	CompressedImageData *t = nullptr;
@@ -128,6 +151,54 @@ int w_isCompressed(lua_State *L)
 	return 1;
 }
 
+int w_newMipmaps(lua_State *L)
+{
+	ImageData *id = luax_checkimagedata(L, 1);
+
+	MipmapGenerator::Settings settings;
+
+	if (!lua_isnoneornil(L, 2))
+	{
+		luaL_checktype(L, 2, LUA_TTABLE);
+
+		lua_getfield(L, 2, "filter");
+		if (!lua_isnoneornil(L, -1))
+		{
+			const char *str = luaL_checkstring(L, -1);
+			if (!MipmapGenerator::getConstant(str, settings.filter))
+				return luax_enumerror(L, "mipmap filter", MipmapGenerator::getConstants(settings.filter), str);
+		}
+		lua_pop(L, 1);
+
+		lua_getfield(L, 2, "gammacorrect");
+		if (!lua_isnoneornil(L, -1))
+			settings.gammaCorrect.set(luax_checkboolean(L, -1));
+		lua_pop(L, 1);
+
+		lua_getfield(L, 2, "alphacoverage");
+		if (!lua_isnoneornil(L, -1))
+			settings.alphaCoverage.set((float) luaL_checknumber(L, -1));
+		lua_pop(L, 1);
+	}
+
+	std::vector<StrongRef<ImageData>> levels;
+	luax_catchexcept(L, [&](){ levels = instance()->newMipmaps(id, settings); });
+
+	// The base level comes first, so the table can be passed straight to
+	// love.graphics.newTexture.
+	lua_createtable(L, (int) levels.size() + 1, 0);
+	luax_pushtype(L, id);
+	lua_rawseti(L, -2, 1);
+
+	for (int i = 0; i < (int) levels.size(); i++)
+	{
+		luax_pushtype(L, levels[i]);
+		lua_rawseti(L, -2, i + 2);
+	}
+
+	return 1;
+}
+
 int w_newCubeFaces(lua_State *L)
 {
 	ImageData *id = luax_checkimagedata(L, 1);
@@ -144,6 +215,7 @@ static const luaL_Reg functions[] =
 	{ "newImageData",  w_newImageData },
 	{ "newCompressedData", w_newCompressedData },
 	{ "isCompressed", w_isCompressed },
+	{ "newMipmaps", w_newMipmaps },
 	{ "newCubeFaces", w_newCubeFaces },
 	{ 0, 0 }
 };
@@ -152,6 +224,7 @@ static const lua_CFunction types[] =
 {
 	luaopen_imagedata,
 	luaopen_compressedimagedata,
+	luaopen_encodejob,
 	0
 };
 
@@ -261,6 +261,33 @@ int w_ImageData_encode(lua_State *L)
 	return 1;
 }
 
+int w_ImageData_encodeAsync(lua_State *L)
+{
+	ImageData *t = luax_checkimagedata(L, 1);
+
+	FormatHandler::EncodedFormat format;
+	const char *fmt = luaL_checkstring(L, 2);
+	if (!ImageData::getConstant(fmt, format))
+		return luax_enumerror(L, "encoded image format", ImageData::getConstants(format), fmt);
+
+	bool hasfilename = false;
+
+	std::string filename = "Image." + std::string(fmt);
+	if (!lua_isnoneornil(L, 3))
+	{
+		hasfilename = true;
+		filename = luax_checkstring(L, 3);
+	}
+
+	EncodeJob *job = nullptr;
+	luax_catchexcept(L, [&](){ job = t->encodeAsync(format, filename.c_str(), hasfilename); });
+
+	luax_pushtype(L, job);
+	job->release();
+
+	return 1;
+}
+
 // C functions in a struct, necessary for the FFI versions of ImageData methods.
 struct FFI_ImageData
 {
@@ -298,6 +325,7 @@ static const luaL_Reg w_ImageData_functions[] =
 	{ "paste", w_ImageData_paste },
 	{ "mapPixel", w_ImageData_mapPixel },
 	{ "encode", w_ImageData_encode },
+	{ "encodeAsync", w_ImageData_encodeAsync },
 	{ 0, 0 }
 };
 
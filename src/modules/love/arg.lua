@@ -107,6 +107,8 @@ love.arg.options = {
 	game = { a = 1 },
 	renderers = { a = 1 },
 	excluderenderers = { a = 1 },
+	buildbytecodecache = { a = 0 },
+	["startup-profile"] = { a = 0 },
 }
 
 love.arg.optionIndices = {}
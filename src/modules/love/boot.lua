@@ -39,6 +39,26 @@ local no_game_code = false
 local invalid_game_path = nil
 local main_file = "main.lua"
 
+-- Startup timings for --startup-profile, in the order they were measured.
+local gettime = love._getTime or os.clock
+local startupbegin = gettime()
+local startupprofile = nil
+
+local function profilemark(name, start)
+	if startupprofile then
+		table.insert(startupprofile, {name = name, time = gettime() - start})
+	end
+end
+
+local function printstartupprofile()
+	local total = gettime() - startupbegin
+	print("Startup profile:")
+	for _, entry in ipairs(startupprofile) do
+		print(("%10.2f ms  %5.1f%%  %s"):format(entry.time * 1000, entry.time / total * 100, entry.name))
+	end
+	print(("%10.2f ms          total to first frame"):format(total * 1000))
+end
+
 -- This can't be overridden.
 function love.boot()
 
@@ -75,6 +95,11 @@ function love.boot()
 
 	local o = love.arg.options
 
+	if o["startup-profile"].set then
+		startupprofile = {}
+		profilemark("boot", startupbegin)
+	end
+
 	local is_fused_game = can_has_game or love.arg.options.fused.set
 
 	love.filesystem.setFused(is_fused_game)
@@ -151,6 +176,41 @@ usage:
 	end
 end
 
+-- Compiles every .lua file in the game into the bytecode cache, so the
+-- resulting directory can be shipped in the game's source.
+local function buildbytecodecache()
+	love.filesystem.setBytecodeCacheEnabled(true)
+
+	local savedir = love.filesystem.getSaveDirectory()
+	local compiled, failed = 0, 0
+
+	local function build(dir)
+		for _, item in ipairs(love.filesystem.getDirectoryItems(dir)) do
+			local path = dir == "" and item or dir .. "/" .. item
+			local info = love.filesystem.getInfo(path)
+
+			-- Only the game's own files, not anything in the save directory.
+			if info and love.filesystem.getRealDirectory(path) ~= savedir then
+				if info.type == "directory" then
+					build(path)
+				elseif info.type == "file" and path:match("%.lua$") then
+					local ok, err = pcall(love.filesystem.load, path)
+					if ok then
+						compiled = compiled + 1
+					else
+						failed = failed + 1
+						print(err)
+					end
+				end
+			end
+		end
+	end
+
+	build("")
+
+	print(("Compiled %d Lua files (%d failed) into %s/.bytecodecache"):format(compiled, failed, savedir))
+end
+
 function love.init()
 
 	-- Create default configuration settings.
@@ -210,6 +270,8 @@ function love.init()
 		highdpi = false,
 		renderers = nil,
 		excluderenderers = nil,
+		bytecodecache = false,
+		lazymodules = false,
 	}
 
 	-- Console hack, part 1.
@@ -219,6 +281,8 @@ function love.init()
 		openedconsole = true
 	end
 
+	local conftime = gettime()
+
 	-- If config file exists, load it and allow it to update config table.
 	local confok, conferr
 	if (not love.conf) and love.filesystem and love.filesystem.getInfo("conf.lua") then
@@ -233,6 +297,8 @@ function love.init()
 		-- the error message can be displayed in the window.
 	end
 
+	profilemark("conf.lua", conftime)
+
 	-- Console hack, part 2.
 	if c.console and love._openConsole and not openedconsole then
 		love._openConsole()
@@ -300,6 +366,22 @@ function love.init()
 		love._requestRecordingPermission(c.audio and c.audio.mic)
 	end
 
+	-- Modules which nothing else needs during startup, and the modules they
+	-- need loaded first. With t.lazymodules these are loaded on first access
+	-- (e.g. the first call to love.audio.newSource) instead of up front.
+	-- love.data stays eager: it registers the ByteData type, which other
+	-- modules (e.g. love.graphics.readbackBuffer) return without loading it.
+	local lazymodules = {
+		thread = {},
+		sound = {},
+		system = {},
+		audio = {"sound"},
+		video = {},
+		math = {},
+		physics = {"data"},
+	}
+	local deferred = {}
+
 	-- Gets desired modules.
 	for k,v in ipairs{
 		"data",
@@ -323,8 +405,49 @@ function love.init()
 		"physics",
 	} do
 		if c.modules[v] then
-			require("love." .. v)
+			if c.lazymodules and lazymodules[v] then
+				deferred[v] = true
+			else
+				local t = gettime()
+				require("love." .. v)
+				profilemark("love." .. v, t)
+			end
+		end
+	end
+
+	local function loaddeferred(name)
+		deferred[name] = nil
+
+		for _, dep in ipairs(lazymodules[name]) do
+			if deferred[dep] then
+				loaddeferred(dep)
+			end
 		end
+
+		local start = gettime()
+		require("love." .. name)
+		profilemark("love." .. name .. " (deferred)", start)
+	end
+
+	-- Deferred modules are loaded the first time they're accessed. Module
+	-- tables are stored directly in love, so __index only runs for missing
+	-- keys, and the metatable goes away once everything has been loaded.
+	if next(deferred) then
+		setmetatable(love, {
+			__index = function(t, name)
+				if not deferred[name] then
+					return nil
+				end
+
+				loaddeferred(name)
+
+				if not next(deferred) then
+					setmetatable(t, nil)
+				end
+
+				return rawget(t, name)
+			end,
+		})
 	end
 
 	if love.event then
@@ -351,8 +474,14 @@ function love.init()
 		error(conferr)
 	end
 
+	-- Prebuilding the bytecode cache doesn't need a window.
+	if love.arg.options.buildbytecodecache.set then
+		c.window = false
+	end
+
 	-- Setup window here.
 	if c.window and c.modules.window then
+		local windowtime = gettime()
 		love.window.setTitle(c.window.title or c.title)
 		assert(love.window.setMode(c.window.width, c.window.height,
 		{
@@ -378,6 +507,12 @@ function love.init()
 			assert(love.image, "If an icon is set in love.conf, love.image must be loaded!")
 			love.window.setIcon(love.image.newImageData(c.window.icon))
 		end
+		profilemark("window and graphics context", windowtime)
+
+		if startupprofile and love.graphics and love.graphics.isCreated() then
+			local shadertime = love.graphics._getDefaultShaderCompileTime()
+			table.insert(startupprofile, {name = "  default shader compilation", time = shadertime})
+		end
 	end
 
 	-- The first couple event pumps on some systems (e.g. macOS) can take a
@@ -395,8 +530,19 @@ function love.init()
 	if love.filesystem then
 		love.filesystem._setAndroidSaveExternal(c.externalstorage)
 		love.filesystem.setIdentity(c.identity or love.filesystem.getIdentity(), c.appendidentity)
+		love.filesystem.setBytecodeCacheEnabled(c.bytecodecache == true)
+
+		if love.arg.options.buildbytecodecache.set then
+			buildbytecodecache()
+			-- Skip the game entirely and quit once the cache is written.
+			love.run = function() return function() return 0 end end
+			return
+		end
+
 		if love.filesystem.getInfo(main_file) then
+			local maintime = gettime()
 			require(main_file:gsub("%.lua$", ""))
+			profilemark(main_file, maintime)
 		end
 	end
 
@@ -441,12 +587,33 @@ return function()
 		result = xpcall(love.init, deferErrhand)
 		if not result then return end
 
+		if startupprofile and love.load then
+			local load = love.load
+			love.load = function(...)
+				local start = gettime()
+				load(...)
+				profilemark("love.load", start)
+				love.load = load
+			end
+		end
+
 		-- NOTE: We can't assign to func directly, as we'd
 		-- overwrite the result of deferErrhand with nil on error
 		local main
 		result, main = xpcall(love.run, deferErrhand)
 		if result then
 			func = main
+
+			if startupprofile and main then
+				func = function()
+					local start = gettime()
+					local retval, restartvalue = main()
+					profilemark("first frame", start)
+					printstartupprofile()
+					func = main
+					return retval, restartvalue
+				end
+			end
 		end
 	end
 
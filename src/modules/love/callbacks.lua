@@ -229,7 +229,8 @@ function love.errhand(msg)
 			v:setVibration()
 		end
 	end
-	if love.audio then love.audio.stop() end
+	-- rawget so a deferred audio module isn't loaded just to be stopped.
+	if rawget(love, "audio") then love.audio.stop() end
 
 	love.graphics.reset()
 	love.graphics.setFont(love.graphics.newFont(15))
@@ -82,6 +82,11 @@
 #	include "system/System.h"
 #endif
 
+// For love::timer::Timer::getTime.
+#ifdef LOVE_ENABLE_TIMER
+#	include "timer/Timer.h"
+#endif
+
 // Scripts.
 #include "scripts/nogame.lua.h"
 
@@ -431,6 +436,14 @@ static int w__setRenderers(lua_State *L)
 	return 0;
 }
 
+#ifdef LOVE_ENABLE_TIMER
+static int w__getTime(lua_State *L)
+{
+	lua_pushnumber(L, love::timer::Timer::getTime());
+	return 1;
+}
+#endif
+
 static int w__setHighDPIAllowed(lua_State *L)
 {
 #ifdef LOVE_ENABLE_WINDOW
@@ -572,6 +585,12 @@ int luaopen_love(lua_State *L)
 	lua_pushcfunction(L, w__setHighDPIAllowed);
 	lua_setfield(L, -2, "_setHighDPIAllowed");
 
+#ifdef LOVE_ENABLE_TIMER
+	// Used to time startup before the timer module is loaded.
+	lua_pushcfunction(L, w__getTime);
+	lua_setfield(L, -2, "_getTime");
+#endif
+
 	// Exposed here because we need to be able to call it before the audio
 	// module is initialized.
 	lua_pushcfunction(L, w__setAudioMixWithSystem);
@@ -23,6 +23,10 @@
 // LOVE
 #include "common/math.h"
 #include "wrap_Body.h"
+#include "thread/ThreadPool.h"
+
+// C++
+#include <unordered_set>
 
 namespace love
 {
@@ -50,6 +54,39 @@ World *Physics::newWorld(float gx, float gy, bool sleep)
 	return new World(b2Vec2(gx, gy), sleep);
 }
 
+void Physics::updateWorlds(const std::vector<World *> &worlds, float dt, int velocityIterations, int positionIterations)
+{
+	std::vector<World *> parallel;
+	std::vector<World *> serial;
+	std::unordered_set<World *> unique;
+
+	for (World *world : worlds)
+	{
+		if (!world->isValid())
+			throw love::Exception("Cannot update a destroyed World.");
+		if (world->isLocked())
+			throw love::Exception("Cannot update a World during its own time step.");
+		if (!unique.insert(world).second)
+			throw love::Exception("Each World may only be updated once per call.");
+
+		if (world->hasLuaCallbacks())
+			serial.push_back(world);
+		else
+			parallel.push_back(world);
+	}
+
+	thread::ThreadPool::getShared()->parallelFor((int) parallel.size(), [&](int i)
+	{
+		parallel[i]->step(dt, velocityIterations, positionIterations);
+	});
+
+	for (World *world : parallel)
+		world->finishUpdate();
+
+	for (World *world : serial)
+		world->update(dt, velocityIterations, positionIterations);
+}
+
 Body *Physics::newBody(World *world, float x, float y, Body::Type type)
 {
 	return new Body(world, b2Vec2(x, y), type);
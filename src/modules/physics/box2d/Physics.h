@@ -73,6 +73,16 @@ class Physics : public Module
 	 **/
 	World *newWorld(float gx, float gy, bool sleep);
 
+	/**
+	 * Updates several Worlds one timestep. Worlds without Lua callbacks are
+	 * stepped in parallel on the shared thread pool, the others on the calling
+	 * thread afterwards. Objects marked for destruction are destroyed on the
+	 * calling thread once all Worlds have been stepped.
+	 * @param worlds The Worlds to update. Each may only appear once.
+	 * @param dt The timestep.
+	 **/
+	void updateWorlds(const std::vector<World *> &worlds, float dt, int velocityIterations, int positionIterations);
+
 	/**
 	 * Creates a new Body at the specified position.
 	 * @param world The world to create the Body in.
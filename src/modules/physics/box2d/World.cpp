@@ -24,11 +24,22 @@
 #include "Contact.h"
 #include "Physics.h"
 #include "common/Reference.h"
+#include "common/Data.h"
+#include "common/profiler.h"
+#include "data/ByteData.h"
+#include "data/HashFunction.h"
+#include "thread/ThreadPool.h"
 
 // Needed for World::getJoints. It should be moved to wrapper code...
 #include "wrap_Joint.h"
 #include "wrap_Shape.h"
 
+// C++
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <unordered_map>
+
 namespace love
 {
 namespace physics
@@ -264,6 +275,27 @@ void World::SayGoodbye(b2Joint *joint)
 	if (j) j->destroyJoint(true);
 }
 
+World::TaskExecutor::TaskExecutor()
+	: threadCount(1)
+{
+}
+
+int32 World::TaskExecutor::GetWorkerCount() const
+{
+	int available = thread::ThreadPool::getShared()->getThreadCount() + 1;
+	if (threadCount <= 0)
+		return available;
+	return std::min(threadCount, available);
+}
+
+void World::TaskExecutor::Run(int32 taskCount, TaskFunction task, void *context)
+{
+	thread::ThreadPool::getShared()->parallelFor(taskCount, [&](int i)
+	{
+		task(i, context);
+	});
+}
+
 World::World()
 	: world(nullptr)
 	, destructWorld(false)
@@ -312,8 +344,19 @@ void World::update(float dt)
 
 void World::update(float dt, int velocityIterations, int positionIterations)
 {
+	LOVE_PROFILE_ZONE("World::update");
+	step(dt, velocityIterations, positionIterations);
+	finishUpdate();
+}
+
+void World::step(float dt, int velocityIterations, int positionIterations)
+{
+	LOVE_PROFILE_ZONE("World::step");
 	world->Step(dt, velocityIterations, positionIterations);
+}
 
+void World::finishUpdate()
+{
 	// Destroy all objects marked during the time step.
 	for (Body *b : destructBodies)
 	{
@@ -341,6 +384,12 @@ void World::update(float dt, int velocityIterations, int positionIterations)
 		destroy();
 }
 
+bool World::hasLuaCallbacks() const
+{
+	return begin.ref != nullptr || end.ref != nullptr || presolve.ref != nullptr
+		|| postsolve.ref != nullptr || filter.ref != nullptr;
+}
+
 void World::BeginContact(b2Contact *contact)
 {
 	begin.process(contact);
@@ -508,6 +557,20 @@ bool World::isSleepingAllowed() const
 	return world->GetAllowSleeping();
 }
 
+void World::setThreadCount(int count)
+{
+	if (count < 0)
+		throw love::Exception("Thread count must not be negative.");
+
+	executor.threadCount = count;
+	world->SetTaskExecutor(count == 1 ? nullptr : &executor);
+}
+
+int World::getThreadCount() const
+{
+	return executor.threadCount;
+}
+
 bool World::isLocked() const
 {
 	return world->IsLocked();
@@ -530,7 +593,7 @@ int World::getContactCount() const
 
 int World::getBodies(lua_State *L) const
 {
-	lua_newtable(L);
+	lua_createtable(L, world->GetBodyCount(), 0);
 	b2Body *b = world->GetBodyList();
 	int i = 1;
 	do
@@ -552,7 +615,7 @@ int World::getBodies(lua_State *L) const
 
 int World::getJoints(lua_State *L) const
 {
-	lua_newtable(L);
+	lua_createtable(L, world->GetJointCount(), 0);
 	b2Joint *j = world->GetJointList();
 	int i = 1;
 	do
@@ -570,7 +633,7 @@ int World::getJoints(lua_State *L) const
 
 int World::getContacts(lua_State *L)
 {
-	lua_newtable(L);
+	lua_createtable(L, world->GetContactCount(), 0);
 	b2Contact *c = world->GetContactList();
 	int i = 1;
 	do
@@ -697,6 +760,433 @@ int World::rayCastClosest(lua_State *L)
 	return 0;
 }
 
+// Reads a batch of boxes or segments (x1, y1, x2, y2 each) from a Data or a
+// flat Lua array. Returns the number of entries.
+static const float *checkBatchInput(lua_State *L, int idx, std::vector<float> &storage, int &count)
+{
+	const int components = 4;
+
+	if (lua_istable(L, idx))
+	{
+		int length = (int) luax_objlen(L, idx);
+		if (length % components != 0)
+			luaL_error(L, "Expected %d numbers per entry, got a table of length %d.", components, length);
+
+		storage.resize(length);
+		for (int i = 0; i < length; i++)
+		{
+			lua_rawgeti(L, idx, i + 1);
+			storage[i] = (float) luaL_checknumber(L, -1);
+			lua_pop(L, 1);
+		}
+
+		count = length / components;
+		return storage.data();
+	}
+
+	Data *data = luax_checktype<Data>(L, idx);
+	size_t entrysize = sizeof(float) * components;
+	if (data->getSize() % entrysize != 0)
+		luaL_error(L, "Input Data size must be a multiple of %d bytes, got %d.", (int) entrysize, (int) data->getSize());
+
+	count = (int) (data->getSize() / entrysize);
+	return (const float *) data->getData();
+}
+
+// Results are written while the inputs are still being read, so the output
+// can't share memory with an input Data.
+static Data *checkBatchOutputData(lua_State *L, int idx, const float *input, int count)
+{
+	Data *data = luax_checktype<Data>(L, idx);
+
+	const char *in = (const char *) input;
+	const char *inend = in + sizeof(float) * 4 * count;
+	const char *out = (const char *) data->getData();
+	const char *outend = out + data->getSize();
+
+	std::less<const char *> less;
+	if (count > 0 && less(in, outend) && less(out, inend))
+		luaL_error(L, "The output Data must not overlap the input Data.");
+
+	return data;
+}
+
+static void *checkBatchOutput(lua_State *L, int idx, const float *input, int count, size_t recordsize)
+{
+	Data *data = checkBatchOutputData(L, idx, input, count);
+	if (data->getSize() < recordsize * count)
+		luaL_error(L, "Output Data is too small: %d bytes are needed.", (int) (recordsize * count));
+	return data->getData();
+}
+
+static int getBatchTaskCount(int count, bool threaded)
+{
+	const int minPerTask = 64;
+	if (!threaded)
+		return 1;
+
+	int threads = thread::ThreadPool::getShared()->getThreadCount() + 1;
+	return std::max(1, std::min(count / minPerTask, threads * 4));
+}
+
+// Calls func(task, begin, end) for contiguous ranges of [0, count), spread
+// across the shared thread pool.
+static void forBatch(int count, int taskcount, const std::function<void(int, int, int)> &func)
+{
+	if (taskcount <= 1)
+	{
+		func(0, 0, count);
+		return;
+	}
+
+	thread::ThreadPool::getShared()->parallelFor(taskcount, [&](int task)
+	{
+		func(task, count * task / taskcount, count * (task + 1) / taskcount);
+	});
+}
+
+// Maps the hit fixtures to 1-based indices into a new table of Shapes, which
+// is left on the stack.
+class ShapeTable
+{
+public:
+
+	ShapeTable(lua_State *L)
+		: L(L)
+	{
+		lua_newtable(L);
+	}
+
+	uint32 getIndex(b2Fixture *fixture)
+	{
+		auto it = indices.find(fixture);
+		if (it != indices.end())
+			return it->second;
+
+		Shape *shape = (Shape *)(fixture->GetUserData().pointer);
+		if (shape == nullptr)
+			throw love::Exception("A Shape has escaped Memoizer!");
+
+		uint32 index = (uint32) indices.size() + 1;
+		indices[fixture] = index;
+		luax_pushshape(L, shape);
+		lua_rawseti(L, -2, (int) index);
+		return index;
+	}
+
+private:
+
+	lua_State *L;
+	std::unordered_map<b2Fixture *, uint32> indices;
+};
+
+int World::rayCastBatch(lua_State *L)
+{
+	std::vector<float> storage;
+	int count = 0;
+	const float *rays = checkBatchInput(L, 1, storage, count);
+	RayCastHit *hits = (RayCastHit *) checkBatchOutput(L, 2, rays, count, sizeof(RayCastHit));
+
+	const char *mode = luaL_optstring(L, 3, "closest");
+	bool any = false;
+	if (strcmp(mode, "any") == 0)
+		any = true;
+	else if (strcmp(mode, "closest") != 0)
+		return luaL_error(L, "Invalid ray cast mode '%s', expected 'closest' or 'any'.", mode);
+
+	uint16 categoryMaskBits = (uint16)luaL_optinteger(L, 4, 0xFFFF);
+	bool threaded = luax_optboolean(L, 5, true);
+
+	std::vector<b2Fixture *> fixtures(count);
+
+	// Broad-phase ray casts only read the world, so they can run concurrently.
+	forBatch(count, getBatchTaskCount(count, threaded), [&](int /*task*/, int begin, int end)
+	{
+		for (int i = begin; i < end; i++)
+		{
+			const float *ray = rays + i * 4;
+			b2Vec2 v1 = Physics::scaleDown(b2Vec2(ray[0], ray[1]));
+			b2Vec2 v2 = Physics::scaleDown(b2Vec2(ray[2], ray[3]));
+
+			RayCastOneCallback raycast(categoryMaskBits, any);
+			world->RayCast(&raycast, v1, v2);
+
+			RayCastHit &hit = hits[i];
+			fixtures[i] = raycast.hitFixture;
+			if (raycast.hitFixture)
+			{
+				b2Vec2 hitPoint = Physics::scaleUp(raycast.hitPoint);
+				hit.x = hitPoint.x;
+				hit.y = hitPoint.y;
+				hit.normalX = raycast.hitNormal.x;
+				hit.normalY = raycast.hitNormal.y;
+				hit.fraction = raycast.hitFraction;
+			}
+			else
+			{
+				hit.x = hit.y = 0.0f;
+				hit.normalX = hit.normalY = 0.0f;
+				hit.fraction = 1.0f;
+			}
+		}
+	});
+
+	int hitcount = (int) std::count_if(fixtures.begin(), fixtures.end(), [](b2Fixture *f) { return f != nullptr; });
+	lua_pushinteger(L, hitcount);
+
+	ShapeTable shapes(L);
+	for (int i = 0; i < count; i++)
+		hits[i].shape = fixtures[i] ? shapes.getIndex(fixtures[i]) : 0;
+
+	return 2;
+}
+
+int World::getShapesInAreaBatch(lua_State *L)
+{
+	std::vector<float> storage;
+	int count = 0;
+	const float *areas = checkBatchInput(L, 1, storage, count);
+
+	Data *output = checkBatchOutputData(L, 2, areas, count);
+	size_t capacity = output->getSize() / sizeof(AreaHit);
+	AreaHit *hits = (AreaHit *) output->getData();
+
+	uint16 categoryMaskBits = (uint16)luaL_optinteger(L, 3, 0xFFFF);
+	bool threaded = luax_optboolean(L, 4, true);
+
+	class AreaQuery : public b2QueryCallback
+	{
+	public:
+		AreaQuery(uint16 categoryMask, std::vector<std::pair<int, b2Fixture *>> &results)
+			: area(0), categoryMask(categoryMask), results(results) {}
+
+		bool ReportFixture(b2Fixture *fixture) override
+		{
+			if (categoryMask == 0xFFFF || (categoryMask & fixture->GetFilterData().categoryBits) != 0)
+				results.emplace_back(area, fixture);
+			return true;
+		}
+
+		int area;
+
+	private:
+		uint16 categoryMask;
+		std::vector<std::pair<int, b2Fixture *>> &results;
+	};
+
+	// Each range of areas collects its own results, which are then joined in
+	// area order.
+	int taskcount = getBatchTaskCount(count, threaded);
+	std::vector<std::vector<std::pair<int, b2Fixture *>>> ranges(taskcount);
+
+	forBatch(count, taskcount, [&](int task, int begin, int end)
+	{
+		AreaQuery query(categoryMaskBits, ranges[task]);
+
+		for (int i = begin; i < end; i++)
+		{
+			const float *area = areas + i * 4;
+			b2AABB box;
+			box.lowerBound = Physics::scaleDown(b2Vec2(area[0], area[1]));
+			box.upperBound = Physics::scaleDown(b2Vec2(area[2], area[3]));
+			query.area = i;
+			world->QueryAABB(&query, box);
+		}
+	});
+
+	size_t total = 0;
+	for (const auto &range : ranges)
+		total += range.size();
+	size_t written = std::min(total, capacity);
+	lua_pushinteger(L, (lua_Integer) written);
+
+	ShapeTable shapes(L);
+	size_t i = 0;
+	for (const auto &range : ranges)
+	{
+		for (const auto &result : range)
+		{
+			if (i == written)
+				break;
+			hits[i].area = (uint32) result.first + 1;
+			hits[i].shape = shapes.getIndex(result.second);
+			i++;
+		}
+	}
+
+	lua_pushinteger(L, (lua_Integer) total);
+	return 3;
+}
+
+// A delta state is a header followed by runs of bytes that differ from the
+// base state, each prefixed by a StateDeltaRun. The base is identified by its
+// size and hash, so a delta is never applied on top of a different state.
+struct StateDeltaHeader
+{
+	uint32 magic;
+	uint32 size;
+	uint64 baseSize;
+	uint64 baseHash;
+};
+
+struct StateDeltaRun
+{
+	uint32 offset;
+	uint32 size;
+};
+
+static const uint32 STATE_DELTA_MAGIC = 0x544C4544; // "DELT"
+
+// Bytes are compared in blocks, and runs separated by fewer equal blocks than
+// a run header would cost are merged.
+static const size_t STATE_DELTA_BLOCK = 8;
+
+static bool isStateDelta(Data *state)
+{
+	uint32 magic = 0;
+	if (state->getSize() >= sizeof(StateDeltaHeader))
+		memcpy(&magic, state->getData(), sizeof(uint32));
+	return magic == STATE_DELTA_MAGIC;
+}
+
+static uint64 hashState(const char *state, size_t size)
+{
+	data::HashFunction::Value value;
+	data::HashFunction::getHashFunction(data::HashFunction::FUNCTION_XXH64)->hash(data::HashFunction::FUNCTION_XXH64, state, size, value);
+
+	uint64 hash = 0;
+	memcpy(&hash, value.data, sizeof(hash));
+	return hash;
+}
+
+static void encodeStateDelta(const char *state, size_t size, const char *base, size_t basesize, std::vector<char> &out)
+{
+	StateDeltaHeader header = {STATE_DELTA_MAGIC, (uint32) size, (uint64) basesize, hashState(base, basesize)};
+	out.assign((const char *) &header, (const char *) &header + sizeof(header));
+
+	auto blockEqual = [&](size_t offset)
+	{
+		size_t length = std::min(STATE_DELTA_BLOCK, size - offset);
+		return offset + length <= basesize && memcmp(state + offset, base + offset, length) == 0;
+	};
+
+	size_t offset = 0;
+	while (offset < size)
+	{
+		if (blockEqual(offset))
+		{
+			offset += STATE_DELTA_BLOCK;
+			continue;
+		}
+
+		size_t start = offset;
+		size_t end = offset;
+		while (end < size)
+		{
+			if (!blockEqual(end))
+			{
+				end += STATE_DELTA_BLOCK;
+				continue;
+			}
+
+			size_t next = end;
+			while (next < size && next - end <= sizeof(StateDeltaRun) && blockEqual(next))
+				next += STATE_DELTA_BLOCK;
+
+			if (next >= size || next - end > sizeof(StateDeltaRun))
+				break;
+			end = next;
+		}
+		end = std::min(end, size);
+
+		StateDeltaRun run = {(uint32) start, (uint32) (end - start)};
+		out.insert(out.end(), (const char *) &run, (const char *) &run + sizeof(run));
+		out.insert(out.end(), state + start, state + end);
+		offset = end;
+	}
+}
+
+static void decodeStateDelta(const char *delta, size_t size, const char *base, size_t basesize, std::vector<char> &out)
+{
+	StateDeltaHeader header;
+	memcpy(&header, delta, sizeof(header));
+	if (header.baseSize != basesize || header.baseHash != hashState(base, basesize))
+		throw love::Exception("The base state does not match the one the delta state was saved against.");
+
+	out.resize(header.size);
+	memcpy(out.data(), base, std::min(basesize, (size_t) header.size));
+
+	size_t offset = sizeof(header);
+	while (offset < size)
+	{
+		StateDeltaRun run;
+		if (size - offset < sizeof(run))
+			throw love::Exception("Invalid delta state.");
+		memcpy(&run, delta + offset, sizeof(run));
+		offset += sizeof(run);
+
+		if (run.size > size - offset || run.offset > header.size || run.size > header.size - run.offset)
+			throw love::Exception("Invalid delta state.");
+		memcpy(out.data() + run.offset, delta + offset, run.size);
+		offset += run.size;
+	}
+}
+
+data::ByteData *World::saveState(Data *base)
+{
+	if (world->IsLocked())
+		throw love::Exception("Cannot save the state of a World during its time step.");
+
+	if (base != nullptr && isStateDelta(base))
+		throw love::Exception("The base of a delta state must be a full state.");
+
+	int32 size = world->SaveState(stateBuffer.data(), (int32) stateBuffer.size());
+	if (size > (int32) stateBuffer.size())
+	{
+		stateBuffer.resize(size);
+		world->SaveState(stateBuffer.data(), size);
+	}
+
+	if (base == nullptr)
+		return new data::ByteData(stateBuffer.data(), size);
+
+	std::vector<char> delta;
+	encodeStateDelta(stateBuffer.data(), size, (const char *) base->getData(), base->getSize(), delta);
+	return new data::ByteData(delta.data(), delta.size());
+}
+
+void World::restoreState(Data *state, Data *base)
+{
+	if (world->IsLocked())
+		throw love::Exception("Cannot restore the state of a World during its time step.");
+
+	const char *data = (const char *) state->getData();
+	size_t size = state->getSize();
+
+	if (isStateDelta(state))
+	{
+		if (base == nullptr)
+			throw love::Exception("A delta state needs the base state it was saved against.");
+
+		decodeStateDelta(data, size, (const char *) base->getData(), base->getSize(), stateBuffer);
+		data = stateBuffer.data();
+		size = stateBuffer.size();
+	}
+
+	if (!world->ValidateState(data, (int32) size))
+		throw love::Exception("The state does not match the Bodies, Shapes and Joints of this World.");
+
+	// The Box2D contacts are about to be replaced.
+	for (b2Contact *c = world->GetContactList(); c; c = c->GetNext())
+	{
+		Contact *contact = (Contact *) findObject(c);
+		if (contact != nullptr)
+			contact->invalidate();
+	}
+
+	world->RestoreState(data, (int32) size);
+}
+
 void World::destroy()
 {
 	if (world == nullptr)
@@ -35,6 +35,14 @@
 
 namespace love
 {
+
+class Data;
+
+namespace data
+{
+class ByteData;
+}
+
 namespace physics
 {
 namespace box2d
@@ -69,6 +77,26 @@ class World : public Object, public b2ContactListener, public b2ContactFilter, p
 
 	static love::Type type;
 
+	/**
+	 * Output record of rayCastBatch, one per ray.
+	 **/
+	struct RayCastHit
+	{
+		uint32 shape; // 1-based index into the returned Shapes, 0 if nothing was hit.
+		float x, y;
+		float normalX, normalY;
+		float fraction;
+	};
+
+	/**
+	 * Output record of getShapesInAreaBatch, one per overlapping Shape.
+	 **/
+	struct AreaHit
+	{
+		uint32 area; // 1-based index of the area.
+		uint32 shape; // 1-based index into the returned Shapes.
+	};
+
 	class ContactCallback
 	{
 	public:
@@ -146,6 +174,18 @@ class World : public Object, public b2ContactListener, public b2ContactFilter, p
 		bool any;
 	};
 
+	/**
+	 * Runs Box2D's step tasks on the shared thread pool.
+	 **/
+	class TaskExecutor : public b2TaskExecutor
+	{
+	public:
+		int threadCount;
+		TaskExecutor();
+		int32 GetWorkerCount() const override;
+		void Run(int32 taskCount, TaskFunction task, void *context) override;
+	};
+
 	/**
 	 * Creates a new world.
 	 **/
@@ -171,6 +211,25 @@ class World : public Object, public b2ContactListener, public b2ContactFilter, p
 	void update(float dt);
 	void update(float dt, int velocityIterations, int positionIterations);
 
+	/**
+	 * Steps the Box2D world without destroying the objects marked for
+	 * destruction during the step. update() is step() followed by
+	 * finishUpdate(). step() may run on another thread when
+	 * hasLuaCallbacks() is false.
+	 **/
+	void step(float dt, int velocityIterations, int positionIterations);
+
+	/**
+	 * Destroys the objects marked for destruction during the last step.
+	 **/
+	void finishUpdate();
+
+	/**
+	 * Whether stepping this World calls into Lua, through contact callbacks
+	 * or a contact filter.
+	 **/
+	bool hasLuaCallbacks() const;
+
 	// From b2ContactListener
 	void BeginContact(b2Contact *contact);
 	void EndContact(b2Contact *contact);
@@ -252,6 +311,19 @@ class World : public Object, public b2ContactListener, public b2ContactFilter, p
 	 **/
 	bool isSleepingAllowed() const;
 
+	/**
+	 * Sets the number of threads used to step this World. Islands, contact
+	 * updates and broad-phase queries are then split across the shared thread
+	 * pool. The results don't depend on the thread count.
+	 * @param count The number of threads, 0 to use all cores. The default is 1.
+	 **/
+	void setThreadCount(int count);
+
+	/**
+	 * Gets the number of threads used to step this World.
+	 **/
+	int getThreadCount() const;
+
 	/**
 	 * Returns whether this World is currently locked.
 	 * If it's locked, it's in the middle of a timestep.
@@ -319,6 +391,39 @@ class World : public Object, public b2ContactListener, public b2ContactFilter, p
 	int rayCastAny(lua_State *L);
 	int rayCastClosest(lua_State *L);
 
+	/**
+	 * Casts many rays, given as packed x1, y1, x2, y2 floats in a Data or as
+	 * a flat Lua array, and writes a RayCastHit per ray to the output Data.
+	 * Returns the number of hits and the Shapes referenced by the hits. The
+	 * queries may run on the shared thread pool.
+	 **/
+	int rayCastBatch(lua_State *L);
+
+	/**
+	 * Queries many bounding boxes, given as packed x1, y1, x2, y2 floats, and
+	 * writes an AreaHit per overlapping Shape to the output Data in area order.
+	 * Returns the number of records written, the referenced Shapes, and the
+	 * total number of overlaps (which may not all have fit).
+	 **/
+	int getShapesInAreaBatch(lua_State *L);
+
+	/**
+	 * Saves the simulation state of every Body, Shape, Joint and Contact,
+	 * so that restoreState gives bit-identical future steps.
+	 * @param base A previous full state. If given, only the bytes that differ
+	 * from it are stored, and the same base must be passed to restoreState.
+	 **/
+	data::ByteData *saveState(Data *base);
+
+	/**
+	 * Restores a state from saveState. The World must have the same Bodies,
+	 * Shapes and Joints, created in the same order. Current Contacts are
+	 * invalidated and no contact callbacks are called.
+	 * @param state The full or delta state.
+	 * @param base The base the delta was saved against, or null.
+	 **/
+	void restoreState(Data *state, Data *base);
+
 	/**
 	 * Destroy this world.
 	 **/
@@ -346,6 +451,11 @@ class World : public Object, public b2ContactListener, public b2ContactFilter, p
 	ContactCallback begin, end, presolve, postsolve;
 	ContactFilter filter;
 
+	TaskExecutor executor;
+
+	// Scratch space for saveState and restoreState.
+	std::vector<char> stateBuffer;
+
 	std::unordered_map<void *, love::Object *> box2dObjectMap;
 
 }; // World
@@ -64,6 +64,30 @@ int w_newWorld(lua_State *L)
 	return 1;
 }
 
+int w_updateWorlds(lua_State *L)
+{
+	luaL_checktype(L, 1, LUA_TTABLE);
+	float dt = (float)luaL_checknumber(L, 2);
+	int velocityiterations = (int) luaL_optinteger(L, 3, 8);
+	int positioniterations = (int) luaL_optinteger(L, 4, 3);
+
+	std::vector<World *> worlds;
+	int count = (int) luax_objlen(L, 1);
+	for (int i = 1; i <= count; i++)
+	{
+		lua_rawgeti(L, 1, i);
+		World *world = luax_checkworld(L, -1);
+		lua_pop(L, 1);
+
+		// Make sure the world callbacks are using the calling Lua thread.
+		world->setCallbacksL(L);
+		worlds.push_back(world);
+	}
+
+	luax_catchexcept(L, [&](){ instance()->updateWorlds(worlds, dt, velocityiterations, positioniterations); });
+	return 0;
+}
+
 int w_newBody(lua_State *L)
 {
 	World *world = luax_checkworld(L, 1);
@@ -866,6 +890,7 @@ int w_computeAngularFrequency(lua_State *L)
 static const luaL_Reg functions[] =
 {
 	{ "newWorld", w_newWorld },
+	{ "updateWorlds", w_updateWorlds },
 	{ "newBody", w_newBody },
 	{ "newCircleBody", w_newCircleBody },
 	{ "newRectangleBody", w_newRectangleBody },
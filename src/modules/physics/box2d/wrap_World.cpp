@@ -19,6 +19,7 @@
  **/
 
 #include "wrap_World.h"
+#include "data/ByteData.h"
 
 namespace love
 {
@@ -123,6 +124,21 @@ int w_World_isSleepingAllowed(lua_State *L)
 	return 1;
 }
 
+int w_World_setThreadCount(lua_State *L)
+{
+	World *t = luax_checkworld(L, 1);
+	int count = (int) luaL_checkinteger(L, 2);
+	luax_catchexcept(L, [&](){ t->setThreadCount(count); });
+	return 0;
+}
+
+int w_World_getThreadCount(lua_State *L)
+{
+	World *t = luax_checkworld(L, 1);
+	lua_pushinteger(L, t->getThreadCount());
+	return 1;
+}
+
 int w_World_isLocked(lua_State *L)
 {
 	World *t = luax_checkworld(L, 1);
@@ -227,6 +243,44 @@ int w_World_rayCastClosest(lua_State *L)
 	return ret;
 }
 
+int w_World_rayCastBatch(lua_State *L)
+{
+	World *t = luax_checkworld(L, 1);
+	lua_remove(L, 1);
+	int ret = 0;
+	luax_catchexcept(L, [&]() { ret = t->rayCastBatch(L); });
+	return ret;
+}
+
+int w_World_getShapesInAreaBatch(lua_State *L)
+{
+	World *t = luax_checkworld(L, 1);
+	lua_remove(L, 1);
+	int ret = 0;
+	luax_catchexcept(L, [&]() { ret = t->getShapesInAreaBatch(L); });
+	return ret;
+}
+
+int w_World_saveState(lua_State *L)
+{
+	World *t = luax_checkworld(L, 1);
+	Data *base = lua_isnoneornil(L, 2) ? nullptr : luax_checktype<Data>(L, 2);
+	data::ByteData *d = nullptr;
+	luax_catchexcept(L, [&]() { d = t->saveState(base); });
+	luax_pushtype(L, d);
+	d->release();
+	return 1;
+}
+
+int w_World_restoreState(lua_State *L)
+{
+	World *t = luax_checkworld(L, 1);
+	Data *state = luax_checktype<Data>(L, 2);
+	Data *base = lua_isnoneornil(L, 3) ? nullptr : luax_checktype<Data>(L, 3);
+	luax_catchexcept(L, [&]() { t->restoreState(state, base); });
+	return 0;
+}
+
 int w_World_destroy(lua_State *L)
 {
 	World *t = luax_checkworld(L, 1);
@@ -253,6 +307,8 @@ static const luaL_Reg w_World_functions[] =
 	{ "translateOrigin", w_World_translateOrigin },
 	{ "setSleepingAllowed", w_World_setSleepingAllowed },
 	{ "isSleepingAllowed", w_World_isSleepingAllowed },
+	{ "setThreadCount", w_World_setThreadCount },
+	{ "getThreadCount", w_World_getThreadCount },
 	{ "isLocked", w_World_isLocked },
 	{ "getBodyCount", w_World_getBodyCount },
 	{ "getJointCount", w_World_getJointCount },
@@ -265,6 +321,10 @@ static const luaL_Reg w_World_functions[] =
 	{ "rayCast", w_World_rayCast },
 	{ "rayCastAny", w_World_rayCastAny },
 	{ "rayCastClosest", w_World_rayCastClosest },
+	{ "rayCastBatch", w_World_rayCastBatch },
+	{ "getShapesInAreaBatch", w_World_getShapesInAreaBatch },
+	{ "saveState", w_World_saveState },
+	{ "restoreState", w_World_restoreState },
 	{ "destroy", w_World_destroy },
 	{ "isDestroyed", w_World_isDestroyed },
 
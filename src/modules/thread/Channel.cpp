@@ -19,6 +19,7 @@
  **/
 
 #include "Channel.h"
+#include "common/profiler.h"
 
 #include <timer/Timer.h>
 
@@ -41,6 +42,7 @@ Channel::~Channel()
 
 uint64 Channel::push(const Variant &var)
 {
+	LOVE_PROFILE_ZONE("Channel::push");
 	Lock l(mutex);
 
 	queue.push(var);
@@ -98,6 +100,7 @@ bool Channel::pop(Variant *var)
 
 bool Channel::demand(Variant *var)
 {
+	LOVE_PROFILE_ZONE("Channel::demand");
 	Lock l(mutex);
 
 	while (!pop(var))
@@ -108,6 +111,7 @@ bool Channel::demand(Variant *var)
 
 bool Channel::demand(Variant *var, double timeout)
 {
+	LOVE_PROFILE_ZONE("Channel::demand");
 	Lock l(mutex);
 
 	while (timeout >= 0)
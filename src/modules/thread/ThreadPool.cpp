@@ -0,0 +1,227 @@
+/**
+ * Copyright (c) 2006-2024 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#include "ThreadPool.h"
+#include "common/Exception.h"
+
+// C++
+#include <algorithm>
+
+namespace love
+{
+namespace thread
+{
+
+ThreadPool::Worker::Worker(ThreadPool *pool, const std::string &name)
+	: pool(pool)
+{
+	threadName = name;
+}
+
+void ThreadPool::Worker::threadFunction()
+{
+	while (true)
+	{
+		Task task;
+
+		{
+			Lock lock(pool->mutex);
+
+			while (!pool->stopping && pool->tasks.empty())
+				pool->cond->wait(pool->mutex);
+
+			if (pool->stopping && pool->tasks.empty())
+				return;
+
+			task = std::move(pool->tasks.front());
+			pool->tasks.pop_front();
+		}
+
+		try
+		{
+			task();
+		}
+		catch (std::exception &)
+		{
+			// Tasks are responsible for reporting their own errors.
+		}
+	}
+}
+
+ThreadPool::ThreadPool(int threadcount, const char *name)
+	: stopping(false)
+{
+	threadcount = std::max(threadcount, 1);
+
+	for (int i = 0; i < threadcount; i++)
+	{
+		Worker *worker = new Worker(this, std::string(name) + std::to_string(i));
+		if (!worker->start())
+		{
+			worker->release();
+			continue;
+		}
+		workers.push_back(worker);
+	}
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		Lock lock(mutex);
+		stopping = true;
+		cond->broadcast();
+	}
+
+	for (Worker *worker : workers)
+	{
+		worker->wait();
+		worker->release();
+	}
+}
+
+void ThreadPool::enqueue(const Task &task)
+{
+	// Run it right away if we failed to start any threads.
+	if (workers.empty())
+	{
+		try
+		{
+			task();
+		}
+		catch (std::exception &)
+		{
+		}
+		return;
+	}
+
+	Lock lock(mutex);
+	tasks.push_back(task);
+	cond->signal();
+}
+
+bool ThreadPool::runQueuedTask()
+{
+	Task task;
+
+	{
+		Lock lock(mutex);
+		if (tasks.empty())
+			return false;
+
+		task = std::move(tasks.front());
+		tasks.pop_front();
+	}
+
+	try
+	{
+		task();
+	}
+	catch (std::exception &)
+	{
+	}
+
+	return true;
+}
+
+void ThreadPool::parallelFor(int count, const std::function<void(int)> &func)
+{
+	if (count <= 0)
+		return;
+
+	if (count == 1 || workers.empty())
+	{
+		for (int i = 0; i < count; i++)
+			func(i);
+		return;
+	}
+
+	MutexRef donemutex;
+	ConditionalRef donecond;
+	int remaining = count;
+	bool failed = false;
+	std::string error;
+
+	auto run = [&](int i)
+	{
+		try
+		{
+			func(i);
+		}
+		catch (std::exception &e)
+		{
+			Lock lock(donemutex);
+			if (!failed)
+			{
+				failed = true;
+				error = e.what();
+			}
+		}
+
+		Lock lock(donemutex);
+		if (--remaining == 0)
+			donecond->broadcast();
+	};
+
+	{
+		Lock lock(mutex);
+		for (int i = 1; i < count; i++)
+			tasks.push_back([&run, i]() { run(i); });
+		cond->broadcast();
+	}
+
+	// The calling thread does some of the work too, instead of just waiting.
+	// This also prevents deadlocks when parallelFor is called from a task.
+	run(0);
+	while (true)
+	{
+		{
+			Lock lock(donemutex);
+			if (remaining == 0)
+				break;
+		}
+
+		if (!runQueuedTask())
+			break;
+	}
+
+	{
+		Lock lock(donemutex);
+		while (remaining > 0)
+			donecond->wait(donemutex);
+	}
+
+	if (failed)
+		throw love::Exception("%s", error.c_str());
+}
+
+int ThreadPool::getThreadCount() const
+{
+	return (int) workers.size();
+}
+
+ThreadPool *ThreadPool::getShared()
+{
+	static ThreadPool pool(getProcessorCount() - 1, "LoveWorker");
+	return &pool;
+}
+
+} // thread
+} // love
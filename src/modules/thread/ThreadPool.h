@@ -0,0 +1,101 @@
+/**
+ * Copyright (c) 2006-2024 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#pragma once
+
+// LOVE
+#include "common/config.h"
+#include "threads.h"
+
+// C++
+#include <deque>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace love
+{
+namespace thread
+{
+
+/**
+ * A fixed set of worker threads which run tasks from a shared queue. Used by
+ * modules to spread CPU-heavy work (compression, hashing, encoding, etc.)
+ * across cores. Tasks must not call into Lua.
+ **/
+class ThreadPool
+{
+public:
+
+	typedef std::function<void()> Task;
+
+	ThreadPool(int threadcount, const char *name);
+	~ThreadPool();
+
+	/**
+	 * Queues a task to be run on one of the worker threads. Exceptions thrown
+	 * by the task are ignored, so the task should catch and store them itself.
+	 **/
+	void enqueue(const Task &task);
+
+	/**
+	 * Calls func(i) for every i in [0, count), spread over the worker threads
+	 * and the calling thread, and waits for all calls to finish. If any call
+	 * throws a love::Exception, the first one is rethrown afterwards.
+	 **/
+	void parallelFor(int count, const std::function<void(int)> &func);
+
+	int getThreadCount() const;
+
+	/**
+	 * Gets the thread pool shared by all modules. It's created the first time
+	 * it's used, with one thread per core except for the calling thread.
+	 **/
+	static ThreadPool *getShared();
+
+private:
+
+	class Worker : public Threadable
+	{
+	public:
+
+		Worker(ThreadPool *pool, const std::string &name);
+		void threadFunction() override;
+
+	private:
+
+		ThreadPool *pool;
+	};
+
+	// Runs a single queued task if there is one. Returns false otherwise.
+	bool runQueuedTask();
+
+	std::vector<Worker *> workers;
+	std::deque<Task> tasks;
+
+	MutexRef mutex;
+	ConditionalRef cond;
+
+	bool stopping;
+
+}; // ThreadPool
+
+} // thread
+} // love
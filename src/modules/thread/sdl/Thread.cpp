@@ -19,6 +19,7 @@
  **/
 
 #include "Thread.h"
+#include "common/profiler.h"
 
 namespace love
 {
@@ -92,6 +93,9 @@ int Thread::thread_runner(void *data)
 {
 	Thread *self = (Thread *) data; // some compilers don't like 'this'
 
+	if (self->t->getThreadName() != nullptr)
+		love::profiler::setThreadName(self->t->getThreadName());
+
 	self->t->threadFunction();
 
 	{
@@ -21,6 +21,8 @@
 #include "threads.h"
 #include "Thread.h"
 
+#include <SDL_cpuinfo.h>
+
 namespace love
 {
 namespace thread
@@ -125,5 +127,11 @@ thread::Thread *newThread(Threadable *t)
 	return new sdl::Thread(t);
 }
 
+int getProcessorCount()
+{
+	int count = SDL_GetCPUCount();
+	return count > 0 ? count : 1;
+}
+
 } // thread
 } // love
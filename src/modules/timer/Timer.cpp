@@ -22,6 +22,7 @@
 #include "common/config.h"
 #include "common/int.h"
 #include "common/delay.h"
+#include "common/profiler.h"
 #include "Timer.h"
 
 #include <iostream>
@@ -57,6 +58,8 @@ Timer::Timer()
 
 double Timer::step()
 {
+	profiler::markFrame();
+
 	// Frames rendered
 	frames++;
 
@@ -22,6 +22,7 @@
 
 // LOVE
 #include "wrap_Timer.h"
+#include "common/profiler.h"
 
 namespace love
 {
@@ -66,6 +67,88 @@ int w_getTime(lua_State *L)
 	return 1;
 }
 
+int w_setProfilerEnabled(lua_State *L)
+{
+	profiler::setEnabled(luax_checkboolean(L, 1));
+	return 0;
+}
+
+int w_isProfilerEnabled(lua_State *L)
+{
+	luax_pushboolean(L, profiler::isEnabled());
+	return 1;
+}
+
+int w_getProfilerFrames(lua_State *L)
+{
+	int count = (int) luaL_optinteger(L, 1, 1);
+
+	std::vector<profiler::Frame> frames = profiler::getFrames(count);
+
+	std::vector<profiler::ThreadInfo> threads = profiler::getThreads();
+	auto getThreadName = [&](uint32 id) -> const char *
+	{
+		for (const auto &info : threads)
+		{
+			if (info.id == id)
+				return info.name.c_str();
+		}
+		return "";
+	};
+
+	lua_createtable(L, (int) frames.size(), 0);
+	for (size_t i = 0; i < frames.size(); i++)
+	{
+		const profiler::Frame &frame = frames[i];
+
+		lua_createtable(L, 0, 4);
+
+		lua_pushnumber(L, (lua_Number) frame.index);
+		lua_setfield(L, -2, "index");
+		lua_pushnumber(L, frame.start / 1e9);
+		lua_setfield(L, -2, "start");
+		lua_pushnumber(L, (frame.end - frame.start) / 1e9);
+		lua_setfield(L, -2, "duration");
+
+		lua_createtable(L, (int) frame.zones.size(), 0);
+		for (size_t j = 0; j < frame.zones.size(); j++)
+		{
+			const profiler::Zone &zone = frame.zones[j];
+
+			lua_createtable(L, 0, 5);
+
+			lua_pushstring(L, zone.name);
+			lua_setfield(L, -2, "name");
+			lua_pushstring(L, getThreadName(zone.thread));
+			lua_setfield(L, -2, "thread");
+			lua_pushnumber(L, zone.start / 1e9);
+			lua_setfield(L, -2, "start");
+			lua_pushnumber(L, (zone.end - zone.start) / 1e9);
+			lua_setfield(L, -2, "duration");
+			lua_pushinteger(L, zone.depth);
+			lua_setfield(L, -2, "depth");
+
+			lua_rawseti(L, -2, (int) j + 1);
+		}
+		lua_setfield(L, -2, "zones");
+
+		lua_rawseti(L, -2, (int) i + 1);
+	}
+
+	return 1;
+}
+
+int w_getProfilerTrace(lua_State *L)
+{
+	int count = (int) luaL_optinteger(L, 1, INT32_MAX);
+
+	std::string trace;
+	luax_catchexcept(L, [&]() { trace = profiler::getChromeTrace(profiler::getFrames(count)); });
+
+	lua_pushlstring(L, trace.data(), trace.size());
+	return 1;
+}
+
 // List of functions to wrap.
 static const luaL_Reg functions[] =
 {
@@ -75,6 +158,10 @@ static const luaL_Reg functions[] =
 	{ "getAverageDelta", w_getAverageDelta },
 	{ "sleep", w_sleep },
 	{ "getTime", w_getTime },
+	{ "setProfilerEnabled", w_setProfilerEnabled },
+	{ "isProfilerEnabled", w_isProfilerEnabled },
+	{ "getProfilerFrames", w_getProfilerFrames },
+	{ "getProfilerTrace", w_getProfilerTrace },
 	{ 0, 0 }
 };
 
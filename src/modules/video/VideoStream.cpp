@@ -19,6 +19,7 @@
  **/
 
 #include "VideoStream.h"
+#include "timer/Timer.h"
 
 using love::thread::Lock;
 
@@ -95,6 +96,7 @@ double VideoStream::FrameSync::tell() const
 VideoStream::DeltaSync::DeltaSync()
 	: playing(false)
 	, position(0)
+	, playStart(0)
 	, speed(1)
 {
 }
@@ -104,31 +106,38 @@ VideoStream::DeltaSync::~DeltaSync()
 }
 
 double VideoStream::DeltaSync::getPosition() const
-{
-	return position;
-}
-
-void VideoStream::DeltaSync::update(double dt)
 {
 	Lock l(mutex);
 	if (playing)
-		position += dt*speed;
+		return position + (love::timer::Timer::getTime() - playStart) * speed;
+	return position;
 }
 
 void VideoStream::DeltaSync::play()
 {
-	playing = true;
+	Lock l(mutex);
+	if (!playing)
+	{
+		playStart = love::timer::Timer::getTime();
+		playing = true;
+	}
 }
 
 void VideoStream::DeltaSync::pause()
 {
-	playing = false;
+	Lock l(mutex);
+	if (playing)
+	{
+		position += (love::timer::Timer::getTime() - playStart) * speed;
+		playing = false;
+	}
 }
 
 void VideoStream::DeltaSync::seek(double time)
 {
 	Lock l(mutex);
 	position = time;
+	playStart = love::timer::Timer::getTime();
 }
 
 bool VideoStream::DeltaSync::isPlaying() const
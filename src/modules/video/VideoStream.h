@@ -65,6 +65,13 @@ class VideoStream : public love::Object
 	virtual int getHeight() const = 0;
 	virtual const std::string &getFilename() const = 0;
 
+	/**
+	 * Sets the maximum number of frames which may be decoded ahead of the
+	 * current playback position.
+	 **/
+	virtual void setDecodeAheadFrames(int /*count*/) {}
+	virtual int getDecodeAheadFrames() const { return 1; }
+
 	// Playback api
 	virtual void play();
 	virtual void pause();
@@ -97,7 +104,6 @@ class VideoStream : public love::Object
 	{
 	public:
 		virtual double getPosition() const = 0;
-		virtual void update(double /*dt*/) {}
 		virtual ~FrameSync() {}
 
 		void copyState(const FrameSync *other);
@@ -117,7 +123,6 @@ class VideoStream : public love::Object
 		~DeltaSync();
 
 		virtual double getPosition() const override;
-		virtual void update(double dt) override;
 
 		virtual void play() override;
 		virtual void pause() override;
@@ -125,8 +130,11 @@ class VideoStream : public love::Object
 		virtual bool isPlaying() const override;
 
 	private:
+		// The position is advanced from the wall clock, so nothing has to
+		// update it while the video plays.
 		bool playing;
 		double position;
+		double playStart;
 		double speed;
 		love::thread::MutexRef mutex;
 	};
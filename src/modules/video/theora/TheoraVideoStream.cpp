@@ -23,6 +23,7 @@
 
 // LOVE
 #include "TheoraVideoStream.h"
+#include "Video.h"
 
 using love::filesystem::File;
 
@@ -37,7 +38,12 @@ TheoraVideoStream::TheoraVideoStream(love::filesystem::File *file)
 	: demuxer(file)
 	, headerParsed(false)
 	, decoder(nullptr)
-	, frameReady(false)
+	, frontBuffer(nullptr)
+	, frontBufferStart(0)
+	, frameCount(0)
+	, decodeAheadFrames(DEFAULT_DECODE_AHEAD_FRAMES)
+	, worker(nullptr)
+	, frameDecoded(false)
 	, lastFrame(0)
 	, nextFrame(0)
 {
@@ -46,21 +52,25 @@ TheoraVideoStream::TheoraVideoStream(love::filesystem::File *file)
 
 	th_info_init(&videoInfo);
 
-	frontBuffer = new Frame();
-	backBuffer = new Frame();
-
 	try
 	{
 		parseHeader();
 	}
 	catch (love::Exception &ex)
 	{
-		delete backBuffer;
-		delete frontBuffer;
 		th_info_clear(&videoInfo);
 		throw ex;
 	}
 
+	frontBuffer = newFrame();
+	frameCount = 1;
+
+	for (int i = 0; i < decodeAheadFrames; i++)
+	{
+		freeFrames.push_back(newFrame());
+		frameCount++;
+	}
+
 	frameSync.set(new DeltaSync(), Acquire::NORETAIN);
 }
 
@@ -72,7 +82,12 @@ TheoraVideoStream::~TheoraVideoStream()
 	th_info_clear(&videoInfo);
 
 	delete frontBuffer;
-	delete backBuffer;
+
+	for (const DecodedFrame &decoded : decodedFrames)
+		delete decoded.frame;
+
+	for (Frame *frame : freeFrames)
+		delete frame;
 }
 
 int TheoraVideoStream::getWidth() const
@@ -100,6 +115,20 @@ void TheoraVideoStream::setSync(FrameSync *frameSync)
 {
 	love::thread::Lock l(bufferMutex);
 	this->frameSync = frameSync;
+	wakeWorker();
+}
+
+void TheoraVideoStream::setWorker(Worker *worker)
+{
+	love::thread::Lock l(bufferMutex);
+	this->worker = worker;
+}
+
+void TheoraVideoStream::wakeWorker()
+{
+	// Must be called with bufferMutex locked.
+	if (worker != nullptr)
+		worker->wake();
 }
 
 const void *TheoraVideoStream::getFrontBuffer() const
@@ -114,7 +143,45 @@ size_t TheoraVideoStream::getSize() const
 
 bool TheoraVideoStream::isPlaying() const
 {
-	return frameSync->isPlaying() && !demuxer.isEos();
+	if (!frameSync->isPlaying())
+		return false;
+
+	// Frames decoded ahead of time can still be displayed after the demuxer
+	// reaches the end of the stream.
+	love::thread::Lock l(bufferMutex);
+	return !demuxer.isEos() || !decodedFrames.empty();
+}
+
+void TheoraVideoStream::setDecodeAheadFrames(int count)
+{
+	if (count < 1)
+		throw love::Exception("The number of decoded frames must be at least 1.");
+
+	love::thread::Lock l(bufferMutex);
+
+	decodeAheadFrames = count;
+
+	while (frameCount < decodeAheadFrames + 1)
+	{
+		freeFrames.push_back(newFrame());
+		frameCount++;
+	}
+
+	// Frames which are in use are deleted when they're recycled.
+	while (frameCount > decodeAheadFrames + 1 && !freeFrames.empty())
+	{
+		delete freeFrames.back();
+		freeFrames.pop_back();
+		frameCount--;
+	}
+
+	wakeWorker();
+}
+
+int TheoraVideoStream::getDecodeAheadFrames() const
+{
+	love::thread::Lock l(bufferMutex);
+	return decodeAheadFrames;
 }
 
 template<typename T>
@@ -162,31 +229,67 @@ void TheoraVideoStream::parseHeader()
 	decoder = th_decode_alloc(&videoInfo, setupInfo);
 	th_setup_free(setupInfo);
 
-	Frame *buffers[2] = {backBuffer, frontBuffer};
-
 	yPlaneXOffset = cPlaneXOffset = videoInfo.pic_x;
 	yPlaneYOffset = cPlaneYOffset = videoInfo.pic_y;
 
 	scaleFormat(videoInfo.pixel_fmt, cPlaneXOffset, cPlaneYOffset);
 
-	for (int i = 0; i < 2; i++)
+	headerParsed = true;
+
+	// The packet which ended the headers is the first frame.
+	ogg_int64_t decoderPosition;
+	if (th_decode_packetin(decoder, &packet, &decoderPosition) == 0)
 	{
-		buffers[i]->cw = buffers[i]->yw = videoInfo.pic_width;
-		buffers[i]->ch = buffers[i]->yh = videoInfo.pic_height;
+		lastFrame = 0;
+		nextFrame = th_granule_time(decoder, decoderPosition);
+		frameDecoded = true;
+	}
+}
 
-		scaleFormat(videoInfo.pixel_fmt, buffers[i]->cw, buffers[i]->ch);
+VideoStream::Frame *TheoraVideoStream::newFrame() const
+{
+	Frame *frame = new Frame();
 
-		buffers[i]->yplane = new unsigned char[buffers[i]->yw * buffers[i]->yh];
-		buffers[i]->cbplane = new unsigned char[buffers[i]->cw * buffers[i]->ch];
-		buffers[i]->crplane = new unsigned char[buffers[i]->cw * buffers[i]->ch];
+	frame->cw = frame->yw = videoInfo.pic_width;
+	frame->ch = frame->yh = videoInfo.pic_height;
 
-		memset(buffers[i]->yplane, 16, buffers[i]->yw * buffers[i]->yh);
-		memset(buffers[i]->cbplane, 128, buffers[i]->cw * buffers[i]->ch);
-		memset(buffers[i]->crplane, 128, buffers[i]->cw * buffers[i]->ch);
+	scaleFormat(videoInfo.pixel_fmt, frame->cw, frame->ch);
+
+	frame->yplane = new unsigned char[frame->yw * frame->yh];
+	frame->cbplane = new unsigned char[frame->cw * frame->ch];
+	frame->crplane = new unsigned char[frame->cw * frame->ch];
+
+	memset(frame->yplane, 16, frame->yw * frame->yh);
+	memset(frame->cbplane, 128, frame->cw * frame->ch);
+	memset(frame->crplane, 128, frame->cw * frame->ch);
+
+	return frame;
+}
+
+void TheoraVideoStream::recycleFrame(Frame *frame)
+{
+	// Must be called with bufferMutex locked.
+	if (frameCount > decodeAheadFrames + 1)
+	{
+		delete frame;
+		frameCount--;
 	}
+	else
+		freeFrames.push_back(frame);
+}
 
-	headerParsed = true;
-	th_decode_packetin(decoder, &packet, nullptr);
+void TheoraVideoStream::flushDecodedFrames()
+{
+	love::thread::Lock l(bufferMutex);
+
+	for (const DecodedFrame &decoded : decodedFrames)
+		recycleFrame(decoded.frame);
+
+	decodedFrames.clear();
+
+	// The front buffer is now from an unrelated part of the video, so any
+	// position is fine until a new frame replaces it.
+	frontBufferStart = -1.0;
 }
 
 void TheoraVideoStream::seekDecoder(double target)
@@ -200,89 +303,126 @@ void TheoraVideoStream::seekDecoder(double target)
 
 	// Now update theora and our decoder on this new position of ours
 	lastFrame = nextFrame = -1;
+	frameDecoded = false;
 	th_decode_ctl(decoder, TH_DECCTL_SET_GRANPOS, &packet.granulepos, sizeof(packet.granulepos));
+
+	flushDecodedFrames();
 }
 
-void TheoraVideoStream::threadedFillBackBuffer(double dt)
+bool TheoraVideoStream::decodeNextFrame()
 {
-	// Synchronize
-	frameSync->update(dt);
-	double position = frameSync->getPosition();
+	ogg_int64_t decoderPosition;
+	do
+	{
+		if (demuxer.readPacket(packet))
+			return false;
 
-	// Seeking backwards
-	if (position < lastFrame)
-		seekDecoder(position);
+		if (packet.granulepos > 0)
+			th_decode_ctl(decoder, TH_DECCTL_SET_GRANPOS, &packet.granulepos, sizeof(packet.granulepos));
+	} while (th_decode_packetin(decoder, &packet, &decoderPosition) != 0);
 
-	th_ycbcr_buffer bufferinfo;
-	bool hasFrame = false;
+	lastFrame = nextFrame;
+	nextFrame = th_granule_time(decoder, decoderPosition);
+	frameDecoded = true;
+	return true;
+}
 
-	// Until we are at the end of the stream, or we are displaying the right frame
-	unsigned int framesBehind = 0;
-	bool failedSeek = false;
-	while (!demuxer.isEos() && position >= nextFrame)
+void TheoraVideoStream::copyFrame(th_ycbcr_buffer bufferinfo, Frame *frame) const
+{
+	for (int y = 0; y < frame->yh; ++y)
 	{
-		// If we can't catch up, seek
-		if (framesBehind++ > 5 && !failedSeek)
-		{
-			seekDecoder(position);
-			framesBehind = 0;
-			failedSeek = true;
-		}
+		memcpy(frame->yplane+frame->yw*y,
+				bufferinfo[0].data+
+					bufferinfo[0].stride*(y+yPlaneYOffset)+yPlaneXOffset,
+				frame->yw);
+	}
 
-		th_decode_ycbcr_out(decoder, bufferinfo);
-		hasFrame = true;
+	for (int y = 0; y < frame->ch; ++y)
+	{
+		memcpy(frame->cbplane+frame->cw*y,
+				bufferinfo[1].data+
+					bufferinfo[1].stride*(y+cPlaneYOffset)+cPlaneXOffset,
+				frame->cw);
+	}
 
-		ogg_int64_t decoderPosition;
-		do
-		{
-			if (demuxer.readPacket(packet))
-				return;
+	for (int y = 0; y < frame->ch; ++y)
+	{
+		memcpy(frame->crplane+frame->cw*y,
+				bufferinfo[2].data+
+					bufferinfo[2].stride*(y+cPlaneYOffset)+cPlaneXOffset,
+				frame->cw);
+	}
+}
 
-			if (packet.granulepos > 0)
-				th_decode_ctl(decoder, TH_DECCTL_SET_GRANPOS, &packet.granulepos, sizeof(packet.granulepos));
-		} while (th_decode_packetin(decoder, &packet, &decoderPosition) != 0);
+void TheoraVideoStream::threadedFillBackBuffer()
+{
+	double position = frameSync->getPosition();
 
-		lastFrame = nextFrame;
-		nextFrame = th_granule_time(decoder, decoderPosition);
-	}
+	bool seekBackwards = false;
 
-	// Only swap once, even if we read many frames to get here
-	if (hasFrame)
 	{
-		// Don't swap whilst we're writing to the backbuffer
-		{
-			love::thread::Lock l(bufferMutex);
-			frameReady = false;
-		}
+		love::thread::Lock l(bufferMutex);
+
+		// Seeking backwards past everything we have decoded. Seeking within
+		// the decoded frames keeps them.
+		seekBackwards = position < frontBufferStart
+			&& (decodedFrames.empty() || position < decodedFrames.front().start);
 
-		for (int y = 0; y < backBuffer->yh; ++y)
+		// Frames which expired before they could be displayed make room for
+		// new ones, but keep the most recent one around in case we can't
+		// decode anything newer in time.
+		while (decodedFrames.size() > 1 && decodedFrames.front().end <= position)
 		{
-			memcpy(backBuffer->yplane+backBuffer->yw*y,
-					bufferinfo[0].data+
-						bufferinfo[0].stride*(y+yPlaneYOffset)+yPlaneXOffset,
-					backBuffer->yw);
+			recycleFrame(decodedFrames.front().frame);
+			decodedFrames.pop_front();
 		}
+	}
 
-		for (int y = 0; y < backBuffer->ch; ++y)
+	if (seekBackwards)
+		seekDecoder(position);
+
+	// Decode ahead until we run out of free frames, or the stream ends.
+	unsigned int framesBehind = 0;
+	bool failedSeek = false;
+	while (frameDecoded || decodeNextFrame())
+	{
+		// The decoded frame has already expired, don't bother copying it.
+		if (nextFrame <= position)
 		{
-			memcpy(backBuffer->cbplane+backBuffer->cw*y,
-					bufferinfo[1].data+
-						bufferinfo[1].stride*(y+cPlaneYOffset)+cPlaneXOffset,
-					backBuffer->cw);
+			frameDecoded = false;
+
+			// If we can't catch up, seek
+			if (framesBehind++ > 5 && !failedSeek)
+			{
+				seekDecoder(position);
+				framesBehind = 0;
+				failedSeek = true;
+			}
+
+			continue;
 		}
 
-		for (int y = 0; y < backBuffer->ch; ++y)
+		Frame *frame = nullptr;
+
 		{
-			memcpy(backBuffer->crplane+backBuffer->cw*y,
-					bufferinfo[2].data+
-						bufferinfo[2].stride*(y+cPlaneYOffset)+cPlaneXOffset,
-					backBuffer->cw);
+			love::thread::Lock l(bufferMutex);
+
+			if (freeFrames.empty())
+				break;
+
+			frame = freeFrames.back();
+			freeFrames.pop_back();
 		}
 
-		// Re-enable swapping
+		// The frame is only accessible to this thread until it's queued.
+		th_ycbcr_buffer bufferinfo;
+		th_decode_ycbcr_out(decoder, bufferinfo);
+		copyFrame(bufferinfo, frame);
+		frameDecoded = false;
+
 		{
 			love::thread::Lock l(bufferMutex);
-			frameReady = true;
+			decodedFrames.push_back({frame, lastFrame, nextFrame});
 		}
 	}
 }
@@ -294,20 +434,41 @@ void TheoraVideoStream::fillBackBuffer()
 
 bool TheoraVideoStream::swapBuffers()
 {
-	if (demuxer.isEos())
-		return false;
-
 	if (!frameSync->isPlaying())
 		return false;
 
+	double position = frameSync->getPosition();
+
 	love::thread::Lock l(bufferMutex);
-	if (!frameReady)
+
+	// Find the most recent decoded frame which should be visible by now.
+	// Older ones are skipped.
+	Frame *frame = nullptr;
+	double start = 0.0;
+	while (!decodedFrames.empty() && decodedFrames.front().start <= position)
+	{
+		if (frame != nullptr)
+			recycleFrame(frame);
+
+		frame = decodedFrames.front().frame;
+		start = decodedFrames.front().start;
+		decodedFrames.pop_front();
+	}
+
+	// The worker only decodes when it's woken up: when frames were freed,
+	// when it has fallen behind, or after a seek backwards.
+	bool seekBackwards = position < frontBufferStart
+		&& (decodedFrames.empty() || position < decodedFrames.front().start);
+
+	if (frame != nullptr || decodedFrames.empty() || seekBackwards)
+		wakeWorker();
+
+	if (frame == nullptr)
 		return false;
-	frameReady = false;
 
-	Frame *temp = frontBuffer;
-	frontBuffer = backBuffer;
-	backBuffer = temp;
+	recycleFrame(frontBuffer);
+	frontBuffer = frame;
+	frontBufferStart = start;
 
 	return true;
 }
@@ -29,6 +29,10 @@
 #include "thread/threads.h"
 #include "OggDemuxer.h"
 
+// STL
+#include <deque>
+#include <vector>
+
 // OGG/Theora
 #include <ogg/ogg.h>
 #include <theora/codec.h>
@@ -41,6 +45,8 @@ namespace video
 namespace theora
 {
 
+class Worker;
+
 class TheoraVideoStream : public love::video::VideoStream
 {
 public:
@@ -59,9 +65,25 @@ class TheoraVideoStream : public love::video::VideoStream
 
 	bool isPlaying() const;
 
-	void threadedFillBackBuffer(double dt);
+	void setDecodeAheadFrames(int count) override;
+	int getDecodeAheadFrames() const override;
+
+	void threadedFillBackBuffer();
+
+	// Sets the worker which is woken up when this stream needs new frames.
+	void setWorker(Worker *worker);
+
+	static const int DEFAULT_DECODE_AHEAD_FRAMES = 3;
 
 private:
+
+	struct DecodedFrame
+	{
+		Frame *frame;
+		double start;
+		double end;
+	};
+
 	OggDemuxer demuxer;
 
 	bool headerParsed;
@@ -72,20 +94,42 @@ class TheoraVideoStream : public love::video::VideoStream
 	th_dec_ctx *decoder;
 
 	Frame *frontBuffer;
-	Frame *backBuffer;
+	double frontBufferStart;
+
+	// Frames which have been decoded but not displayed yet, in display order.
+	std::deque<DecodedFrame> decodedFrames;
+
+	// Frames which can be decoded into.
+	std::vector<Frame *> freeFrames;
+
+	// The total number of allocated frames, including the front buffer.
+	int frameCount;
+	int decodeAheadFrames;
+
 	unsigned int yPlaneXOffset;
 	unsigned int cPlaneXOffset;
 	unsigned int yPlaneYOffset;
 	unsigned int cPlaneYOffset;
 
 	love::thread::MutexRef bufferMutex;
-	bool frameReady;
 
+	// Guarded by bufferMutex.
+	Worker *worker;
+
+	// Whether the decoder holds a frame which hasn't been queued yet, and the
+	// time range it should be displayed in.
+	bool frameDecoded;
 	double lastFrame;
 	double nextFrame;
 
 	void parseHeader();
+	Frame *newFrame() const;
+	void recycleFrame(Frame *frame);
+	void flushDecodedFrames();
+	bool decodeNextFrame();
+	void copyFrame(th_ycbcr_buffer bufferinfo, Frame *frame) const;
 	void seekDecoder(double target);
+	void wakeWorker();
 }; // TheoraVideoStream
 
 } // theora
@@ -19,12 +19,11 @@
  **/
 
 // STL
+#include <algorithm>
 #include <vector>
 
 // LOVE
 #include "Video.h"
-#include "common/delay.h"
-#include "timer/Timer.h"
 
 namespace love
 {
@@ -36,24 +35,52 @@ namespace theora
 Video::Video()
 	: love::video::Video("love.video.theora")
 {
-	workerThread = new Worker();
-	workerThread->start();
+	// Leave a core for the main thread.
+	int cores = love::thread::getProcessorCount();
+	maxWorkers = std::max(1, std::min(cores - 1, MAX_WORKERS));
 }
 
 Video::~Video()
 {
-	delete workerThread;
+	for (Worker *worker : workers)
+		delete worker;
 }
 
 VideoStream *Video::newVideoStream(love::filesystem::File *file)
 {
 	TheoraVideoStream *stream = new TheoraVideoStream(file);
-	workerThread->addStream(stream);
+
+	love::thread::Lock l(workersMutex);
+
+	// Each stream is decoded by a single worker. Pick the least busy one, or
+	// start a new worker if all of them are busy and we still can.
+	Worker *target = nullptr;
+	int targetcount = 0;
+
+	for (Worker *worker : workers)
+	{
+		int count = worker->getStreamCount();
+		if (target == nullptr || count < targetcount)
+		{
+			target = worker;
+			targetcount = count;
+		}
+	}
+
+	if (target == nullptr || (targetcount > 0 && (int) workers.size() < maxWorkers))
+	{
+		target = new Worker();
+		target->start();
+		workers.push_back(target);
+	}
+
+	target->addStream(stream);
 	return stream;
 }
 
 Worker::Worker()
 	: stopping(false)
+	, woken(false)
 {
 	threadName = "VideoWorker";
 }
@@ -65,9 +92,21 @@ Worker::~Worker()
 
 void Worker::addStream(TheoraVideoStream *stream)
 {
+	// Streams lock their own mutex before waking the worker, so they're set
+	// up before this worker's mutex is locked.
+	stream->setWorker(this);
+
 	love::thread::Lock l(mutex);
 	streams.push_back(stream);
-	cond->broadcast();
+	woken = true;
+	cond->signal();
+}
+
+int Worker::getStreamCount()
+{
+	love::thread::Lock l(mutex);
+	removeReleasedStreams();
+	return (int) streams.size();
 }
 
 void Worker::stop()
@@ -75,47 +114,60 @@ void Worker::stop()
 	{
 		love::thread::Lock l(mutex);
 		stopping = true;
-		cond->broadcast();
+		cond->signal();
 	}
 
 	owner->wait();
+
+	for (TheoraVideoStream *stream : streams)
+		stream->setWorker(nullptr);
 }
 
-void Worker::threadFunction()
+void Worker::wake()
 {
-	double lastFrame = love::timer::Timer::getTime();
+	love::thread::Lock l(mutex);
+	woken = true;
+	cond->signal();
+}
 
-	while (true)
+void Worker::removeReleasedStreams()
+{
+	// Streams are only decoded through a copy of the list made under the
+	// mutex, so one that only the list references isn't in use.
+	auto released = [](const StrongRef<TheoraVideoStream> &stream)
 	{
-		love::sleep(2);
+		return stream->getReferenceCount() == 1;
+	};
 
-		love::thread::Lock l(mutex);
+	streams.erase(std::remove_if(streams.begin(), streams.end(), released), streams.end());
+}
+
+void Worker::threadFunction()
+{
+	std::vector<StrongRef<TheoraVideoStream>> pending;
 
-		while (!stopping && streams.empty())
+	while (true)
+	{
 		{
-			cond->wait(mutex);
-			lastFrame = love::timer::Timer::getTime();
-		}
+			love::thread::Lock l(mutex);
 
-		if (stopping)
-			return;
+			while (!stopping && !woken)
+				cond->wait(mutex);
 
-		double curFrame = love::timer::Timer::getTime();
-		double dt = curFrame-lastFrame;
-		lastFrame = curFrame;
+			if (stopping)
+				return;
 
-		for (auto it = streams.begin(); it != streams.end(); ++it)
-		{
-			TheoraVideoStream *stream = *it;
-			if (stream->getReferenceCount() == 1)
-			{
-				// We're the only ones left
-				streams.erase(it);
-				break;
-			}
-
-			stream->threadedFillBackBuffer(dt);
+			woken = false;
+			removeReleasedStreams();
+			pending = streams;
 		}
+
+		// Decoding can take a while, so it's done without holding the mutex.
+		// Streams synchronize with the main thread on their own.
+		for (TheoraVideoStream *stream : pending)
+			stream->threadedFillBackBuffer();
+
+		pending.clear();
 	}
 }
 
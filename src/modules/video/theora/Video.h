@@ -49,7 +49,15 @@ class Video : public love::video::Video
 	VideoStream *newVideoStream(love::filesystem::File* file);
 
 private:
-	Worker *workerThread;
+
+	// Upper limit for the number of decoder threads, regardless of core count.
+	static const int MAX_WORKERS = 8;
+
+	// Worker threads are started on demand, up to maxWorkers.
+	std::vector<Worker *> workers;
+	int maxWorkers;
+
+	love::thread::MutexRef workersMutex;
 }; // Video
 
 class Worker : public love::thread::Threadable
@@ -62,17 +70,27 @@ class Worker : public love::thread::Threadable
 	void threadFunction();
 
 	void addStream(TheoraVideoStream *stream);
+	int getStreamCount();
 	// Frees itself!
 	void stop();
 
+	// Makes the worker go over its streams once more. Called by streams when
+	// they need new frames.
+	void wake();
+
 private:
 
+	// Drops streams which only this worker still references. Must be called
+	// with mutex locked.
+	void removeReleasedStreams();
+
 	std::vector<StrongRef<TheoraVideoStream>> streams;
 
 	love::thread::MutexRef mutex;
 	love::thread::ConditionalRef cond;
 
 	bool stopping;
+	bool woken;
 }; // Worker
 
 } // theora
@@ -109,6 +109,23 @@ int w_VideoStream_isPlaying(lua_State *L)
 	return 1;
 }
 
+int w_VideoStream_setDecodeAheadFrames(lua_State *L)
+{
+	auto stream = luax_checkvideostream(L, 1);
+	int count = (int) luaL_checkinteger(L, 2);
+	if (count < 1)
+		return luaL_error(L, "The number of decoded frames must be at least 1.");
+	luax_catchexcept(L, [&]() { stream->setDecodeAheadFrames(count); });
+	return 0;
+}
+
+int w_VideoStream_getDecodeAheadFrames(lua_State *L)
+{
+	auto stream = luax_checkvideostream(L, 1);
+	lua_pushinteger(L, stream->getDecodeAheadFrames());
+	return 1;
+}
+
 static const luaL_Reg videostream_functions[] =
 {
 	{ "setSync", w_VideoStream_setSync },
@@ -119,6 +136,8 @@ static const luaL_Reg videostream_functions[] =
 	{ "rewind", w_VideoStream_rewind },
 	{ "tell", w_VideoStream_tell },
 	{ "isPlaying", w_VideoStream_isPlaying },
+	{ "setDecodeAheadFrames", w_VideoStream_setDecodeAheadFrames },
+	{ "getDecodeAheadFrames", w_VideoStream_getDecodeAheadFrames },
 	{ 0, 0 }
 };
 
@@ -0,0 +1,116 @@
+-- Physics benchmarks.
+-- Steps 50 pyramids of 100 boxes each, resting on one static ground, with
+-- different World:setThreadCount values and prints the average step time.
+-- Then times World:getBodies on 100k bodies, both the first call, which
+-- creates a Lua object for every Body, and later calls, which reuse them.
+-- Run with: love testing/benchmarks/physics [step] [getbodies]
+
+local PYRAMIDS = 50
+local BOXES = 100
+local SIZE = 16
+local WARMUP_STEPS = 60
+local STEPS = 300
+local GETBODIES_BODIES = 100000
+local GETBODIES_CALLS = 20
+
+local function build()
+  local world = love.physics.newWorld(0, 9.81*64, true)
+  local ground = love.physics.newBody(world, 0, 0, 'static')
+  love.physics.newEdgeShape(ground, -1000, 0, PYRAMIDS*20*SIZE + 1000, 0)
+
+  for p=0,PYRAMIDS-1 do
+    local count, row, width = 0, 0, 14
+    while count < BOXES do
+      for col=0,width-1 do
+        if count == BOXES then break end
+        local x = p*20*SIZE + (col + row*0.5)*(SIZE + 1)
+        local y = -SIZE*0.5 - row*(SIZE + 0.5)
+        local body = love.physics.newBody(world, x, y, 'dynamic')
+        love.physics.newRectangleShape(body, SIZE, SIZE)
+        count = count + 1
+      end
+      row, width = row + 1, width - 1
+    end
+  end
+
+  return world
+end
+
+local function run(threads)
+  local world = build()
+  world:setThreadCount(threads)
+
+  -- let the pyramids settle into resting contact first
+  for i=1,WARMUP_STEPS do
+    world:update(1/60)
+  end
+
+  local start = love.timer.getTime()
+  for i=1,STEPS do
+    world:update(1/60)
+  end
+  local elapsed = love.timer.getTime() - start
+
+  local contacts = world:getContactCount()
+  world:destroy()
+  return elapsed / STEPS * 1000, contacts
+end
+
+local function benchmarkGetBodies()
+  local world = love.physics.newWorld(0, 0, false)
+  for i=1,GETBODIES_BODIES do
+    love.physics.newBody(world, i, 0, 'static')
+  end
+
+  -- the first call goes through the path which creates the Lua objects
+  collectgarbage()
+  local start = love.timer.getTime()
+  local bodies = world:getBodies()
+  local first = love.timer.getTime() - start
+
+  -- later calls find the existing objects while they're still referenced
+  start = love.timer.getTime()
+  for i=1,GETBODIES_CALLS do
+    world:getBodies()
+  end
+  local cached = (love.timer.getTime() - start) / GETBODIES_CALLS
+
+  print(string.format('getBodies %d bodies: first %7.3f ms, cached %7.3f ms (%.2fx)',
+    #bodies, first * 1000, cached * 1000, first / cached))
+
+  bodies = nil
+  world:destroy()
+end
+
+local function benchmarkStep()
+  local cores = love.system.getProcessorCount()
+  print(string.format('%d pyramids x %d boxes, %d cores', PYRAMIDS, BOXES, cores))
+
+  local counts = {}
+  local threads = 1
+  while threads < cores do
+    table.insert(counts, threads)
+    threads = threads * 2
+  end
+  table.insert(counts, cores)
+
+  local base
+  for _, threads in ipairs(counts) do
+    local ms, contacts = run(threads)
+    base = base or ms
+    print(string.format('threads %2d: %7.3f ms/step (%.2fx, %d contacts)', threads, ms, base / ms, contacts))
+  end
+end
+
+function love.load(args)
+  local selected = {}
+  for _, name in ipairs(args) do
+    selected[name] = true
+  end
+  local all = not (selected.step or selected.getbodies)
+
+  if all or selected.step then benchmarkStep() end
+  if all or selected.getbodies then benchmarkGetBodies() end
+
+  love.event.quit()
+end
@@ -62,6 +62,101 @@ love.test.data.CompressedData = function(test)
 end
 
 
+-- CompressionStream (love.data.newCompressionStream)
+love.test.data.CompressionStream = function(test)
+
+  -- create a string big enough to be split into multiple blocks
+  local parts = {}
+  for i=1,20000 do
+    parts[i] = 'line ' .. tostring(i) .. ' of the save file\n'
+  end
+  local input = table.concat(parts)
+
+  for _, format in ipairs({'lz4frame', 'zlib', 'gzip', 'deflate'}) do
+
+    -- create new obj
+    local stream = love.data.newCompressionStream(format, { blocksize = 65536 })
+    test:assertObject(stream)
+    test:assertEquals(format, stream:getFormat(), 'check format used')
+    test:assertTrue(stream:isCompressing(), 'check compressing')
+    test:assertFalse(stream:isFinished(), 'check not finished')
+
+    -- feed the input in uneven pieces and collect the output
+    local compressed = {}
+    local offset = 1
+    while offset <= #input do
+      local piece = input:sub(offset, offset + 12344)
+      table.insert(compressed, stream:feed(piece))
+      offset = offset + #piece
+    end
+    table.insert(compressed, stream:flush())
+    table.insert(compressed, stream:finish())
+    test:assertTrue(stream:isFinished(), 'check finished')
+    local cstr = table.concat(compressed)
+    test:assertLessEqual(#input, #cstr, 'check ' .. format .. ' compressed')
+
+    -- output is compatible with the one-shot functions
+    test:assertEquals(input, love.data.decompress('string', format, cstr), 'check ' .. format .. ' one-shot decompress')
+
+    -- decompress it again a few bytes at a time
+    local dstream = love.data.newDecompressionStream(format)
+    test:assertFalse(dstream:isCompressing(), 'check decompressing')
+    local decompressed = {}
+    for i=1,#cstr,999 do
+      table.insert(decompressed, dstream:feed(cstr:sub(i, i + 998)))
+    end
+    table.insert(decompressed, dstream:finish())
+    test:assertEquals(input, table.concat(decompressed), 'check ' .. format .. ' stream decompress')
+
+  end
+
+  -- truncated data is an error
+  local cstr = love.data.compress('string', 'lz4frame', 'helloworld')
+  local dstream = love.data.newDecompressionStream('lz4frame')
+  dstream:feed(cstr:sub(1, #cstr - 2))
+  local ok = pcall(dstream.finish, dstream)
+  test:assertFalse(ok, 'check truncated data errors')
+
+  -- the old lz4 format has no framing so can't be streamed
+  ok = pcall(love.data.newCompressionStream, 'lz4')
+  test:assertFalse(ok, 'check lz4 not streamable')
+
+  -- write straight to a file
+  local file = love.filesystem.openFile('compressionstream.gz', 'w')
+  local fstream = love.data.newCompressionStream('gzip', { output = file })
+  test:assertEquals(nil, fstream:feed('helloworld'), 'check no string returned')
+  fstream:finish()
+  file:close()
+  local contents = love.filesystem.read('compressionstream.gz')
+  test:assertEquals('helloworld', love.data.decompress('string', 'gzip', contents), 'check file output')
+  love.filesystem.remove('compressionstream.gz')
+
+end
+
+
+-- Hasher (love.data.newHasher)
+love.test.data.Hasher = function(test)
+  for _, func in ipairs({ 'xxh32', 'xxh64', 'crc32c' }) do
+    -- create new obj
+    local hasher = love.data.newHasher(func)
+    test:assertObject(hasher)
+    test:assertEquals(func, hasher:getFunction(), 'check function used')
+    -- hashing in pieces gives the same result as hashing at once
+    hasher:update('hello')
+    hasher:update(love.data.newByteData('world'))
+    test:assertEquals(love.data.hash('string', func, 'helloworld'), hasher:digest(), 'check ' .. func .. ' incremental')
+    test:assertEquals(hasher:digest(), hasher:digest('data'):getString(), 'check ' .. func .. ' data container')
+    -- reset starts over
+    hasher:reset()
+    hasher:update('helloworld')
+    test:assertEquals(love.data.hash('string', func, 'helloworld'), hasher:digest(), 'check ' .. func .. ' reset')
+  end
+  -- cryptographic hashes are only available as one-shot calls
+  local ok = pcall(love.data.newHasher, 'sha256')
+  test:assertFalse(ok, 'check sha256 not incremental')
+end
+
+
 --------------------------------------------------------------------------------
 --------------------------------------------------------------------------------
 ------------------------------------METHODS-------------------------------------
@@ -147,6 +242,8 @@ love.test.data.decompress = function(test)
   local str16 = love.data.compress('data', 'gzip', 'helloworld', -1)
   local str17 = love.data.compress('data', 'gzip', 'helloworld', 0)
   local str18 = love.data.compress('data', 'gzip', 'helloworld', 9)
+  local str19 = love.data.compress('string', 'lz4frame', 'helloworld', -1)
+  local str20 = love.data.compress('data', 'lz4frame', 'helloworld', 9)
   -- check decompressed value matches whats expected
   test:assertEquals('helloworld', love.data.decompress('string', 'lz4', str1), 'check string lz4 decompress')
   test:assertEquals('helloworld', love.data.decompress('string', 'lz4', str2), 'check string lz4 decompress')
@@ -166,6 +263,8 @@ love.test.data.decompress = function(test)
   test:assertEquals(love.data.newByteData('helloworld'):getString(), love.data.decompress('data', 'gzip', str16):getString(), 'check data glib decompress')
   test:assertEquals(love.data.newByteData('helloworld'):getString(), love.data.decompress('data', 'gzip', str17):getString(), 'check data glib decompress')
   test:assertEquals(love.data.newByteData('helloworld'):getString(), love.data.decompress('data', 'gzip', str18):getString(), 'check data glib decompress')
+  test:assertEquals('helloworld', love.data.decompress('string', 'lz4frame', str19), 'check string lz4frame decompress')
+  test:assertEquals(love.data.newByteData('helloworld'):getString(), love.data.decompress('data', 'lz4frame', str20):getString(), 'check data lz4frame decompress')
 end
 
 
@@ -234,6 +333,37 @@ love.test.data.hash = function(test)
   test:assertEquals('936a185caaa266bb9cbe981e9e05cb78cd732b0b3280eb944412bb6f8f8f07af', love.data.encode("string", "hex", data4), 'check data sha256 encode')
   test:assertEquals('97982a5b1414b9078103a1c008c4e3526c27b41cdbcf80790560a40f2a9bf2ed4427ab1428789915ed4b3dc07c454bd9', love.data.encode("string", "hex", data5), 'check data sha384 encode')
   test:assertEquals('1594244d52f2d8c12b142bb61f47bc2eaf503d6d9ca8480cae9fcf112f66e4967dc5e8fa98285e36db8af1b8ffa8b84cb15e0fbcf836c3deb803c13f37659a60', love.data.encode("string", "hex", data6), 'check data sha512 encode')
+    -- test non-cryptographic hashes
+  test:assertEquals('2362e202', love.data.encode("string", "hex", love.data.hash('string', 'xxh32', 'helloworld')), 'check string xxh32 encode')
+  test:assertEquals('80111601aa1c6a4f', love.data.encode("string", "hex", love.data.hash('string', 'xxh64', 'helloworld')), 'check string xxh64 encode')
+  test:assertEquals('e3069283', love.data.encode("string", "hex", love.data.hash('string', 'crc32c', '123456789')), 'check string crc32c encode')
+  test:assertEquals('56cbb480', love.data.encode("string", "hex", love.data.hash('data', 'crc32c', 'helloworld')), 'check data crc32c encode')
+end
+
+
+-- love.data.hashBatch
+love.test.data.hashBatch = function(test)
+  local bytedata = love.data.newByteData('helloworld')
+  local inputs = { 'helloworld', bytedata, { bytedata, 5, 5 }, { bytedata, 5 } }
+  -- hash enough data that the work is spread over threads
+  for i=1,200 do
+    table.insert(inputs, string.rep(tostring(i), 1000))
+  end
+  for _, func in ipairs({ 'sha256', 'xxh64', 'crc32c' }) do
+    local hashes = love.data.hashBatch('string', func, inputs)
+    test:assertEquals(#inputs, #hashes, 'check ' .. func .. ' result count')
+    test:assertEquals(love.data.hash('string', func, 'helloworld'), hashes[1], 'check ' .. func .. ' string input')
+    test:assertEquals(hashes[1], hashes[2], 'check ' .. func .. ' data input')
+    test:assertEquals(love.data.hash('string', func, 'world'), hashes[3], 'check ' .. func .. ' slice input')
+    test:assertEquals(hashes[3], hashes[4], 'check ' .. func .. ' slice without size')
+    test:assertEquals(love.data.hash('string', func, inputs[150]), hashes[150], 'check ' .. func .. ' large batch')
+  end
+  local datahashes = love.data.hashBatch('data', 'xxh32', { 'helloworld' })
+  test:assertEquals('2362e202', love.data.encode('string', 'hex', datahashes[1]), 'check data container')
+  local ok = pcall(love.data.hashBatch, 'string', 'xxh64', { { bytedata, 2^62, 2^62 } })
+  test:assertFalse(ok, 'check huge slice rejected')
+  ok = pcall(love.data.hashBatch, 'string', 'xxh64', { { bytedata, 5, 6 } })
+  test:assertFalse(ok, 'check slice past the end rejected')
 end
 
 
@@ -241,6 +371,17 @@ end
 -- @NOTE this is just basic nil checking, objs have their own test method
 love.test.data.newByteData = function(test)
   test:assertObject(love.data.newByteData('helloworld'))
+  local source = love.data.newByteData('helloworld')
+  test:assertEquals('world', love.data.newByteData(source, 5, 5):getString(), 'check slice')
+  test:assertFalse(pcall(love.data.newByteData, source, 2^62, 2^62), 'check huge slice rejected')
+  test:assertFalse(pcall(love.data.newByteData, source, 5, 6), 'check slice past the end rejected')
+end
+
+
+-- love.data.newCompressionStream
+-- @NOTE this is just basic nil checking, objs have their own test method
+love.test.data.newCompressionStream = function(test)
+  test:assertObject(love.data.newCompressionStream('lz4frame', { level = 9, threads = 2 }))
 end
 
 
@@ -251,6 +392,20 @@ love.test.data.newDataView = function(test)
 end
 
 
+-- love.data.newDecompressionStream
+-- @NOTE this is just basic nil checking, objs have their own test method
+love.test.data.newDecompressionStream = function(test)
+  test:assertObject(love.data.newDecompressionStream('gzip'))
+end
+
+
+-- love.data.newHasher
+-- @NOTE this is just basic nil checking, objs have their own test method
+love.test.data.newHasher = function(test)
+  test:assertObject(love.data.newHasher('xxh64'))
+end
+
+
 -- love.data.pack
 love.test.data.pack = function(test)
   local packed1 = love.data.pack('string', '>I4I4I4I4', 9999, 1000, 1010, 2030)
@@ -501,6 +501,33 @@ love.test.filesystem.remove = function(test)
 end
 
 
+-- love.filesystem.setBytecodeCacheEnabled
+love.test.filesystem.setBytecodeCacheEnabled = function(test)
+  test:assertFalse(love.filesystem.isBytecodeCacheEnabled(), 'check disabled by default')
+  love.filesystem.write('cached.lua', 'return 42')
+  love.filesystem.setBytecodeCacheEnabled(true)
+  test:assertTrue(love.filesystem.isBytecodeCacheEnabled(), 'check enabled')
+  -- first load compiles and stores the chunk, second load uses the cache
+  local chunk1 = love.filesystem.load('cached.lua')
+  test:assertEquals(42, chunk1(), 'check cache miss runs')
+  local entries = love.filesystem.getDirectoryItems('.bytecodecache')
+  test:assertEquals(1, #entries, 'check cache entry written')
+  local chunk2 = love.filesystem.load('cached.lua')
+  test:assertEquals(42, chunk2(), 'check cache hit runs')
+  -- changed source must not reuse the old entry
+  love.filesystem.write('cached.lua', 'return 7')
+  local chunk3 = love.filesystem.load('cached.lua')
+  test:assertEquals(7, chunk3(), 'check changed source recompiles')
+  -- cleanup
+  love.filesystem.setBytecodeCacheEnabled(false)
+  for _, item in ipairs(love.filesystem.getDirectoryItems('.bytecodecache')) do
+    love.filesystem.remove('.bytecodecache/' .. item)
+  end
+  love.filesystem.remove('.bytecodecache')
+  love.filesystem.remove('cached.lua')
+end
+
+
 -- love.filesystem.setCRequirePath
 love.test.filesystem.setCRequirePath = function(test)
   -- check setting path val is returned
@@ -521,6 +548,36 @@ love.test.filesystem.setIdentity = function(test)
 end
 
 
+-- love.filesystem.setPathIndexEnabled
+love.test.filesystem.setPathIndexEnabled = function(test)
+  test:assertFalse(love.filesystem.isPathIndexEnabled(), 'check disabled by default')
+  love.filesystem.setPathIndexEnabled(true)
+  test:assertTrue(love.filesystem.isPathIndexEnabled(), 'check enabled')
+  -- index sees files written after it was built
+  test:assertEquals(nil, love.filesystem.getInfo('indexed/file.txt'), 'check missing')
+  love.filesystem.createDirectory('indexed/sub')
+  love.filesystem.write('indexed/file.txt', 'hello')
+  local info = love.filesystem.getInfo('indexed/file.txt')
+  test:assertNotEquals(nil, info, 'check written file indexed')
+  test:assertEquals('file', info.type, 'check type')
+  test:assertEquals(5, info.size, 'check size')
+  test:assertEquals('directory', love.filesystem.getInfo('indexed/sub').type, 'check nested directory')
+  test:assertEquals(love.filesystem.getSaveDirectory(), love.filesystem.getRealDirectory('indexed/file.txt'), 'check real directory')
+  local items = love.filesystem.getDirectoryItems('indexed')
+  test:assertEquals(2, #items, 'check directory items')
+  test:assertEquals('file.txt', items[1], 'check item order')
+  test:assertEquals('sub', items[2], 'check item order')
+  -- and drops them when removed
+  love.filesystem.remove('indexed/file.txt')
+  love.filesystem.remove('indexed/sub')
+  test:assertEquals(nil, love.filesystem.getInfo('indexed/file.txt'), 'check removed')
+  test:assertEquals(0, #love.filesystem.getDirectoryItems('indexed'), 'check no items')
+  -- cleanup
+  love.filesystem.remove('indexed')
+  love.filesystem.setPathIndexEnabled(false)
+end
+
+
 -- love.filesystem.setRequirePath
 love.test.filesystem.setRequirePath = function(test)
   -- check setting path val is returned
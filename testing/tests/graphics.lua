@@ -98,6 +98,40 @@ love.test.graphics.ShaderStorageBuffer = function(test)
 end
 
 
+-- Dynamic GraphicsBuffer updates (love.graphics.newBuffer)
+-- @NOTE several updates in one frame and across frames, which are staged in
+-- GPU-visible upload memory where it's supported
+love.test.graphics.DynamicBuffer = function(test)
+  local buffer = love.graphics.newBuffer('float', 64, {vertex=true, usage='dynamic'})
+  local function check(expected, label)
+    local data = love.graphics.readbackBuffer(buffer)
+    local values = {love.data.unpack(string.rep('f', 64), data:getString())}
+    local matches = true
+    for i=1,64 do
+      if values[i] ~= expected[i] then matches = false end
+    end
+    test:assertTrue(matches, label)
+  end
+  local expected = {}
+  for frame=1,3 do
+    for i=1,64 do expected[i] = frame * 100 + i end
+    buffer:setArrayData(expected)
+    -- partial update through a second upload in the same frame
+    local part = {}
+    for i=1,8 do
+      part[i] = -i * frame
+      expected[16 + i] = part[i]
+    end
+    buffer:setArrayData(part, 1, 17, 8)
+    local bytes = love.data.pack('data', string.rep('f', 4), 1, 2, 3, 4)
+    buffer:setArrayData(bytes, 1, 61, 4)
+    expected[61], expected[62], expected[63], expected[64] = 1, 2, 3, 4
+    check(expected, 'check dynamic buffer contents in frame ' .. frame)
+    test:waitFrames(1)
+  end
+end
+
+
 -- Canvas (love.graphics.newCanvas)
 love.test.graphics.Canvas = function(test)
 
@@ -260,6 +294,58 @@ love.test.graphics.Canvas = function(test)
 end
 
 
+-- DrawCommandBuffer (love.graphics.newDrawCommandBuffer)
+love.test.graphics.DrawCommandBuffer = function(test)
+
+  -- create obj
+  local buffer = love.graphics.newDrawCommandBuffer()
+  test:assertObject(buffer)
+  test:assertEquals(0, buffer:getCount(), 'check empty by default')
+  test:assertEquals(nil, buffer:getBlendMode(), 'check no blend mode by default')
+
+  -- record sprites from a worker thread
+  local imgdata = love.image.newImageData(4, 4)
+  imgdata:mapPixel(function() return 1, 1, 1, 1 end)
+  local image1 = love.graphics.newImage(imgdata)
+  local image2 = love.graphics.newImage(imgdata)
+  local thread = love.thread.newThread([[
+    require('love.graphics')
+    local buffer, image1, image2 = ...
+    buffer:setColor(1, 0, 0, 1)
+    buffer:add(image1, 0, 0)
+    buffer:add(image1, 4, 0)
+    buffer:setBlendMode('replace')
+    buffer:add(image2, 8, 0)
+  ]])
+  thread:start(buffer, image1, image2)
+  thread:wait()
+  test:assertEquals(nil, thread:getError(), 'check thread recorded without errors')
+  test:assertEquals(3, buffer:getCount(), 'check sprite count')
+  test:assertEquals(2, buffer:getCommandCount(), 'check sprites with the same state merged')
+  test:assertEquals('replace', buffer:getBlendMode(), 'check blend mode recorded')
+
+  -- submit on the main thread
+  local canvas = love.graphics.newCanvas(16, 16)
+  love.graphics.setCanvas(canvas)
+    love.graphics.clear(0, 0, 0, 1)
+    love.graphics.draw(buffer)
+  love.graphics.setCanvas()
+  test:assertEquals('alpha', love.graphics.getBlendMode(), 'check blend mode restored')
+  local data = love.graphics.readbackTexture(canvas)
+  for _, x in ipairs({1, 5, 9}) do
+    local r, g, b = data:getPixel(x, 1)
+    test:assertEquals(1, r, 'check red at ' .. x)
+    test:assertEquals(0, g, 'check green at ' .. x)
+  end
+  local r = data:getPixel(13, 1)
+  test:assertEquals(0, r, 'check nothing drawn past the sprites')
+
+  buffer:clear()
+  test:assertEquals(0, buffer:getCount(), 'check cleared')
+
+end
+
+
 -- Font (love.graphics.newFont)
 love.test.graphics.Font = function(test)
 
@@ -1106,6 +1192,31 @@ love.test.graphics.SpriteBatch = function(test)
   local imgdata4 = love.graphics.readbackTexture(canvas)
   test:compareImg(imgdata4)
 
+  -- set scattered sprites so several separate ranges get uploaded
+  local rbatch = love.graphics.newSpriteBatch(texture2, 64)
+  for s=0,63 do
+    rbatch:add(quad2, s, 0, 0, 1, 1)
+  end
+  love.graphics.setCanvas(canvas)
+    love.graphics.clear(0, 0, 0, 1)
+    love.graphics.draw(rbatch, 0, 0)
+  love.graphics.setCanvas()
+  rbatch:setColor(1, 0, 0, 1)
+  for _, s in ipairs({0, 20, 63}) do
+    rbatch:set(s + 1, quad2, s, 0, 0, 1, 1)
+  end
+  love.graphics.setCanvas(canvas)
+    love.graphics.clear(0, 0, 0, 1)
+    love.graphics.draw(rbatch, 0, 0)
+  love.graphics.setCanvas()
+  local rdata = love.graphics.readbackTexture(canvas)
+  for s=0,63 do
+    local r, g, b = rdata:getPixel(s, 0)
+    local red = s == 0 or s == 20 or s == 63
+    test:assertEquals(1, r, 'check scattered set r ' .. s)
+    test:assertEquals(red and 0 or 1, g, 'check scattered set g ' .. s)
+  end
+
   -- array texture sbatch
   local texture3 = love.graphics.newArrayImage({
     'resources/love.png',
@@ -1129,6 +1240,46 @@ love.test.graphics.SpriteBatch = function(test)
   local imgdata5 = love.graphics.readbackTexture(canvas)
   test:compareImg(imgdata5)
 
+  -- instanced storage: one compact instance per sprite
+  test:assertEquals('vertices', sbatch:getStorageMode(), 'check default storage')
+  if love.graphics.getSupported().texelbuffer then
+    local ibatch = love.graphics.newSpriteBatch(texture2, 16, 'dynamic', 'instances')
+    test:assertEquals('instances', ibatch:getStorageMode(), 'check instanced storage')
+    local white = ibatch:addQuad(quad2)
+    test:assertEquals(0, white, 'check first quad index')
+    test:assertEquals(white, ibatch:addQuad(quad2), 'check quad reuse')
+    test:assertEquals(1, ibatch:getQuadCount(), 'check quad count')
+    for s=0,7 do
+      ibatch:add(quad2, s, 0)
+    end
+    -- a red sprite at (0, 1) from raw instance data
+    local instance = love.data.pack('data', '<ffffffI2I2BBBB',
+      1, 0, 0, 0, 1, 1, white, 0, 255, 0, 0, 255)
+    ibatch:setInstances(9, instance)
+    test:assertEquals(9, ibatch:getCount(), 'check instance count')
+    love.graphics.setCanvas(canvas)
+      love.graphics.clear(0, 0, 0, 1)
+      love.graphics.draw(ibatch, 0, 0)
+    love.graphics.setCanvas()
+    local idata = love.graphics.readbackTexture(canvas)
+    local r1, g1, b1 = idata:getPixel(7, 0)
+    test:assertEquals(1, g1, 'check instanced sprite drawn')
+    local r2, g2, b2 = idata:getPixel(0, 1)
+    test:assertEquals(1, r2, 'check raw instance r')
+    test:assertEquals(0, g2, 'check raw instance g')
+    local r3, g3, b3 = idata:getPixel(8, 0)
+    test:assertEquals(0, r3, 'check nothing drawn past instances')
+    -- quad layers are validated against array textures like addLayer does
+    local iabatch = love.graphics.newSpriteBatch(texture3, 4, 'dynamic', 'instances')
+    local layerquad = love.graphics.newQuad(0, 0, 1, 1, texture3)
+    layerquad:setLayer(texture3:getLayerCount() + 1)
+    test:assertFalse(pcall(iabatch.add, iabatch, layerquad, 0, 0), 'check invalid quad layer errors')
+  else
+    -- the instanced shaders need texel buffers, so there's no fallback
+    local ok = pcall(love.graphics.newSpriteBatch, texture2, 16, 'dynamic', 'instances')
+    test:assertFalse(ok, 'check instanced storage needs texel buffers')
+  end
+
 end
 
 
@@ -1173,6 +1324,75 @@ love.test.graphics.Text = function(test)
 end
 
 
+-- TileMap (love.graphics.newTileMap)
+love.test.graphics.TileMap = function(test)
+
+  -- tileset with two 4x4 tiles side by side: red (id 1) and green (id 2)
+  local tiledata = love.image.newImageData(8, 4)
+  tiledata:mapPixel(function(x, y)
+    if x < 4 then return 1, 0, 0, 1 end
+    return 0, 1, 0, 1
+  end)
+  local tileset = love.graphics.newImage(tiledata)
+  tileset:setFilter('nearest', 'nearest')
+
+  local map = love.graphics.newTileMap(tileset, 4, 4, 4, 4)
+  test:assertObject(map)
+  test:assertEquals(4, map:getWidth(), 'check width')
+  test:assertEquals(4, map:getHeight(), 'check height')
+  local tw, th = map:getTileDimensions()
+  test:assertEquals(4, tw, 'check tile width')
+  test:assertEquals(4, th, 'check tile height')
+  test:assertEquals('r16ui', map:getFormat(), 'check default format')
+  test:assertEquals(2, map:getMaxTileID(), 'check max tile id is the tile count')
+  test:assertEquals(tileset, map:getTileset(), 'check tileset')
+
+  -- edit tiles
+  test:assertEquals(0, map:getTile(0, 0), 'check tiles start empty')
+  map:setTile(1, 0, 1)
+  test:assertEquals(1, map:getTile(1, 0), 'check set tile')
+  map:setTiles(0, 2, 2, { 1, 2, 2, 1 })
+  test:assertEquals(2, map:getTile(0, 3), 'check set tiles region')
+  test:assertEquals(false, pcall(map.setTile, map, 4, 0, 1), 'check out of bounds tile')
+  test:assertEquals(false, pcall(map.setTile, map, 0, 0, 65536), 'check tile id range')
+  test:assertEquals(false, pcall(map.setTile, map, 0, 0, 3), 'check tile id past the tileset')
+  test:assertEquals(false, pcall(map.setTiles, map, 0, 0, 1, { 3 }), 'check region id past the tileset')
+  test:assertEquals(false, pcall(map.fill, map, 3), 'check fill id past the tileset')
+  -- a tileset with fewer tiles than the ids in use is rejected
+  local smalltileset = love.graphics.newImage(love.image.newImageData(4, 4))
+  test:assertEquals(false, pcall(map.setTileset, map, smalltileset), 'check smaller tileset')
+  test:assertEquals(tileset, map:getTileset(), 'check tileset kept')
+  test:assertEquals(false, pcall(map.setTiles, map, 0, 0, 3, { 1, 2 }), 'check region size')
+
+  -- draw: empty cells stay clear, others sample their tile
+  local canvas = love.graphics.newCanvas(16, 16)
+  love.graphics.setCanvas(canvas)
+    love.graphics.clear(0, 0, 0, 1)
+    love.graphics.draw(map, 0, 0)
+  love.graphics.setCanvas()
+  local imgdata = love.graphics.readbackTexture(canvas)
+  local r1, g1 = imgdata:getPixel(1, 1)
+  test:assertEquals(0, r1 + g1, 'check empty tile')
+  local r2, g2 = imgdata:getPixel(6, 1)
+  test:assertEquals(1, r2, 'check red tile r')
+  test:assertEquals(0, g2, 'check red tile g')
+  local r3, g3 = imgdata:getPixel(1, 14)
+  test:assertEquals(0, r3, 'check green tile r')
+  test:assertEquals(1, g3, 'check green tile g')
+
+  -- edits after a draw are uploaded on the next draw
+  map:fill(2)
+  love.graphics.setCanvas(canvas)
+    love.graphics.draw(map, 0, 0)
+  love.graphics.setCanvas()
+  imgdata = love.graphics.readbackTexture(canvas)
+  local r4, g4 = imgdata:getPixel(1, 1)
+  test:assertEquals(0, r4, 'check filled tile r')
+  test:assertEquals(1, g4, 'check filled tile g')
+
+end
+
+
 -- Video (love.graphics.newVideo)
 love.test.graphics.Video = function(test)
 
@@ -1452,6 +1672,93 @@ love.test.graphics.line = function(test)
 end
 
 
+-- love.graphics.multiDrawIndirect
+love.test.graphics.multiDrawIndirect = function(test)
+  if not love.graphics.getSupported().indirectdraw then
+    test:skipTest('indirect draws are not supported on this system')
+    return
+  end
+  local mesh = love.graphics.newMesh({
+    { 0, 0, 0, 0 }, { 16, 0, 1, 0 }, { 0, 16, 0, 1 },
+    { 16, 0, 1, 0 }, { 16, 16, 1, 1 }, { 0, 16, 0, 1 }
+  }, 'triangles', 'static')
+  -- two draws of 3 vertices each: { vertexcount, instancecount, first, baseinstance }
+  local args = love.graphics.newBuffer('uint32', 8, {indirectarguments=true})
+  args:setArrayData({ 3, 1, 0, 0, 3, 1, 3, 0 })
+  test:assertFalse(pcall(love.graphics.multiDrawIndirect, mesh, args, 1, 0), 'check drawcount must be positive')
+  test:assertFalse(pcall(love.graphics.multiDrawIndirect, mesh, args, 2, 2), 'check args buffer bounds')
+  if not love.graphics.getSupported().multidrawindirect then
+    test:assertFalse(pcall(love.graphics.multiDrawIndirect, mesh, args, 1, 2), 'check unsupported multi-draw errors')
+    return
+  end
+  local canvas = love.graphics.newCanvas(16, 16)
+  love.graphics.setCanvas(canvas)
+    love.graphics.clear(0, 0, 0, 1)
+    love.graphics.multiDrawIndirect(mesh, args, 1, 2)
+  love.graphics.setCanvas()
+  local imgdata = love.graphics.readbackTexture(canvas)
+  -- both triangles should be drawn, covering the whole canvas
+  for _, p in ipairs({{1, 1}, {14, 14}}) do
+    local r, g, b = imgdata:getPixel(p[1], p[2])
+    test:assertEquals(3, r+g+b, 'check pixel ' .. p[1] .. ',' .. p[2] .. ' drawn')
+  end
+  -- love_DrawID is the index of each draw within the multi-draw
+  local shader = love.graphics.newShader([[
+    varying vec4 drawcolor;
+    vec4 position(mat4 transform_projection, vec4 vertex_position) {
+      drawcolor = love_DrawID == 0 ? vec4(1.0, 0.0, 0.0, 1.0) : vec4(0.0, 1.0, 0.0, 1.0);
+      return transform_projection * vertex_position;
+    }
+  ]], [[
+    varying vec4 drawcolor;
+    vec4 effect(vec4 color, Image tex, vec2 texcoord, vec2 pixcoord) {
+      return drawcolor;
+    }
+  ]])
+  love.graphics.setCanvas(canvas)
+    love.graphics.clear(0, 0, 0, 1)
+    love.graphics.setShader(shader)
+    love.graphics.multiDrawIndirect(mesh, args, 1, 2)
+    love.graphics.setShader()
+  love.graphics.setCanvas()
+  imgdata = love.graphics.readbackTexture(canvas)
+  local r, g, b = imgdata:getPixel(1, 1)
+  test:assertEquals(1, r, 'check first draw red')
+  test:assertEquals(0, g, 'check first draw not green')
+  r, g, b = imgdata:getPixel(14, 14)
+  test:assertEquals(0, r, 'check second draw not red')
+  test:assertEquals(1, g, 'check second draw green')
+  -- consecutive draws of the same mesh are merged into one multi-draw, each
+  -- keeping its own transform and color
+  -- @NOTE merging reads per-draw data from a texel buffer, without them the
+  -- draws stay separate but must look the same
+  love.graphics.setCanvas(canvas)
+    love.graphics.clear(0, 0, 0, 1)
+    local before = love.graphics.getStats().drawcalls
+    love.graphics.setColor(1, 0, 0, 1)
+    love.graphics.draw(mesh, 0, 0, 0, 0.5, 0.5)
+    love.graphics.setColor(0, 1, 0, 1)
+    love.graphics.draw(mesh, 8, 0, 0, 0.5, 0.5)
+    love.graphics.setColor(0, 0, 1, 1)
+    love.graphics.draw(mesh, 0, 8, 0, 0.5, 0.5)
+    love.graphics.setColor(1, 1, 1, 1)
+  love.graphics.setCanvas()
+  if love.graphics.getSupported().texelbuffer then
+    test:assertEquals(before + 1, love.graphics.getStats().drawcalls, 'check mesh draws merged')
+  else
+    test:assertEquals(before + 3, love.graphics.getStats().drawcalls, 'check mesh draws not merged')
+  end
+  imgdata = love.graphics.readbackTexture(canvas)
+  local expected = {{2, 2, 1, 0, 0}, {10, 2, 0, 1, 0}, {2, 10, 0, 0, 1}, {10, 10, 0, 0, 0}}
+  for _, p in ipairs(expected) do
+    r, g, b = imgdata:getPixel(p[1], p[2])
+    test:assertEquals(p[3], r, 'check merged draw red at ' .. p[1] .. ',' .. p[2])
+    test:assertEquals(p[4], g, 'check merged draw green at ' .. p[1] .. ',' .. p[2])
+    test:assertEquals(p[5], b, 'check merged draw blue at ' .. p[1] .. ',' .. p[2])
+  end
+end
+
+
 -- love.graphics.points
 love.test.graphics.points = function(test)
   local canvas = love.graphics.newCanvas(16, 16)
@@ -1564,8 +1871,14 @@ end
 love.test.graphics.captureScreenshot = function(test)
   love.graphics.captureScreenshot('example-screenshot.png')
   test:waitFrames(1)
-  -- need to wait until end of the frame for the screenshot
+  -- need to wait until end of the frame for the screenshot, and then for it
+  -- to be encoded and written on a worker thread
+  local start = love.timer.getTime()
+  while not love.filesystem.exists('example-screenshot.png') and love.timer.getTime() < start + 5 do
+    test:waitFrames(1)
+  end
   test:assertTrue(love.filesystem.exists('example-screenshot.png'))
+  test:waitSeconds(0.1)
   love.filesystem.remove('example-screenshot.png')
   -- test callback version
   local cbdata = nil
@@ -1622,11 +1935,36 @@ love.test.graphics.newCubeImage = function(test)
 end
 
 
+-- love.graphics.newDrawCommandBuffer
+-- @NOTE this is just basic nil checking, objs have their own test method
+love.test.graphics.newDrawCommandBuffer = function(test)
+  test:assertObject(love.graphics.newDrawCommandBuffer())
+end
+
+
 -- love.graphics.newFont
 -- @NOTE this is just basic nil checking, objs have their own test method
 love.test.graphics.newFont = function(test)
   test:assertObject(love.graphics.newFont('resources/font.ttf'))
   test:assertObject(love.graphics.newFont('resources/font.ttf', 8, "normal", 1))
+  -- sdf fonts are drawn through the built-in sdf shader, scaled up here
+  local sdffont = love.graphics.newFont('resources/font.ttf', 8, { sdf = true })
+  test:assertObject(sdffont)
+  local canvas = love.graphics.newCanvas(32, 32)
+  love.graphics.setCanvas(canvas)
+    love.graphics.clear(0, 0, 0, 1)
+    love.graphics.setFont(sdffont)
+    love.graphics.print('love', 0, 0, 0, 3, 3)
+    love.graphics.setFont(Font)
+  love.graphics.setCanvas()
+  local imgdata = love.graphics.readbackTexture(canvas)
+  local lit = 0
+  for y=0,31 do
+    for x=0,31 do
+      if imgdata:getPixel(x, y) > 0.5 then lit = lit + 1 end
+    end
+  end
+  test:assertGreaterEqual(1, lit, 'check sdf glyphs drawn')
 end
 
 
@@ -1710,6 +2048,25 @@ end
 love.test.graphics.newTexture = function(test)
   local imgdata = love.image.newImageData('resources/love.png')
   test:assertObject(love.graphics.newTexture(imgdata))
+
+  -- compress picks a format the system supports, or keeps the pixels as-is
+  local compressed = love.graphics.newTexture(imgdata, { compress = true, mipmaps = true })
+  test:assertObject(compressed)
+  test:assertEquals(64, compressed:getWidth(), 'check compressed width')
+  if love.graphics.getTextureFormats({ canvas = false }).DXT5 then
+    local dxt5 = love.graphics.newTexture(imgdata, { compress = 'DXT5' })
+    test:assertEquals('DXT5', dxt5:getFormat(), 'check explicit compressed format')
+  end
+end
+
+
+-- love.graphics.newTileMap
+-- @NOTE this is just basic nil checking, objs have their own test method
+love.test.graphics.newTileMap = function(test)
+  local image = love.graphics.newImage('resources/love.png')
+  test:assertObject(love.graphics.newTileMap(image, 64, 64, 16, 16))
+  test:assertObject(love.graphics.newTileMap(image, 64, 64, 16, 16, 'r32ui'))
+  test:assertEquals(false, pcall(love.graphics.newTileMap, image, 4, 4, 16, 16, 'rgba8'), 'check invalid format')
 end
 
 
@@ -2785,17 +3142,106 @@ love.test.graphics.getRendererInfo = function(test)
 end
 
 
+-- love.graphics.getGPUTimings
+-- @NOTE timestamps are read back a few frames late, so zones are re-added
+-- every frame until they show up
+love.test.graphics.getGPUTimings = function(test)
+  local timings, supported = love.graphics.getGPUTimings()
+  test:assertNotNil(timings)
+  local ok = pcall(love.graphics.endProfileZone)
+  test:assertFalse(ok, 'check unmatched endProfileZone errors')
+  if not supported then
+    test:assertEquals(0, #timings, 'check no timings without timer queries')
+    return
+  end
+  local canvas = love.graphics.newCanvas(16, 16, { debugname = 'gputiming' })
+  local zone, pass = nil, nil
+  for f=1,30 do
+    love.graphics.beginProfileZone('outer')
+      love.graphics.beginProfileZone('inner')
+        love.graphics.setCanvas(canvas)
+          love.graphics.clear(0, 0, 0, 1)
+          love.graphics.rectangle('fill', 0, 0, 8, 8)
+        love.graphics.setCanvas()
+      love.graphics.endProfileZone()
+    love.graphics.endProfileZone()
+    test:waitFrames(1)
+    for _, timing in ipairs(love.graphics.getGPUTimings()) do
+      if timing.name == 'inner' then zone = timing end
+      if timing.name == 'gputiming' then pass = timing end
+    end
+    if zone ~= nil and pass ~= nil then break end
+  end
+  test:assertNotNil(zone)
+  test:assertNotNil(pass)
+  test:assertEquals(1, zone.depth, 'check nested zone depth')
+  test:assertFalse(zone.renderpass, 'check user zone is not a pass')
+  test:assertTrue(pass.renderpass, 'check canvas pass is a pass')
+  test:assertGreaterEqual(0, zone.time, 'check zone time')
+  test:assertGreaterEqual(0, love.graphics.getStats().gputime, 'check gputime')
+end
+
+
 -- love.graphics.getStats
 -- @NOTE cant really predict some of these so just nil check for most
 love.test.graphics.getStats = function(test)
   local stattypes = {
     'drawcalls', 'canvasswitches', 'texturememory', 'shaderswitches',
-    'drawcallsbatched', 'textures', 'fonts'
+    'drawcallsbatched', 'textures', 'fonts', 'gputime', 'streamvertexsize',
+    'streamindexsize', 'streamstalls'
   }
   local stats = love.graphics.getStats()
   for s=1,#stattypes do
     test:assertNotEquals(nil, stats[stattypes[s] ], 'expected a key for stat: ' .. stattypes[s])
   end
+  local flushtypes = { 'other', 'texture', 'shader', 'blend', 'format', 'overflow' }
+  for f=1,#flushtypes do
+    test:assertNotEquals(nil, stats.batchflushes[flushtypes[f] ], 'expected a key for batch flush: ' .. flushtypes[f])
+  end
+  test:assertGreaterEqual(1, stats.streamvertexsize, 'check stream vertex buffer size')
+  -- alternating textures between otherwise batchable draws flushes each time
+  local image1 = love.graphics.newImage(love.image.newImageData(4, 4))
+  local image2 = love.graphics.newImage(love.image.newImageData(4, 4))
+  local canvas = love.graphics.newCanvas(16, 16)
+  love.graphics.setCanvas(canvas)
+    local before = love.graphics.getStats().batchflushes.texture
+    love.graphics.draw(image1)
+    love.graphics.draw(image2)
+    love.graphics.draw(image1)
+    love.graphics.draw(image1)
+    local after = love.graphics.getStats(stats).batchflushes.texture
+  love.graphics.setCanvas()
+  test:assertEquals(before + 2, after, 'check texture flush count')
+end
+
+
+-- love.graphics.beginDrawList
+love.test.graphics.beginDrawList = function(test)
+  test:assertFalse(love.graphics.isDrawListActive(), 'check no draw list by default')
+  test:assertFalse(pcall(love.graphics.submitDrawList), 'check submit without begin errors')
+  -- recorded draws are sorted by texture so alternating images batch together
+  local image1 = love.graphics.newImage(love.image.newImageData(4, 4))
+  local image2 = love.graphics.newImage(love.image.newImageData(4, 4))
+  local canvas = love.graphics.newCanvas(16, 16)
+  love.graphics.setCanvas(canvas)
+    local before = love.graphics.getStats().batchflushes.texture
+    love.graphics.beginDrawList()
+    test:assertTrue(love.graphics.isDrawListActive(), 'check draw list active')
+    test:assertFalse(pcall(love.graphics.beginDrawList), 'check nested begin errors')
+    love.graphics.setDrawListLayer(2)
+    test:assertEquals(2, love.graphics.getDrawListLayer(), 'check layer set')
+    test:assertFalse(pcall(love.graphics.setDrawListLayer, 0/0), 'check NaN layer errors')
+    love.graphics.setBlendMode('add')
+    love.graphics.draw(image1)
+    love.graphics.draw(image2)
+    love.graphics.setBlendMode('alpha')
+    love.graphics.draw(image1)
+    love.graphics.draw(image2)
+    love.graphics.submitDrawList()
+    local after = love.graphics.getStats().batchflushes.texture
+  love.graphics.setCanvas()
+  test:assertFalse(love.graphics.isDrawListActive(), 'check draw list ended')
+  test:assertRange(after - before, 0, 1, 'check texture flush count')
 end
 
 
@@ -2805,7 +3251,7 @@ love.test.graphics.getSupported = function(test)
   -- table match what the documentation lists
   local gfs = {
     'clampzero', 'lighten', 'glsl3', 'instancing', 'fullnpot', 
-    'pixelshaderhighp', 'shaderderivatives', 'indirectdraw',
+    'pixelshaderhighp', 'shaderderivatives', 'indirectdraw', 'multidrawindirect',
     'copytexturetobuffer', 'multirendertargetformats', 
     'clampone', 'glsl4'
   }
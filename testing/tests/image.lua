@@ -96,6 +96,23 @@ love.test.image.ImageData = function(test)
   test:assertNotNil(read2)
   love.filesystem.remove('test-encode.exr')
 
+  -- check encoding on a worker thread gives the same result
+  local job = idata:encodeAsync('png')
+  test:assertObject(job)
+  job:wait()
+  test:assertTrue(job:isComplete(), 'check async encode complete')
+  test:assertFalse(job:hasError(), 'check async encode no error')
+  test:assertEquals(idata:encode('png'):getString(), job:getFileData():getString(), 'check async encode matches')
+
+  -- changing the pixels after starting doesn't affect the result
+  local before = idata:encode('png'):getString()
+  local job2 = idata:encodeAsync('png', 'test-encode-async.png')
+  idata:setPixel(0, 0, 0.2, 0.4, 0.6, 1)
+  job2:wait()
+  test:assertEquals(before, job2:getFileData():getString(), 'check async encode uses a snapshot')
+  test:assertEquals(before, love.filesystem.read('test-encode-async.png'), 'check async encode file')
+  love.filesystem.remove('test-encode-async.png')
+
   -- check linear
   test:assertFalse(idata:isLinear(), 'check not linear')
   idata:setLinear(true)
@@ -121,10 +138,231 @@ love.test.image.isCompressed = function(test)
 end
 
 
+-- reads count bits from pos of a block, where bit 0 is the lowest bit of the
+-- first byte
+local function readBits(block, pos, count)
+  local value = 0
+  for i = pos + count - 1, pos, -1 do
+    value = value * 2 + math.floor(block[math.floor(i / 8) + 1] / 2^(i % 8)) % 2
+  end
+  return value
+end
+
+
+-- decoders for single blocks written by love.image.newCompressedData, which
+-- return the 16 rgb pixels (0-255) in row-major order
+-- @NOTE only bc7 mode 6 and the etc1 compatible etc2 modes are decoded, as
+-- those are the only ones the encoder writes. nil is returned for others
+local bc7Weights = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64}
+local etcModifiers = {
+  {2, 8}, {5, 17}, {9, 29}, {13, 42}, {18, 60}, {24, 80}, {33, 106}, {47, 183}
+}
+local blockDecoders = {
+  DXT1 = function(block)
+    local c0 = block[1] + block[2] * 256
+    local c1 = block[3] + block[4] * 256
+    local palette = {}
+    for e, c in ipairs({c0, c1}) do
+      palette[e] = {
+        math.floor(c / 2048) * 255 / 31,
+        math.floor(c / 32) % 64 * 255 / 63,
+        c % 32 * 255 / 31
+      }
+    end
+    palette[3], palette[4] = {}, {}
+    for c = 1, 3 do
+      if c0 > c1 then
+        palette[3][c] = (2 * palette[1][c] + palette[2][c]) / 3
+        palette[4][c] = (palette[1][c] + 2 * palette[2][c]) / 3
+      else
+        palette[3][c] = (palette[1][c] + palette[2][c]) / 2
+        palette[4][c] = 0
+      end
+    end
+    local pixels = {}
+    for i = 1, 16 do
+      local color = palette[readBits(block, 32 + (i - 1) * 2, 2) + 1]
+      pixels[i] = {}
+      for c = 1, 3 do
+        pixels[i][c] = math.floor(color[c] + 0.5)
+      end
+    end
+    return pixels
+  end,
+  BC7 = function(block)
+    if readBits(block, 0, 7) ~= 64 then return nil end
+    local p0, p1 = readBits(block, 63, 1), readBits(block, 64, 1)
+    local e0, e1 = {}, {}
+    for c = 1, 3 do
+      e0[c] = readBits(block, 7 + (c - 1) * 14, 7) * 2 + p0
+      e1[c] = readBits(block, 14 + (c - 1) * 14, 7) * 2 + p1
+    end
+    local pixels, pos = {}, 65
+    for i = 1, 16 do
+      local bits = i == 1 and 3 or 4
+      local w = bc7Weights[readBits(block, pos, bits) + 1]
+      pos = pos + bits
+      pixels[i] = {}
+      for c = 1, 3 do
+        pixels[i][c] = math.floor(((64 - w) * e0[c] + w * e1[c] + 32) / 64)
+      end
+    end
+    return pixels
+  end,
+  ETC2rgb = function(block)
+    local diff = math.floor(block[4] / 2) % 2 == 1
+    local flip = block[4] % 2 == 1
+    local bases = {{}, {}}
+    for c = 1, 3 do
+      if diff then
+        local base, delta = math.floor(block[c] / 8), block[c] % 8
+        if delta >= 4 then delta = delta - 8 end
+        local other = base + delta
+        -- out of range sums select the etc2 only t, h and planar modes
+        if other < 0 or other > 31 then return nil end
+        bases[1][c] = base * 8 + math.floor(base / 4)
+        bases[2][c] = other * 8 + math.floor(other / 4)
+      else
+        bases[1][c] = math.floor(block[c] / 16) * 17
+        bases[2][c] = block[c] % 16 * 17
+      end
+    end
+    local tables = {math.floor(block[4] / 32), math.floor(block[4] / 4) % 8}
+    -- selector bits are big endian, with pixels stored column by column
+    local function selectorBit(k)
+      return math.floor(block[8 - math.floor(k / 8)] / 2^(k % 8)) % 2
+    end
+    local pixels = {}
+    for y = 0, 3 do
+      for x = 0, 3 do
+        local i = x * 4 + y
+        local sub = ((flip and y >= 2) or (not flip and x >= 2)) and 2 or 1
+        local modifier = etcModifiers[tables[sub] + 1][selectorBit(i) + 1]
+        if selectorBit(i + 16) == 1 then modifier = -modifier end
+        local pixel = {}
+        for c = 1, 3 do
+          pixel[c] = math.min(math.max(bases[sub][c] + modifier, 0), 255)
+        end
+        pixels[y * 4 + x + 1] = pixel
+      end
+    end
+    return pixels
+  end
+}
+
+
 -- love.image.newCompressedData
 -- @NOTE this is just basic nil checking, objs have their own test method
 love.test.image.newCompressedData = function(test)
   test:assertObject(love.image.newCompressedData('resources/love.dxt1'))
+
+  -- encode imagedata at runtime, with and without mipmaps
+  local idata = love.image.newImageData('resources/love.png')
+  local formats = { DXT1 = 2048, DXT5 = 4096, BC7 = 4096, ETC2rgb = 2048, ETC2rgba = 4096 }
+  for format, size in pairs(formats) do
+    local cdata = love.image.newCompressedData(idata, format)
+    test:assertObject(cdata)
+    test:assertEquals(format, cdata:getFormat(), 'check ' .. format .. ' format')
+    test:assertEquals(size, cdata:getSize(), 'check ' .. format .. ' size')
+    test:assertEquals(1, cdata:getMipmapCount(), 'check ' .. format .. ' mipmap count')
+  end
+  local mipped = love.image.newCompressedData(idata, 'DXT1', true)
+  test:assertEquals(7, mipped:getMipmapCount(), 'check encoded mipmap count')
+  test:assertEquals(1, mipped:getWidth(7), 'check smallest mipmap width')
+
+  -- non-multiple-of-4 sizes and other source formats
+  local odd = love.image.newImageData(5, 3, 'rgba16f')
+  test:assertEquals(32, love.image.newCompressedData(odd, 'BC7'):getSize(), 'check partial blocks')
+  local ok = pcall(love.image.newCompressedData, idata, 'ASTC4x4')
+  test:assertFalse(ok, 'check unsupported encode format')
+
+  -- decode an encoded gradient and check its psnr, so quality regressions
+  -- are caught and not just size changes
+  local gradient = love.image.newImageData(128, 128)
+  gradient:mapPixel(function(x, y)
+    return x / 127, y / 127, 1 - (x + y) / 254, 1
+  end)
+  local floors = { DXT1 = 38, BC7 = 42, ETC2rgb = 36 }
+  for format, floor in pairs(floors) do
+    local encoded = love.image.newCompressedData(gradient, format):getString()
+    local blocksize = #encoded / (32 * 32)
+    local decoded, sqerror = 0, 0
+    for by = 0, 31 do
+      for bx = 0, 31 do
+        local offset = (by * 32 + bx) * blocksize
+        local pixels = blockDecoders[format]({encoded:byte(offset + 1, offset + blocksize)})
+        if pixels ~= nil then
+          decoded = decoded + 1
+          for i = 1, 16 do
+            local source = {gradient:getPixel(bx * 4 + (i - 1) % 4, by * 4 + math.floor((i - 1) / 4))}
+            for c = 1, 3 do
+              sqerror = sqerror + (pixels[i][c] - math.floor(source[c] * 255 + 0.5))^2
+            end
+          end
+        end
+      end
+    end
+    test:assertEquals(32 * 32, decoded, 'check ' .. format .. ' blocks decoded')
+    local mse = math.max(sqerror / (128 * 128 * 3), 1e-6)
+    local psnr = 10 * math.log10(255 * 255 / mse)
+    test:assertGreaterEqual(floor, psnr, 'check ' .. format .. ' psnr')
+  end
+
+  -- cache to disk as ktx and load it back
+  mipped:encode('ktx', 'test-encode.ktx')
+  local loaded = love.image.newCompressedData('test-encode.ktx')
+  test:assertEquals('DXT1', loaded:getFormat(), 'check cached format')
+  test:assertEquals(7, loaded:getMipmapCount(), 'check cached mipmap count')
+  test:assertEquals(mipped:getString(), loaded:getString(), 'check cached data')
+  love.filesystem.remove('test-encode.ktx')
+end
+
+
+-- love.image.newMipmaps
+love.test.image.newMipmaps = function(test)
+  local idata = love.image.newImageData('resources/love.png')
+  local mips = love.image.newMipmaps(idata)
+  test:assertEquals(7, #mips, 'check level count')
+  test:assertEquals(idata, mips[1], 'check base level')
+  test:assertEquals(32, mips[2]:getWidth(), 'check level 2 width')
+  test:assertEquals(1, mips[7]:getHeight(), 'check last level height')
+  test:assertEquals('rgba8', mips[2]:getFormat(), 'check level format')
+
+  -- a solid color stays the same through every filter
+  local solid = love.image.newImageData(7, 5)
+  solid:mapPixel(function() return 0.5, 0.25, 1, 1 end)
+  for _, filter in ipairs({'box', 'kaiser'}) do
+    local levels = love.image.newMipmaps(solid, { filter = filter })
+    test:assertEquals(3, #levels, 'check odd size level count')
+    local r, g, b, a = levels[2]:getPixel(1, 1)
+    test:assertRange(r, 0.49, 0.51, 'check ' .. filter .. ' r')
+    test:assertRange(g, 0.24, 0.26, 'check ' .. filter .. ' g')
+    test:assertEquals(1, a, 'check ' .. filter .. ' a')
+  end
+
+  -- gamma-correct averaging of black and white is brighter than 0.5
+  local checker = love.image.newImageData(2, 2)
+  checker:setPixel(0, 0, 1, 1, 1, 1)
+  checker:setPixel(1, 1, 1, 1, 1, 1)
+  local gr = love.image.newMipmaps(checker)[2]:getPixel(0, 0)
+  local lr = love.image.newMipmaps(checker, { gammacorrect = false })[2]:getPixel(0, 0)
+  test:assertGreaterEqual(0.7, gr, 'check gamma-correct average')
+  test:assertRange(lr, 0.49, 0.51, 'check linear average')
+
+  -- alpha coverage keeps a sparse cutout from fading away
+  local cutout = love.image.newImageData(8, 8)
+  for i = 0, 7 do cutout:setPixel(i, i, 1, 1, 1, 1) end
+  local faded = love.image.newMipmaps(cutout, { gammacorrect = false })
+  local kept = love.image.newMipmaps(cutout, { gammacorrect = false, alphacoverage = 0.5 })
+  local _, _, _, fa = faded[3]:getPixel(0, 0)
+  local _, _, _, ka = kept[3]:getPixel(0, 0)
+  test:assertGreaterEqual(fa, ka, 'check coverage scaled alpha up')
+
+  -- the levels can be used as texture mipmaps
+  if love.graphics ~= nil and love.graphics.newTexture ~= nil then
+    local tex = love.graphics.newTexture(mips, { mipmaps = true })
+    test:assertEquals(7, tex:getMipmapCount(), 'check texture mipmaps')
+  end
 end
 
 
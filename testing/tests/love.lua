@@ -52,3 +52,102 @@ end
 love.test.love.run = function(test)
   test:assertTrue(type(love.run) == 'function', 'check defined')
 end
+
+
+-- runs a small game in a separate love process and returns what it printed
+-- @NOTE the game is written to the save directory, and any renderer the test
+-- suite was started with is passed on
+local function runGame(test, name, files, options)
+  local exepath = love.filesystem.getExecutablePath()
+  if io.popen == nil or exepath == nil or #exepath == 0 or love.filesystem.isFused() then
+    test:skipTest('cant start a separate love process here')
+    return nil
+  end
+  love.filesystem.createDirectory(name)
+  for file, contents in pairs(files) do
+    love.filesystem.write(name .. '/' .. file, contents)
+  end
+  local renderers = love.arg.options.renderers
+  if renderers.set then
+    options = options .. ' --renderers ' .. renderers.arg[1]
+  end
+  local path = love.filesystem.getSaveDirectory() .. '/' .. name
+  local pipe = io.popen('"' .. exepath .. '" "' .. path .. '" ' .. options .. ' 2>&1')
+  local output = pipe:read('*a')
+  pipe:close()
+  for file, _ in pairs(files) do
+    love.filesystem.remove(name .. '/' .. file)
+  end
+  love.filesystem.remove(name)
+  return output
+end
+
+
+-- t.lazymodules
+-- @NOTE deferred modules load on first access, after the modules they need,
+-- and objects they return from other modules keep their methods
+love.test.love.lazymodules = function(test)
+  local output = runGame(test, 'lazymodules', {
+    ['conf.lua'] = [[
+      function love.conf(t)
+        t.lazymodules = true
+        t.window.width = 64
+        t.window.height = 64
+      end
+    ]],
+    ['main.lua'] = [[
+      local function check(label, value)
+        print((value and 'ok ' or 'fail ') .. label)
+      end
+      function love.load()
+        check('physics deferred', rawget(love, 'physics') == nil)
+        check('physics loaded on access', love.physics ~= nil and rawget(love, 'physics') ~= nil)
+        check('sound deferred', rawget(love, 'sound') == nil)
+        check('audio loaded on access', love.audio ~= nil)
+        check('sound loaded before audio', rawget(love, 'sound') ~= nil)
+        check('unknown key', love.notamodule == nil)
+        local buffer = love.graphics.newBuffer('float', 4, {vertex=true})
+        local data = love.graphics.readbackBuffer(buffer)
+        check('readback data methods', data:getSize() == 16 and #data:getString() == 16)
+        local world = love.physics.newWorld(0, 0)
+        love.physics.newBody(world, 0, 0, 'dynamic')
+        local state = world:saveState()
+        check('saved state methods', state:getSize() > 0 and #state:getString() == state:getSize())
+        love.event.quit()
+      end
+    ]]
+  }, '')
+  if output == nil then return end
+  for _, label in ipairs({
+    'physics deferred', 'physics loaded on access', 'sound deferred',
+    'audio loaded on access', 'sound loaded before audio', 'unknown key',
+    'readback data methods', 'saved state methods'
+  }) do
+    test:assertNotEquals(nil, output:find('ok ' .. label, 1, true), 'check ' .. label)
+  end
+end
+
+
+-- --startup-profile
+love.test.love.startupProfile = function(test)
+  local output = runGame(test, 'startupprofile', {
+    ['conf.lua'] = [[
+      function love.conf(t)
+        t.window.width = 64
+        t.window.height = 64
+      end
+    ]],
+    ['main.lua'] = [[
+      function love.load()
+        love.event.quit()
+      end
+    ]]
+  }, '--startup-profile')
+  if output == nil then return end
+  for _, label in ipairs({
+    'Startup profile:', 'boot', 'conf.lua', 'love.graphics', 'window and graphics context',
+    'main.lua', 'love.load', 'first frame', 'total to first frame'
+  }) do
+    test:assertNotEquals(nil, output:find(label, 1, true), 'check ' .. label .. ' listed')
+  end
+end
@@ -521,6 +521,7 @@ love.test.physics.World = function(test)
   test:assertRange(world:getBodies()[1]:getX(), 9, 11, 'check body prop change x')
   test:assertRange(world:getBodies()[1]:getY(), 9, 11, 'check body prop change y')
   test:assertEquals(1, world:getBodyCount(), 'check 1 body count')
+  test:assertTrue(rawequal(body1, world:getBodies()[1]), 'check body proxy reused')
 
   -- check shapes in world
   test:assertEquals(1, #world:getShapesInArea(0, 0, 10, 10), 'check shapes in area #1')
@@ -607,6 +608,255 @@ love.test.physics.World = function(test)
 end
 
 
+-- World:getBodies (pushes many objects to lua at once)
+-- @NOTE testing/benchmarks/physics times this with many more bodies
+love.test.physics.WorldGetBodies = function(test)
+
+  local world = love.physics.newWorld(0, 0, false)
+  local count = 100
+  for i=1,count do
+    love.physics.newBody(world, i, 0, 'static')
+  end
+
+  -- first call creates the proxies, later calls reuse them
+  local bodies = world:getBodies()
+  test:assertEquals(count, #bodies, 'check body count')
+  local again = world:getBodies()
+  test:assertEquals(count, #again, 'check body count again')
+  test:assertTrue(rawequal(bodies[1], again[1]), 'check first proxy reused')
+  test:assertTrue(rawequal(bodies[count], again[count]), 'check last proxy reused')
+  test:assertEquals('Body', bodies[count]:type(), 'check metatable type')
+  world:destroy()
+
+end
+
+
+-- World:rayCastBatch and World:getShapesInAreaBatch
+-- batched results must match the single query functions
+love.test.physics.WorldBatchQueries = function(test)
+
+  -- a row of boxes to cast against
+  local world = love.physics.newWorld(0, 0, false)
+  for i=0,9 do
+    local body = love.physics.newBody(world, i*20, 0, 'static')
+    love.physics.newRectangleShape(body, 10, 10)
+  end
+
+  -- vertical rays, every other one misses
+  local rays = {}
+  for i=0,199 do
+    local x = (i % 20)*10
+    table.insert(rays, x) ; table.insert(rays, -50)
+    table.insert(rays, x) ; table.insert(rays, 50)
+  end
+  local count = #rays/4
+  for _, threaded in ipairs({false, true}) do
+    local results = love.data.newByteData(count*24)
+    local hits, shapes = world:rayCastBatch(rays, results, 'closest', nil, threaded)
+    test:assertEquals(100, hits, 'check hit count')
+    test:assertEquals(10, #shapes, 'check unique shapes')
+    local mismatches = 0
+    for i=0,count-1 do
+      local shape, x, y, nx, ny, fraction = love.data.unpack('<I4fffff', results, i*24 + 1)
+      local rshape, rx, ry, rnx, rny, rfraction = world:rayCastClosest(rays[i*4+1], rays[i*4+2], rays[i*4+3], rays[i*4+4])
+      if (shape == 0) ~= (rshape == nil) then
+        mismatches = mismatches + 1
+      elseif rshape ~= nil and (shapes[shape] ~= rshape or math.abs(y - ry) > 0.001 or math.abs(fraction - rfraction) > 0.0001) then
+        mismatches = mismatches + 1
+      end
+    end
+    test:assertEquals(0, mismatches, 'check ray results match rayCastClosest')
+  end
+
+  -- two areas, the second covers three boxes
+  local areas = love.data.pack('data', '<ffffffff', -5, -5, 5, 5, 15, -5, 65, 5)
+  local results = love.data.newByteData(8*8)
+  local written, shapes, total = world:getShapesInAreaBatch(areas, results)
+  test:assertEquals(4, total, 'check area overlaps')
+  test:assertEquals(4, written, 'check area records')
+  local area1, shape1 = love.data.unpack('<I4I4', results, 1)
+  test:assertEquals(1, area1, 'check first area index')
+  test:assertEquals('PolygonShape', shapes[shape1]:type(), 'check shape type')
+  local area4 = love.data.unpack('<I4', results, 3*8 + 1)
+  test:assertEquals(2, area4, 'check last area index')
+
+  -- a small output buffer is filled as far as possible
+  local small = love.data.newByteData(8*2)
+  written, shapes, total = world:getShapesInAreaBatch(areas, small)
+  test:assertEquals(2, written, 'check truncated records')
+  test:assertEquals(4, total, 'check total with truncation')
+
+  -- partial input records are rejected
+  local partial = love.data.pack('data', '<fffff', -5, -5, 5, 5, 1)
+  test:assertFalse(pcall(world.getShapesInAreaBatch, world, partial, results), 'check partial area rejected')
+  test:assertFalse(pcall(world.rayCastBatch, world, partial, results), 'check partial ray rejected')
+
+  -- outputs sharing memory with the input are rejected
+  local shared = love.data.newByteData(areas)
+  test:assertFalse(pcall(world.getShapesInAreaBatch, world, shared, shared), 'check same area data rejected')
+  local memory = love.data.newByteData(64)
+  local input = love.data.newDataView(memory, 0, 32)
+  local output = love.data.newDataView(memory, 16, 48)
+  test:assertFalse(pcall(world.rayCastBatch, world, input, output), 'check overlapping ray data rejected')
+  input = love.data.newDataView(memory, 0, 16)
+  output = love.data.newDataView(memory, 16, 24)
+  test:assertTrue(pcall(world.rayCastBatch, world, input, output), 'check adjacent ray data accepted')
+
+  world:destroy()
+
+end
+
+
+-- World:setThreadCount
+-- stepping on several threads must give the same results as a single thread
+love.test.physics.WorldThreadCount = function(test)
+
+  -- separate pyramids resting on one shared static ground
+  local function build()
+    local world = love.physics.newWorld(0, 9.81*64, true)
+    local ground = love.physics.newBody(world, 0, 0, 'static')
+    love.physics.newEdgeShape(ground, -1000, 0, 4000, 0)
+    local bodies = {}
+    for p=0,19 do
+      for row=0,5 do
+        for col=0,5-row do
+          local x = p*150 + col*17 + row*8.5
+          local y = -8 - row*16.5
+          local body = love.physics.newBody(world, x, y, 'dynamic')
+          love.physics.newRectangleShape(body, 16, 16)
+          table.insert(bodies, body)
+        end
+      end
+    end
+    local impulses = 0
+    world:setCallbacks(nil, nil, nil, function() impulses = impulses + 1 end)
+    return world, bodies, function() return impulses end
+  end
+
+  local world1, bodies1, count1 = build()
+  local world2, bodies2, count2 = build()
+  test:assertEquals(1, world1:getThreadCount(), 'check default thread count')
+  world2:setThreadCount(0)
+  test:assertEquals(0, world2:getThreadCount(), 'check thread count set')
+
+  for i=1,60 do
+    world1:update(1/60)
+    world2:update(1/60)
+  end
+
+  test:assertEquals(count1(), count2(), 'check postsolve count')
+  local mismatches = 0
+  for i=1,#bodies1 do
+    local x1, y1 = bodies1[i]:getPosition()
+    local x2, y2 = bodies2[i]:getPosition()
+    if x1 ~= x2 or y1 ~= y2 or bodies1[i]:getAngle() ~= bodies2[i]:getAngle() then
+      mismatches = mismatches + 1
+    end
+  end
+  test:assertEquals(0, mismatches, 'check identical positions')
+  test:assertEquals(world1:getContactCount(), world2:getContactCount(), 'check contact count')
+
+  world1:destroy()
+  world2:destroy()
+
+end
+
+
+-- World:saveState and World:restoreState
+love.test.physics.WorldState = function(test)
+
+  local world = love.physics.newWorld(0, 9.81*64, true)
+  local ground = love.physics.newBody(world, 0, 0, 'static')
+  love.physics.newEdgeShape(ground, -400, 0, 400, 0)
+  local bodies = {}
+  for row=0,5 do
+    for col=0,5-row do
+      local body = love.physics.newBody(world, col*17 + row*8.5, -8 - row*16.5 - 40, 'dynamic')
+      love.physics.newRectangleShape(body, 16, 16)
+      table.insert(bodies, body)
+    end
+  end
+  local wheel = love.physics.newBody(world, -100, -50, 'dynamic')
+  love.physics.newCircleShape(wheel, 10)
+  love.physics.newRevoluteJoint(ground, wheel, -100, -50)
+  table.insert(bodies, wheel)
+
+  local function snapshot()
+    local positions = {}
+    for i=1,#bodies do
+      local x, y = bodies[i]:getPosition()
+      local vx, vy = bodies[i]:getLinearVelocity()
+      table.insert(positions, {x, y, bodies[i]:getAngle(), vx, vy})
+    end
+    return positions
+  end
+  local function mismatches(a, b)
+    local count = 0
+    for i=1,#a do
+      for j=1,#a[i] do
+        if a[i][j] ~= b[i][j] then count = count + 1 end
+      end
+    end
+    return count
+  end
+  local function step(n)
+    for i=1,n do world:update(1/60) end
+  end
+
+  -- full state, restored after the simulation has moved on
+  step(30)
+  local base = world:saveState()
+  test:assertObject(base)
+  test:assertGreaterEqual(1, base:getSize(), 'check state size')
+  step(30)
+  local expected = snapshot()
+  local contacts = world:getContactCount()
+  step(45)
+  world:restoreState(base)
+  step(30)
+  test:assertEquals(0, mismatches(expected, snapshot()), 'check restored simulation')
+  test:assertEquals(contacts, world:getContactCount(), 'check restored contacts')
+
+  -- delta state against the full state
+  world:restoreState(base)
+  step(5)
+  local delta = world:saveState(base)
+  step(30)
+  expected = snapshot()
+  world:restoreState(base)
+  world:restoreState(delta, base)
+  step(30)
+  test:assertEquals(0, mismatches(expected, snapshot()), 'check restored delta')
+  local ok = pcall(world.restoreState, world, delta)
+  test:assertFalse(ok, 'check delta without base')
+
+  -- a different base of the same size is rejected before anything is modified
+  local other = world:saveState()
+  test:assertEquals(base:getSize(), other:getSize(), 'check same base size')
+  local unchanged = snapshot()
+  ok = pcall(world.restoreState, world, delta, other)
+  test:assertFalse(ok, 'check delta with different base')
+  test:assertEquals(0, mismatches(unchanged, snapshot()), 'check world unchanged by wrong base')
+
+  -- a truncated state is rejected before anything is modified
+  local live = world:getContacts()[1]
+  local before = snapshot()
+  local truncated = love.data.newByteData(base:getString():sub(1, -5))
+  ok = pcall(world.restoreState, world, truncated)
+  test:assertFalse(ok, 'check truncated state')
+  test:assertEquals(0, mismatches(before, snapshot()), 'check world unchanged')
+  test:assertFalse(live:isDestroyed(), 'check contacts kept')
+
+  -- the state only fits a world with the same objects
+  love.physics.newBody(world, 0, 0, 'dynamic')
+  ok = pcall(world.restoreState, world, base)
+  test:assertFalse(ok, 'check different world')
+
+  world:destroy()
+
+end
+
+
 --------------------------------------------------------------------------------
 --------------------------------------------------------------------------------
 ------------------------------------METHODS-------------------------------------
@@ -837,3 +1087,39 @@ love.test.physics.setMeter = function(test)
   test:assertEquals(100, x, 'check pos x')
   test:assertEquals(100, y, 'check pos y')
 end
+
+
+-- love.physics.updateWorlds
+love.test.physics.updateWorlds = function(test)
+  local function build()
+    local world = love.physics.newWorld(0, 9.81*64, true)
+    local ground = love.physics.newBody(world, 0, 0, 'static')
+    love.physics.newEdgeShape(ground, -100, 0, 100, 0)
+    local body = love.physics.newBody(world, 0, -50, 'dynamic')
+    love.physics.newRectangleShape(body, 16, 16)
+    return world, body
+  end
+  -- reference world stepped on its own
+  local reference, refbody = build()
+  -- one world with callbacks is stepped on the main thread
+  local worlds, bodies = {}, {}
+  for i=1,4 do
+    worlds[i], bodies[i] = build()
+  end
+  local begins = 0
+  worlds[4]:setCallbacks(function() begins = begins + 1 end)
+  for i=1,60 do
+    reference:update(1/60)
+    love.physics.updateWorlds(worlds, 1/60)
+  end
+  local rx, ry = refbody:getPosition()
+  for i=1,4 do
+    local x, y = bodies[i]:getPosition()
+    test:assertEquals(rx, x, 'check world ' .. i .. ' x')
+    test:assertEquals(ry, y, 'check world ' .. i .. ' y')
+  end
+  test:assertEquals(1, begins, 'check callback ran')
+  -- each world may only appear once
+  local ok = pcall(love.physics.updateWorlds, {worlds[1], worlds[1]}, 1/60)
+  test:assertFalse(ok, 'check duplicate world rejected')
+end
@@ -28,6 +28,34 @@ love.test.timer.getFPS = function(test)
 end
 
 
+-- love.timer.getProfilerFrames
+love.test.timer.getProfilerFrames = function(test)
+  love.timer.setProfilerEnabled(true)
+  test:assertTrue(love.timer.isProfilerEnabled(), 'check enabled')
+  love.timer.step()
+  local channel = love.thread.newChannel()
+  channel:push(1)
+  channel:demand()
+  love.timer.step()
+  love.timer.setProfilerEnabled(false)
+  local frames = love.timer.getProfilerFrames(1)
+  test:assertEquals(1, #frames, 'check frame count')
+  local names = {}
+  for _, zone in ipairs(frames[1].zones) do
+    names[zone.name] = zone
+  end
+  test:assertNotNil(names['Channel::push'])
+  test:assertNotNil(names['Channel::demand'])
+  if names['Channel::push'] then
+    test:assertEquals('Main', names['Channel::push'].thread, 'check thread name')
+    test:assertRange(names['Channel::push'].duration, 0, frames[1].duration, 'check zone duration')
+  end
+  local trace = love.timer.getProfilerTrace(1)
+  test:assertNotEquals(nil, trace:find('"traceEvents"', 1, true), 'check trace events')
+  test:assertNotEquals(nil, trace:find('Channel::push', 1, true), 'check trace zone')
+end
+
+
 -- love.timer.getTime
 love.test.timer.getTime = function(test)
   local starttime = love.timer.getTime()
@@ -29,6 +29,25 @@ love.test.video.VideoStream = function(test)
   video:pause()
   test:assertFalse(video:isPlaying(), 'check paused')
 
+  -- check decode ahead frames
+  test:assertEquals(3, video:getDecodeAheadFrames(), 'check def decode ahead')
+  video:setDecodeAheadFrames(8)
+  test:assertEquals(8, video:getDecodeAheadFrames(), 'check set decode ahead')
+  video:setDecodeAheadFrames(1)
+  test:assertEquals(1, video:getDecodeAheadFrames(), 'check shrink decode ahead')
+  local ok = pcall(video.setDecodeAheadFrames, video, 0)
+  test:assertFalse(ok, 'check decode ahead minimum')
+
+  -- check several streams can play at once
+  local streams = {}
+  for i=1,4 do
+    streams[i] = love.video.newVideoStream('resources/sample.ogv')
+    streams[i]:play()
+  end
+  for i=1,4 do
+    test:assertTrue(streams[i]:isPlaying(), 'check stream ' .. tostring(i) .. ' playing')
+  end
+
 end
 
 